@@ -0,0 +1,189 @@
+/**
+ * @file
+ * Bogenlaengen-Modul.
+ * Die Kurve besteht aus gleich breiten Teilstuecken in T. Je Teilstueck
+ * werden ARC_LENGTH_SAMPLES Stuetzstellen ausgewertet und die Laengen der
+ * Sehnen vom Anfang des Teilstuecks an aufsummiert, zusaetzlich wird die
+ * Laenge bis zum Anfang jedes Teilstuecks gespeichert. Aendert sich die
+ * Kurve nur lokal (z.B. beim Verschieben eines Kontrollpunktes), muessen
+ * nur die betroffenen Teilstuecke neu ausgewertet werden. Eine Laenge wird
+ * per binaerer Suche ueber die Teilstuecke und deren Stuetzstellen und
+ * linearer Interpolation zwischen zwei Stuetzstellen in T umgerechnet.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "arcLength.h"
+
+/* ---- Funktionen ---- */
+
+/**
+ * Initialisiert die Tabelle fuer eine Kurve und wertet alle Teilstuecke aus.
+ * Vorhandener Speicher der Tabelle wird wiederverwendet.
+ * @param table die Tabelle (in/out-param), beim ersten Aufruf mit 0 initialisiert
+ * @param function die Funktion, die den Punkt der Kurve zu T berechnet
+ * @param data Daten, die an die Funktion uebergeben werden
+ * @param dimensions Anzahl der Koordinaten eines Punktes (hoechstens ARC_LENGTH_MAX_DIMENSIONS)
+ * @param segments Anzahl der Teilstuecke (mindestens 1)
+ */
+void initArcLengthTable(ArcLengthTable *table, ArcLengthFunction function, void *data, int dimensions, int segments)
+{
+    table->function = function;
+    table->data = data;
+    table->dimensions = dimensions;
+    if (segments != table->segments || table->segmentStarts == NULL)
+    {
+        table->segments = segments;
+        table->sampleLengths = realloc(table->sampleLengths, sizeof(float) * segments * ARC_LENGTH_SAMPLES);
+        table->segmentStarts = realloc(table->segmentStarts, sizeof(float) * (segments + 1));
+        if (table->sampleLengths == NULL || table->segmentStarts == NULL)
+        {
+            printf("Kein virtueller RAM mehr verfügbar ...\n");
+            exit(1);
+        }
+        table->segmentStarts[0] = 0.0f;
+    }
+    updateArcLengthSegments(table, 0, segments - 1);
+}
+
+/**
+ * Wertet die Teilstuecke first bis last neu aus und aktualisiert die
+ * Laengen bis zum Anfang der folgenden Teilstuecke.
+ * @param table die Tabelle
+ * @param first erstes neu auszuwertendes Teilstueck (wird begrenzt)
+ * @param last letztes neu auszuwertendes Teilstueck (wird begrenzt)
+ */
+void updateArcLengthSegments(ArcLengthTable *table, int first, int last)
+{
+    first = first < 0 ? 0 : first;
+    last = last >= table->segments ? table->segments - 1 : last;
+    float sampleCount = (float)table->segments * ARC_LENGTH_SAMPLES;
+    for (int s = first; s <= last; s++)
+    {
+        float previous[ARC_LENGTH_MAX_DIMENSIONS];
+        float current[ARC_LENGTH_MAX_DIMENSIONS];
+        table->function(s * ARC_LENGTH_SAMPLES / sampleCount, previous, table->data);
+        float length = 0.0f;
+        float *lengths = table->sampleLengths + s * ARC_LENGTH_SAMPLES;
+        for (int k = 0; k < ARC_LENGTH_SAMPLES; k++)
+        {
+            table->function((s * ARC_LENGTH_SAMPLES + k + 1) / sampleCount, current, table->data);
+            float squared = 0.0f;
+            for (int d = 0; d < table->dimensions; d++)
+            {
+                float delta = current[d] - previous[d];
+                squared += delta * delta;
+                previous[d] = current[d];
+            }
+            length += sqrtf(squared);
+            lengths[k] = length;
+        }
+    }
+    //Anfaenge aller folgenden Teilstuecke verschieben sich
+    for (int s = first; s < table->segments; s++)
+    {
+        table->segmentStarts[s + 1] = table->segmentStarts[s] + table->sampleLengths[s * ARC_LENGTH_SAMPLES + ARC_LENGTH_SAMPLES - 1];
+    }
+}
+
+/**
+ * Liefert die Laenge der gesamten Kurve.
+ * @param table die Tabelle
+ * @return die Laenge der Kurve
+ */
+float getArcLength(const ArcLengthTable *table)
+{
+    return table->segmentStarts[table->segments];
+}
+
+/**
+ * Berechnet das T, an dem die Kurve vom Anfang aus gemessen die
+ * uebergebene Laenge erreicht.
+ * @param table die Tabelle
+ * @param distance die Laenge vom Anfang der Kurve (wird auf die Kurve begrenzt)
+ * @return das zugehoerige T [0-1]
+ */
+float getArcLengthParameter(const ArcLengthTable *table, float distance)
+{
+    float total = getArcLength(table);
+    distance = distance < 0.0f ? 0.0f : distance > total ? total : distance;
+
+    //Letztes Teilstueck, das vor der Laenge beginnt
+    int low = 0;
+    int high = table->segments - 1;
+    while (low < high)
+    {
+        int middle = (low + high + 1) / 2;
+        if (table->segmentStarts[middle] <= distance)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    int segment = low;
+    float local = distance - table->segmentStarts[segment];
+
+    //Erste Stuetzstelle, die die Laenge erreicht
+    const float *lengths = table->sampleLengths + segment * ARC_LENGTH_SAMPLES;
+    low = 0;
+    high = ARC_LENGTH_SAMPLES - 1;
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+        if (lengths[middle] < local)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    float before = low > 0 ? lengths[low - 1] : 0.0f;
+    float width = lengths[low] - before;
+    float fraction = width > 0.0f ? (local - before) / width : 0.0f;
+    return (segment * ARC_LENGTH_SAMPLES + low + fraction) / ((float)table->segments * ARC_LENGTH_SAMPLES);
+}
+
+/**
+ * Berechnet die Laenge der Kurve vom Anfang bis zu einem T.
+ * @param table die Tabelle
+ * @param T das T [0-1]
+ * @return die Laenge vom Anfang der Kurve bis T
+ */
+float getArcLengthAtParameter(const ArcLengthTable *table, float T)
+{
+    int sampleCount = table->segments * ARC_LENGTH_SAMPLES;
+    float position = T * sampleCount;
+    int sample = (int)floorf(position);
+    sample = sample < 0 ? 0 : sample >= sampleCount ? sampleCount - 1 : sample;
+    float fraction = position - sample;
+    fraction = fraction < 0.0f ? 0.0f : fraction > 1.0f ? 1.0f : fraction;
+    int segment = sample / ARC_LENGTH_SAMPLES;
+    int k = sample % ARC_LENGTH_SAMPLES;
+    const float *lengths = table->sampleLengths + segment * ARC_LENGTH_SAMPLES;
+    float before = k > 0 ? lengths[k - 1] : 0.0f;
+    return table->segmentStarts[segment] + before + (lengths[k] - before) * fraction;
+}
+
+/**
+ * Gibt den Speicher der Tabelle frei.
+ * @param table die Tabelle
+ */
+void freeArcLengthTable(ArcLengthTable *table)
+{
+    free(table->sampleLengths);
+    free(table->segmentStarts);
+    table->sampleLengths = NULL;
+    table->segmentStarts = NULL;
+    table->segments = 0;
+}
@@ -0,0 +1,56 @@
+#ifndef __ARC_LENGTH_H__
+#define __ARC_LENGTH_H__
+/**
+ * @file
+ * Bogenlaengen-Modul.
+ * Das Modul tabelliert die Bogenlaenge einer Kurve ueber T [0-1], damit
+ * Bewegungen entlang der Kurve mit konstanter Geschwindigkeit im Raum
+ * erfolgen koennen. Die Kurve wird als Funktion uebergeben, sodass das Modul
+ * unabhaengig von der Art der Kurve ist.
+ *
+ * Das Modul wird von ueb01 (Flugzeug auf der Kurve) sowie ueb02 und ueb03
+ * (Kameraflug) genutzt und ist unabhaengig von deren Typen.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- Konstanten ---- */
+
+/* Anzahl der Stuetzstellen je Teilstueck */
+#define ARC_LENGTH_SAMPLES 32
+/* Hoechstzahl an Dimensionen eines Kurvenpunktes */
+#define ARC_LENGTH_MAX_DIMENSIONS 3
+
+/* ---- Typedeklarationen ---- */
+
+/* Funktion, die den Punkt einer Kurve zu T [0-1] berechnet */
+typedef void (*ArcLengthFunction)(float T, float *point, void *data);
+
+/* Tabelle der Bogenlaenge einer Kurve aus gleich breiten Teilstuecken in T */
+typedef struct
+{
+    ArcLengthFunction function;
+    void *data;
+    int dimensions;
+    int segments;
+    /* Je Teilstueck die Laenge von dessen Anfang bis zu jeder Stuetzstelle */
+    float *sampleLengths;
+    /* Laenge vom Anfang der Kurve bis zum Anfang jedes Teilstuecks (segments + 1 Eintraege) */
+    float *segmentStarts;
+} ArcLengthTable;
+
+/* ---- Funktionen ---- */
+
+void initArcLengthTable(ArcLengthTable *table, ArcLengthFunction function, void *data, int dimensions, int segments);
+
+void updateArcLengthSegments(ArcLengthTable *table, int first, int last);
+
+float getArcLength(const ArcLengthTable *table);
+
+float getArcLengthParameter(const ArcLengthTable *table, float distance);
+
+float getArcLengthAtParameter(const ArcLengthTable *table, float T);
+
+void freeArcLengthTable(ArcLengthTable *table);
+
+#endif
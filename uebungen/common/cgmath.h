@@ -0,0 +1,529 @@
+#ifndef __CGMATH_H__
+#define __CGMATH_H__
+/**
+ * @file
+ * Mathematik-Modul.
+ * Gemeinsame Vektor- und Matrixfunktionen aller Uebungen. Das Modul besteht
+ * nur aus diesem Header: Alle Funktionen sind static inline, damit der
+ * Compiler sie in die aufrufenden Schleifen einsetzen kann und keine
+ * Funktionsaufrufe oder Speicheranforderungen anfallen.
+ *
+ * Vektoren sind float-Arrays mit 3 (bzw. 4) Komponenten, Matrizen sind
+ * 16-elementige float-Arrays, die zeilenweise gelesen werden
+ * (Element (Zeile i, Spalte j) an Index 4 * i + j). Ergebnisse werden immer
+ * vollstaendig in res geschrieben, res darf daher uninitialisiert sein und
+ * (sofern nicht anders angegeben) auf einen der Operanden zeigen.
+ *
+ * Multiplikation und Inverse von 4x4 Matrizen nutzen SSE, sofern verfuegbar,
+ * sonst eine skalare Variante mit demselben Ergebnis.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <math.h>
+#include <stdio.h>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define CGMATH_SSE
+#endif
+
+/* ---- Typedeklarationen ---- */
+
+/** Vektor im 3D-Raum */
+typedef GLfloat CGVec3f[3];
+
+/** Vektor in homogenen Koordinaten */
+typedef GLfloat CGVec4f[4];
+
+/** 4x4 Matrix, zeilenweise */
+typedef GLfloat CGMat4f[16];
+
+/* ---- Skalare ---- */
+
+/**
+ * Hilfsfunktion um von Grad zu Radian zu konvertieren
+ * @param degree Grad
+ * @return Radian
+ */
+static inline float degreeToRad(float degree)
+{
+    return degree * ((float)M_PI / 180.0f);
+}
+
+/**
+ * Hilfsfunktion um von Radian zu Grad zu konvertieren
+ * @param rad Radian
+ * @return Grad
+ */
+static inline float radToDegree(float rad)
+{
+    return rad * (180.0f / (float)M_PI);
+}
+
+/**
+ * Hilfsfunktion zum begrenzen eines Wertes innerhalb eines Wertebereichs
+ * @param value des Wert des zu Begrenzen ist
+ * @param lower die untere Grenze
+ * @param upper die obere Grenze
+ * @return der potenziell korrigierte Wert
+ */
+static inline float clip(float value, float lower, float upper)
+{
+    return value < lower ? lower : value > upper ? upper : value;
+}
+
+/* ---- Vektoren ---- */
+
+/**
+ * Setzt die Komponenten eines 3D Vektors
+ * @param x die x Komponente
+ * @param y die y Komponente
+ * @param z die z Komponente
+ * @param res der beschriebe Vektor
+ */
+static inline void setVector(float x, float y, float z, float *res)
+{
+    res[0] = x;
+    res[1] = y;
+    res[2] = z;
+}
+
+/**
+ * Berechnet den Richtungsvektor zwischen zwei Punkten im 3-D Raum
+ * @param startPtr der Startpunkt
+ * @param endPtr der Endpunkt
+ * @param resPtr der Ergebnissvektor
+ */
+static inline void calcVectorBetweenPoints(const GLfloat *startPtr, const GLfloat *endPtr, GLfloat *resPtr)
+{
+    resPtr[0] = endPtr[0] - startPtr[0];
+    resPtr[1] = endPtr[1] - startPtr[1];
+    resPtr[2] = endPtr[2] - startPtr[2];
+}
+
+/**
+ * Addiert zwei Vektoren
+ * @param a erster Vektor auf den addiert wird
+ * @param b zweiter Vektor der addiert wird
+ * @param res Ergbeniss Vektor auf den das Ergbeniss geschrieben wird
+ */
+static inline void addVectors(const float *a, const float *b, float *res)
+{
+    res[0] = a[0] + b[0];
+    res[1] = a[1] + b[1];
+    res[2] = a[2] + b[2];
+}
+
+/**
+ * Kuemmert sich um die subtraktion zweier Vektoren.
+ * b wird von a abgezogen. (b ist das Ziel)
+ * @param a erster Vektor von dem subtrahiert wird
+ * @param b zweiter Vektor der subtrahiert wird
+ * @param res Ergbeniss Vektor auf den das Ergbeniss geschrieben wird
+ */
+static inline void subtractVectos(const float *a, const float *b, float *res)
+{
+    res[0] = a[0] - b[0];
+    res[1] = a[1] - b[1];
+    res[2] = a[2] - b[2];
+}
+
+/**
+ * Multipliziert zwei Vektoren komponentenweise
+ * @param a erster Vektor
+ * @param b zweiter Vektor
+ * @param res Ergbeniss Vektor auf den das Ergbeniss geschrieben wird
+ */
+static inline void multiplyVectors(const float *a, const float *b, float *res)
+{
+    res[0] = a[0] * b[0];
+    res[1] = a[1] * b[1];
+    res[2] = a[2] * b[2];
+}
+
+/**
+ * Multipliziert einen Skalar mit einem Vector
+ * (1x3 Vektor)
+ * @param v der zu multiplizierende Vector.
+ * @param scalar der scalar.
+ * @param res das Erbeniss der Berechnung.
+ */
+static inline void multiplyVectorWithScalar(const float *v, float scalar, float *res)
+{
+    res[0] = v[0] * scalar;
+    res[1] = v[1] * scalar;
+    res[2] = v[2] * scalar;
+}
+
+/**
+ * Dividiert einen Vektor mit einem Scalar
+ * (1x3 Vektor)
+ * @param v der zu dividierende Vector.
+ * @param scalar der scalar.
+ * @param res das Erbeniss der Berechnung.
+ */
+static inline void divideVectorWithScalar(const float *v, float scalar, float *res)
+{
+    res[0] = v[0] / scalar;
+    res[1] = v[1] / scalar;
+    res[2] = v[2] / scalar;
+}
+
+/**
+ * Berechnet das Skalarprodukt
+ * @param a erster Vektor
+ * @param b zweiter Vektor
+ * @return das Ergebniss
+ */
+static inline float calcDotProduct(const float *a, const float *b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * Berechnet Betrag/Laenge eines Vektors
+ * @param a ein Vektor
+ * @return der Betrag des Vektors
+ */
+static inline float calcVectorLength(const float *a)
+{
+    return sqrtf(calcDotProduct(a, a));
+}
+
+/**
+ * Normalisiert einen Vektor.
+ * @param vec zu normalisiernder Vektor
+ */
+static inline void normalizeVector(float *vec)
+{
+    divideVectorWithScalar(vec, calcVectorLength(vec), vec);
+}
+
+/**
+ * Berechnet das Kreuzprodukt zwischen zwei 3D Vektoren und schreibt das
+ * (nicht normalisierte) Ergebnis auf res.
+ * @param a Zeiger auf den ersten Vektor
+ * @param b Zeiger auf den zweiten Vektor
+ * @param res Zeiger auf das Arrayelemet in das das Erg. geschrieben wird
+ */
+static inline void calcCrossProduct(const GLfloat *a, const GLfloat *b, GLfloat *res)
+{
+    float x = a[1] * b[2] - a[2] * b[1];
+    float y = a[2] * b[0] - a[0] * b[2];
+    float z = a[0] * b[1] - a[1] * b[0];
+    setVector(x, y, z, res);
+}
+
+/**
+ * Berechnet das Kreuzprodukt zwischen zwei 3D Vektoren und bringt es auf die
+ * uebergebene Laenge (z.B. 1 fuer eine Normale).
+ * @param a Zeiger auf den ersten Vektor
+ * @param b Zeiger auf den zweiten Vektor
+ * @param length die Laenge des Ergebnisses
+ * @param res Zeiger auf das Arrayelemet in das das Erg. geschrieben wird
+ */
+static inline void calcNormalizedCrossProduct(const GLfloat *a, const GLfloat *b, float length, GLfloat *res)
+{
+    calcCrossProduct(a, b, res);
+    multiplyVectorWithScalar(res, length / calcVectorLength(res), res);
+}
+
+/* ---- Matrizen ---- */
+
+/**
+ * Setzt eine 4x4 Matrix auf die Einheitsmatrix.
+ * @param res die Matrix
+ */
+static inline void setIdentityMatrix(GLfloat *res)
+{
+    for (int i = 0; i < 16; i++)
+    {
+        res[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+}
+
+/**
+ * Transponiert eine 4x4 Matrix.
+ * @param m die Matrix
+ * @param res die transponierte Matrix (darf m sein)
+ */
+static inline void transpose4x4(const GLfloat *m, GLfloat *res)
+{
+    GLfloat t[16];
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            t[4 * j + i] = m[4 * i + j];
+        }
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        res[i] = t[i];
+    }
+}
+
+/**
+ * Hilfsfunktion welche zwei 4x4 Matrixen welche als 16-Elementige Arrays representiert
+ * werden miteinander multipliziert. mat1*mat2 = res
+ * @param mat1 Zeiger auf die ertste Matrix
+ * @param mat2 Zeiger auf die zweite Matrix
+ * @param res Zeiger auf die Ergebnissmatrix (darf mat1 oder mat2 sein)
+ */
+static inline void multiply4x4With4x4Matrix(const GLfloat *mat1, const GLfloat *mat2, GLfloat *res)
+{
+#ifdef CGMATH_SSE
+    //Zeile i des Ergebnisses ist die Linearkombination der Zeilen von mat2
+    //mit den Elementen der Zeile i von mat1
+    __m128 row0 = _mm_loadu_ps(mat2);
+    __m128 row1 = _mm_loadu_ps(mat2 + 4);
+    __m128 row2 = _mm_loadu_ps(mat2 + 8);
+    __m128 row3 = _mm_loadu_ps(mat2 + 12);
+    for (int i = 0; i < 16; i += 4)
+    {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(mat1[i]), row0);
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(mat1[i + 1]), row1));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(mat1[i + 2]), row2));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(mat1[i + 3]), row3));
+        _mm_storeu_ps(res + i, row);
+    }
+#else
+    GLfloat t[16];
+    for (int i = 0; i < 16; i += 4)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            t[i + j] = mat1[i] * mat2[j] + mat1[i + 1] * mat2[4 + j] + mat1[i + 2] * mat2[8 + j] + mat1[i + 3] * mat2[12 + j];
+        }
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        res[i] = t[i];
+    }
+#endif
+}
+
+/**
+ * Multipliziert dem Monomvektor S [1X4] mit der uebergebenen Matrix [4X4]
+ * @param monomVectorS der Monomvektor S
+ * @param mat4x4 die zu multiplizierende [4X4] Matrix
+ * @param result das Ergebniss der multiplikation
+ */
+static inline void multiply1x4With4x4Matrix(const float *monomVectorS, const float *mat4x4, float *result)
+{
+    float s0 = monomVectorS[0];
+    float s1 = monomVectorS[1];
+    float s2 = monomVectorS[2];
+    float s3 = monomVectorS[3];
+    for (int i = 0; i < 4; i++)
+    {
+        result[i] = s0 * mat4x4[i] + s1 * mat4x4[4 + i] + s2 * mat4x4[8 + i] + s3 * mat4x4[12 + i];
+    }
+}
+
+/**
+ * Multipliziert den Monomvektor T mit der Interpolationsmatrix.
+ * @param interpolation die Interpolationsmatrix
+ * @param monomVectorT der Monomvektor T
+ * @param result das Ergebniss des Multiplikation
+ */
+static inline void multiply4x4With4x1Matrix(const float *interpolation, const float *monomVectorT, float *result)
+{
+    float t0 = monomVectorT[0];
+    float t1 = monomVectorT[1];
+    float t2 = monomVectorT[2];
+    float t3 = monomVectorT[3];
+    for (int i = 0; i < 4; i++)
+    {
+        const float *row = interpolation + 4 * i;
+        result[i] = row[0] * t0 + row[1] * t1 + row[2] * t2 + row[3] * t3;
+    }
+}
+
+/**
+ * Multipiliert die uebergebenen Matrixen miteinander
+ * @param m1x4 Zeiger auf die 1X4 Matrix
+ * @param m4x1 Zeiger auf die 4X1 Matrix
+ * @return das Skalarprodukt
+ */
+static inline float multiply1x4With4x1Matrix(const float *m1x4, const float *m4x1)
+{
+    return m1x4[0] * m4x1[0] + m1x4[1] * m4x1[1] + m1x4[2] * m4x1[2] + m1x4[3] * m4x1[3];
+}
+
+/**
+ * Multipiliert die uebergebenen Matrixen miteinander
+ * @param m1x4 Zeiger auf die 1X4 Matrix
+ * @param dimension die x, y oder z dimension der 1x4 Matrix welche zu berechnen ist.
+ * @param m4x1 Zeiger auf die 4X1 Matrix
+ * @return das Skalarprodukt
+ */
+static inline float multiply1x4With4x1MatrixByDimension(GLfloat (*m1x4)[3], int dimension, const float *m4x1)
+{
+    return m1x4[0][dimension] * m4x1[0] + m1x4[1][dimension] * m4x1[1] + m1x4[2][dimension] * m4x1[2] + m1x4[3][dimension] * m4x1[3];
+}
+
+#ifdef CGMATH_SSE
+/* Vertauscht die Elemente eines Vektors */
+#define CGMATH_SWIZZLE(vec, x, y, z, w) _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(w, z, y, x))
+/* Waehlt die Elemente x, y aus a und z, w aus b */
+#define CGMATH_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+
+/**
+ * Multipliziert zwei 2x2 Matrizen (zeilenweise in einem Register) A * B.
+ */
+static inline __m128 cgmathMul2x2(__m128 a, __m128 b)
+{
+    return _mm_add_ps(_mm_mul_ps(a, CGMATH_SWIZZLE(b, 0, 3, 0, 3)),
+                      _mm_mul_ps(CGMATH_SWIZZLE(a, 1, 0, 3, 2), CGMATH_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+/**
+ * Multipliziert die Adjunkte einer 2x2 Matrix mit einer zweiten, adj(A) * B.
+ */
+static inline __m128 cgmathAdjMul2x2(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(CGMATH_SWIZZLE(a, 3, 3, 0, 0), b),
+                      _mm_mul_ps(CGMATH_SWIZZLE(a, 1, 1, 2, 2), CGMATH_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+/**
+ * Multipliziert eine 2x2 Matrix mit der Adjunkten einer zweiten, A * adj(B).
+ */
+static inline __m128 cgmathMulAdj2x2(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(a, CGMATH_SWIZZLE(b, 3, 0, 3, 0)),
+                      _mm_mul_ps(CGMATH_SWIZZLE(a, 1, 0, 3, 2), CGMATH_SWIZZLE(b, 2, 1, 2, 1)));
+}
+#endif
+
+/**
+ * Bestimmt die Inverse einer 4x4 Matrix.
+ * Mit SSE ueber die Zerlegung in 2x2 Bloecke (A B / C D), deren Adjunkten
+ * und Determinanten sich je in einem Register berechnen lassen, sonst ueber
+ * die Kofaktoren
+ * (Quelle :https://stackoverflow.com/questions/1148309/inverting-a-4x4-matrix).
+ * @param m die zu invertierende Matrix
+ * @param invOut die invertierte Matrix (darf m sein)
+ * @return ob die determinante == 0 (nicht loesbar) oder nicht
+ */
+static inline GLboolean gluInvertMatrix(const GLfloat m[16], GLfloat invOut[16])
+{
+#ifdef CGMATH_SSE
+    __m128 row0 = _mm_loadu_ps(m);
+    __m128 row1 = _mm_loadu_ps(m + 4);
+    __m128 row2 = _mm_loadu_ps(m + 8);
+    __m128 row3 = _mm_loadu_ps(m + 12);
+
+    //2x2 Bloecke
+    __m128 a = _mm_movelh_ps(row0, row1);
+    __m128 b = _mm_movehl_ps(row1, row0);
+    __m128 c = _mm_movelh_ps(row2, row3);
+    __m128 d = _mm_movehl_ps(row3, row2);
+
+    //Determinanten der Bloecke (|A| |B| |C| |D|)
+    __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(CGMATH_SHUFFLE(row0, row2, 0, 2, 0, 2), CGMATH_SHUFFLE(row1, row3, 1, 3, 1, 3)),
+        _mm_mul_ps(CGMATH_SHUFFLE(row0, row2, 1, 3, 1, 3), CGMATH_SHUFFLE(row1, row3, 0, 2, 0, 2)));
+    __m128 detA = CGMATH_SWIZZLE(detSub, 0, 0, 0, 0);
+    __m128 detB = CGMATH_SWIZZLE(detSub, 1, 1, 1, 1);
+    __m128 detC = CGMATH_SWIZZLE(detSub, 2, 2, 2, 2);
+    __m128 detD = CGMATH_SWIZZLE(detSub, 3, 3, 3, 3);
+
+    __m128 dc = cgmathAdjMul2x2(d, c);
+    __m128 ab = cgmathAdjMul2x2(a, b);
+    //Adjunkten der Bloecke der Inversen
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), cgmathMul2x2(b, dc));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), cgmathMul2x2(c, ab));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), cgmathMulAdj2x2(d, ab));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), cgmathMulAdj2x2(a, dc));
+
+    //|M| = |A| |D| + |B| |C| - Spur(adj(A) B adj(D) C)
+    __m128 trace = _mm_mul_ps(ab, CGMATH_SWIZZLE(dc, 0, 2, 1, 3));
+    trace = _mm_add_ps(trace, CGMATH_SWIZZLE(trace, 2, 3, 0, 1));
+    trace = _mm_add_ps(trace, CGMATH_SWIZZLE(trace, 1, 0, 3, 2));
+    __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+    if (_mm_cvtss_f32(det) == 0.0f)
+    {
+        return GL_FALSE;
+    }
+    __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+    x = _mm_mul_ps(x, invDet);
+    y = _mm_mul_ps(y, invDet);
+    z = _mm_mul_ps(z, invDet);
+    w = _mm_mul_ps(w, invDet);
+
+    //Adjunkte bilden und zeilenweise zusammensetzen
+    _mm_storeu_ps(invOut, CGMATH_SHUFFLE(x, y, 3, 1, 3, 1));
+    _mm_storeu_ps(invOut + 4, CGMATH_SHUFFLE(x, y, 2, 0, 2, 0));
+    _mm_storeu_ps(invOut + 8, CGMATH_SHUFFLE(z, w, 3, 1, 3, 1));
+    _mm_storeu_ps(invOut + 12, CGMATH_SHUFFLE(z, w, 2, 0, 2, 0));
+    return GL_TRUE;
+#else
+    GLfloat inv[16], det;
+
+    inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+    inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+    inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+    inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+    inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+    inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+    inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+    inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+    inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+    inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+    inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+    inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+    inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+    det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+    if (det == 0.0f)
+    {
+        return GL_FALSE;
+    }
+    det = 1.0f / det;
+    for (int i = 0; i < 16; i++)
+    {
+        invOut[i] = inv[i] * det;
+    }
+    return GL_TRUE;
+#endif
+}
+
+/**
+ * Berechnet aus der Modelmatrix dessen Position in Weltkoordinaten
+ * @param viewMatrixPtr ein Zeiger auf die Aktuelle Viewmatrix
+ * @param objectMatrixPtr ein Zeiger auf die Modelviewmatrix des zu bestimmenden Objektes
+ * @param worldCoordinatesPtr Zeiger auf den Vektor in den das Ergebniss geschrieben werden soll (x,y,z)
+ */
+static inline void calcWorldCoordinates(const GLfloat *viewMatrixPtr, const GLfloat *objectMatrixPtr, GLfloat *worldCoordinatesPtr)
+{
+    GLfloat invertedViewMatrix[16];
+    GLfloat worldCoordinatesMatrix[16];
+    if (gluInvertMatrix(viewMatrixPtr, invertedViewMatrix))
+    {
+        multiply4x4With4x4Matrix(objectMatrixPtr, invertedViewMatrix, worldCoordinatesMatrix);
+        setVector(worldCoordinatesMatrix[12], worldCoordinatesMatrix[13], worldCoordinatesMatrix[14], worldCoordinatesPtr);
+    }
+    else
+    {
+        printf("FELHER BEI BERECHNUNG DER INVERSE!");
+    }
+}
+
+#endif
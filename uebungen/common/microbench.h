@@ -0,0 +1,299 @@
+#ifndef __MICROBENCH_H__
+#define __MICROBENCH_H__
+/**
+ * @file
+ * Microbenchmark-Modul.
+ * Gemeinsames Geruest der Microbenchmarks aller Uebungen. Ein Kernel wird
+ * zunaechst zum Aufwaermen (Caches, Sprungvorhersage, Taktanhebung) einige
+ * Male ausgefuehrt und danach in einer festen Anzahl an Wiederholungen
+ * gemessen. Jede Wiederholung ruft die gemessene Funktion calls-mal auf,
+ * damit auch Funktionen im Bereich weniger Nanosekunden ueber der Aufloesung
+ * der Uhr liegen. Ausgegeben werden Median, p99 und Minimum der Laufzeit je
+ * Aufruf sowie der Median der Takte je Aufruf.
+ *
+ * Die Takte stammen aus dem Zeitstempelzaehler des Prozessors (rdtsc) und
+ * zaehlen mit fester Referenzfrequenz, unabhaengig von der aktuellen
+ * Taktfrequenz des Kerns. Auf anderen Architekturen fehlen sie (-1 bzw.
+ * null im JSON).
+ *
+ * Optional werden waehrend der gemessenen Wiederholungen Hardwarezaehler
+ * (perfcounters.h) mitgelesen und als Mittelwert je Aufruf ausgegeben. Die
+ * Zaehler werden ausserhalb der Zeitmessung gelesen und verfaelschen die
+ * Laufzeiten daher nicht.
+ *
+ * Die Ergebnisse lassen sich als JSON schreiben, um sie ueber mehrere
+ * Commits hinweg zu vergleichen:
+ *
+ *   {"suite": "ueb03", "warmup": 20, "repetitions": 201, "results": [
+ *     {"name": "interpolate", "calls": 1024, "median_ns": 61.2, "p99_ns": 64.0,
+ *      "min_ns": 60.8, "median_cycles": 183.5,
+ *      "counters": {"cycles": 240.1, "instructions": 610.0, ...}}, ...]}
+ *
+ * "counters" fehlt ohne Hardwarezaehler, einzelne nicht verfuegbare Zaehler
+ * sind null.
+ *
+ * Wie cgmath.h besteht das Modul nur aus diesem Header.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define MICROBENCH_CYCLES
+#endif
+
+/* ---- Eigene Header einbinden ---- */
+#include "perfcounters.h"
+
+/* ---- Konstanten ---- */
+
+/* Standardwerte fuer Aufwaermen und Wiederholungen */
+#define MICROBENCH_DEFAULT_WARMUP 20
+#define MICROBENCH_DEFAULT_REPETITIONS 201
+
+/* ---- Typedeklarationen ---- */
+
+/**
+ * Gemessener Kernel: ruft die untersuchte Funktion calls-mal auf. Ergebnisse
+ * sollten in den Kontext geschrieben oder mit consumeMicroBenchResult
+ * verbraucht werden, damit der Compiler die Aufrufe nicht entfernt.
+ */
+typedef void (*MicroBenchKernel)(void *context, int calls);
+
+/** Messergebnis eines Kernels, alle Zeiten je Aufruf */
+typedef struct
+{
+    const char *name;
+    /* Aufrufe je Wiederholung und Anzahl der Wiederholungen */
+    int calls;
+    int repetitions;
+    double medianNanos;
+    double p99Nanos;
+    double minNanos;
+    /* Median der Referenztakte je Aufruf, -1 wenn nicht verfuegbar */
+    double medianCycles;
+    /* Hardwarezaehler je Aufruf, -1 wenn nicht gemessen */
+    PerfCounterValues counters;
+} MicroBenchResult;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Verbraucht ein Ergebnis im Speicher, ohne Code zu erzeugen. Der Compiler
+ * muss es dazu vollstaendig berechnen und ablegen. Sonst rechnet er von
+ * inline eingebundenen Funktionen (z.B. aus cgmath.h) nur die Elemente aus,
+ * die spaeter gelesen werden.
+ * @param result das Ergebnis (z.B. Matrix oder Vektor)
+ */
+static inline void consumeMicroBenchResult(const void *result)
+{
+    __asm__ volatile("" : : "r"(result) : "memory");
+}
+
+/**
+ * Liefert den aktuellen Zeitstempel einer monotonen Uhr.
+ * @return der Zeitstempel in Nanosekunden
+ */
+static inline double getMicroBenchNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/**
+ * Liefert den Zeitstempelzaehler des Prozessors.
+ * @return die Referenztakte seit dem Start oder 0, wenn nicht verfuegbar
+ */
+static inline unsigned long long getMicroBenchCycles(void)
+{
+#ifdef MICROBENCH_CYCLES
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Vergleichsfunktion fuer qsort.
+ */
+static inline int compareMicroBenchSamples(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+/**
+ * Misst einen Kernel.
+ * @param name Name der gemessenen Funktion (wird nicht kopiert)
+ * @param kernel der Kernel
+ * @param context Daten des Kernels
+ * @param calls Aufrufe je Wiederholung
+ * @param warmup Anzahl der nicht gemessenen Wiederholungen vorab
+ * @param repetitions Anzahl der gemessenen Wiederholungen
+ * @param counters Hardwarezaehler, NULL fuer keine
+ * @return das Messergebnis
+ */
+static inline MicroBenchResult runMicroBench(const char *name, MicroBenchKernel kernel, void *context,
+                                             int calls, int warmup, int repetitions, const PerfCounters *counters)
+{
+    MicroBenchResult result = {name, calls, repetitions, 0.0, 0.0, 0.0, -1.0, {{0.0}}};
+    PerfCounterValues before, after;
+    resetPerfCounterValues(&result.counters);
+    double *nanos = malloc(sizeof(double) * repetitions);
+    double *cycles = malloc(sizeof(double) * repetitions);
+    if (nanos == NULL || cycles == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < warmup; i++)
+    {
+        kernel(context, calls);
+    }
+    for (int i = 0; i < repetitions; i++)
+    {
+        readPerfCounters(counters, &before);
+        double start = getMicroBenchNanos();
+        unsigned long long startCycles = getMicroBenchCycles();
+        kernel(context, calls);
+        unsigned long long endCycles = getMicroBenchCycles();
+        nanos[i] = (getMicroBenchNanos() - start) / calls;
+        readPerfCounters(counters, &after);
+        cycles[i] = (double)(endCycles - startCycles) / calls;
+        addPerfCounterDelta(&result.counters, &before, &after);
+    }
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (result.counters.values[i] >= 0.0)
+        {
+            result.counters.values[i] /= (double)calls * repetitions;
+        }
+    }
+
+    qsort(nanos, repetitions, sizeof(double), compareMicroBenchSamples);
+    qsort(cycles, repetitions, sizeof(double), compareMicroBenchSamples);
+    result.medianNanos = nanos[repetitions / 2];
+    result.p99Nanos = nanos[(int)(0.99 * (repetitions - 1) + 0.5)];
+    result.minNanos = nanos[0];
+#ifdef MICROBENCH_CYCLES
+    result.medianCycles = cycles[repetitions / 2];
+#endif
+
+    free(nanos);
+    free(cycles);
+    return result;
+}
+
+/**
+ * Gibt die Kopfzeile der Ergebnistabelle aus.
+ */
+static inline void printMicroBenchHeader(void)
+{
+    printf("%-32s %10s %12s %12s %12s %12s\n", "Funktion", "Aufrufe", "Median ns", "p99 ns", "min ns", "Takte");
+}
+
+/**
+ * Gibt ein Messergebnis als Tabellenzeile aus.
+ * @param result das Messergebnis
+ */
+static inline void printMicroBenchResult(const MicroBenchResult *result)
+{
+    printf("%-32s %10d %12.2f %12.2f %12.2f %12.1f\n", result->name, result->calls,
+           result->medianNanos, result->p99Nanos, result->minNanos, result->medianCycles);
+}
+
+/**
+ * Gibt die Hardwarezaehler je Aufruf aller Messergebnisse als Tabelle aus.
+ * Ohne gemessene Zaehler entfaellt die Tabelle.
+ * @param results die Messergebnisse
+ * @param count Anzahl der Messergebnisse
+ */
+static inline void printMicroBenchCounters(const MicroBenchResult *results, int count)
+{
+    int measured = 0;
+    for (int i = 0; i < count; i++)
+    {
+        measured |= hasPerfCounterValues(&results[i].counters);
+    }
+    if (measured)
+    {
+        printf("\n");
+        printPerfCounterHeader("Zaehler je Aufruf");
+        for (int i = 0; i < count; i++)
+        {
+            printPerfCounterValues(results[i].name, &results[i].counters, 1.0);
+        }
+    }
+}
+
+/**
+ * Schreibt die Messergebnisse als JSON.
+ * @param path Pfad der Datei, "-" fuer die Standardausgabe
+ * @param suite Name der Messreihe (z.B. der Uebung)
+ * @param warmup Anzahl der Wiederholungen zum Aufwaermen
+ * @param results die Messergebnisse
+ * @param count Anzahl der Messergebnisse
+ * @return ob die Datei geschrieben werden konnte
+ */
+static inline int writeMicroBenchJson(const char *path, const char *suite, int warmup,
+                                      const MicroBenchResult *results, int count)
+{
+    FILE *file = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (file == NULL)
+    {
+        perror(path);
+        return 0;
+    }
+    fprintf(file, "{\"suite\": \"%s\", \"warmup\": %d, \"repetitions\": %d, \"results\": [\n",
+            suite, warmup, count > 0 ? results[0].repetitions : 0);
+    for (int i = 0; i < count; i++)
+    {
+        const MicroBenchResult *result = &results[i];
+        fprintf(file, "  {\"name\": \"%s\", \"calls\": %d, \"median_ns\": %.3f, \"p99_ns\": %.3f, \"min_ns\": %.3f, ",
+                result->name, result->calls, result->medianNanos, result->p99Nanos, result->minNanos);
+        if (result->medianCycles >= 0.0)
+        {
+            fprintf(file, "\"median_cycles\": %.2f", result->medianCycles);
+        }
+        else
+        {
+            fprintf(file, "\"median_cycles\": null");
+        }
+        if (hasPerfCounterValues(&result->counters))
+        {
+            fprintf(file, ", \"counters\": {");
+            for (int c = 0; c < PERF_COUNTER_COUNT; c++)
+            {
+                fprintf(file, "%s\"%s\": ", c > 0 ? ", " : "", getPerfCounterKey(c));
+                if (result->counters.values[c] >= 0.0)
+                {
+                    fprintf(file, "%.3f", result->counters.values[c]);
+                }
+                else
+                {
+                    fprintf(file, "null");
+                }
+            }
+            fprintf(file, "}");
+        }
+        fprintf(file, "}");
+        fprintf(file, "%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(file, "]}\n");
+    if (file != stdout)
+    {
+        fclose(file);
+    }
+    return 1;
+}
+
+#endif
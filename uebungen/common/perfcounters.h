@@ -0,0 +1,282 @@
+#ifndef __PERFCOUNTERS_H__
+#define __PERFCOUNTERS_H__
+/**
+ * @file
+ * Hardwarezaehler-Modul.
+ * Liest Leistungszaehler des Prozessors ueber perf_event_open (Linux):
+ * Takte, Instruktionen, Fehlzugriffe im L1-Datencache und im letzten Cache
+ * (LLC) sowie falsch vorhergesagte Spruenge. Damit lassen sich Aenderungen am
+ * Speicherlayout nach ihrem Cacheverhalten beurteilen und nicht nur nach der
+ * Laufzeit. Gezaehlt wird nur im Benutzermodus des eigenen Prozesses.
+ *
+ * Die Zaehler laufen ab dem Oeffnen durch, gemessen wird ueber die Differenz
+ * zweier readPerfCounters. Mit inheritThreads zaehlen auch alle danach
+ * gestarteten Threads mit (z.B. die Arbeitsthreads des Job-Moduls), die
+ * Zaehler muessen dann vor dem Start der Threads geoeffnet werden.
+ *
+ * In Containern, virtuellen Maschinen oder bei restriktivem
+ * /proc/sys/kernel/perf_event_paranoid fehlen einzelne oder alle Zaehler.
+ * Sie werden dann als -1 geliefert und als "-" ausgegeben, die Messung laeuft
+ * ohne sie weiter. Muessen sich mehr Zaehler die Hardware teilen als
+ * vorhanden, werden die Werte anhand ihrer tatsaechlichen Laufzeit
+ * hochgerechnet.
+ *
+ * Wie cgmath.h besteht das Modul nur aus diesem Header.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#define PERF_COUNTERS_SUPPORTED
+#endif
+
+/* ---- Typedeklarationen ---- */
+
+/** Die gemessenen Zaehler */
+typedef enum
+{
+    perfCounterCycles,
+    perfCounterInstructions,
+    perfCounterL1Misses,
+    perfCounterLLCMisses,
+    perfCounterBranchMisses,
+    PERF_COUNTER_COUNT
+} PerfCounter;
+
+/** Geoeffnete Zaehler, -1 fuer nicht verfuegbare */
+typedef struct
+{
+    int fds[PERF_COUNTER_COUNT];
+} PerfCounters;
+
+/** Zaehlerstaende oder -differenzen, -1 fuer nicht verfuegbare */
+typedef struct
+{
+    double values[PERF_COUNTER_COUNT];
+} PerfCounterValues;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Liefert den Namen eines Zaehlers fuer Tabellen.
+ * @param counter der Zaehler
+ * @return der Name
+ */
+static inline const char *getPerfCounterName(PerfCounter counter)
+{
+    static const char *names[PERF_COUNTER_COUNT] = {"Takte", "Instruktionen", "L1D-Fehl.", "LLC-Fehl.", "Sprung-Fehl."};
+    return names[counter];
+}
+
+/**
+ * Liefert den Schluessel eines Zaehlers fuer JSON.
+ * @param counter der Zaehler
+ * @return der Schluessel
+ */
+static inline const char *getPerfCounterKey(PerfCounter counter)
+{
+    static const char *keys[PERF_COUNTER_COUNT] = {"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+    return keys[counter];
+}
+
+/**
+ * Oeffnet die Zaehler fuer den aufrufenden Thread. Nicht verfuegbare Zaehler
+ * werden mit dem Grund auf stderr gemeldet und danach uebergangen.
+ * @param counters die Zaehler (out-param)
+ * @param inheritThreads ob auch danach gestartete Threads gezaehlt werden
+ * @return Anzahl der verfuegbaren Zaehler
+ */
+static inline int openPerfCounters(PerfCounters *counters, int inheritThreads)
+{
+    int opened = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        counters->fds[i] = -1;
+    }
+#ifdef PERF_COUNTERS_SUPPORTED
+    static const unsigned types[PERF_COUNTER_COUNT] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+                                                       PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+    static const unsigned long long configs[PERF_COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_BRANCH_MISSES};
+    int error = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = types[i];
+        attr.config = configs[i];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = inheritThreads ? 1 : 0;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        counters->fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (counters->fds[i] >= 0)
+        {
+            opened++;
+        }
+        else
+        {
+            error = errno;
+        }
+    }
+    if (opened < PERF_COUNTER_COUNT)
+    {
+        fprintf(stderr, "Hardwarezaehler: %d von %d verfuegbar (%s)\n", opened, PERF_COUNTER_COUNT, strerror(error));
+    }
+#else
+    (void)inheritThreads;
+    fprintf(stderr, "Hardwarezaehler: nur unter Linux verfuegbar\n");
+#endif
+    return opened;
+}
+
+/**
+ * Liest die aktuellen Zaehlerstaende.
+ * @param counters die Zaehler, NULL fuer keine
+ * @param values die Zaehlerstaende, -1 fuer nicht verfuegbare (out-param)
+ */
+static inline void readPerfCounters(const PerfCounters *counters, PerfCounterValues *values)
+{
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        values->values[i] = -1.0;
+#ifdef PERF_COUNTERS_SUPPORTED
+        /* Wert, aktivierte und tatsaechlich gezaehlte Zeit */
+        unsigned long long data[3];
+        if (counters != NULL && counters->fds[i] >= 0 && read(counters->fds[i], data, sizeof(data)) == sizeof(data))
+        {
+            values->values[i] = data[2] > 0 ? (double)data[0] * ((double)data[1] / (double)data[2]) : 0.0;
+        }
+#endif
+    }
+}
+
+/**
+ * Setzt aufsummierte Zaehlerdifferenzen auf 0.
+ * @param values die Summen (out-param)
+ */
+static inline void resetPerfCounterValues(PerfCounterValues *values)
+{
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        values->values[i] = 0.0;
+    }
+}
+
+/**
+ * Addiert die Differenz zweier Zaehlerstaende. Ein fehlender Stand macht die
+ * Summe dauerhaft ungueltig (-1).
+ * @param sum die Summe (in/out-param)
+ * @param start Stand am Anfang
+ * @param end Stand am Ende
+ */
+static inline void addPerfCounterDelta(PerfCounterValues *sum, const PerfCounterValues *start, const PerfCounterValues *end)
+{
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (sum->values[i] < 0.0 || start->values[i] < 0.0 || end->values[i] < 0.0)
+        {
+            sum->values[i] = -1.0;
+        }
+        else
+        {
+            sum->values[i] += end->values[i] - start->values[i];
+        }
+    }
+}
+
+/**
+ * Prueft, ob ueberhaupt ein Zaehler gemessen wurde.
+ * @param values die Zaehlerwerte
+ * @return ob mindestens ein Wert gueltig ist
+ */
+static inline int hasPerfCounterValues(const PerfCounterValues *values)
+{
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (values->values[i] >= 0.0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Gibt die Kopfzeile einer Zaehlertabelle aus.
+ * @param title Ueberschrift der ersten Spalte (z.B. die Bezugsgroesse)
+ */
+static inline void printPerfCounterHeader(const char *title)
+{
+    printf("%-32s", title);
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        printf(" %14s", getPerfCounterName(i));
+    }
+    printf(" %6s\n", "IPC");
+}
+
+/**
+ * Gibt Zaehlerwerte als Tabellenzeile aus.
+ * @param name Name der Zeile (z.B. die Stufe)
+ * @param values die Zaehlerwerte
+ * @param divisor Bezugsgroesse, durch die geteilt wird (z.B. Anzahl der Schritte)
+ */
+static inline void printPerfCounterValues(const char *name, const PerfCounterValues *values, double divisor)
+{
+    printf("%-32s", name);
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (values->values[i] < 0.0)
+        {
+            printf(" %14s", "-");
+        }
+        else
+        {
+            printf(" %14.1f", values->values[i] / divisor);
+        }
+    }
+    double cycles = values->values[perfCounterCycles];
+    double instructions = values->values[perfCounterInstructions];
+    if (cycles > 0.0 && instructions >= 0.0)
+    {
+        printf(" %6.2f\n", instructions / cycles);
+    }
+    else
+    {
+        printf(" %6s\n", "-");
+    }
+}
+
+/**
+ * Schliesst die Zaehler.
+ * @param counters die Zaehler
+ */
+static inline void closePerfCounters(PerfCounters *counters)
+{
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+#ifdef PERF_COUNTERS_SUPPORTED
+        if (counters->fds[i] >= 0)
+        {
+            close(counters->fds[i]);
+        }
+#endif
+        counters->fds[i] = -1;
+    }
+}
+
+#endif
@@ -0,0 +1,439 @@
+/**
+ * @file
+ * Profiling-Modul.
+ * Ringpuffer je Thread, Auswertung je Frame, Overlay und Chrome-Trace-Export.
+ * Die Puffer werden nur von ihrem Thread beschrieben: Er schreibt den
+ * Abschnitt in das naechste Feld und erhoeht danach den Schreibzaehler
+ * (release). Der Hauptthread liest bis zum Schreibzaehler (acquire) und
+ * verwirft danach die Abschnitte, die der Thread waehrend des Lesens bereits
+ * wieder ueberschrieben haben koennte. Es gibt daher weder Sperren noch
+ * Wartezeiten in den gemessenen Threads, nur bei voellig ueberlaufenen
+ * Puffern gehen die aeltesten Abschnitte verloren.
+ *
+ * Im Overlay werden die Zeiten gleichnamiger Abschnitte eines Frames
+ * addiert, auch ueber mehrere Threads hinweg (dann ist es CPU-Zeit, nicht
+ * Wandzeit).
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "profiler.h"
+
+/* ---- Konstanten ---- */
+
+#define PROFILER_RING_MASK (PROFILER_RING_SIZE - 1)
+
+/* Zeilen des Frame-Zeit-Graphen, der Graph reicht bis zum doppelten Budget */
+#define PROFILER_GRAPH_ROWS 8
+/* Erste Zeile ueber dem Budget, hier wird die Budgetlinie gepunktet */
+#define PROFILER_GRAPH_BUDGET_ROW (PROFILER_GRAPH_ROWS / 2)
+
+/* Position und Zeilenabstaende des Overlays (0 bis 1) */
+#define PROFILER_OVERLAY_X 0.02f
+#define PROFILER_OVERLAY_Y 0.04f
+#define PROFILER_OVERLAY_LINE 0.03f
+#define PROFILER_GRAPH_LINE 0.018f
+
+/* ---- Typedeklarationen ---- */
+
+/** Ein beendeter Abschnitt */
+typedef struct
+{
+    const char *name;
+    double start;
+    double end;
+} ProfileEvent;
+
+/** Ringpuffer eines Threads */
+typedef struct
+{
+    ProfileEvent events[PROFILER_RING_SIZE];
+    /* Anzahl der bisher geschriebenen Abschnitte, nur vom Thread selbst erhoeht */
+    atomic_ulong head;
+    /* Anzahl der von markProfileFrame ausgewerteten Abschnitte (nur Hauptthread) */
+    unsigned long consumed;
+    int id;
+    char name[PROFILER_NAME_LENGTH];
+} ProfileThread;
+
+/** Zeiten eines Abschnitts in den letzten Frames */
+typedef struct
+{
+    const char *name;
+    double nanos[PROFILER_FRAME_HISTORY];
+} ProfileStage;
+
+/* ---- Globale Daten ---- */
+
+/* Ringpuffer aller Threads, Index ist die Id des Threads */
+static ProfileThread *_Atomic g_profileThreads[PROFILER_MAX_THREADS];
+static atomic_int g_profileThreadCount = 0;
+
+/* Ringpuffer des aktuellen Threads */
+static _Thread_local ProfileThread *t_profileThread = NULL;
+/* Ob der aktuelle Thread keinen Ringpuffer mehr bekommen hat */
+static _Thread_local int t_profileThreadRejected = 0;
+
+/* Zwischenspeicher zum Auslesen eines Ringpuffers (nur Hauptthread) */
+static ProfileEvent g_profileScratch[PROFILER_RING_SIZE];
+
+/* Zeiten je Abschnitt und Frame-Zeiten, Index ist der Frame im Ring */
+static ProfileStage g_profileStages[PROFILER_MAX_STAGES];
+static int g_profileStageCount = 0;
+static double g_profileFrames[PROFILER_FRAME_HISTORY];
+/* Index des neuesten Frames und Anzahl der gueltigen Frames */
+static int g_profileFrameIndex = 0;
+static int g_profileFrameCount = 0;
+/* Zeitpunkt des letzten Aufrufs von markProfileFrame, 0 vor dem ersten */
+static double g_profileLastFrame = 0.0;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Liefert den aktuellen Zeitstempel einer monotonen Uhr.
+ * @return der Zeitstempel in Nanosekunden
+ */
+double getProfileNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/**
+ * Liefert den Ringpuffer des aktuellen Threads und legt ihn beim ersten
+ * Aufruf an.
+ * @return der Ringpuffer oder NULL, wenn bereits PROFILER_MAX_THREADS
+ *   Threads aufzeichnen
+ */
+static ProfileThread *getProfileThread(void)
+{
+    if (t_profileThread == NULL && !t_profileThreadRejected)
+    {
+        int id = atomic_fetch_add(&g_profileThreadCount, 1);
+        if (id >= PROFILER_MAX_THREADS)
+        {
+            t_profileThreadRejected = 1;
+            return NULL;
+        }
+        ProfileThread *thread = calloc(1, sizeof(ProfileThread));
+        if (thread == NULL)
+        {
+            printf("Kein virtueller RAM mehr verfügbar ...\n");
+            exit(1);
+        }
+        thread->id = id;
+        snprintf(thread->name, PROFILER_NAME_LENGTH, "Thread %d", id);
+        atomic_store_explicit(&g_profileThreads[id], thread, memory_order_release);
+        t_profileThread = thread;
+    }
+    return t_profileThread;
+}
+
+/**
+ * Benennt den aktuellen Thread im Chrome-Trace (z.B. "Hauptthread", "Arbeitsthread 1").
+ * @param name der Name, wird kopiert
+ */
+void setProfileThreadName(const char *name)
+{
+    ProfileThread *thread = getProfileThread();
+    if (thread != NULL)
+    {
+        snprintf(thread->name, PROFILER_NAME_LENGTH, "%s", name);
+    }
+}
+
+/**
+ * Beginnt einen Abschnitt.
+ * @return der Startzeitpunkt, der an endProfileScope uebergeben wird
+ */
+double beginProfileScope(void)
+{
+    return getProfileNanos();
+}
+
+/**
+ * Beendet einen Abschnitt und schreibt ihn in den Ringpuffer des Threads.
+ * @param name Name des Abschnitts (Zeichenkettenliteral, wird nicht kopiert)
+ * @param start Rueckgabewert von beginProfileScope
+ */
+void endProfileScope(const char *name, double start)
+{
+    ProfileThread *thread = getProfileThread();
+    if (thread != NULL)
+    {
+        unsigned long head = atomic_load_explicit(&thread->head, memory_order_relaxed);
+        ProfileEvent *event = &thread->events[head & PROFILER_RING_MASK];
+        event->name = name;
+        event->start = start;
+        event->end = getProfileNanos();
+        atomic_store_explicit(&thread->head, head + 1, memory_order_release);
+    }
+}
+
+/**
+ * Kopiert die Abschnitte ab from aus dem Ringpuffer eines Threads, soweit sie
+ * noch nicht ueberschrieben wurden.
+ * @param thread der Ringpuffer
+ * @param from Nummer des ersten gewuenschten Abschnitts
+ * @param events Ziel mit Platz fuer PROFILER_RING_SIZE Abschnitte (out-param)
+ * @param next Nummer des ersten nicht kopierten Abschnitts (out-param)
+ * @return Anzahl der kopierten Abschnitte
+ */
+static int copyProfileEvents(ProfileThread *thread, unsigned long from, ProfileEvent *events, unsigned long *next)
+{
+    unsigned long head = atomic_load_explicit(&thread->head, memory_order_acquire);
+    if (head - from > PROFILER_RING_SIZE)
+    {
+        from = head - PROFILER_RING_SIZE;
+    }
+    for (unsigned long i = from; i < head; i++)
+    {
+        events[i - from] = thread->events[i & PROFILER_RING_MASK];
+    }
+
+    //Felder, die der Thread seit dem Lesen des Zaehlers erneut beschreibt, verwerfen
+    atomic_thread_fence(memory_order_acquire);
+    unsigned long written = atomic_load_explicit(&thread->head, memory_order_relaxed);
+    unsigned long valid = from;
+    if (written >= PROFILER_RING_SIZE && written - PROFILER_RING_SIZE + 1 > valid)
+    {
+        valid = written - PROFILER_RING_SIZE + 1;
+    }
+    *next = head;
+    if (valid >= head)
+    {
+        return 0;
+    }
+    memmove(events, events + (valid - from), (head - valid) * sizeof(ProfileEvent));
+    return (int)(head - valid);
+}
+
+/**
+ * Liefert die Zeiten eines Abschnitts und legt sie beim ersten Auftreten an.
+ * @param name Name des Abschnitts
+ * @return die Zeiten oder NULL, wenn bereits PROFILER_MAX_STAGES Abschnitte
+ *   bekannt sind
+ */
+static ProfileStage *getProfileStage(const char *name)
+{
+    for (int i = 0; i < g_profileStageCount; i++)
+    {
+        if (g_profileStages[i].name == name || strcmp(g_profileStages[i].name, name) == 0)
+        {
+            return &g_profileStages[i];
+        }
+    }
+    if (g_profileStageCount == PROFILER_MAX_STAGES)
+    {
+        return NULL;
+    }
+    ProfileStage *stage = &g_profileStages[g_profileStageCount++];
+    stage->name = name;
+    memset(stage->nanos, 0, sizeof(stage->nanos));
+    return stage;
+}
+
+/**
+ * Schliesst einen Frame ab. Muss vom Hauptthread einmal je Frame aufgerufen
+ * werden, z.B. nach dem Tauschen der Buffer. Die Frame-Zeit ist der Abstand
+ * zum vorherigen Aufruf, die Abschnitte aller Threads seit dem vorherigen
+ * Aufruf werden diesem Frame zugerechnet.
+ */
+void markProfileFrame(void)
+{
+    double now = getProfileNanos();
+    //Vor dem ersten Frame werden die Abschnitte nur verworfen
+    int record = g_profileLastFrame > 0.0;
+    if (record)
+    {
+        g_profileFrameIndex = (g_profileFrameIndex + 1) % PROFILER_FRAME_HISTORY;
+        g_profileFrames[g_profileFrameIndex] = now - g_profileLastFrame;
+        if (g_profileFrameCount < PROFILER_FRAME_HISTORY)
+        {
+            g_profileFrameCount++;
+        }
+        for (int i = 0; i < g_profileStageCount; i++)
+        {
+            g_profileStages[i].nanos[g_profileFrameIndex] = 0.0;
+        }
+    }
+
+    int threadCount = atomic_load(&g_profileThreadCount);
+    for (int t = 0; t < threadCount && t < PROFILER_MAX_THREADS; t++)
+    {
+        ProfileThread *thread = atomic_load_explicit(&g_profileThreads[t], memory_order_acquire);
+        if (thread != NULL)
+        {
+            int count = copyProfileEvents(thread, thread->consumed, g_profileScratch, &thread->consumed);
+            for (int i = 0; i < count && record; i++)
+            {
+                ProfileStage *stage = getProfileStage(g_profileScratch[i].name);
+                if (stage != NULL)
+                {
+                    stage->nanos[g_profileFrameIndex] += g_profileScratch[i].end - g_profileScratch[i].start;
+                }
+            }
+        }
+    }
+    g_profileLastFrame = now;
+}
+
+/**
+ * Berechnet Mittelwert und Maximum ueber die letzten Frames.
+ * @param nanos Werte je Frame im Ring
+ * @param average der Mittelwert (out-param)
+ * @param max das Maximum (out-param)
+ */
+static void calcProfileStatistics(const double *nanos, double *average, double *max)
+{
+    double sum = 0.0;
+    *max = 0.0;
+    for (int i = 0; i < g_profileFrameCount; i++)
+    {
+        double value = nanos[(g_profileFrameIndex - i + PROFILER_FRAME_HISTORY) % PROFILER_FRAME_HISTORY];
+        sum += value;
+        if (value > *max)
+        {
+            *max = value;
+        }
+    }
+    *average = sum / g_profileFrameCount;
+}
+
+/**
+ * Zeichnet das Overlay: Frame-Zeit der letzten Frames als Graph (bis zum
+ * doppelten Budget, gepunktete Linie beim Budget, Frames ueber dem Budget
+ * rot) und die Zeiten je Abschnitt. Die Balken sind 'I' und Leerzeichen, die
+ * in der Schrift von glutBitmapCharacter gleich breit sind, sodass die
+ * Spalten auch ueber mehrere Zeichenketten uebereinander liegen.
+ * @param drawText Funktion zum Zeichnen von Text, z.B. drawString
+ */
+void drawProfileOverlay(ProfileTextFunction drawText)
+{
+    float textColor[3] = {1.0f, 1.0f, 1.0f};
+    float okColor[3] = {0.2f, 0.9f, 0.2f};
+    float overColor[3] = {1.0f, 0.25f, 0.25f};
+
+    if (g_profileFrameCount == 0)
+    {
+        return;
+    }
+
+    double average;
+    double max;
+    calcProfileStatistics(g_profileFrames, &average, &max);
+    float y = PROFILER_OVERLAY_Y;
+    drawText(PROFILER_OVERLAY_X, y, g_profileFrames[g_profileFrameIndex] > PROFILER_FRAME_BUDGET_NANOS ? overColor : textColor,
+             "Frame: %.2f ms (Mittel %.2f, Max %.2f, Budget %.2f)", g_profileFrames[g_profileFrameIndex] / 1e6,
+             average / 1e6, max / 1e6, PROFILER_FRAME_BUDGET_NANOS / 1e6);
+
+    //Graph zeilenweise von oben, aeltester Frame links
+    char ok[PROFILER_FRAME_HISTORY + 1];
+    char over[PROFILER_FRAME_HISTORY + 1];
+    double rowNanos = 2.0 * PROFILER_FRAME_BUDGET_NANOS / PROFILER_GRAPH_ROWS;
+    for (int row = PROFILER_GRAPH_ROWS - 1; row >= 0; row--)
+    {
+        for (int i = 0; i < g_profileFrameCount; i++)
+        {
+            double frame = g_profileFrames[(g_profileFrameIndex - g_profileFrameCount + 1 + i + PROFILER_FRAME_HISTORY) % PROFILER_FRAME_HISTORY];
+            int filled = frame > row * rowNanos;
+            int isOver = frame > PROFILER_FRAME_BUDGET_NANOS;
+            ok[i] = filled && !isOver ? 'I' : (!filled && row == PROFILER_GRAPH_BUDGET_ROW ? '.' : ' ');
+            over[i] = filled && isOver ? 'I' : ' ';
+        }
+        ok[g_profileFrameCount] = '\0';
+        over[g_profileFrameCount] = '\0';
+        y += PROFILER_GRAPH_LINE;
+        drawText(PROFILER_OVERLAY_X, y, okColor, "%s", ok);
+        drawText(PROFILER_OVERLAY_X, y, overColor, "%s", over);
+    }
+
+    //Abschnitte, rot wenn sie in einem der Frames das Budget allein sprengen
+    y += PROFILER_OVERLAY_LINE;
+    for (int i = 0; i < g_profileStageCount; i++)
+    {
+        ProfileStage *stage = &g_profileStages[i];
+        calcProfileStatistics(stage->nanos, &average, &max);
+        y += PROFILER_OVERLAY_LINE;
+        drawText(PROFILER_OVERLAY_X, y, max > PROFILER_FRAME_BUDGET_NANOS ? overColor : textColor,
+                 "%s: %.2f ms (Mittel %.2f, Max %.2f)", stage->name, stage->nanos[g_profileFrameIndex] / 1e6,
+                 average / 1e6, max / 1e6);
+    }
+}
+
+/**
+ * Schreibt alle noch in den Ringpuffern liegenden Abschnitte im
+ * Chrome-Trace-Format (JSON, Zeiten in Mikrosekunden).
+ * @param path Pfad der Datei
+ * @return ob die Datei geschrieben werden konnte
+ */
+int writeProfileTrace(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        perror(path);
+        return 0;
+    }
+    ProfileEvent *events = malloc(sizeof(ProfileEvent) * PROFILER_RING_SIZE);
+    if (events == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    int first = 1;
+    int threadCount = atomic_load(&g_profileThreadCount);
+    for (int t = 0; t < threadCount && t < PROFILER_MAX_THREADS; t++)
+    {
+        ProfileThread *thread = atomic_load_explicit(&g_profileThreads[t], memory_order_acquire);
+        if (thread != NULL)
+        {
+            unsigned long next;
+            int count = copyProfileEvents(thread, 0, events, &next);
+            fprintf(file, "%s  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                    first ? "" : ",\n", thread->id, thread->name);
+            first = 0;
+            for (int i = 0; i < count; i++)
+            {
+                fprintf(file, ",\n  {\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                        events[i].name, thread->id, events[i].start / 1e3, (events[i].end - events[i].start) / 1e3);
+            }
+        }
+    }
+    fprintf(file, "\n]}\n");
+
+    free(events);
+    fclose(file);
+    return 1;
+}
+
+/**
+ * Gibt die Ringpuffer frei und setzt alle Zeiten zurueck. Darf erst
+ * aufgerufen werden, wenn alle anderen aufzeichnenden Threads beendet sind.
+ */
+void freeProfiler(void)
+{
+    int threadCount = atomic_load(&g_profileThreadCount);
+    for (int t = 0; t < threadCount && t < PROFILER_MAX_THREADS; t++)
+    {
+        free(atomic_exchange(&g_profileThreads[t], NULL));
+    }
+    atomic_store(&g_profileThreadCount, 0);
+    t_profileThread = NULL;
+    t_profileThreadRejected = 0;
+    g_profileStageCount = 0;
+    g_profileFrameCount = 0;
+    g_profileFrameIndex = 0;
+    g_profileLastFrame = 0.0;
+}
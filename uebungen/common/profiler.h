@@ -0,0 +1,81 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+/**
+ * @file
+ * Profiling-Modul.
+ * Misst die Laufzeit einzelner Abschnitte eines Frames (Logik, Physik,
+ * Tesselierung, Raytracing, Zeichnen, ...). Ein Abschnitt wird mit
+ * beginProfileScope/endProfileScope umschlossen:
+ *
+ *   double start = beginProfileScope();
+ *   handleLogicCalculations(interval);
+ *   endProfileScope("Logik", start);
+ *
+ * Jeder Thread schreibt seine Abschnitte ohne Sperren in einen eigenen
+ * Ringpuffer, der beim ersten Abschnitt des Threads angelegt wird. Nur der
+ * Hauptthread liest die Puffer: markProfileFrame fasst am Ende jedes Frames
+ * die seitdem beendeten Abschnitte je Name zusammen, drawProfileOverlay
+ * zeichnet daraus einen Frame-Zeit-Graphen mit dem Budget von 60 FPS und die
+ * Zeiten je Abschnitt, writeProfileTrace schreibt die Abschnitte im
+ * Chrome-Trace-Format (chrome://tracing, Perfetto).
+ *
+ * Die Zeitstempel stammen aus der monotonen Uhr (clock_gettime), die Namen
+ * der Abschnitte muessen Zeichenkettenliterale sein, da nur der Zeiger
+ * gespeichert wird.
+ *
+ * Anders als cgmath.h haelt das Modul globalen Zustand und besteht deshalb
+ * aus Header und Uebersetzungseinheit (profiler.c).
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- Konstanten ---- */
+
+/* Hoechstzahl an Threads, die Abschnitte aufzeichnen */
+#define PROFILER_MAX_THREADS 64
+
+/* Anzahl der Abschnitte je Thread im Ringpuffer (Zweierpotenz) */
+#define PROFILER_RING_SIZE 16384
+
+/* Anzahl der Frames im Graphen und in den Mittelwerten */
+#define PROFILER_FRAME_HISTORY 60
+
+/* Hoechstzahl an unterschiedlich benannten Abschnitten im Overlay */
+#define PROFILER_MAX_STAGES 16
+
+/* Zeitbudget eines Frames bei 60 FPS */
+#define PROFILER_FRAME_BUDGET_NANOS (1e9 / 60.0)
+
+/* Laenge der Threadnamen */
+#define PROFILER_NAME_LENGTH 32
+
+/* ---- Typedeklarationen ---- */
+
+/**
+ * Funktion zum Zeichnen von Text im Overlay, z.B. drawString.
+ * @param x x-Position des ersten Zeichens 0 bis 1
+ * @param y y-Position des ersten Zeichens 0 bis 1
+ * @param color Textfarbe
+ * @param format Formatstring fuer die weiteren Parameter
+ */
+typedef void (*ProfileTextFunction)(float x, float y, float *color, char *format, ...);
+
+/* ---- Funktionen ---- */
+
+double getProfileNanos(void);
+
+void setProfileThreadName(const char *name);
+
+double beginProfileScope(void);
+
+void endProfileScope(const char *name, double start);
+
+void markProfileFrame(void);
+
+void drawProfileOverlay(ProfileTextFunction drawText);
+
+int writeProfileTrace(const char *path);
+
+void freeProfiler(void);
+
+#endif
@@ -0,0 +1,716 @@
+#ifndef __TEXTURECOMPRESSION_H__
+#define __TEXTURECOMPRESSION_H__
+/**
+ * @file
+ * Texturkompressions-Modul.
+ * Blockkompression im Format BC1 (DXT1, RGB, 4 Bit je Pixel) und BC3 (DXT5,
+ * RGBA, 8 Bit je Pixel) sowie Lesen und Schreiben von DDS-Dateien. Beide
+ * Formate teilen das Bild in Bloecke von 4x4 Pixeln: je Block werden zwei
+ * Endfarben (RGB565) und fuer jedes Pixel ein 2-Bit-Index auf vier daraus
+ * interpolierte Farben gespeichert, BC3 zusaetzlich zwei Alpha-Endwerte mit
+ * 3-Bit-Indizes auf acht Alphawerte. Die Grafikkarte dekodiert die Bloecke
+ * beim Zugriff, die Textur belegt also auch im Grafikspeicher nur ein Sechstel
+ * (BC1 gegenueber RGB) bzw. ein Viertel (BC3 gegenueber RGBA).
+ *
+ * Der Kodierer legt die Endfarben auf die Hauptachse der Farben des Blocks
+ * (Potenzmethode auf der Kovarianzmatrix), zieht sie um 1/16 nach innen,
+ * waehlt je Pixel die naechste der vier Farben und passt die Endfarben
+ * danach einmal per kleinster Quadrate an diese Wahl an. Das ist schnell
+ * genug fuer den Konverter und deutlich besser als die Eckpunkte der
+ * Bounding Box.
+ * Der Dekodierer dient als Software-Rueckfall, wenn OpenGL die Formate nicht
+ * unterstuetzt (GL_EXT_texture_compression_s3tc fehlt).
+ *
+ * DDS-Dateien bestehen aus der Kennung "DDS ", einem Kopf von 124 Byte und
+ * allen Mipmap-Stufen hintereinander. Die Werte werden wie in der
+ * Spezifikation als Little Endian erwartet, also ohne Umwandlung nur auf
+ * x86/ARM.
+ *
+ * Wie cgmath.h besteht das Modul nur aus diesem Header.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ---- Konstanten ---- */
+
+/* Kantenlaenge eines Blocks in Pixeln */
+#define TEXTURE_BLOCK_SIZE 4
+#define TEXTURE_BLOCK_PIXELS (TEXTURE_BLOCK_SIZE * TEXTURE_BLOCK_SIZE)
+
+/* Hoechstzahl an Mipmap-Stufen (2^31 Pixel Kantenlaenge) */
+#define TEXTURE_MAX_LEVELS 32
+
+/* Kennungen und Flags aus der DDS-Spezifikation */
+#define DDS_MAGIC 0x20534444u
+#define DDS_FOURCC_DXT1 0x31545844u
+#define DDS_FOURCC_DXT5 0x35545844u
+#define DDSD_CAPS 0x1u
+#define DDSD_HEIGHT 0x2u
+#define DDSD_WIDTH 0x4u
+#define DDSD_PIXELFORMAT 0x1000u
+#define DDSD_MIPMAPCOUNT 0x20000u
+#define DDSD_LINEARSIZE 0x80000u
+#define DDPF_FOURCC 0x4u
+#define DDSCAPS_COMPLEX 0x8u
+#define DDSCAPS_TEXTURE 0x1000u
+#define DDSCAPS_MIPMAP 0x400000u
+
+/* ---- Typedeklarationen ---- */
+
+/** Blockkomprimierte Formate */
+typedef enum
+{
+    textureFormatBC1,
+    textureFormatBC3,
+    TEXTURE_FORMAT_COUNT
+} TextureFormat;
+
+/** Pixelformat im DDS-Kopf */
+typedef struct
+{
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t rBitMask;
+    uint32_t gBitMask;
+    uint32_t bBitMask;
+    uint32_t aBitMask;
+} DdsPixelFormat;
+
+/** Kennung und Kopf einer DDS-Datei, danach folgen die Stufen */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitchOrLinearSize;
+    uint32_t depth;
+    uint32_t mipMapCount;
+    uint32_t reserved1[11];
+    DdsPixelFormat pixelFormat;
+    uint32_t caps;
+    uint32_t caps2;
+    uint32_t caps3;
+    uint32_t caps4;
+    uint32_t reserved2;
+} DdsHeader;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Liefert den Namen eines Formats.
+ * @param format das Format
+ * @return der Name
+ */
+static inline const char *getTextureFormatName(TextureFormat format)
+{
+    return format == textureFormatBC3 ? "BC3" : "BC1";
+}
+
+/**
+ * Liefert die Groesse eines Blocks.
+ * @param format das Format
+ * @return Byte je Block von 4x4 Pixeln
+ */
+static inline int getTextureBlockBytes(TextureFormat format)
+{
+    return format == textureFormatBC3 ? 16 : 8;
+}
+
+/**
+ * Liefert die Anzahl der Stufen einer vollstaendigen Mipmap-Kette. Jede
+ * Stufe halbiert Breite und Hoehe (abgerundet, mindestens 1).
+ * @param width Breite der obersten Stufe
+ * @param height Hoehe der obersten Stufe
+ * @return Anzahl der Stufen bis einschliesslich 1x1
+ */
+static inline int getTextureLevelCount(int width, int height)
+{
+    int levels = 1;
+    while ((width > 1 || height > 1) && levels < TEXTURE_MAX_LEVELS)
+    {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        levels++;
+    }
+    return levels;
+}
+
+/**
+ * Liefert die Groesse einer komprimierten Stufe, angebrochene Bloecke am
+ * Rand zaehlen voll.
+ * @param format das Format
+ * @param width Breite der Stufe
+ * @param height Hoehe der Stufe
+ * @return Groesse in Byte
+ */
+static inline size_t getCompressedLevelSize(TextureFormat format, int width, int height)
+{
+    size_t blocksX = (width + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE;
+    size_t blocksY = (height + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE;
+    return blocksX * blocksY * getTextureBlockBytes(format);
+}
+
+/**
+ * Berechnet eine Mipmap-Stufe aus der darueberliegenden, je Pixel als
+ * Mittelwert von 2x2 Pixeln. Bei ungerader Kantenlaenge wird der Rand
+ * wiederholt.
+ * @param src die darueberliegende Stufe
+ * @param width Breite der darueberliegenden Stufe
+ * @param height Hoehe der darueberliegenden Stufe
+ * @param channels Anzahl der Farbkanaele
+ * @param dst die neue Stufe (out-param)
+ */
+static inline void downsampleTextureLevel(const unsigned char *src, int width, int height, int channels, unsigned char *dst)
+{
+    int dstWidth = width > 1 ? width / 2 : 1;
+    int dstHeight = height > 1 ? height / 2 : 1;
+    for (int y = 0; y < dstHeight; y++)
+    {
+        const unsigned char *row0 = src + (size_t)(2 * y < height ? 2 * y : height - 1) * width * channels;
+        const unsigned char *row1 = src + (size_t)(2 * y + 1 < height ? 2 * y + 1 : height - 1) * width * channels;
+        for (int x = 0; x < dstWidth; x++)
+        {
+            int x0 = (2 * x < width ? 2 * x : width - 1) * channels;
+            int x1 = (2 * x + 1 < width ? 2 * x + 1 : width - 1) * channels;
+            for (int c = 0; c < channels; c++)
+            {
+                dst[((size_t)y * dstWidth + x) * channels + c] =
+                    (unsigned char)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+            }
+        }
+    }
+}
+
+/**
+ * Wandelt eine Farbe nach RGB565.
+ * @param color die Farbe (RGB)
+ * @return die Farbe als RGB565
+ */
+static inline uint16_t packColor565(const float *color)
+{
+    int r = (int)(color[0] * 31.0f / 255.0f + 0.5f);
+    int g = (int)(color[1] * 63.0f / 255.0f + 0.5f);
+    int b = (int)(color[2] * 31.0f / 255.0f + 0.5f);
+    r = r < 0 ? 0 : (r > 31 ? 31 : r);
+    g = g < 0 ? 0 : (g > 63 ? 63 : g);
+    b = b < 0 ? 0 : (b > 31 ? 31 : b);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+/**
+ * Wandelt eine Farbe aus RGB565 nach RGB mit 8 Bit je Kanal.
+ * @param packed die Farbe als RGB565
+ * @param color die Farbe (out-param)
+ */
+static inline void unpackColor565(uint16_t packed, int *color)
+{
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+/**
+ * Berechnet die vier Farben eines Farbblocks.
+ * @param color0 erste Endfarbe (RGB565)
+ * @param color1 zweite Endfarbe (RGB565)
+ * @param fourColors ob immer vier Farben gelten (BC3) statt drei und
+ *   Transparenz bei color0 <= color1 (BC1)
+ * @param palette die vier Farben als RGBA (out-param)
+ */
+static inline void getColorPalette(uint16_t color0, uint16_t color1, int fourColors, int palette[4][4])
+{
+    unpackColor565(color0, palette[0]);
+    unpackColor565(color1, palette[1]);
+    palette[0][3] = 255;
+    palette[1][3] = 255;
+    for (int c = 0; c < 3; c++)
+    {
+        if (fourColors || color0 > color1)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        else
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = (fourColors || color0 > color1) ? 255 : 0;
+}
+
+/**
+ * Quantisiert zwei Endfarben, ordnet sie (color0 >= color1) und waehlt je
+ * Pixel die naechste der vier Farben.
+ * @param rgba die 16 Pixel des Blocks zeilenweise als RGBA
+ * @param end0 erste Endfarbe (RGB)
+ * @param end1 zweite Endfarbe (RGB)
+ * @param color0 erste Endfarbe als RGB565 (out-param)
+ * @param color1 zweite Endfarbe als RGB565 (out-param)
+ * @param indices die 16 Indizes zu je 2 Bit (out-param)
+ * @return Summe der quadratischen Fehler
+ */
+static inline int findColorEndpoints(const unsigned char *rgba, const float *end0, const float *end1, uint16_t *color0,
+                                     uint16_t *color1, uint32_t *indices)
+{
+    *color0 = packColor565(end0);
+    *color1 = packColor565(end1);
+    if (*color0 < *color1)
+    {
+        uint16_t swap = *color0;
+        *color0 = *color1;
+        *color1 = swap;
+    }
+    int palette[4][4];
+    getColorPalette(*color0, *color1, 1, palette);
+    int error = 0;
+    *indices = 0;
+    for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+    {
+        int best = 0;
+        int bestDistance = 0x7fffffff;
+        for (int p = 0; p < 4; p++)
+        {
+            int dr = rgba[4 * i] - palette[p][0];
+            int dg = rgba[4 * i + 1] - palette[p][1];
+            int db = rgba[4 * i + 2] - palette[p][2];
+            int distance = dr * dr + dg * dg + db * db;
+            if (distance < bestDistance)
+            {
+                best = p;
+                bestDistance = distance;
+            }
+        }
+        *indices |= (uint32_t)best << (2 * i);
+        error += bestDistance;
+    }
+    return error;
+}
+
+/**
+ * Kodiert die Farben eines Blocks (8 Byte: zwei Endfarben, 16 Indizes).
+ * Es werden immer vier Farben verwendet (color0 > color1), damit der Block
+ * sowohl in BC1 als auch in BC3 gueltig ist. Die Endfarben aus der
+ * Hauptachse werden einmal per kleinster Quadrate nachgebessert, sofern das
+ * den Fehler verringert.
+ * @param rgba die 16 Pixel des Blocks zeilenweise als RGBA
+ * @param block der kodierte Block (out-param)
+ */
+static inline void encodeColorBlock(const unsigned char *rgba, unsigned char *block)
+{
+    //Mittelwert und Kovarianz der Farben
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            mean[c] += rgba[4 * i + c] / (float)TEXTURE_BLOCK_PIXELS;
+        }
+    }
+    float covariance[6] = {0.0f};
+    for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+    {
+        float r = rgba[4 * i] - mean[0];
+        float g = rgba[4 * i + 1] - mean[1];
+        float b = rgba[4 * i + 2] - mean[2];
+        covariance[0] += r * r;
+        covariance[1] += r * g;
+        covariance[2] += r * b;
+        covariance[3] += g * g;
+        covariance[4] += g * b;
+        covariance[5] += b * b;
+    }
+
+    //Hauptachse per Potenzmethode, bei einfarbigen Bloecken die Grauachse
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float next[3] = {covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                         covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                         covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]};
+        float length = next[0] * next[0] + next[1] * next[1] + next[2] * next[2];
+        if (length < 1e-12f)
+        {
+            break;
+        }
+        float scale = 1.0f / sqrtf(length);
+        for (int c = 0; c < 3; c++)
+        {
+            axis[c] = next[c] * scale;
+        }
+    }
+
+    //Endfarben an den Enden der Projektion, um 1/16 nach innen gezogen
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+    for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+    {
+        float projection = (rgba[4 * i] - mean[0]) * axis[0] + (rgba[4 * i + 1] - mean[1]) * axis[1] +
+                           (rgba[4 * i + 2] - mean[2]) * axis[2];
+        minProjection = projection < minProjection ? projection : minProjection;
+        maxProjection = projection > maxProjection ? projection : maxProjection;
+    }
+    float inset = (maxProjection - minProjection) / 16.0f;
+    float end0[3], end1[3];
+    for (int c = 0; c < 3; c++)
+    {
+        end0[c] = mean[c] + axis[c] * (maxProjection - inset);
+        end1[c] = mean[c] + axis[c] * (minProjection + inset);
+    }
+    uint16_t color0, color1;
+    uint32_t indices;
+    int error = findColorEndpoints(rgba, end0, end1, &color0, &color1, &indices);
+
+    //Endfarben einmal per kleinster Quadrate an die gewaehlten Indizes anpassen
+    float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[3] = {0.0f, 0.0f, 0.0f};
+    float bx[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+    {
+        float a = weights[(indices >> (2 * i)) & 3];
+        float b = 1.0f - a;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int c = 0; c < 3; c++)
+        {
+            ax[c] += a * rgba[4 * i + c];
+            bx[c] += b * rgba[4 * i + c];
+        }
+    }
+    float determinant = aa * bb - ab * ab;
+    if (fabsf(determinant) > 1e-6f)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            end0[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+            end1[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+        }
+        uint16_t refined0, refined1;
+        uint32_t refinedIndices;
+        if (findColorEndpoints(rgba, end0, end1, &refined0, &refined1, &refinedIndices) < error)
+        {
+            color0 = refined0;
+            color1 = refined1;
+            indices = refinedIndices;
+        }
+    }
+
+    block[0] = color0 & 0xff;
+    block[1] = color0 >> 8;
+    block[2] = color1 & 0xff;
+    block[3] = color1 >> 8;
+    for (int i = 0; i < 4; i++)
+    {
+        block[4 + i] = (indices >> (8 * i)) & 0xff;
+    }
+}
+
+/**
+ * Kodiert die Alphawerte eines Blocks (8 Byte: zwei Endwerte, 16 Indizes
+ * zu je 3 Bit). Die Endwerte sind Minimum und Maximum (alpha0 > alpha1,
+ * acht interpolierte Werte).
+ * @param rgba die 16 Pixel des Blocks zeilenweise als RGBA
+ * @param block der kodierte Block (out-param)
+ */
+static inline void encodeAlphaBlock(const unsigned char *rgba, unsigned char *block)
+{
+    int alpha0 = 0;
+    int alpha1 = 255;
+    for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+    {
+        alpha0 = rgba[4 * i + 3] > alpha0 ? rgba[4 * i + 3] : alpha0;
+        alpha1 = rgba[4 * i + 3] < alpha1 ? rgba[4 * i + 3] : alpha1;
+    }
+    uint64_t indices = 0;
+    if (alpha0 > alpha1)
+    {
+        int palette[8] = {alpha0, alpha1};
+        for (int p = 1; p < 7; p++)
+        {
+            palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+        }
+        for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+        {
+            int best = 0;
+            int bestDistance = 256;
+            for (int p = 0; p < 8; p++)
+            {
+                int distance = abs(rgba[4 * i + 3] - palette[p]);
+                if (distance < bestDistance)
+                {
+                    best = p;
+                    bestDistance = distance;
+                }
+            }
+            indices |= (uint64_t)best << (3 * i);
+        }
+    }
+    block[0] = (unsigned char)alpha0;
+    block[1] = (unsigned char)alpha1;
+    for (int i = 0; i < 6; i++)
+    {
+        block[2 + i] = (indices >> (8 * i)) & 0xff;
+    }
+}
+
+/**
+ * Dekodiert die Farben eines Blocks.
+ * @param block der kodierte Block
+ * @param fourColors ob immer vier Farben gelten (BC3)
+ * @param rgba die 16 Pixel zeilenweise als RGBA (out-param)
+ */
+static inline void decodeColorBlock(const unsigned char *block, int fourColors, unsigned char *rgba)
+{
+    uint16_t color0 = (uint16_t)(block[0] | (block[1] << 8));
+    uint16_t color1 = (uint16_t)(block[2] | (block[3] << 8));
+    uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((uint32_t)block[7] << 24);
+    int palette[4][4];
+    getColorPalette(color0, color1, fourColors, palette);
+    for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+    {
+        int index = (indices >> (2 * i)) & 3;
+        for (int c = 0; c < 4; c++)
+        {
+            rgba[4 * i + c] = (unsigned char)palette[index][c];
+        }
+    }
+}
+
+/**
+ * Dekodiert die Alphawerte eines Blocks.
+ * @param block der kodierte Block
+ * @param rgba die 16 Pixel zeilenweise als RGBA, nur Alpha wird gesetzt (out-param)
+ */
+static inline void decodeAlphaBlock(const unsigned char *block, unsigned char *rgba)
+{
+    int alpha0 = block[0];
+    int alpha1 = block[1];
+    int palette[8] = {alpha0, alpha1};
+    if (alpha0 > alpha1)
+    {
+        for (int p = 1; p < 7; p++)
+        {
+            palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+        }
+    }
+    else
+    {
+        for (int p = 1; p < 5; p++)
+        {
+            palette[p + 1] = ((5 - p) * alpha0 + p * alpha1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; i++)
+    {
+        indices |= (uint64_t)block[2 + i] << (8 * i);
+    }
+    for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+    {
+        rgba[4 * i + 3] = (unsigned char)palette[(indices >> (3 * i)) & 7];
+    }
+}
+
+/**
+ * Komprimiert eine Stufe. Angebrochene Bloecke am Rand wiederholen die
+ * letzte Zeile bzw. Spalte.
+ * @param format das Format
+ * @param pixels die Pixel zeilenweise
+ * @param width Breite der Stufe
+ * @param height Hoehe der Stufe
+ * @param channels Anzahl der Farbkanaele (1 bis 4)
+ * @param dst die Bloecke, getCompressedLevelSize Byte (out-param)
+ */
+static inline void compressTextureLevel(TextureFormat format, const unsigned char *pixels, int width, int height,
+                                        int channels, unsigned char *dst)
+{
+    int blockBytes = getTextureBlockBytes(format);
+    for (int by = 0; by < height; by += TEXTURE_BLOCK_SIZE)
+    {
+        for (int bx = 0; bx < width; bx += TEXTURE_BLOCK_SIZE)
+        {
+            unsigned char rgba[TEXTURE_BLOCK_PIXELS * 4];
+            for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+            {
+                int x = bx + i % TEXTURE_BLOCK_SIZE < width ? bx + i % TEXTURE_BLOCK_SIZE : width - 1;
+                int y = by + i / TEXTURE_BLOCK_SIZE < height ? by + i / TEXTURE_BLOCK_SIZE : height - 1;
+                const unsigned char *pixel = pixels + ((size_t)y * width + x) * channels;
+                //Grauwerte auf alle Kanaele, Alpha nur bei 2 und 4 Kanaelen
+                rgba[4 * i] = pixel[0];
+                rgba[4 * i + 1] = channels >= 3 ? pixel[1] : pixel[0];
+                rgba[4 * i + 2] = channels >= 3 ? pixel[2] : pixel[0];
+                rgba[4 * i + 3] = channels == 2 ? pixel[1] : (channels == 4 ? pixel[3] : 255);
+            }
+            if (format == textureFormatBC3)
+            {
+                encodeAlphaBlock(rgba, dst);
+                encodeColorBlock(rgba, dst + 8);
+            }
+            else
+            {
+                encodeColorBlock(rgba, dst);
+            }
+            dst += blockBytes;
+        }
+    }
+}
+
+/**
+ * Dekomprimiert eine Stufe (Software-Rueckfall).
+ * @param format das Format
+ * @param src die Bloecke
+ * @param width Breite der Stufe
+ * @param height Hoehe der Stufe
+ * @param channels Anzahl der Kanaele der Ausgabe (3 fuer RGB, 4 fuer RGBA)
+ * @param pixels die Pixel zeilenweise (out-param)
+ */
+static inline void decompressTextureLevel(TextureFormat format, const unsigned char *src, int width, int height,
+                                          int channels, unsigned char *pixels)
+{
+    int blockBytes = getTextureBlockBytes(format);
+    for (int by = 0; by < height; by += TEXTURE_BLOCK_SIZE)
+    {
+        for (int bx = 0; bx < width; bx += TEXTURE_BLOCK_SIZE)
+        {
+            unsigned char rgba[TEXTURE_BLOCK_PIXELS * 4];
+            if (format == textureFormatBC3)
+            {
+                decodeColorBlock(src + 8, 1, rgba);
+                decodeAlphaBlock(src, rgba);
+            }
+            else
+            {
+                decodeColorBlock(src, 0, rgba);
+            }
+            for (int i = 0; i < TEXTURE_BLOCK_PIXELS; i++)
+            {
+                int x = bx + i % TEXTURE_BLOCK_SIZE;
+                int y = by + i / TEXTURE_BLOCK_SIZE;
+                if (x < width && y < height)
+                {
+                    memcpy(pixels + ((size_t)y * width + x) * channels, &rgba[4 * i], channels);
+                }
+            }
+            src += blockBytes;
+        }
+    }
+}
+
+/**
+ * Liefert den Pfad der komprimierten Fassung einer Bilddatei: die Dateiendung
+ * wird durch ".dds" ersetzt (textures/landscape_0.jpg -> textures/landscape_0.dds).
+ * @param filename Pfad der Bilddatei
+ * @param path der Pfad der DDS-Datei (out-param)
+ * @param length Groesse von path
+ * @return ob der Pfad in path passt
+ */
+static inline int getDdsPath(const char *filename, char *path, size_t length)
+{
+    const char *slash = strrchr(filename, '/');
+    const char *dot = strrchr(filename, '.');
+    size_t stem = dot != NULL && (slash == NULL || dot > slash) ? (size_t)(dot - filename) : strlen(filename);
+    if (stem + sizeof(".dds") > length)
+    {
+        return 0;
+    }
+    memcpy(path, filename, stem);
+    memcpy(path + stem, ".dds", sizeof(".dds"));
+    return 1;
+}
+
+/**
+ * Fuellt Kennung und Kopf einer DDS-Datei mit vollstaendiger Mipmap-Kette.
+ * @param header der Kopf (out-param)
+ * @param format das Format
+ * @param width Breite der obersten Stufe
+ * @param height Hoehe der obersten Stufe
+ */
+static inline void initDdsHeader(DdsHeader *header, TextureFormat format, int width, int height)
+{
+    memset(header, 0, sizeof(DdsHeader));
+    header->magic = DDS_MAGIC;
+    header->size = sizeof(DdsHeader) - sizeof(header->magic);
+    header->flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+    header->height = height;
+    header->width = width;
+    header->pitchOrLinearSize = (uint32_t)getCompressedLevelSize(format, width, height);
+    header->mipMapCount = getTextureLevelCount(width, height);
+    header->pixelFormat.size = sizeof(DdsPixelFormat);
+    header->pixelFormat.flags = DDPF_FOURCC;
+    header->pixelFormat.fourCC = format == textureFormatBC3 ? DDS_FOURCC_DXT5 : DDS_FOURCC_DXT1;
+    header->caps = DDSCAPS_TEXTURE | DDSCAPS_MIPMAP | DDSCAPS_COMPLEX;
+}
+
+/**
+ * Prueft eine DDS-Datei und liefert deren Eigenschaften. Unterstuetzt werden
+ * DXT1 (BC1) und DXT5 (BC3) mit beliebig vielen Mipmap-Stufen.
+ * @param data der Inhalt der Datei
+ * @param size die Groesse der Datei
+ * @param format das Format (out-param)
+ * @param width Breite der obersten Stufe (out-param)
+ * @param height Hoehe der obersten Stufe (out-param)
+ * @param levels Anzahl der Stufen (out-param)
+ * @return ob die Datei gueltig und vollstaendig ist
+ */
+static inline int parseDdsHeader(const void *data, size_t size, TextureFormat *format, int *width, int *height,
+                                 int *levels)
+{
+    const DdsHeader *header = data;
+    if (size < sizeof(DdsHeader) || header->magic != DDS_MAGIC || header->size != sizeof(DdsHeader) - sizeof(header->magic) ||
+        !(header->pixelFormat.flags & DDPF_FOURCC) || header->width < 1 || header->height < 1 ||
+        header->width > (1u << (TEXTURE_MAX_LEVELS - 2)) || header->height > (1u << (TEXTURE_MAX_LEVELS - 2)))
+    {
+        return 0;
+    }
+    if (header->pixelFormat.fourCC == DDS_FOURCC_DXT1)
+    {
+        *format = textureFormatBC1;
+    }
+    else if (header->pixelFormat.fourCC == DDS_FOURCC_DXT5)
+    {
+        *format = textureFormatBC3;
+    }
+    else
+    {
+        return 0;
+    }
+    *width = header->width;
+    *height = header->height;
+    *levels = (header->flags & DDSD_MIPMAPCOUNT) && header->mipMapCount > 0 ? (int)header->mipMapCount : 1;
+    if (*levels > getTextureLevelCount(*width, *height))
+    {
+        return 0;
+    }
+
+    size_t expected = sizeof(DdsHeader);
+    int w = *width;
+    int h = *height;
+    for (int level = 0; level < *levels; level++)
+    {
+        expected += getCompressedLevelSize(*format, w, h);
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+    }
+    return size >= expected;
+}
+
+#endif
@@ -0,0 +1,755 @@
+/**
+ * @file
+ * Textur-Lade-Modul.
+ * Angeforderte Texturen durchlaufen die Zustaende wartend -> in Arbeit ->
+ * fertig (oder fehlgeschlagen) -> hochgeladen. Die Arbeitsthreads holen sich
+ * wartende Texturen unter einer gemeinsamen Sperre, dekodieren sie ohne
+ * Sperre und legen das Ergebnis wieder unter der Sperre ab. Sie beenden
+ * sich, sobald keine Textur mehr wartet. Der Hauptthread haelt die Sperre
+ * nur zum Entnehmen fertiger Texturen, nie waehrend des Hochladens.
+ *
+ * Eine fertige Textur liegt immer im Format des Caches vor (Kopf, danach
+ * alle Mipmap-Stufen), entweder per mmap aus dem Cache eingeblendet oder
+ * frisch berechnet im Speicher. Die Stufen halbieren Breite und Hoehe
+ * (abgerundet, mindestens 1) und mitteln dazu je 2x2 Pixel.
+ *
+ * Liegt neben der Bilddatei eine mindestens ebenso neue DDS-Datei
+ * (textures/landscape_0.dds zu textures/landscape_0.jpg, erzeugt mit
+ * ueb03_texconv), wird stattdessen diese eingeblendet und blockkomprimiert
+ * hochgeladen. Fehlt dem OpenGL-Treiber die S3TC-Erweiterung oder ist
+ * TEXTURE_SOFTWARE_DECODE gesetzt, dekodieren die Arbeitsthreads die Bloecke
+ * in Software und die Textur wird unkomprimiert hochgeladen. Sind alle
+ * Texturen hochgeladen, wird der belegte Grafikspeicher je Textur ausgegeben.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "textureLoader.h"
+#include "textureCompression.h"
+
+/* ---- Konstanten ---- */
+
+/* Kennung und Version des Cache-Formats */
+#define TEXTURE_CACHE_MAGIC "MIPS"
+#define TEXTURE_CACHE_VERSION 1
+
+/* Laenge der Pfade im Cache */
+#define TEXTURE_PATH_LENGTH 256
+
+/* Kantenlaenge und Farben des Platzhalters */
+#define TEXTURE_PLACEHOLDER_SIZE 2
+#define TEXTURE_PLACEHOLDER_LIGHT 160
+#define TEXTURE_PLACEHOLDER_DARK 96
+
+/* S3TC-Formate, falls glext.h sie nicht bereitstellt */
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+/* ---- Typedeklarationen ---- */
+
+/** Zustand einer angeforderten Textur */
+typedef enum
+{
+    textureStatePending,
+    textureStateDecoding,
+    textureStateReady,
+    textureStateFailed,
+    textureStateDone
+} TextureState;
+
+/** Kopf des Caches, direkt gefolgt von den Stufen */
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t levels;
+    /* Groesse und Aenderungszeit der Bilddatei, aus der der Cache stammt */
+    int64_t sourceSize;
+    int64_t sourceTime;
+} TextureCacheHeader;
+
+/** Eine angeforderte Textur */
+typedef struct
+{
+    GLuint id;
+    const char *filename;
+    TextureState state;
+    /* Groesse und Stufen, nur im Zustand fertig gesetzt */
+    int width;
+    int height;
+    int channels;
+    int levels;
+    /* Ob die Stufen blockkomprimiert im Format format vorliegen */
+    int compressed;
+    TextureFormat format;
+    const unsigned char *pixels;
+    /* Speicherbereich, der die Stufen enthaelt */
+    void *data;
+    size_t size;
+    /* Ob data per mmap eingeblendet ist (sonst malloc) */
+    int mapped;
+    /* Belegter Grafikspeicher und Groesse ohne Kompression, ab dem Hochladen */
+    size_t gpuBytes;
+    size_t uncompressedBytes;
+} TextureRequest;
+
+/* ---- Globale Daten ---- */
+
+/* Angeforderte Texturen, geschuetzt durch g_loaderMutex */
+static TextureRequest g_textureRequests[TEXTURE_LOADER_MAX_TEXTURES];
+static int g_textureRequestCount = 0;
+static pthread_mutex_t g_loaderMutex = PTHREAD_MUTEX_INITIALIZER;
+/* Ob die Arbeitsthreads keine weiteren Texturen mehr beginnen sollen */
+static int g_loaderStopping = 0;
+
+/* Arbeitsthreads und Funktionen zum Dekodieren */
+static pthread_t g_loaderWorkers[TEXTURE_LOADER_MAX_WORKERS];
+static int g_loaderWorkerCount = 0;
+static TextureDecodeFunction g_decodeTexture = NULL;
+static TextureReleaseFunction g_releaseTexture = NULL;
+
+/* Ob DDS-Dateien komprimiert hochgeladen werden (sonst Software-Dekodierung) */
+static int g_compressedUpload = 0;
+/* Ob der Speicherbericht bereits ausgegeben wurde */
+static int g_memoryReported = 0;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Liefert die Groesse von Kopf und allen Stufen.
+ * @param header der Kopf
+ * @return die Groesse in Byte
+ */
+static size_t getTextureCacheSize(const TextureCacheHeader *header)
+{
+    size_t size = sizeof(TextureCacheHeader);
+    size_t width = header->width;
+    size_t height = header->height;
+    for (uint32_t level = 0; level < header->levels; level++)
+    {
+        size += width * height * header->channels;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return size;
+}
+
+/**
+ * Blendet eine Datei per mmap ein.
+ * @param path Pfad der Datei
+ * @param minSize Mindestgroesse der Datei
+ * @param size Groesse der Datei (out-param)
+ * @return der Inhalt oder NULL, wenn die Datei fehlt oder zu klein ist
+ */
+static void *mapTextureFile(const char *path, size_t minSize, size_t *size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat info;
+    void *data = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= minSize)
+    {
+        data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    //Die Abbildung bleibt auch nach dem Schliessen der Datei bestehen
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return NULL;
+    }
+    *size = info.st_size;
+    return data;
+}
+
+/**
+ * Uebernimmt unkomprimierte Stufen im Format des Caches in eine Textur.
+ * @param data Kopf und Stufen
+ * @param size Groesse in Byte
+ * @param mapped ob data per mmap eingeblendet ist
+ * @param request die Textur (out-param)
+ */
+static void setTextureCacheData(TextureCacheHeader *data, size_t size, int mapped, TextureRequest *request)
+{
+    request->width = data->width;
+    request->height = data->height;
+    request->channels = data->channels;
+    request->levels = data->levels;
+    request->compressed = 0;
+    request->pixels = (const unsigned char *)(data + 1);
+    request->data = data;
+    request->size = size;
+    request->mapped = mapped;
+}
+
+/**
+ * Blendet den Cache einer Textur per mmap ein, sofern er zur Bilddatei passt.
+ * @param path Pfad des Caches
+ * @param source Dateiinformationen der Bilddatei
+ * @param request die Textur, erhaelt bei Erfolg die Daten (out-param)
+ * @return ob der Cache gueltig war
+ */
+static int mapTextureCache(const char *path, const struct stat *source, TextureRequest *request)
+{
+    size_t size;
+    TextureCacheHeader *header = mapTextureFile(path, sizeof(TextureCacheHeader), &size);
+    if (header == NULL)
+    {
+        return 0;
+    }
+    if (memcmp(header->magic, TEXTURE_CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != TEXTURE_CACHE_VERSION || header->sourceSize != (int64_t)source->st_size ||
+        header->sourceTime != (int64_t)source->st_mtime || header->width < 1 || header->height < 1 ||
+        header->channels < 1 || header->channels > 4 ||
+        header->levels != (uint32_t)getTextureLevelCount(header->width, header->height) ||
+        getTextureCacheSize(header) != size)
+    {
+        munmap(header, size);
+        return 0;
+    }
+    setTextureCacheData(header, size, 1, request);
+    return 1;
+}
+
+/**
+ * Schreibt den Cache einer Textur. Es wird zuerst in eine temporaere Datei
+ * geschrieben und diese dann umbenannt, damit nie ein halber Cache gelesen
+ * wird. Fehler (z.B. schreibgeschuetzte Verzeichnisse) werden ignoriert, die
+ * Textur wird dann beim naechsten Start erneut dekodiert.
+ * @param path Pfad des Caches
+ * @param data Kopf und Stufen
+ * @param size Groesse in Byte
+ */
+static void writeTextureCache(const char *path, const TextureCacheHeader *data, size_t size)
+{
+    char tempPath[TEXTURE_PATH_LENGTH];
+    if (snprintf(tempPath, sizeof(tempPath), "%s.%d", path, (int)getpid()) >= (int)sizeof(tempPath))
+    {
+        return;
+    }
+    FILE *file = fopen(tempPath, "wb");
+    if (file == NULL)
+    {
+        return;
+    }
+    int ok = fwrite(data, 1, size, file) == size;
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(tempPath, path) != 0)
+    {
+        remove(tempPath);
+    }
+}
+
+/**
+ * Dekodiert eine Bilddatei und berechnet ihre Mipmap-Kette.
+ * @param source Dateiinformationen der Bilddatei
+ * @param request die Textur, erhaelt bei Erfolg die Daten (out-param)
+ * @return ob die Datei dekodiert werden konnte
+ */
+static int decodeTexture(const struct stat *source, TextureRequest *request)
+{
+    int width, height, channels;
+    unsigned char *pixels = g_decodeTexture(request->filename, &width, &height, &channels, 0);
+    if (pixels == NULL)
+    {
+        return 0;
+    }
+
+    TextureCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TEXTURE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = TEXTURE_CACHE_VERSION;
+    header.width = width;
+    header.height = height;
+    header.channels = channels;
+    header.levels = getTextureLevelCount(width, height);
+    header.sourceSize = source->st_size;
+    header.sourceTime = source->st_mtime;
+    size_t size = getTextureCacheSize(&header);
+    TextureCacheHeader *data = malloc(size);
+    if (data == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    *data = header;
+
+    unsigned char *level = (unsigned char *)(data + 1);
+    memcpy(level, pixels, (size_t)width * height * channels);
+    g_releaseTexture(pixels);
+    for (uint32_t i = 1; i < header.levels; i++)
+    {
+        unsigned char *next = level + (size_t)width * height * channels;
+        downsampleTextureLevel(level, width, height, channels, next);
+        level = next;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    setTextureCacheData(data, size, 0, request);
+    return 1;
+}
+
+/**
+ * Blendet eine DDS-Datei per mmap ein. Ohne komprimiertes Hochladen werden
+ * alle Stufen in Software nach RGB (BC1) bzw. RGBA (BC3) dekodiert.
+ * @param path Pfad der DDS-Datei
+ * @param request die Textur, erhaelt bei Erfolg die Daten (out-param)
+ * @return ob die Datei gueltig war
+ */
+static int loadCompressedTexture(const char *path, TextureRequest *request)
+{
+    size_t size;
+    void *data = mapTextureFile(path, sizeof(DdsHeader), &size);
+    TextureFormat format;
+    int width, height, levels;
+    if (data == NULL || !parseDdsHeader(data, size, &format, &width, &height, &levels))
+    {
+        fprintf(stderr, "DDS-Datei %s ist ungueltig und wird ignoriert!\n", path);
+        if (data != NULL)
+        {
+            munmap(data, size);
+        }
+        return 0;
+    }
+    request->width = width;
+    request->height = height;
+    request->levels = levels;
+    request->format = format;
+    request->channels = format == textureFormatBC3 ? 4 : 3;
+    const unsigned char *blocks = (const unsigned char *)data + sizeof(DdsHeader);
+    if (g_compressedUpload)
+    {
+        request->compressed = 1;
+        request->pixels = blocks;
+        request->data = data;
+        request->size = size;
+        request->mapped = 1;
+        return 1;
+    }
+
+    //Software-Rueckfall: Stufen nacheinander dekodieren
+    size_t decodedSize = 0;
+    for (int level = 0; level < levels; level++)
+    {
+        decodedSize += (size_t)width * height * request->channels;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    unsigned char *pixels = malloc(decodedSize);
+    if (pixels == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    unsigned char *level = pixels;
+    width = request->width;
+    height = request->height;
+    for (int i = 0; i < levels; i++)
+    {
+        decompressTextureLevel(format, blocks, width, height, request->channels, level);
+        blocks += getCompressedLevelSize(format, width, height);
+        level += (size_t)width * height * request->channels;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    munmap(data, size);
+    request->compressed = 0;
+    request->pixels = pixels;
+    request->data = pixels;
+    request->size = decodedSize;
+    request->mapped = 0;
+    return 1;
+}
+
+/**
+ * Gibt die Daten einer Textur frei.
+ * @param request die Textur
+ */
+static void releaseTextureData(TextureRequest *request)
+{
+    if (request->data != NULL)
+    {
+        if (request->mapped)
+        {
+            munmap(request->data, request->size);
+        }
+        else
+        {
+            free(request->data);
+        }
+        request->data = NULL;
+    }
+}
+
+/**
+ * Arbeitsthread: laedt wartende Texturen aus dem Cache oder dekodiert sie,
+ * bis keine mehr wartet.
+ * @param arg unbenutzt
+ * @return NULL
+ */
+static void *runTextureWorker(void *arg)
+{
+    for (;;)
+    {
+        pthread_mutex_lock(&g_loaderMutex);
+        TextureRequest *request = NULL;
+        for (int i = 0; i < g_textureRequestCount && request == NULL && !g_loaderStopping; i++)
+        {
+            if (g_textureRequests[i].state == textureStatePending)
+            {
+                request = &g_textureRequests[i];
+                request->state = textureStateDecoding;
+            }
+        }
+        pthread_mutex_unlock(&g_loaderMutex);
+        if (request == NULL)
+        {
+            return NULL;
+        }
+
+        //Der Eintrag gehoert bis zum Ablegen des Ergebnisses nur diesem Thread
+        TextureRequest result = *request;
+        struct stat source;
+        int hasSource = stat(result.filename, &source) == 0;
+        int ok = 0;
+
+        //Komprimierte Fassung, sofern nicht aelter als die Bilddatei
+        char ddsPath[TEXTURE_PATH_LENGTH];
+        struct stat compressed;
+        if (getDdsPath(result.filename, ddsPath, sizeof(ddsPath)) && stat(ddsPath, &compressed) == 0)
+        {
+            if (hasSource && compressed.st_mtime < source.st_mtime)
+            {
+                fprintf(stderr, "DDS-Datei %s ist aelter als %s und wird ignoriert!\n", ddsPath, result.filename);
+            }
+            else
+            {
+                ok = loadCompressedTexture(ddsPath, &result);
+            }
+        }
+
+        //Bei zu langen Pfaden wird ohne Cache geladen
+        char cachePath[TEXTURE_PATH_LENGTH];
+        int cached = snprintf(cachePath, sizeof(cachePath), "%s%s", result.filename, TEXTURE_CACHE_SUFFIX) < (int)sizeof(cachePath);
+        if (!ok && hasSource)
+        {
+            ok = cached && mapTextureCache(cachePath, &source, &result);
+            if (!ok)
+            {
+                ok = decodeTexture(&source, &result);
+                if (ok && cached)
+                {
+                    writeTextureCache(cachePath, result.data, result.size);
+                }
+            }
+        }
+
+        pthread_mutex_lock(&g_loaderMutex);
+        result.state = ok ? textureStateReady : textureStateFailed;
+        *request = result;
+        pthread_mutex_unlock(&g_loaderMutex);
+    }
+}
+
+/**
+ * Setzt die Filter- und Wiederholungsparameter der gebundenen Textur.
+ */
+static void setTextureParameters(void)
+{
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+}
+
+/**
+ * Liefert das OpenGL-Pixelformat zu einer Anzahl an Farbkanaelen.
+ * @param channels Anzahl der Farbkanaele
+ * @return das Pixelformat
+ */
+static GLenum getTexturePixelFormat(int channels)
+{
+    switch (channels)
+    {
+    case 1:
+        return GL_LUMINANCE;
+    case 2:
+        return GL_LUMINANCE_ALPHA;
+    case 4:
+        return GL_RGBA;
+    default:
+        return GL_RGB;
+    }
+}
+
+/**
+ * Berechnet den Grafikspeicher aller Stufen einer fertigen Textur und ihre
+ * Groesse ohne Kompression. Unkomprimierte Texturen werden mit ihrer
+ * Kanalzahl gerechnet, auch wenn Treiber RGB intern oft auf RGBA auffuellen.
+ * @param request die Textur (in/out-param)
+ */
+static void setTextureMemory(TextureRequest *request)
+{
+    int width = request->width;
+    int height = request->height;
+    request->gpuBytes = 0;
+    request->uncompressedBytes = 0;
+    for (int level = 0; level < request->levels; level++)
+    {
+        size_t pixelBytes = (size_t)width * height * request->channels;
+        request->gpuBytes += request->compressed ? getCompressedLevelSize(request->format, width, height) : pixelBytes;
+        request->uncompressedBytes += pixelBytes;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+}
+
+/**
+ * Liefert den Namen des Formats, in dem eine Textur im Grafikspeicher liegt.
+ * @param request die Textur
+ * @return der Name
+ */
+static const char *getTextureStorageName(const TextureRequest *request)
+{
+    static const char *names[4] = {"L", "LA", "RGB", "RGBA"};
+    return request->compressed ? getTextureFormatName(request->format) : names[request->channels - 1];
+}
+
+/**
+ * Fordert eine Textur an. Sie erhaelt sofort einen Platzhalter und wird
+ * nach startTextureLoader im Hintergrund geladen. Muss im Hauptthread vor
+ * startTextureLoader aufgerufen werden.
+ * @param id die bereits erzeugte Textur
+ * @param filename Pfad der Bilddatei (wird nicht kopiert)
+ * @return ob der Platzhalter angelegt werden konnte
+ */
+int requestTexture(GLuint id, const char *filename)
+{
+    if (g_textureRequestCount >= TEXTURE_LOADER_MAX_TEXTURES)
+    {
+        return 0;
+    }
+    TextureRequest *request = &g_textureRequests[g_textureRequestCount++];
+    request->id = id;
+    request->filename = filename;
+    request->state = textureStatePending;
+    request->data = NULL;
+    request->gpuBytes = 0;
+    request->uncompressedBytes = 0;
+
+    //Graues Schachbrett als Platzhalter
+    GLubyte placeholder[TEXTURE_PLACEHOLDER_SIZE * TEXTURE_PLACEHOLDER_SIZE * 3];
+    for (int i = 0; i < TEXTURE_PLACEHOLDER_SIZE * TEXTURE_PLACEHOLDER_SIZE; i++)
+    {
+        int light = (i / TEXTURE_PLACEHOLDER_SIZE + i % TEXTURE_PLACEHOLDER_SIZE) % 2 == 0;
+        memset(&placeholder[3 * i], light ? TEXTURE_PLACEHOLDER_LIGHT : TEXTURE_PLACEHOLDER_DARK, 3);
+    }
+    GLint bound;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+    glBindTexture(GL_TEXTURE_2D, id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, TEXTURE_PLACEHOLDER_SIZE, TEXTURE_PLACEHOLDER_SIZE, 0, GL_RGB,
+                 GL_UNSIGNED_BYTE, placeholder);
+    setTextureParameters();
+    glBindTexture(GL_TEXTURE_2D, bound);
+    return glGetError() == GL_NO_ERROR;
+}
+
+/**
+ * Startet die Arbeitsthreads fuer alle angeforderten Texturen, hoechstens
+ * einen je Prozessorkern und Textur. Muss im Hauptthread mit gueltigem
+ * OpenGL-Kontext aufgerufen werden, da hier die S3TC-Unterstuetzung
+ * abgefragt wird.
+ * @param decode Funktion zum Dekodieren der Bilddateien
+ * @param release Funktion zum Freigeben der dekodierten Pixel
+ */
+void startTextureLoader(TextureDecodeFunction decode, TextureReleaseFunction release)
+{
+    g_decodeTexture = decode;
+    g_releaseTexture = release;
+    g_loaderStopping = 0;
+    g_memoryReported = 0;
+#ifdef TEXTURE_SOFTWARE_DECODE
+    g_compressedUpload = 0;
+#else
+    const char *extensions = (const char *)glGetString(GL_EXTENSIONS);
+    g_compressedUpload = extensions != NULL && strstr(extensions, "GL_EXT_texture_compression_s3tc") != NULL;
+#endif
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int workers = cores > 0 ? (int)cores : 1;
+    workers = workers < TEXTURE_LOADER_MAX_WORKERS ? workers : TEXTURE_LOADER_MAX_WORKERS;
+    workers = workers < g_textureRequestCount ? workers : g_textureRequestCount;
+    for (g_loaderWorkerCount = 0; g_loaderWorkerCount < workers; g_loaderWorkerCount++)
+    {
+        if (pthread_create(&g_loaderWorkers[g_loaderWorkerCount], NULL, runTextureWorker, NULL) != 0)
+        {
+            break;
+        }
+    }
+    //Ohne Arbeitsthread wird im Hauptthread geladen
+    if (g_loaderWorkerCount == 0)
+    {
+        runTextureWorker(NULL);
+    }
+}
+
+/**
+ * Laedt fertig dekodierte Texturen hoch, hoechstens
+ * TEXTURE_LOADER_UPLOADS_PER_FRAME je Aufruf. Muss im Hauptthread aufgerufen
+ * werden, z.B. zu Beginn jedes Frames. Fehlgeschlagene Texturen werden
+ * gemeldet und behalten den Platzhalter. Nach der letzten Textur folgt der
+ * Speicherbericht.
+ * @return Anzahl der noch nicht hochgeladenen Texturen
+ */
+int uploadLoadedTextures(void)
+{
+    TextureRequest uploads[TEXTURE_LOADER_UPLOADS_PER_FRAME];
+    int uploadCount = 0;
+    int remaining = 0;
+    pthread_mutex_lock(&g_loaderMutex);
+    for (int i = 0; i < g_textureRequestCount; i++)
+    {
+        TextureRequest *request = &g_textureRequests[i];
+        if (request->state == textureStateFailed)
+        {
+            fprintf(stderr, "Textur %s konnte nicht geladen werden!\n", request->filename);
+            request->state = textureStateDone;
+        }
+        else if (request->state == textureStateReady && uploadCount < TEXTURE_LOADER_UPLOADS_PER_FRAME)
+        {
+            setTextureMemory(request);
+            uploads[uploadCount++] = *request;
+            request->data = NULL;
+            request->state = textureStateDone;
+        }
+        else if (request->state != textureStateDone)
+        {
+            remaining++;
+        }
+    }
+    pthread_mutex_unlock(&g_loaderMutex);
+
+    if (uploadCount > 0)
+    {
+        GLint bound, alignment;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+        //Zeilen der kleinen Stufen sind nicht auf 4 Byte ausgerichtet
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (int i = 0; i < uploadCount; i++)
+        {
+            TextureRequest *upload = &uploads[i];
+            const unsigned char *level = upload->pixels;
+            GLsizei width = upload->width;
+            GLsizei height = upload->height;
+            GLenum compressedFormat = upload->format == textureFormatBC3 ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+                                                                         : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            glBindTexture(GL_TEXTURE_2D, upload->id);
+            for (int l = 0; l < upload->levels; l++)
+            {
+                size_t levelSize;
+                if (upload->compressed)
+                {
+                    levelSize = getCompressedLevelSize(upload->format, width, height);
+                    glCompressedTexImage2D(GL_TEXTURE_2D, l, compressedFormat, width, height, 0, (GLsizei)levelSize,
+                                           level);
+                }
+                else
+                {
+                    levelSize = (size_t)width * height * upload->channels;
+                    glTexImage2D(GL_TEXTURE_2D, l, upload->channels, width, height, 0,
+                                 getTexturePixelFormat(upload->channels), GL_UNSIGNED_BYTE, level);
+                }
+                level += levelSize;
+                width = width > 1 ? width / 2 : 1;
+                height = height > 1 ? height / 2 : 1;
+            }
+            setTextureParameters();
+            releaseTextureData(upload);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+        glBindTexture(GL_TEXTURE_2D, bound);
+    }
+    if (remaining == 0 && g_textureRequestCount > 0 && !g_memoryReported)
+    {
+        printTextureMemoryReport();
+        g_memoryReported = 1;
+    }
+    return remaining;
+}
+
+/**
+ * Gibt den Grafikspeicher der hochgeladenen Texturen aus, je Textur und in
+ * Summe, jeweils mit der Groesse ohne Kompression. Wird automatisch
+ * aufgerufen, sobald alle Texturen hochgeladen sind. Muss im Hauptthread
+ * aufgerufen werden.
+ */
+void printTextureMemoryReport(void)
+{
+    size_t gpuBytes = 0;
+    size_t uncompressedBytes = 0;
+    printf("%-32s %-6s %11s %6s %12s %12s\n", "Textur", "Format", "Groesse", "Stufen", "Grafik-KiB", "Unkompr.-KiB");
+    pthread_mutex_lock(&g_loaderMutex);
+    for (int i = 0; i < g_textureRequestCount; i++)
+    {
+        const TextureRequest *request = &g_textureRequests[i];
+        if (request->state == textureStateDone && request->gpuBytes > 0)
+        {
+            char size[32];
+            snprintf(size, sizeof(size), "%dx%d", request->width, request->height);
+            printf("%-32s %-6s %11s %6d %12.1f %12.1f\n", request->filename, getTextureStorageName(request), size,
+                   request->levels, request->gpuBytes / 1024.0, request->uncompressedBytes / 1024.0);
+            gpuBytes += request->gpuBytes;
+            uncompressedBytes += request->uncompressedBytes;
+        }
+    }
+    pthread_mutex_unlock(&g_loaderMutex);
+    printf("%-32s %-6s %11s %6s %12.1f %12.1f", "Gesamt", "", "", "", gpuBytes / 1024.0, uncompressedBytes / 1024.0);
+    if (gpuBytes > 0)
+    {
+        printf("  (%.1f:1)", (double)uncompressedBytes / gpuBytes);
+    }
+    printf("\n");
+}
+
+/**
+ * Beendet die Arbeitsthreads (laufende Texturen werden noch fertig geladen)
+ * und gibt alle nicht hochgeladenen Texturen frei.
+ */
+void stopTextureLoader(void)
+{
+    pthread_mutex_lock(&g_loaderMutex);
+    g_loaderStopping = 1;
+    pthread_mutex_unlock(&g_loaderMutex);
+    for (int i = 0; i < g_loaderWorkerCount; i++)
+    {
+        pthread_join(g_loaderWorkers[i], NULL);
+    }
+    g_loaderWorkerCount = 0;
+    for (int i = 0; i < g_textureRequestCount; i++)
+    {
+        releaseTextureData(&g_textureRequests[i]);
+    }
+    g_textureRequestCount = 0;
+}
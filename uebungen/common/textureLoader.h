@@ -0,0 +1,93 @@
+#ifndef __TEXTURELOADER_H__
+#define __TEXTURELOADER_H__
+/**
+ * @file
+ * Textur-Lade-Modul.
+ * Dekodiert Bilddateien im Hintergrund, damit der Start nicht auf das Laden
+ * aller Texturen wartet. Jede angeforderte Textur erhaelt sofort einen
+ * Platzhalter (graues Schachbrett), Arbeitsthreads dekodieren die Dateien
+ * und berechnen die Mipmap-Kette, der Hauptthread laedt fertige Texturen in
+ * uploadLoadedTextures hoch (OpenGL darf nur aus dem Hauptthread aufgerufen
+ * werden):
+ *
+ *   requestTexture(id, "textures/landscape_0.jpg");
+ *   startTextureLoader(stbi_load, stbi_image_free);
+ *   ...
+ *   //in jedem Frame
+ *   uploadLoadedTextures();
+ *
+ * Die Mipmap-Kette wird neben der Bilddatei als Cache abgelegt
+ * (<Datei>.mips: Kopf und alle Stufen unkomprimiert hintereinander) und bei
+ * spaeteren Starts per mmap eingeblendet statt neu dekodiert. Der Cache gilt,
+ * solange Groesse und Aenderungszeit der Bilddatei uebereinstimmen, und kann
+ * jederzeit geloescht werden.
+ *
+ * Blockkomprimierte Fassungen (BC1/BC3 als DDS-Datei mit gleichem Namen und
+ * Endung .dds, siehe textureCompression.h) haben Vorrang vor Bilddatei und
+ * Cache und belegen im Grafikspeicher ein Viertel bis ein Sechstel. Mit
+ * -D TEXTURE_SOFTWARE_DECODE werden sie wie ohne S3TC-faehigen Treiber in
+ * Software dekodiert und unkomprimiert hochgeladen.
+ *
+ * Die Bilddateien werden ueber die beim Start uebergebene Funktion dekodiert
+ * (z.B. stbi_load), damit stb_image in der jeweiligen Uebung bleibt.
+ *
+ * Wie profiler.c haelt das Modul globalen Zustand und besteht deshalb aus
+ * Header und Uebersetzungseinheit.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+/* ---- Konstanten ---- */
+
+/* Hoechstzahl angeforderter Texturen */
+#define TEXTURE_LOADER_MAX_TEXTURES 32
+
+/* Hoechstzahl der Arbeitsthreads */
+#define TEXTURE_LOADER_MAX_WORKERS 4
+
+/* Anzahl der je Frame hochgeladenen Texturen, damit kein Frame lange haengt */
+#define TEXTURE_LOADER_UPLOADS_PER_FRAME 1
+
+/* Dateiendung des Mipmap-Caches */
+#define TEXTURE_CACHE_SUFFIX ".mips"
+
+/* ---- Typedeklarationen ---- */
+
+/**
+ * Funktion zum Dekodieren einer Bilddatei, z.B. stbi_load.
+ * @param filename Pfad der Bilddatei
+ * @param width Breite des Bildes (out-param)
+ * @param height Hoehe des Bildes (out-param)
+ * @param channels Anzahl der Farbkanaele (out-param)
+ * @param desiredChannels gewuenschte Kanaele, 0 fuer die der Datei
+ * @return die Pixel zeilenweise oder NULL im Fehlerfall
+ */
+typedef unsigned char *(*TextureDecodeFunction)(const char *filename, int *width, int *height, int *channels,
+                                                int desiredChannels);
+
+/**
+ * Funktion zum Freigeben der dekodierten Pixel, z.B. stbi_image_free.
+ * @param data die Pixel
+ */
+typedef void (*TextureReleaseFunction)(void *data);
+
+/* ---- Funktionen ---- */
+
+int requestTexture(GLuint id, const char *filename);
+
+void startTextureLoader(TextureDecodeFunction decode, TextureReleaseFunction release);
+
+int uploadLoadedTextures(void);
+
+void printTextureMemoryReport(void);
+
+void stopTextureLoader(void);
+
+#endif
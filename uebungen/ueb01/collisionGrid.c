@@ -0,0 +1,163 @@
+/**
+ * @file
+ * Kollisionsgitter-Modul.
+ * Das Gitter wird einmal je Level aufgebaut. Jedes Objekt wird in alle
+ * Zellen eingetragen, die sein um einen Rand vergroesserter Kreis
+ * beruehrt. Eine Abfrage liefert dadurch die Objekte einer einzigen Zelle,
+ * die dann noch exakt geprueft werden muessen. Die Objekte werden per
+ * Counting Sort zellenweise hintereinander abgelegt.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "collisionGrid.h"
+#include "util.h"
+
+/* ---- Funktionen ---- */
+
+/**
+ * Berechnet die Spalte bzw. Zeile einer Koordinate, begrenzt auf das Gitter.
+ * @param value die Koordinate
+ * @param min die kleinste Koordinate des Gitters
+ * @param cellSize die Kantenlaenge einer Zelle
+ * @param cells Anzahl der Zellen auf der Achse
+ * @return die Spalte bzw. Zeile
+ */
+static int getCellCoordinate(float value, float min, float cellSize, int cells)
+{
+    int cell = (int)floorf((value - min) / cellSize);
+    return cell < 0 ? 0 : cell >= cells ? cells - 1 : cell;
+}
+
+/**
+ * Bestimmt die Zellen, die ein Objekt samt Rand beruehrt.
+ * @param grid das Gitter
+ * @param object das Objekt
+ * @param margin der Rand
+ * @param range erste und letzte Spalte, erste und letzte Zeile (out-param)
+ */
+static void getObjectCells(const CollisionGrid *grid, const CollisionObject *object, float margin, int range[4])
+{
+    float reach = object->radius + margin;
+    range[0] = getCellCoordinate(object->x - reach, grid->minX, grid->cellSize, grid->columns);
+    range[1] = getCellCoordinate(object->x + reach, grid->minX, grid->cellSize, grid->columns);
+    range[2] = getCellCoordinate(object->y - reach, grid->minY, grid->cellSize, grid->rows);
+    range[3] = getCellCoordinate(object->y + reach, grid->minY, grid->cellSize, grid->rows);
+}
+
+/**
+ * Baut das Gitter ueber den uebergebenen Objekten auf. Das Gitter umfasst
+ * alle Objekte samt Rand, die Anzahl der Zellen waechst mit der Anzahl der
+ * Objekte. Eine Zelle ist mindestens so gross wie ein durchschnittliches
+ * Objekt samt Rand.
+ * @param grid das Gitter (in/out-param), vorhandener Speicher wird wiederverwendet
+ * @param objects die Objekte
+ * @param count Anzahl der Objekte
+ * @param margin Rand um jedes Objekt, z.B. der Radius des Fliegers
+ */
+void buildCollisionGrid(CollisionGrid *grid, const CollisionObject *objects, int count, float margin)
+{
+    //Huelle aller Objekte samt Rand
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+    float reachSum = 0.0f;
+    for (int i = 0; i < count; i++)
+    {
+        float reach = objects[i].radius + margin;
+        reachSum += reach;
+        minX = i == 0 || objects[i].x - reach < minX ? objects[i].x - reach : minX;
+        minY = i == 0 || objects[i].y - reach < minY ? objects[i].y - reach : minY;
+        maxX = i == 0 || objects[i].x + reach > maxX ? objects[i].x + reach : maxX;
+        maxY = i == 0 || objects[i].y + reach > maxY ? objects[i].y + reach : maxY;
+    }
+    float extent = fmaxf(fmaxf(maxX - minX, maxY - minY), 1e-3f);
+    int cells = (int)ceilf(sqrtf((float)count));
+    cells = cells < 1 ? 1 : cells > COLLISION_GRID_MAX_CELLS ? COLLISION_GRID_MAX_CELLS : cells;
+    grid->minX = minX;
+    grid->minY = minY;
+    //Zellen nicht kleiner als ein durchschnittliches Objekt, sonst liegt es in zu vielen Zellen
+    grid->cellSize = fmaxf(extent / cells, count > 0 ? 2.0f * reachSum / count : 0.0f);
+    grid->columns = (int)ceilf((maxX - minX) / grid->cellSize);
+    grid->rows = (int)ceilf((maxY - minY) / grid->cellSize);
+    grid->columns = grid->columns < 1 ? 1 : grid->columns;
+    grid->rows = grid->rows < 1 ? 1 : grid->rows;
+    int cellCount = grid->columns * grid->rows;
+
+    //Eintraege je Zelle zaehlen
+    grid->cellStart = reallocArray(grid->cellStart, sizeof(int) * (cellCount + 1));
+    memset(grid->cellStart, 0, sizeof(int) * (cellCount + 1));
+    int range[4];
+    for (int i = 0; i < count; i++)
+    {
+        getObjectCells(grid, &objects[i], margin, range);
+        for (int row = range[2]; row <= range[3]; row++)
+        {
+            for (int column = range[0]; column <= range[1]; column++)
+            {
+                grid->cellStart[row * grid->columns + column + 1]++;
+            }
+        }
+    }
+    //Praefixsumme liefert den Beginn jeder Zelle
+    for (int cell = 0; cell < cellCount; cell++)
+    {
+        grid->cellStart[cell + 1] += grid->cellStart[cell];
+    }
+    grid->objectCount = grid->cellStart[cellCount];
+    grid->objects = reallocArray(grid->objects, sizeof(CollisionObject) * grid->objectCount);
+
+    //Eintragen, dabei dienen die Anfaenge der Folgezellen als Schreibzeiger
+    int *next = reallocArray(NULL, sizeof(int) * cellCount);
+    memcpy(next, grid->cellStart, sizeof(int) * cellCount);
+    for (int i = 0; i < count; i++)
+    {
+        getObjectCells(grid, &objects[i], margin, range);
+        for (int row = range[2]; row <= range[3]; row++)
+        {
+            for (int column = range[0]; column <= range[1]; column++)
+            {
+                grid->objects[next[row * grid->columns + column]++] = objects[i];
+            }
+        }
+    }
+    free(next);
+}
+
+/**
+ * Liefert die Objekte, deren Kreis samt Rand die Zelle einer Position
+ * beruehren koennte. Positionen ausserhalb des Gitters liefern keine Objekte.
+ * @param grid das Gitter
+ * @param x x-Koordinate der Position
+ * @param y y-Koordinate der Position
+ * @param objects das erste Objekt der Zelle (out-param)
+ * @return Anzahl der Objekte der Zelle
+ */
+int queryCollisionGrid(const CollisionGrid *grid, float x, float y, const CollisionObject **objects)
+{
+    if (grid->cellStart == NULL || x < grid->minX || y < grid->minY ||
+        x >= grid->minX + grid->columns * grid->cellSize || y >= grid->minY + grid->rows * grid->cellSize)
+    {
+        return 0;
+    }
+    int cell = getCellCoordinate(y, grid->minY, grid->cellSize, grid->rows) * grid->columns +
+               getCellCoordinate(x, grid->minX, grid->cellSize, grid->columns);
+    *objects = grid->objects + grid->cellStart[cell];
+    return grid->cellStart[cell + 1] - grid->cellStart[cell];
+}
+
+/**
+ * Gibt den Speicher des Gitters frei.
+ * @param grid das Gitter
+ */
+void freeCollisionGrid(CollisionGrid *grid)
+{
+    free(grid->cellStart);
+    free(grid->objects);
+    memset(grid, 0, sizeof(CollisionGrid));
+}
@@ -0,0 +1,28 @@
+#ifndef __COLLISION_GRID_H__
+#define __COLLISION_GRID_H__
+/**
+ * @file
+ * Kollisionsgitter-Modul.
+ * Das Modul verwaltet ein gleichmaessiges Gitter ueber den kreisfoermigen
+ * Objekten eines Levels, sodass fuer eine Position nur die Objekte der
+ * zugehoerigen Zelle geprueft werden muessen.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/* ---- Konstanten ---- */
+
+/* Hoechstzahl an Zellen je Achse */
+#define COLLISION_GRID_MAX_CELLS 256
+
+/* ---- Funktionen ---- */
+
+void buildCollisionGrid(CollisionGrid *grid, const CollisionObject *objects, int count, float margin);
+
+int queryCollisionGrid(const CollisionGrid *grid, float x, float y, const CollisionObject **objects);
+
+void freeCollisionGrid(CollisionGrid *grid);
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file
+ * Kurven-Modul.
+ * Das Modul wertet stueckweise kubische Kurven (B-Spline bzw. Bezier) ueber
+ * einem Kontrollpolygon beliebiger Laenge aus. Ein Kontrollpolygon mit n
+ * Punkten hat n - 3 Teilstuecke, die gleich breite Abschnitte von T [0-1]
+ * belegen. Das Teilstueck zu T wird direkt berechnet, die Gewichte der vier
+ * Kontrollpunkte per Horner-Schema aus der Basismatrix.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <math.h>
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+/* ---- Eigene Header einbinden ---- */
+#include "curve.h"
+#include "logic.h"
+
+/* ---- Globale Daten ---- */
+
+/*Interpolationsmatrix fuer Spline*/
+static const float g_splineBasis[16] = {-(1.0f / 6.0f), (1.0f / 2.0f), -(1.0f / 2.0f), (1.0f / 6.0f),
+                                        (1.0f / 2.0f), -1.0f, (1.0f / 2.0f), 0,
+                                        -(1.0f / 2.0f), 0.0f, (1.0f / 2.0f), 0,
+                                        (1.0f / 6.0f), (2.0f / 3.0f), (1.0f / 6.0f), 0};
+/*Interpolationsmatrix fuer Bezier*/
+static const float g_bezierBasis[16] = {-1.0f, 3.0f, -3.0f, 1.0f,
+                                        3.0f, -6.0f, 3.0f, 0.0f,
+                                        -3.0f, 3.0f, 0.0f, 0.0f,
+                                        1.0f, 0.0f, 0.0f, 0.0f};
+
+/* ---- Funktionen ---- */
+
+/**
+ * Liefert die Basismatrix fuer Spline oder Bezier.
+ * @param isSpline ob die Matrix des Splines geliefert werden soll
+ * @return die Basismatrix (zeilenweise)
+ */
+const float *getCurveBasis(GLboolean isSpline)
+{
+    return isSpline ? g_splineBasis : g_bezierBasis;
+}
+
+/**
+ * Liefert die Anzahl der Teilstuecke einer Kurve.
+ * @param curve die Kurve
+ * @return die Anzahl der Teilstuecke (0, wenn zu wenig Kontrollpunkte)
+ */
+int getCurveSegmentCount(const Curve *curve)
+{
+    int segments = curve->pointCount - (CURVE_SEGMENT_POINTS - 1);
+    return segments > 0 ? segments : 0;
+}
+
+/**
+ * Berechnet den Punkt der Kurve zu einem gegebenen T. Liegt T genau auf der
+ * Grenze zweier Teilstuecke, wird das hintere mit t = 0 ausgewertet (die
+ * Kurve ist dort stetig), T = 1 liefert das letzte Teilstueck mit t = 1.
+ * Das lokale t bleibt so fuer jede Anzahl an Teilstuecken in [0-1].
+ * @param curve die Kurve (mindestens CURVE_SEGMENT_POINTS Kontrollpunkte)
+ * @param T die Zeit [0-1]
+ * @param point der Punkt der Kurve (out-param)
+ */
+void evaluateCurve(const Curve *curve, float T, CGPoint2f point)
+{
+    int segments = getCurveSegmentCount(curve);
+    float scaled = T * segments;
+    //Teilstueck direkt bestimmen statt die Teilbereiche abzulaufen
+    int segment = (int)floorf(scaled);
+    segment = segment < 0 ? 0 : segment >= segments ? segments - 1 : segment;
+    float t = scaled - segment;
+
+    const float *m = curve->basis;
+    const CGPoint2f *p = curve->points + segment;
+    float x = 0.0f;
+    float y = 0.0f;
+    for (int i = 0; i < CURVE_SEGMENT_POINTS; i++)
+    {
+        //Gewicht von Kontrollpunkt i: (t^3, t^2, t, 1) * Spalte i der Basismatrix
+        float weight = ((m[i] * t + m[4 + i]) * t + m[8 + i]) * t + m[12 + i];
+        x += weight * p[i][LX];
+        y += weight * p[i][LY];
+    }
+    point[LX] = x;
+    point[LY] = y;
+}
+
+#ifdef DEBUG
+/* Anzahl der Kontrollpunkte und Abtastwerte je Teilstueck der Selbstpruefung */
+#define CURVE_CHECK_POINTS 5003
+#define CURVE_CHECK_SAMPLES 8
+/* Zulaessige Abweichung: ein float-T loest das lokale t bei 5000
+ * Teilstuecken nur auf etwa 3e-4 auf */
+#define CURVE_CHECK_TOLERANCE 0.001f
+
+/**
+ * Wertet Teilstueck segment direkt mit lokalem t aus, als Zeilenvektor
+ * (t^3, t^2, t, 1) mal Basismatrix mal Kontrollpunkte.
+ * @param curve die Kurve
+ * @param segment das Teilstueck
+ * @param t das lokale t [0-1]
+ * @param point der Punkt der Kurve (out-param)
+ */
+static void evaluateCurveSegmentDirect(const Curve *curve, int segment, float t, CGPoint2f point)
+{
+    float powers[CURVE_SEGMENT_POINTS] = {t * t * t, t * t, t, 1.0f};
+    point[LX] = 0.0f;
+    point[LY] = 0.0f;
+    for (int i = 0; i < CURVE_SEGMENT_POINTS; i++)
+    {
+        float weight = 0.0f;
+        for (int j = 0; j < CURVE_SEGMENT_POINTS; j++)
+        {
+            weight += powers[j] * curve->basis[j * CURVE_SEGMENT_POINTS + i];
+        }
+        point[LX] += weight * curve->points[segment + i][LX];
+        point[LY] += weight * curve->points[segment + i][LY];
+    }
+}
+
+/**
+ * Liefert die groessere Abweichung zweier Punkte in x bzw. y.
+ * @param a erster Punkt
+ * @param b zweiter Punkt
+ * @return die Abweichung
+ */
+static float getPointDeviation(const CGPoint2f a, const CGPoint2f b)
+{
+    return fmaxf(fabsf(a[LX] - b[LX]), fabsf(a[LY] - b[LY]));
+}
+
+/**
+ * Prueft evaluateCurve fuer ein langes Kontrollpolygon gegen die direkte
+ * Auswertung jedes Teilstuecks mit lokalem t, fuer Spline und Bezier.
+ * Abgetastet wird im Inneren der Teilstuecke, da aufeinanderfolgende
+ * Bezier-Teilstuecke an ihrer Grenze nicht zusammenfallen, dazu T = 0 und
+ * T = 1 (erstes bzw. letztes Teilstueck).
+ * @return ob alle Abweichungen unter CURVE_CHECK_TOLERANCE liegen
+ */
+GLboolean checkCurve(void)
+{
+    static CGPoint2f points[CURVE_CHECK_POINTS];
+    for (int i = 0; i < CURVE_CHECK_POINTS; i++)
+    {
+        points[i][LX] = (float)i / (CURVE_CHECK_POINTS - 1);
+        points[i][LY] = (i % 7) / 7.0f;
+    }
+    GLboolean ok = GL_TRUE;
+    for (int spline = 0; spline < 2; spline++)
+    {
+        Curve curve = {points, CURVE_CHECK_POINTS, getCurveBasis(spline)};
+        int segments = getCurveSegmentCount(&curve);
+        CGPoint2f expected, actual;
+        evaluateCurveSegmentDirect(&curve, 0, 0.0f, expected);
+        evaluateCurve(&curve, 0.0f, actual);
+        float maxError = getPointDeviation(actual, expected);
+        evaluateCurveSegmentDirect(&curve, segments - 1, 1.0f, expected);
+        evaluateCurve(&curve, 1.0f, actual);
+        maxError = fmaxf(maxError, getPointDeviation(actual, expected));
+        for (int segment = 0; segment < segments; segment++)
+        {
+            for (int sample = 0; sample < CURVE_CHECK_SAMPLES; sample++)
+            {
+                float t = (sample + 0.5f) / CURVE_CHECK_SAMPLES;
+                evaluateCurveSegmentDirect(&curve, segment, t, expected);
+                evaluateCurve(&curve, (segment + t) / segments, actual);
+                maxError = fmaxf(maxError, getPointDeviation(actual, expected));
+            }
+        }
+        if (maxError > CURVE_CHECK_TOLERANCE)
+        {
+            fprintf(stderr, "evaluateCurve (%s, %d Teilstuecke): Abweichung %g\n", spline ? "Spline" : "Bezier",
+                    segments, maxError);
+            ok = GL_FALSE;
+        }
+    }
+    return ok;
+}
+#endif
@@ -0,0 +1,32 @@
+#ifndef __CURVE_H__
+#define __CURVE_H__
+/**
+ * @file
+ * Kurven-Modul.
+ * Das Modul wertet stueckweise kubische Kurven (B-Spline bzw. Bezier) ueber
+ * einem Kontrollpolygon beliebiger Laenge aus. Die Funktionen haben keinen
+ * Zustand und reservieren keinen Speicher.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/* ---- Konstanten ---- */
+
+/* Anzahl der Kontrollpunkte je Teilstueck */
+#define CURVE_SEGMENT_POINTS 4
+
+/* ---- Funktionen ---- */
+
+const float *getCurveBasis(GLboolean isSpline);
+
+int getCurveSegmentCount(const Curve *curve);
+
+void evaluateCurve(const Curve *curve, float T, CGPoint2f point);
+
+#ifdef DEBUG
+GLboolean checkCurve(void);
+#endif
+
+#endif
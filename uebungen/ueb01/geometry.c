@@ -0,0 +1,238 @@
+/**
+ * @file
+ * Geometrie-Modul.
+ * Die Orientierung dreier Punkte wird zuerst in double berechnet. Liegt das
+ * Ergebnis innerhalb der Fehlerschranke dieser Rechnung, wird es exakt
+ * nachgerechnet (Produkte per fma, Summe als Expansion nach Shewchuk), sodass
+ * das Vorzeichen immer stimmt und keine Toleranzen (DELTA) noetig sind.
+ *
+ * Die konvexe Huelle wird mit dem Monotone-Chain-Verfahren (Andrew) in
+ * O(n log n) berechnet: Die Punkte werden nach x sortiert und die untere und
+ * obere Kette in je einem Durchlauf aufgebaut. Wird ein einzelner Punkt
+ * verschoben, wird er nur in der Sortierung nachgeschoben und die Ketten in
+ * O(n) neu aufgebaut.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "geometry.h"
+#include "logic.h"
+#include "util.h"
+
+/* ---- Konstanten ---- */
+
+/* Relative Fehlerschranke der Orientierung in double, (3 + 16 eps) * eps */
+#define ORIENT_ERROR_BOUND 3.3306690738754716e-16
+
+/* ---- Funktionen ---- */
+
+/**
+ * Summe zweier doubles samt exaktem Rundungsfehler (a + b = sum + error).
+ * @param a erster Summand
+ * @param b zweiter Summand
+ * @param sum die gerundete Summe (out-param)
+ * @param error der Rundungsfehler (out-param)
+ */
+static void twoSum(double a, double b, double *sum, double *error)
+{
+    double s = a + b;
+    double bVirtual = s - a;
+    double aVirtual = s - bVirtual;
+    *sum = s;
+    *error = (a - aVirtual) + (b - bVirtual);
+}
+
+/**
+ * Berechnet das Vorzeichen der Orientierung exakt. Die Differenzen der
+ * float-Koordinaten sind in double exakt, die Produkte werden per fma in
+ * Wert und Rundungsfehler zerlegt und die vier Teile als Expansion summiert.
+ * @param a erster Punkt
+ * @param b zweiter Punkt
+ * @param c dritter Punkt
+ * @return die Orientierung mit exaktem Vorzeichen
+ */
+static double orient2dExact(const float *a, const float *b, const float *c)
+{
+    double abx = (double)b[LX] - a[LX];
+    double aby = (double)b[LY] - a[LY];
+    double acx = (double)c[LX] - a[LX];
+    double acy = (double)c[LY] - a[LY];
+    double left = abx * acy;
+    double right = aby * acx;
+    double terms[4] = {fma(abx, acy, -left), -fma(aby, acx, -right), left, -right};
+
+    //Expansion aufbauen: jeder Term wird durch alle bisherigen Komponenten gereicht
+    double expansion[4];
+    int length = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        double q = terms[i];
+        for (int j = 0; j < length; j++)
+        {
+            twoSum(q, expansion[j], &q, &expansion[j]);
+        }
+        expansion[length++] = q;
+    }
+    //Die betragsgroesste Komponente (die letzte ungleich 0) bestimmt das Vorzeichen
+    for (int i = length - 1; i >= 0; i--)
+    {
+        if (expansion[i] != 0.0)
+        {
+            return expansion[i];
+        }
+    }
+    return 0.0;
+}
+
+/**
+ * Bestimmt die Orientierung dreier Punkte mit exaktem Vorzeichen.
+ * @param a erster Punkt
+ * @param b zweiter Punkt
+ * @param c dritter Punkt
+ * @return > 0, wenn c links von a->b liegt (gegen den Uhrzeigersinn),
+ *         < 0, wenn rechts, 0, wenn die Punkte auf einer Geraden liegen
+ */
+double orient2d(const float *a, const float *b, const float *c)
+{
+    double left = ((double)b[LX] - a[LX]) * ((double)c[LY] - a[LY]);
+    double right = ((double)b[LY] - a[LY]) * ((double)c[LX] - a[LX]);
+    double det = left - right;
+    if (fabs(det) > ORIENT_ERROR_BOUND * (fabs(left) + fabs(right)))
+    {
+        return det;
+    }
+    return orient2dExact(a, b, c);
+}
+
+/**
+ * Vergleicht zwei Punkte nach x, bei gleichem x nach y, dann nach Index.
+ * @param a erster Punkt
+ * @param b zweiter Punkt
+ * @return < 0, 0 oder > 0 fuer kleiner, gleich oder groesser
+ */
+static int compareHullPoints(const void *a, const void *b)
+{
+    const HullPoint *p = a;
+    const HullPoint *q = b;
+    if (p->x != q->x)
+    {
+        return p->x < q->x ? -1 : 1;
+    }
+    if (p->y != q->y)
+    {
+        return p->y < q->y ? -1 : 1;
+    }
+    //Gleiche Punkte nach Index, damit die Reihenfolge eindeutig ist
+    return p->index - q->index;
+}
+
+/**
+ * Baut die untere und obere Kette aus den sortierten Punkten auf.
+ * @param hull die Huelle
+ */
+static void buildHullChains(ConvexHull *hull)
+{
+    const HullPoint *sorted = hull->sorted;
+    int n = hull->count;
+    //Kette als Indizes in sorted, hoechstens 2n Eintraege
+    int *chain = hull->indices;
+    int k = 0;
+    for (int i = 0; i < n; i++)
+    {
+        while (k >= 2 && orient2d(&sorted[chain[k - 2]].x, &sorted[chain[k - 1]].x, &sorted[i].x) <= 0.0)
+        {
+            k--;
+        }
+        chain[k++] = i;
+    }
+    for (int i = n - 2, lower = k + 1; i >= 0; i--)
+    {
+        while (k >= lower && orient2d(&sorted[chain[k - 2]].x, &sorted[chain[k - 1]].x, &sorted[i].x) <= 0.0)
+        {
+            k--;
+        }
+        chain[k++] = i;
+    }
+    //Der Startpunkt steht am Ende noch einmal
+    hull->length = n > 1 ? k - 1 : n;
+    for (int i = 0; i < hull->length; i++)
+    {
+        chain[i] = sorted[chain[i]].index;
+    }
+}
+
+/**
+ * Berechnet die konvexe Huelle einer Punktmenge. Vorhandener Speicher der
+ * Huelle wird wiederverwendet.
+ * @param hull die Huelle (in/out-param), beim ersten Aufruf mit 0 initialisiert
+ * @param points die Punkte
+ * @param count Anzahl der Punkte
+ */
+void initConvexHull(ConvexHull *hull, const CGPoint2f *points, int count)
+{
+    if (count > hull->count || hull->sorted == NULL)
+    {
+        hull->sorted = reallocArray(hull->sorted, sizeof(HullPoint) * count);
+        hull->position = reallocArray(hull->position, sizeof(int) * count);
+        hull->indices = reallocArray(hull->indices, sizeof(int) * (2 * count + 1));
+    }
+    hull->count = count;
+    for (int i = 0; i < count; i++)
+    {
+        hull->sorted[i] = (HullPoint){points[i][LX], points[i][LY], i};
+    }
+    qsort(hull->sorted, count, sizeof(HullPoint), compareHullPoints);
+    for (int i = 0; i < count; i++)
+    {
+        hull->position[hull->sorted[i].index] = i;
+    }
+    buildHullChains(hull);
+}
+
+/**
+ * Aktualisiert die Huelle, nachdem ein einzelner Punkt verschoben wurde. Der
+ * Punkt wird in der Sortierung nur bis zu seiner neuen Position verschoben.
+ * @param hull die Huelle
+ * @param points die Punkte (mit dem neuen Wert des verschobenen Punktes)
+ * @param moved Index des verschobenen Punktes
+ */
+void updateConvexHull(ConvexHull *hull, const CGPoint2f *points, int moved)
+{
+    HullPoint point = {points[moved][LX], points[moved][LY], moved};
+    int i = hull->position[moved];
+    //Nach vorne bzw. hinten schieben, bis die Sortierung wieder stimmt
+    while (i > 0 && compareHullPoints(&hull->sorted[i - 1], &point) > 0)
+    {
+        hull->sorted[i] = hull->sorted[i - 1];
+        hull->position[hull->sorted[i].index] = i;
+        i--;
+    }
+    while (i < hull->count - 1 && compareHullPoints(&hull->sorted[i + 1], &point) < 0)
+    {
+        hull->sorted[i] = hull->sorted[i + 1];
+        hull->position[hull->sorted[i].index] = i;
+        i++;
+    }
+    hull->sorted[i] = point;
+    hull->position[moved] = i;
+    buildHullChains(hull);
+}
+
+/**
+ * Gibt den Speicher der Huelle frei.
+ * @param hull die Huelle
+ */
+void freeConvexHull(ConvexHull *hull)
+{
+    free(hull->sorted);
+    free(hull->position);
+    free(hull->indices);
+    memset(hull, 0, sizeof(ConvexHull));
+}
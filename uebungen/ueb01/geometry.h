@@ -0,0 +1,24 @@
+#ifndef __GEOMETRY_H__
+#define __GEOMETRY_H__
+/**
+ * @file
+ * Geometrie-Modul.
+ * Das Modul enthaelt robuste geometrische Praedikate und die konvexe Huelle
+ * einer Punktmenge in der Ebene.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/* ---- Funktionen ---- */
+
+double orient2d(const float *a, const float *b, const float *c);
+
+void initConvexHull(ConvexHull *hull, const CGPoint2f *points, int count);
+
+void updateConvexHull(ConvexHull *hull, const CGPoint2f *points, int moved);
+
+void freeConvexHull(ConvexHull *hull);
+
+#endif
@@ -338,6 +338,9 @@ static void
 cbDisplay(void)
 {
 
+    /* Fertig geladene Texturen hochladen */
+    updateTextures();
+
     /* Buffer zuruecksetzen */
     glClear(GL_COLOR_BUFFER_BIT);
 
@@ -444,6 +447,8 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
             case 'Q':
             case ESC:
                 freeArraysScene();
+                freeArraysLogic();
+                freeTextures();
                 exit(0);
                 break;
             case 'n':
@@ -0,0 +1,218 @@
+/**
+ * @file
+ * Level-Modul.
+ * Das Modul liest die Level aus einer Textdatei. Jede Zeile enthaelt ein
+ * Schluesselwort und dessen Werte, Zeilen mit # und leere Zeilen werden
+ * uebersprungen:
+ *
+ *   level                  beginnt ein neues Level
+ *   point x y              Kontrollpunkt (mindestens LOWEST_AMOUNT_CONTROL_POINTS je Level)
+ *   star x y               einzusammelnder Stern
+ *   cloud x y              Wolke, deren Beruehrung das Level beendet
+ *   obstacle x y radius    kreisfoermiges Hindernis, wie eine Wolke
+ *
+ * Alle Arrays wachsen dynamisch, die Anzahl der Level und Objekte ist
+ * nicht begrenzt.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "level.h"
+#include "logic.h"
+#include "util.h"
+
+/* ---- Globale Daten ---- */
+
+/* Die geladenen Level */
+Level *g_levels = NULL;
+int g_levelCount = 0;
+int g_levelCapacity = 0;
+
+/* Kapazitaeten der Arrays des zuletzt begonnenen Levels */
+int g_controlPointCapacity = 0;
+int g_starCapacity = 0;
+int g_cloudCapacity = 0;
+int g_obstacleCapacity = 0;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Sorgt dafuer, dass ein Array mindestens ein weiteres Element aufnehmen
+ * kann. Die Kapazitaet wird dabei verdoppelt.
+ * @param array das Array
+ * @param count Anzahl der Elemente im Array
+ * @param capacity Kapazitaet des Arrays (in/out-param)
+ * @param elementSize Groesse eines Elements in Byte
+ * @return das (ggf. neu reservierte) Array
+ */
+static void *growArray(void *array, int count, int *capacity, size_t elementSize)
+{
+    if (count < *capacity)
+    {
+        return array;
+    }
+    *capacity = *capacity > 0 ? *capacity * 2 : 8;
+    return reallocArray(array, elementSize * *capacity);
+}
+
+/**
+ * Beginnt ein neues, leeres Level.
+ */
+static void beginLevel(void)
+{
+    g_levels = growArray(g_levels, g_levelCount, &g_levelCapacity, sizeof(Level));
+    memset(&g_levels[g_levelCount], 0, sizeof(Level));
+    g_levelCount++;
+    g_controlPointCapacity = 0;
+    g_starCapacity = 0;
+    g_cloudCapacity = 0;
+    g_obstacleCapacity = 0;
+}
+
+/**
+ * Wertet eine Zeile der Leveldatei aus.
+ * @param line die Zeile
+ * @return GL_TRUE, wenn die Zeile gueltig ist
+ */
+static GLboolean parseLevelLine(const char *line)
+{
+    char keyword[LEVEL_LINE_LENGTH];
+    float x, y, radius;
+    int offset = 0;
+    if (sscanf(line, "%s %n", keyword, &offset) != 1 || keyword[0] == '#')
+    {
+        //Leere Zeile oder Kommentar
+        return GL_TRUE;
+    }
+    if (strcmp(keyword, "level") == 0)
+    {
+        beginLevel();
+        return GL_TRUE;
+    }
+    if (g_levelCount == 0)
+    {
+        return GL_FALSE;
+    }
+
+    Level *level = &g_levels[g_levelCount - 1];
+    line += offset;
+    if (strcmp(keyword, "point") == 0 && sscanf(line, "%f %f", &x, &y) == 2)
+    {
+        level->controlPoints = growArray(level->controlPoints, level->controlPointCount, &g_controlPointCapacity, sizeof(CGPoint2f));
+        level->controlPoints[level->controlPointCount][LX] = x;
+        level->controlPoints[level->controlPointCount][LY] = y;
+        level->controlPointCount++;
+    }
+    else if (strcmp(keyword, "star") == 0 && sscanf(line, "%f %f", &x, &y) == 2)
+    {
+        level->stars = growArray(level->stars, level->starCount, &g_starCapacity, sizeof(Star));
+        level->stars[level->starCount++] = (Star){x, y, GL_TRUE};
+    }
+    else if (strcmp(keyword, "cloud") == 0 && sscanf(line, "%f %f", &x, &y) == 2)
+    {
+        level->clouds = growArray(level->clouds, level->cloudCount, &g_cloudCapacity, sizeof(Cloud));
+        level->clouds[level->cloudCount++] = (Cloud){x, y, GL_TRUE};
+    }
+    else if (strcmp(keyword, "obstacle") == 0 && sscanf(line, "%f %f %f", &x, &y, &radius) == 3 && radius > 0.0f)
+    {
+        level->obstacles = growArray(level->obstacles, level->obstacleCount, &g_obstacleCapacity, sizeof(Obstacle));
+        level->obstacles[level->obstacleCount++] = (Obstacle){x, y, radius};
+    }
+    else
+    {
+        return GL_FALSE;
+    }
+    return GL_TRUE;
+}
+
+/**
+ * Liest die Level aus einer Datei. Bereits geladene Level werden verworfen.
+ * @param path der Dateiname
+ * @return GL_TRUE, wenn mindestens ein gueltiges Level gelesen wurde
+ */
+GLboolean loadLevels(const char *path)
+{
+    freeLevels();
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        printf("Leveldatei %s konnte nicht geoeffnet werden.\n", path);
+        return GL_FALSE;
+    }
+
+    char line[LEVEL_LINE_LENGTH];
+    int lineNumber = 0;
+    GLboolean success = GL_TRUE;
+    while (success && fgets(line, sizeof(line), file) != NULL)
+    {
+        lineNumber++;
+        success = parseLevelLine(line);
+        if (!success)
+        {
+            printf("Fehler in %s, Zeile %d: %s", path, lineNumber, line);
+        }
+    }
+    fclose(file);
+
+    for (int i = 0; success && i < g_levelCount; i++)
+    {
+        if (g_levels[i].controlPointCount < LOWEST_AMOUNT_CONTROL_POINTS)
+        {
+            printf("Level %d in %s hat weniger als %d Kontrollpunkte.\n", i + 1, path, LOWEST_AMOUNT_CONTROL_POINTS);
+            success = GL_FALSE;
+        }
+    }
+    if (success && g_levelCount == 0)
+    {
+        printf("Leveldatei %s enthaelt kein Level.\n", path);
+        success = GL_FALSE;
+    }
+    if (!success)
+    {
+        freeLevels();
+    }
+    return success;
+}
+
+/**
+ * Gibt den Speicher der geladenen Level frei.
+ */
+void freeLevels(void)
+{
+    for (int i = 0; i < g_levelCount; i++)
+    {
+        free(g_levels[i].controlPoints);
+        free(g_levels[i].stars);
+        free(g_levels[i].clouds);
+        free(g_levels[i].obstacles);
+    }
+    free(g_levels);
+    g_levels = NULL;
+    g_levelCount = 0;
+    g_levelCapacity = 0;
+}
+
+/**
+ * Liefert die Anzahl der geladenen Level.
+ * @return die Anzahl der Level
+ */
+int getLevelCount(void)
+{
+    return g_levelCount;
+}
+
+/**
+ * Liefert das Level an dem uebergebenen Index.
+ * @param index der Index des Levels
+ * @return das Level
+ */
+const Level *getLevel(int index)
+{
+    return &g_levels[index];
+}
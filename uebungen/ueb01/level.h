@@ -0,0 +1,31 @@
+#ifndef __LEVEL_H__
+#define __LEVEL_H__
+/**
+ * @file
+ * Level-Modul.
+ * Das Modul liest die Level (Kontrollpunkte, Sterne, Wolken und Hindernisse)
+ * aus einer Textdatei und haelt sie fuer die Programmlogik vor.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/* ---- Konstanten ---- */
+
+/* Standard-Leveldatei */
+#define LEVEL_FILE "levels.txt"
+/* Hoechstlaenge einer Zeile in der Leveldatei */
+#define LEVEL_LINE_LENGTH 256
+
+/* ---- Funktionen ---- */
+
+GLboolean loadLevels(const char *path);
+
+void freeLevels(void);
+
+int getLevelCount(void);
+
+const Level *getLevel(int index);
+
+#endif
@@ -22,6 +22,12 @@
 #include "debugGL.h"
 #include "scene.h"
 #include "io.h"
+#include "curve.h"
+#include "level.h"
+#include "collisionGrid.h"
+#include "arcLength.h"
+#include "geometry.h"
+#include "util.h"
 
 /* ---- Globale Daten ---- */
 GLboolean g_isSpline = GL_TRUE;
@@ -30,52 +36,31 @@ int g_currentLevel = 0;
 
 int g_hitPointIdx = 0;
 
-int g_currentSplineSubPart = 0;
-
-/*Interpolationsmatrix fuer Spline*/
-float g_splineInterpolation[16] = {-(1.0f / 6.0f), (1.0f / 2.0f), -(1.0f / 2.0f), (1.0f / 6.0f),
-                                   (1.0f / 2.0f), -1.0f, (1.0f / 2.0f), 0,
-                                   -(1.0f / 2.0f), 0.0f, (1.0f / 2.0f), 0,
-                                   (1.0f / 6.0f), (2.0f / 3.0f), (1.0f / 6.0f), 0};
-/*Interpolationsmatrix fuer Bezier*/
-float g_bezierInterpolation[16] = {-1.0f, 3.0f, -3.0f, 1.0f,
-                                   3.0f, -6.0f, 3.0f, 0.0f,
-                                   -3.0f, 3.0f, 0.0f, 0.0f,
-                                   1.0f, 0.0f, 0.0f, 0.0f};
-/*Monomvektor*/
-float g_monomVector[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-/*Monomvektor mit Interpolationsmatrix multipliziert*/
-float g_multipliedMonomWithInterpolation[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-//Ausgangslevel
-/* ------------------------------------------------------------------------------------- Level_1 --------------------------------------- */
-CGPoint2f g_initLevel[LEVEL_AMOUNT][6] = {{{-0.8f, 0.0f}, {-0.4f, -0.25f}, {0.4f, -0.25f}, {0.8f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}},
-                                          /* --------------------------------------------- Level_2 --------------------------------------- */
-                                          {{-0.8f, 0.0f}, {-0.4f, -0.25f}, {0.0f, -0.30f}, {0.4f, -0.25f}, {0.8f, 0.0f}, {0.0f, 0.0f}},
-                                          /* --------------------------------------------- Level_3 --------------------------------------- */
-                                          {{-0.8f, 0.0f}, {-0.4f, -0.25f}, {-0.2f, -0.30f}, {0.2f, -0.30f}, {0.4f, -0.25f}, {0.8f, 0.0f}}};
-/*Anzahl der Sterne nach Level indiziert*/
-int g_starCount[3] = {1, 3, 2};
-/*Initialisierungsdaten der Sterne nach Level*/
-Star g_initStars[3][3] = {{{0.0f, 0.75f, GL_TRUE}, {0.0f, 0.0f, GL_FALSE}, {0.0f, 0.0f, GL_FALSE}},
-                          {{-0.4f, -0.45f, GL_TRUE}, {0.4f, -0.45f, GL_TRUE}, {0.0f, 0.45f, GL_TRUE}},
-                          {{-0.4f, 0.5f, GL_TRUE}, {0.4f, -0.5f, GL_TRUE}, {0.0f, 0.0f, GL_FALSE}}};
 /*Sterne im aktuellen Level*/
-Star g_stars[3] = {{0}};
-
-/*Die Wolke in LvL 3*/
-Cloud g_cloud = {0.0, 0.5f, GL_FALSE};
+Star *g_stars = NULL;
+int g_starCount = 0;
 
 /*Die Kontrollpunkte im aktuellen Level*/
-CGPoint2f g_controlPoints[6] = {0};
+CGPoint2f *g_controlPoints = NULL;
+
+/*Kollisionsgitter ueber Sternen, Wolken und Hindernissen des aktuellen Levels*/
+CollisionGrid g_collisionGrid;
 
-/* Die Kontrollpunkte fuer die konvexe Huelle */
-CGPoint2f *g_convexHull = NULL;
+/*Die Kurve ueber den Kontrollpunkten im aktuellen Level*/
+Curve g_curve = {NULL, 0, NULL};
 
-int g_convexHullLength;
+/*Bogenlaenge der Kurve, fuer eine gleichmaessige Geschwindigkeit des Fliegers*/
+ArcLengthTable g_arcLengthTable;
+
+/* Die konvexe Huelle der Kontrollpunkte */
+ConvexHull g_convexHull;
 
 /*Die Position des Fiegers in T [0-1] */
 float g_planePosition = 0.0f;
 
+/*Die Position des Fliegers als zurueckgelegte Strecke entlang der Kurve*/
+float g_planeDistance = 0.0f;
+
 /*Fliegergeschwindigkeit*/
 float g_planeVelocity = INIT_VELOCITY;
 
@@ -124,9 +109,12 @@ static void movePlane(float interval)
         // 85 - 95 und -85 - -95 keine Geschwindigkeitsaenderung
 
         // Wenn Plane am Ende is curseFinished -> True
-        if (g_planePosition + g_planeVelocity < 1.0f - DELTA)
+        // Der Flieger bewegt sich entlang der Bogenlaenge, damit die Geschwindigkeit
+        // nicht vom Abstand der Kontrollpunkte abhaengt
+        if (g_planeDistance + g_planeVelocity * PLANE_DISTANCE_PER_T < getArcLength(&g_arcLengthTable) - DELTA)
         {
-            g_planePosition += g_planeVelocity * interval * PLANE_SPEED;
+            g_planeDistance += g_planeVelocity * interval * PLANE_SPEED * PLANE_DISTANCE_PER_T;
+            g_planePosition = getArcLengthParameter(&g_arcLengthTable, g_planeDistance);
         }
         else
         {
@@ -143,36 +131,42 @@ static void handlePlaneCollision(void)
 {
     GLfloat n[3] = {0};
     calcPlaneNormal(n);
-    float currentX = calculateX(g_planePosition) + n[LX];
-    float currentY = calculateY(g_planePosition) + n[LY];
-    int starCount = g_starCount[g_currentLevel];
-    for (int i = 0; i < starCount; i++)
+    CGPoint2f plane;
+    evaluateCurve(&g_curve, g_planePosition, plane);
+    float currentX = plane[LX] + n[LX];
+    float currentY = plane[LY] + n[LY];
+    //Nur die Objekte der Zelle des Fliegers pruefen
+    const CollisionObject *objects = NULL;
+    int objectCount = queryCollisionGrid(&g_collisionGrid, currentX, currentY, &objects);
+    GLboolean hitHazard = GL_FALSE;
+    for (int i = 0; i < objectCount && !hitHazard; i++)
     {
-        Star currentStar = {g_stars[i].x, g_stars[i].y, g_stars[i].isVisible};
-        if (currentStar.isVisible)
+        const CollisionObject *object = &objects[i];
+        float distanceToPlaneX = object->x - currentX;
+        float distanceToPlaneY = object->y - currentY;
+        float distanceToPlane = sqrtf(distanceToPlaneX * distanceToPlaneX + distanceToPlaneY * distanceToPlaneY);
+        if (distanceToPlane <= object->radius + (PLANE_DIAMETER / 2.0f))
         {
-            float distanceToPlaneX = currentStar.x - currentX;
-            float distanceToPlaneY = currentStar.y - currentY;
-
-            float distanceToPlane = sqrt(pow(distanceToPlaneX, 2) + pow(distanceToPlaneY, 2));
-            if (distanceToPlane <= (STAR_DIAMETER / 2.0f) + (PLANE_DIAMETER / 2.0f))
+            if (object->type == collisionStar)
+            {
+                if (g_stars[object->index].isVisible)
+                {
+                    g_stars[object->index].isVisible = GL_FALSE;
+                    g_collectedStars++;
+                }
+            }
+            //Wolken und Hindernisse beenden das Level
+            else
             {
-                g_stars[i].isVisible = GL_FALSE;
-                g_collectedStars++;
+                hitHazard = GL_TRUE;
             }
         }
     }
-    if (g_cloud.isVisible && g_currentLevel == 2)
+    if (hitHazard)
     {
-        float distanceToPlaneX = g_cloud.x - currentX;
-        float distanceToPlaneY = g_cloud.y - currentY;
-        float distanceToPlane = sqrt(pow(distanceToPlaneX, 2) + pow(distanceToPlaneY, 2));
-        if (distanceToPlane <= (CLOUD_DIAMETER / 2.0f) + (PLANE_DIAMETER / 2.0f))
-        {
-            g_gameInProgress = GL_FALSE;
+        g_gameInProgress = GL_FALSE;
 
-            setCurrentLevel(g_currentLevel);
-        }
+        setCurrentLevel(g_currentLevel);
     }
 }
 
@@ -181,7 +175,7 @@ static void handlePlaneCollision(void)
  */
 static GLboolean gameWon(void)
 {
-    return g_collectedStars == g_starCount[g_currentLevel] && g_curseFinished;
+    return g_collectedStars == g_starCount && g_curseFinished;
 }
 
 /**
@@ -189,7 +183,7 @@ static GLboolean gameWon(void)
  */
 static GLboolean gameLost(void)
 {
-    return g_collectedStars != g_starCount[g_currentLevel] && g_curseFinished;
+    return g_collectedStars != g_starCount && g_curseFinished;
 }
 
 /**
@@ -208,7 +202,7 @@ void handleLogicCalculations(double interval)
         }
         if (gameWon())
         {
-            setCurrentLevel((g_currentLevel + 1) % 3);
+            setCurrentLevel((g_currentLevel + 1) % getLevelCount());
         }
         if (gameLost())
         {
@@ -217,16 +211,30 @@ void handleLogicCalculations(double interval)
     }
 }
 
+/**
+ * Berechnet einen Punkt der Kurve fuer die Bogenlaengentabelle.
+ * @param T die Zeit [0-1]
+ * @param point der Punkt (out-param)
+ * @param data die Kurve
+ */
+static void evaluateArcLengthCurve(float T, float *point, void *data)
+{
+    evaluateCurve(data, T, point);
+}
+
 /**
  * Initialisiert die Kontrollpunkte des aktuellen Levels
  */
 static void initControlPoints(void)
 {
-    for (int i = 0; i <= LOWEST_AMOUNT_CONTROL_POINTS + g_currentLevel; i++)
-    {
-        g_controlPoints[i][LX] = g_initLevel[g_currentLevel][i][LX];
-        g_controlPoints[i][LY] = g_initLevel[g_currentLevel][i][LY];
-    }
+    const Level *level = getLevel(g_currentLevel);
+    g_controlPoints = reallocArray(g_controlPoints, sizeof(CGPoint2f) * level->controlPointCount);
+    memcpy(g_controlPoints, level->controlPoints, sizeof(CGPoint2f) * level->controlPointCount);
+    g_curve.points = g_controlPoints;
+    g_curve.pointCount = level->controlPointCount;
+    g_curve.basis = getCurveBasis(g_isSpline);
+    initArcLengthTable(&g_arcLengthTable, evaluateArcLengthCurve, &g_curve, 2, getCurveSegmentCount(&g_curve));
+    initConvexHull(&g_convexHull, g_controlPoints, g_curve.pointCount);
 }
 
 /**
@@ -234,25 +242,36 @@ static void initControlPoints(void)
  */
 static void initStars(void)
 {
-    for (int i = 0; i < g_starCount[g_currentLevel]; i++)
-    {
-        g_stars[i] = g_initStars[g_currentLevel][i];
-    }
+    const Level *level = getLevel(g_currentLevel);
+    g_starCount = level->starCount;
+    g_stars = reallocArray(g_stars, sizeof(Star) * g_starCount);
+    memcpy(g_stars, level->stars, sizeof(Star) * g_starCount);
 }
 
 /**
- * Initialisiert die Sichtbarkeit der Wolke
+ * Baut das Kollisionsgitter ueber Sternen, Wolken und Hindernissen des
+ * aktuellen Levels auf. Der Rand um jedes Objekt ist der Radius des Fliegers.
  */
-static void initCloud(void)
+static void initCollisionGrid(void)
 {
-    if (g_currentLevel != 2)
+    const Level *level = getLevel(g_currentLevel);
+    int count = level->starCount + level->cloudCount + level->obstacleCount;
+    CollisionObject *objects = reallocArray(NULL, sizeof(CollisionObject) * count);
+    int k = 0;
+    for (int i = 0; i < level->starCount; i++)
     {
-        g_cloud.isVisible = GL_FALSE;
+        objects[k++] = (CollisionObject){level->stars[i].x, level->stars[i].y, STAR_DIAMETER / 2.0f, collisionStar, i};
     }
-    else
+    for (int i = 0; i < level->cloudCount; i++)
     {
-        g_cloud.isVisible = GL_TRUE;
+        objects[k++] = (CollisionObject){level->clouds[i].x, level->clouds[i].y, CLOUD_DIAMETER / 2.0f, collisionCloud, i};
     }
+    for (int i = 0; i < level->obstacleCount; i++)
+    {
+        objects[k++] = (CollisionObject){level->obstacles[i].x, level->obstacles[i].y, level->obstacles[i].radius, collisionObstacle, i};
+    }
+    buildCollisionGrid(&g_collisionGrid, objects, count, PLANE_DIAMETER / 2.0f);
+    free(objects);
 }
 
 /**
@@ -261,6 +280,7 @@ static void initCloud(void)
 static void initPlanePosition(void)
 {
     g_planePosition = 0.0f;
+    g_planeDistance = 0.0f;
     g_planeIsMoving = GL_FALSE;
     g_planeVelocity = INIT_VELOCITY;
 }
@@ -272,6 +292,7 @@ static void initPlanePosition(void)
 void updatePlanePosition(float T)
 {
     g_planePosition = T;
+    g_planeDistance = getArcLengthAtParameter(&g_arcLengthTable, T);
 }
 
 /**
@@ -282,24 +303,16 @@ void initLogic(void)
     setCurrentLevel(0);
 }
 
-/**
- * Berechnet den Monomvektor fuer ein gegebenes t
- * @param t klein t fuer den Monomvektor
- */
-static void setg_monomVector(float t)
-{
-    g_monomVector[0] = powf(t, 3.0f);
-    g_monomVector[1] = powf(t, 2.0f);
-    g_monomVector[2] = t;
-    g_monomVector[3] = 1.0f;
-}
-
 /**
  * Setzt das Aktuelle Level und initialisiert neu
  * @param numCurrLevel der Index des zu setzenden Levels
  */
 void setCurrentLevel(int numCurrLevel)
 {
+    if (numCurrLevel < 0 || numCurrLevel >= getLevelCount())
+    {
+        return;
+    }
     g_currentLevel = numCurrLevel;
     g_gameInProgress = GL_TRUE;
     g_curseFinished = GL_FALSE;
@@ -307,110 +320,27 @@ void setCurrentLevel(int numCurrLevel)
     initControlPoints();
     initPlanePosition();
     initStars();
-    initCloud();
+    initCollisionGrid();
     updateVertexArray(GL_TRUE);
 }
 
 /**
- * Multipliziert den Monomvektor mit der aktuell gesetzten Interpolationsmatrix
- */
-static void multiplyTWithM(void)
-{
-    int count = 0;
-    for (int i = 0; i < 4; i++)
-    {
-        g_multipliedMonomWithInterpolation[i] = 0.0f;
-        for (int j = 0; j < 16; j = j + 4)
-        {
-            if (g_isSpline)
-            {
-                g_multipliedMonomWithInterpolation[i] += g_monomVector[count % 4] * g_splineInterpolation[j + i];
-            }
-            else
-            {
-                g_multipliedMonomWithInterpolation[i] += g_monomVector[count % 4] * g_bezierInterpolation[j + i];
-            }
-            count++;
-        }
-    }
-}
-
-/**
- * Berechnet die X oder Y Komponente der aktuellen Kurve
- * @param isX ob die X Komponente berechnet werden soll
- * @return den jew. X oder Y Wert.
- */
-static float calcInterpolatedValue(GLboolean isX)
-{
-    int xOrYIndice = 0;
-    float ret = 0.0f;
-    if (!isX)
-    {
-        xOrYIndice = 1;
-    }
-    //i je nachdem in welchem splineSubpart wir gerade berechnen z.B. 0..3 oder 1..4
-    for (int i = g_currentSplineSubPart; i < g_currentSplineSubPart + 4; i++)
-    {
-        //i - g_currentSplineSubPart um immer von 0 bis 3
-        ret += g_controlPoints[i][xOrYIndice] * g_multipliedMonomWithInterpolation[i - g_currentSplineSubPart];
-    }
-    return ret;
-}
-
-/**
- * Konvertiert T zu t. Setzt dabei den aktuellen Teilbereich des Splines.
- * @param T Gross T der zu konvertieren ist
- * @return klein t
- */
-static float convertTTot(float T)
-{
-    float splineSubPartWidth = 1.0f / (g_currentLevel + 1.0f);
-    int splineSubPartCounter = 0;
-    float t = 0.0f;
-
-    while (t + splineSubPartWidth < T - DELTA)
-    {
-        t += splineSubPartWidth;
-        splineSubPartCounter++;
-    }
-    g_currentSplineSubPart = splineSubPartCounter;
-    return (T - t) / splineSubPartWidth;
-}
-
-/**
- * Berechnet die X Komponente fuer ein ubergebenes groß T
- * @param T die Zeit [0-1]
- * @return die X Komponente
- */
-float calculateX(float T)
-{
-    float t = convertTTot(T);
-    setg_monomVector(t);
-    multiplyTWithM();
-    return calcInterpolatedValue(GL_TRUE);
-}
-
-/**
- * Berechnet die Y Komponente fuer ein ubergebenes groß T
+ * Berechnet den Punkt der aktuellen Kurve fuer ein uebergebenes gross T
  * @param T die Zeit [0-1]
- * @return die Y Komponente
+ * @param point der Punkt der Kurve (out-param)
  */
-float calculateY(float T)
+void calculateCurvePoint(float T, CGPoint2f point)
 {
-    float t = convertTTot(T);
-    setg_monomVector(t);
-    multiplyTWithM();
-    return calcInterpolatedValue(GL_FALSE);
+    evaluateCurve(&g_curve, T, point);
 }
 
 /**
- * Hilfsfunktion um von Radian zu Grad zu konvertieren
- * @param rad Radian
- * @return Grad
+ * Liefert die Kurve ueber den Kontrollpunkten des aktuellen Levels
+ * @return die Kurve
  */
-float radToDegree(float rad)
+const Curve *getCurve(void)
 {
-    return rad * 180.0f / M_PI;
+    return &g_curve;
 }
 
 /**
@@ -428,6 +358,9 @@ int getg_currentLevel(void)
 void toggleSpline(void)
 {
     g_isSpline = !g_isSpline;
+    g_curve.basis = getCurveBasis(g_isSpline);
+    updateArcLengthSegments(&g_arcLengthTable, 0, getCurveSegmentCount(&g_curve) - 1);
+    g_planePosition = getArcLengthParameter(&g_arcLengthTable, g_planeDistance);
 }
 
 /**
@@ -449,22 +382,23 @@ float getControlpointY(int index)
 {
     return g_controlPoints[index][CY];
 }
+
 /**
- * Liefert die X Position des Fliegers
- * @return die X Position
+ * Liefert die Anzahl der Kontrollpunkte im aktuellen Level
+ * @return die Anzahl der Kontrollpunkte
  */
-float getPlaneX(void)
+int getControlPointCount(void)
 {
-    return calculateX(g_planePosition);
+    return g_curve.pointCount;
 }
 
 /**
- * Liefert die Y Position des Fliegers
- * @return die Y Position
+ * Liefert die Position des Fliegers
+ * @param position die Position (out-param)
  */
-float getPlaneY(void)
+void getPlanePosition(CGPoint2f position)
 {
-    return calculateY(g_planePosition);
+    evaluateCurve(&g_curve, g_planePosition, position);
 }
 
 /**
@@ -485,10 +419,10 @@ void checkCircleHit(float x, float y)
 {
     g_hitPointIdx = 0;
     //Nicht beim Ersten
-    for (int i = 1; i < (g_currentLevel + LOWEST_AMOUNT_CONTROL_POINTS) && g_hitPointIdx == 0; i++)
+    for (int i = 1; i < g_curve.pointCount && g_hitPointIdx == 0; i++)
     {
         //Nicht beim Letzen
-        if (i < g_currentLevel + LOWEST_AMOUNT_CONTROL_POINTS - 1)
+        if (i < g_curve.pointCount - 1)
         {
             float d = sqrtf(powf(x - g_controlPoints[i][LX], 2) + pow(y - g_controlPoints[i][LY], 2));
             if (d <= CONTROL_POINT_RADIUS + DELTA)
@@ -512,6 +446,10 @@ void moveObject(float hitX, float hitY)
         hitY = hitY < -1.0f ? -1.0f : hitY > 1.0f ? 1.0f : hitY;
         g_controlPoints[g_hitPointIdx][LX] = hitX;
         g_controlPoints[g_hitPointIdx][LY] = hitY;
+        //Nur die Teilstuecke, die den Kontrollpunkt nutzen, neu vermessen
+        updateArcLengthSegments(&g_arcLengthTable, g_hitPointIdx - (CURVE_SEGMENT_POINTS - 1), g_hitPointIdx);
+        updateConvexHull(&g_convexHull, g_controlPoints, g_hitPointIdx);
+        g_planePosition = getArcLengthParameter(&g_arcLengthTable, g_planeDistance);
         updateVertexArray(GL_FALSE);
     }
 }
@@ -530,7 +468,7 @@ void startPlane(void)
  */
 int getStarCount(void)
 {
-    return g_starCount[g_currentLevel];
+    return g_starCount;
 }
 
 /**
@@ -544,168 +482,41 @@ Star getStar(int i)
 }
 
 /**
- * Liefert die Wolke in Level 3
- * @return Die Wolke
+ * Liefert die Anzahl der Wolken im aktuellen Level
+ * @return die Anzahl der Wolken
  */
-Cloud getCloud(void)
+int getCloudCount(void)
 {
-    return g_cloud;
+    return getLevel(g_currentLevel)->cloudCount;
 }
 
 /**
- * Normalisiert den ubergebenen Vektor auf laege 1
- * @param v Der zu normalisierende Vektor
+ * Liefert die Wolke an dem uebergebenen Index
+ * @param i der Index
+ * @return Die Wolke
  */
-static void normalizeVector(float *v)
+Cloud getCloud(int i)
 {
-    float length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
-    v[0] /= length;
-    v[1] /= length;
-    v[2] /= length;
+    return getLevel(g_currentLevel)->clouds[i];
 }
 
 /**
- * Berechnet den Winkel von einem Vektor zwischen zwei Punkten zu der x-Achse.
- * @param points Punkte-Array aus dem die richtigen Punkte gelesen werden
- * @param i index s Ziel-Punktes
- * @param lastX x-Position des Startpunktes
- * @param lastY y-Position des Startpunktes
- * @param currentDistance Laenge des vektors
- * @param x x-Achse
+ * Liefert die Anzahl der Hindernisse im aktuellen Level
+ * @return die Anzahl der Hindernisse
  */
-float calculateAlpha(CGPoint2f *points, int i, float lastX, float lastY, float *currentDistance, float *x)
+int getObstacleCount(void)
 {
-
-    /* -----------Werte holen und Winkel berechnen---------------- */
-    float currentY = points[i][LY];
-    float currentX = points[i][LX];
-    //Vektor vom zuletzt berechnetem Punkt (Startpunkt) zu aktuell betrachtetem Punkt
-    float v[3] = {currentX - lastX, currentY - lastY, 0.0f};
-    *currentDistance = calcVectorLength(v);
-    normalizeVector(v);
-    float alpha = acosf(calcDotProduct(v, x));
-    /* ------------------------------------------------------------ */
-    alpha = radToDegree(alpha);
-    //Formel, wenn y vom neuen kleiner als y vom vorherigen
-    if (currentY < lastY - DELTA)
-    {
-        alpha = 360.0f - alpha;
-    }
-    return alpha;
+    return getLevel(g_currentLevel)->obstacleCount;
 }
 
 /**
- * Berechnet die konvexe Huelle der Kontrollpunkte
+ * Liefert das Hindernis an dem uebergebenen Index
+ * @param i der Index
+ * @return das Hindernis
  */
-void calcConvexHull(void)
+Obstacle getObstacle(int i)
 {
-    int controlPointsAmount = g_currentLevel + LOWEST_AMOUNT_CONTROL_POINTS;
-    //Beide Mengen
-    CGPoint2f calculated[controlPointsAmount];
-    CGPoint2f notCalculated[controlPointsAmount];
-    //Werte der Kontrollpunkte kopieren. NotCalculated mit allen Kontrollpunkten
-    for (int i = 0; i < controlPointsAmount; i++)
-    {
-        notCalculated[i][LX] = g_controlPoints[i][LX];
-        notCalculated[i][LY] = g_controlPoints[i][LY];
-    }
-    //Etwas was hoher als 1 ist
-    float lowestY = 1.5f;
-    float lowestX = 1.5f;
-    //Index fuer das Calculated Array -> zeigt immer auf den zuletzt hinzugefuegten Punkt
-    int calculatedPoints = 0;
-    //Index in cotCalculates des gefundenen Startpunktes berechnen (untester-links)
-    int calculatedPointIdx = 0;
-    //Alle Punkte durchgehen und den Startpunkt berechnen (unten links)
-    for (int i = 0; i < controlPointsAmount; i++)
-    {
-        float currentY = notCalculated[i][LY];
-        float currentX = notCalculated[i][LX];
-
-        if (currentY < lowestY - DELTA)
-        {
-            lowestY = currentY;
-            lowestX = currentX;
-            calculatedPointIdx = i;
-        }
-        //Wenn Y gleich nimm den Punkt mit niedrigeren X Wert
-        else if (fabsf(currentY - lowestY) < DELTA && currentX < lowestX - DELTA)
-        {
-            lowestX = currentX;
-            calculatedPointIdx = i;
-        }
-    }
-    //Den Startpunkt in das Calculated Array schreiben
-    calculated[calculatedPoints][LX] = notCalculated[calculatedPointIdx][LX];
-    calculated[calculatedPoints][LY] = notCalculated[calculatedPointIdx][LY];
-    calculatedPoints++;
-
-    //Iteration um den Punkt mit dem kleinsten Winkel zum letzten Startpunkt zu finden
-    //Wenn Winkel gleich dann groesster Abstand
-    //UND Winkel vom zugefuegten Punkt muss groesser sein als der Winkel vom zuletzt zugefuegten Punkt zu dem davor
-    GLboolean run = GL_TRUE;
-    //Winkel zwischen des zuletzt berechneten Punkt und x-Achse
-    float lastAlpha = 0.0f;
-    while (run && (calculatedPoints < controlPointsAmount))
-    {
-        //Groesser 360
-        float lowestAlpha = 361.0f;
-        float biggestDistance = -1.0f;
-        float lastY = calculated[calculatedPoints - 1][LY];
-        float lastX = calculated[calculatedPoints - 1][LX];
-        float x[3] = {1.0f, 0.0f, 0.0f};
-        //Alle unberechneten Punkte durchgehen und den neuen Startpunkt berechnen
-        for (int i = 0; i < controlPointsAmount; i++)
-        {
-            float currentDistance;
-            float alpha = calculateAlpha(notCalculated, i, lastX, lastY, &currentDistance, x);
-            if (alpha < lowestAlpha - DELTA && alpha >= lastAlpha)
-            {
-                lowestAlpha = alpha;
-                biggestDistance = currentDistance;
-                calculatedPointIdx = i;
-            }
-            else if (fabs(alpha - lowestAlpha) < DELTA && currentDistance > biggestDistance + DELTA && alpha >= lastAlpha)
-            {
-                biggestDistance = currentDistance;
-                calculatedPointIdx = i;
-            }
-        }
-        float distanceStartAndCurrent;
-        float alpha = calculateAlpha(notCalculated, calculatedPointIdx, lastX, lastY, &distanceStartAndCurrent, x);
-        lastAlpha = alpha;
-
-        if (fabsf(notCalculated[calculatedPointIdx][LX] - calculated[0][LX]) < DELTA && fabsf(notCalculated[calculatedPointIdx][LY] - calculated[0][LY]) < DELTA)
-        {
-            //Abbruch wenn alle Punke betrachtet und wieder beim Ausgangspunkt
-            run = GL_FALSE;
-        }
-        //Noch nicht am ende
-        else
-        {
-            //Neuen Startpunkt in das Calculated Array schreiben
-            calculated[calculatedPoints][LX] = notCalculated[calculatedPointIdx][LX];
-            calculated[calculatedPoints][LY] = notCalculated[calculatedPointIdx][LY];
-            calculatedPoints++;
-        }
-    }
-
-    //Werte in das ConvexHull Array kopieren
-    g_convexHull = realloc(g_convexHull, sizeof(CGPoint2f) * calculatedPoints);
-    if (g_convexHull != NULL)
-    {
-        for (int i = 0; i < calculatedPoints; i++)
-        {
-            g_convexHull[i][LX] = calculated[i][LX];
-            g_convexHull[i][LY] = calculated[i][LY];
-        }
-        g_convexHullLength = calculatedPoints;
-    }
-    else
-    {
-        printf("Kein virtueller RAM mehr verfügbar ...\n");
-        exit(1);
-    }
+    return getLevel(g_currentLevel)->obstacles[i];
 }
 
 /**
@@ -714,7 +525,7 @@ void calcConvexHull(void)
  */
 int getConvexHullLength(void)
 {
-    return g_convexHullLength;
+    return g_convexHull.length;
 }
 
 /**
@@ -724,7 +535,7 @@ int getConvexHullLength(void)
  */
 float getConvexHullPointXByIndex(int index)
 {
-    return g_convexHull[index][LX];
+    return g_controlPoints[g_convexHull.indices[index]][LX];
 }
 
 /**
@@ -734,7 +545,7 @@ float getConvexHullPointXByIndex(int index)
  */
 float getConvexHullPointYByIndex(int index)
 {
-    return g_convexHull[index][LY];
+    return g_controlPoints[g_convexHull.indices[index]][LY];
 }
 
 /**
@@ -745,3 +556,18 @@ GLboolean isPlaneMoving(void)
 {
     return g_planeIsMoving;
 }
+
+/**
+ * Gibt den Speicher der dynamisch allozierten Arrays in der Logik frei
+ */
+void freeArraysLogic(void)
+{
+    free(g_controlPoints);
+    g_controlPoints = NULL;
+    free(g_stars);
+    g_stars = NULL;
+    freeConvexHull(&g_convexHull);
+    freeCollisionGrid(&g_collisionGrid);
+    freeArcLengthTable(&g_arcLengthTable);
+    freeLevels();
+}
@@ -31,9 +31,6 @@
 #define LX (0)
 #define LY (1)
 
-//Anzahl an Lvl
-#define LEVEL_AMOUNT 3
-
 #define DELTA 0.0001f
 
 #define DEFAULT_RESOLUTION 0.01f
@@ -51,6 +48,9 @@
 #define VELOCITY_STEPS 0.00003f
 
 #define PLANE_SPEED 100
+/* Strecke entlang der Kurve, die einer Einheit der Geschwindigkeit entspricht
+ * (ungefaehr die Laenge der Kurve in Level 1) */
+#define PLANE_DISTANCE_PER_T 0.28f
 
 #define PLANE_NORMAL_OFFSET 0.01f
 
@@ -60,13 +60,13 @@ float getControlpointX(int index);
 
 float getControlpointY(int index);
 
-float calculateX(float T);
+int getControlPointCount(void);
 
-float calculateY(float T);
+void calculateCurvePoint(float T, CGPoint2f point);
 
-void toggleSpline(void);
+const Curve *getCurve(void);
 
-float radToDegree(float rad);
+void toggleSpline(void);
 
 void checkCircleHit(float x, float y);
 
@@ -76,9 +76,7 @@ void setCurrentLevel(int numCurrLevel);
 
 void initLogic(void);
 
-float getPlaneX(void);
-
-float getPlaneY(void);
+void getPlanePosition(CGPoint2f position);
 
 float getPlaneT(void);
 
@@ -90,8 +88,6 @@ void handleLogicCalculations(double interval);
 
 int getStarCount(void);
 
-void calcConvexHull(void);
-
 int getConvexHullLength(void);
 
 float getConvexHullPointXByIndex(int index);
@@ -100,6 +96,14 @@ float getConvexHullPointYByIndex(int index);
 
 Star getStar(int i);
 
-Cloud getCloud(void);
+int getCloudCount(void);
+
+Cloud getCloud(int i);
+
+int getObstacleCount(void);
+
+Obstacle getObstacle(int i);
+
+void freeArraysLogic(void);
 
 GLboolean isPlaneMoving(void);
\ No newline at end of file
@@ -13,16 +13,33 @@
 /* ---- Eigene Header einbinden ---- */
 #include "io.h"
 #include "debugGL.h"
+#include "level.h"
+#include "curve.h"
 
 /**
  * Hauptprogramm.
  * Initialisierung und Starten der Ereignisbehandlung.
+ * Aufruf: ueb01 [Leveldatei], ohne Angabe wird LEVEL_FILE geladen.
  * @param argc Anzahl der Kommandozeilenparameter (In).
  * @param argv Kommandozeilenparameter (In).
  * @return Rueckgabewert im Fehlerfall ungleich Null.
  */
 int main(int argc, char **argv)
 {
+#ifdef DEBUG
+    /* Selbstpruefung der Kurvenauswertung fuer lange Kontrollpolygone */
+    if (!checkCurve())
+    {
+        return 1;
+    }
+#endif
+
+    /* Level laden, bevor die Logik initialisiert wird */
+    if (!loadLevels(argc > 1 ? argv[1] : LEVEL_FILE))
+    {
+        return 1;
+    }
+
     /* Initialisierung des I/O-Sytems
        (inkl. Erzeugung des Fensters und Starten der Ereignisbehandlung). */
     if (!initAndStartIO("CG2 Cloudy", 500, 500))
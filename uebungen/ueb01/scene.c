@@ -34,6 +34,8 @@
 #include "debugGL.h"
 #include "texture.h"
 #include "stringOutput.h"
+#include "curve.h"
+#include "cgmath.h"
 /* ---- Globale Variablen ---- */
 
 /*Status ob Normalen angezeigt werden sollen*/
@@ -101,55 +103,6 @@ static void drawLineInBetween(float x1, float y1, float z1, float x2, float y2,
     glEnd();
 }
 
-/**
- * Berechnet Betrag/Laenge eines Vektors
- * @param a ein Vektor
- * @return der Betrag des Vektors
- */
-float calcVectorLength(float *a)
-{
-    float res = 0.0f;
-    for (int i = 0; i < 3; i++)
-    {
-        res = res + pow(a[i], 2);
-    }
-    return sqrtf(res);
-}
-
-/**
- * Berechnet das Kreuzprodukt zwischen zwei 3D Vektoren und schreibt das normalisierte Ergebnis auf res.
- * @param a Zeiger auf den ersten Vektor
- * @param b Zeiger auf den zweiten Vektor
- * @param res Zeiger auf das Arrayelemet in das das Erg. geschieben wird
- */
-static void calcCrossProduct(GLfloat *a, GLfloat *b, GLfloat *res)
-{
-    float length;
-    res[0] = a[1] * b[2] - a[2] * b[1];
-    res[1] = a[2] * b[0] - a[0] * b[2];
-    res[2] = a[0] * b[1] - a[1] * b[0];
-    length = calcVectorLength(res);
-    res[0] *= 0.1f / length; //Normaliserter Vektor länge 0.1 statt 1
-    res[1] *= 0.1f / length;
-    res[2] *= 0.1f / length;
-}
-
-/**
- * Berechnet das Kreuzprodukt zweiter Vektoren
- * @param a Vektor a
- * @param Vektor b
- * @return das Kreuzprodukt zwischen den beiden Vektoren
- */
-float calcDotProduct(float *a, float *b)
-{
-    float res = 0.0f;
-    for (int i = 0; i < 3; i++)
-    {
-        res = res + a[i] * b[i];
-    }
-    return res;
-}
-
 /**
  * Zeichnet einen Einheitskreis.
  */
@@ -166,7 +119,7 @@ static void drawCircle(void)
 void drawControlPoints(void)
 {
     //Das Aktuelle Level bestimmen
-    int controlPointsAmount = getg_currentLevel() + LOWEST_AMOUNT_CONTROL_POINTS;
+    int controlPointsAmount = getControlPointCount();
     for (int i = 0; i < controlPointsAmount; i++)
     {
         float currPointX = getControlpointX(i);
@@ -231,27 +184,26 @@ void calcPlaneNormal(float *n)
     GLfloat u[3] = {0};
     //holt sich die Position vom Plane und berechnet die Positionen links und rechts mit einem OFFSET um die Normale zu berechnen
     float planePosition = getPlaneT();
-    if (planePosition - PLANE_NORMAL_OFFSET >= 0.0f + DELTA && planePosition + PLANE_NORMAL_OFFSET <= 1.0f - DELTA)
+    float left = planePosition - PLANE_NORMAL_OFFSET;
+    float right = planePosition + PLANE_NORMAL_OFFSET;
+    //Am Anfang bzw. Ende der Kurve die Position des Fliegers selbst nutzen
+    if (left < 0.0f + DELTA)
     {
-        //Linker und rechter Punkt neben der aktuellen Position des Fliegers
-        u[CX] = calculateX(planePosition - PLANE_NORMAL_OFFSET) - calculateX(planePosition + PLANE_NORMAL_OFFSET);
-        u[CY] = calculateY(planePosition - PLANE_NORMAL_OFFSET) - calculateY(planePosition + PLANE_NORMAL_OFFSET);
-        u[CZ] = 0.0f;
+        left = planePosition;
     }
-    else if (planePosition - PLANE_NORMAL_OFFSET < 0.0f + DELTA)
+    else if (right > 1.0f - DELTA)
     {
-        u[CX] = calculateX(planePosition) - calculateX(planePosition + PLANE_NORMAL_OFFSET);
-        u[CY] = calculateY(planePosition) - calculateY(planePosition + PLANE_NORMAL_OFFSET);
-        u[CZ] = 0.0f;
-    }
-    else if (planePosition + PLANE_NORMAL_OFFSET > 1.0f - DELTA)
-    {
-        u[CX] = calculateX(planePosition - PLANE_NORMAL_OFFSET) - calculateX(planePosition);
-        u[CY] = calculateY(planePosition - PLANE_NORMAL_OFFSET) - calculateY(planePosition);
-        u[CZ] = 0.0f;
+        right = planePosition;
     }
+    CGPoint2f leftPoint;
+    CGPoint2f rightPoint;
+    calculateCurvePoint(left, leftPoint);
+    calculateCurvePoint(right, rightPoint);
+    u[CX] = leftPoint[LX] - rightPoint[LX];
+    u[CY] = leftPoint[LY] - rightPoint[LY];
+    u[CZ] = 0.0f;
     // Normale wird berechnet
-    calcCrossProduct(u, v, n);
+    calcNormalizedCrossProduct(u, v, 0.1f, n);
 }
 
 /**
@@ -323,10 +275,10 @@ void drawStars(void)
 
 /**
  * Zeichnet eine Wolke.
+ * @param cloud die Wolke
  */
-void drawCloud(void)
+static void drawCloud(Cloud cloud)
 {
-    Cloud cloud = getCloud();
     if (cloud.isVisible)
     {
         float x = cloud.x;
@@ -356,6 +308,38 @@ void drawCloud(void)
     }
 }
 
+/**
+ * Zeichnet die Wolken des aktuellen Levels.
+ */
+void drawClouds(void)
+{
+    int cloudCount = getCloudCount();
+    for (int i = 0; i < cloudCount; i++)
+    {
+        drawCloud(getCloud(i));
+    }
+}
+
+/**
+ * Zeichnet die Hindernisse des aktuellen Levels.
+ */
+void drawObstacles(void)
+{
+    int obstacleCount = getObstacleCount();
+    glColor3f(BROWN);
+    for (int i = 0; i < obstacleCount; i++)
+    {
+        Obstacle obstacle = getObstacle(i);
+        glPushMatrix();
+        {
+            glTranslatef(obstacle.x, obstacle.y, 0.0f);
+            glScalef(obstacle.radius, obstacle.radius, 1.0f);
+            drawCircle();
+        }
+        glPopMatrix();
+    }
+}
+
 /*Zeichnet eine Hintergrundtextur*/
 void drawBackground(void)
 {
@@ -402,9 +386,12 @@ static void drawField(void)
     glLineWidth(3.0f);
     glDrawElements(GL_LINE_STRIP, g_resolutionVerticesCount, GL_UNSIGNED_INT, g_curveIndices);
     glLineWidth(1.0f);
-    drawPlane(getPlaneX(), getPlaneY());
+    CGPoint2f plane;
+    getPlanePosition(plane);
+    drawPlane(plane[LX], plane[LY]);
     drawStars();
-    drawCloud();
+    drawClouds();
+    drawObstacles();
 }
 
 /**
@@ -463,7 +450,6 @@ void drawScene(void)
         drawField();
         if (getConvexHullStatus())
         {
-            calcConvexHull();
             drawConvexHull();
         }
         drawControlPoints();
@@ -534,7 +520,7 @@ static void calcVertexNormals(int z)
         u[CZ] = 0.0f;
     }
 
-    calcCrossProduct(u, v, n);
+    calcNormalizedCrossProduct(u, v, 0.1f, n);
 
     g_curveVertices[z][NX] = n[CX];
     g_curveVertices[z][NY] = n[CY];
@@ -548,8 +534,10 @@ void updateVertexArray(GLboolean resetPlane)
 {
     //Punkte pro Splinesubbereich berechnen
     int verticesPerSubPart = ((int)((1.0f / g_resolution) + DELTA));
-    //Punkte insgesamt Berechnen (in abh. von Level)
-    g_resolutionVerticesCount = 1 + verticesPerSubPart;
+    //Punkte insgesamt Berechnen (in abh. von der Anzahl der Teilstuecke)
+    int segments = getCurveSegmentCount(getCurve());
+    g_resolutionVerticesCount = 1 + verticesPerSubPart * segments;
+    float step = 1.0f / (verticesPerSubPart * segments);
 
     //Den benötigten Speicher reservieren
     g_curveVertices = realloc(g_curveVertices, sizeof(Vertex) * g_resolutionVerticesCount);
@@ -567,15 +555,17 @@ void updateVertexArray(GLboolean resetPlane)
             {
                 T = 1.0f;
             }
-            g_curveVertices[i][CX] = calculateX(T);
-            g_curveVertices[i][CY] = calculateY(T);
+            CGPoint2f point;
+            calculateCurvePoint(T, point);
+            g_curveVertices[i][CX] = point[LX];
+            g_curveVertices[i][CY] = point[LY];
             g_curveVertices[i][CZ] = 0.0f;
             g_curveVertices[i][NX] = 0.0f;
             g_curveVertices[i][NY] = 0.0f;
             g_curveVertices[i][NZ] = 0.0f;
             g_curveIndices[i] = i;
             //Um einen Aufloesungsschritt erhohen (0 - 0.999)
-            T += g_resolution;
+            T = (i + 1) * step;
         }
     }
     else
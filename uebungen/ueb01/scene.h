@@ -56,19 +56,4 @@ void increaseResolution(void);
 
 void decreaseResolution(void);
 
-/**
- * Berechnet das Kreuzprodukt zweiter Vektoren
- * @param a Vektor a
- * @param Vektor b
- * @return das Kreuzprodukt zwischen den beiden Vektoren
- */
-float calcDotProduct(float *a, float *b);
-
-/**
- * Berechnet Betrag/Laenge eines Vektors
- * @param a ein Vektor
- * @return der Betrag des Vektors
- */
-float calcVectorLength(float *a);
-
 #endif
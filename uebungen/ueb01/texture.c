@@ -25,6 +25,7 @@
 /* ---- Eigene Header einbinden ---- */
 #include "texture.h"
 #include "debugGL.h"
+#include "textureLoader.h"
 
 /* Bibliothek um Bilddateien zu laden. Es handelt sich um eine
  * Bibliothek, die sowohl den Header als auch die Quelle in einer Datei
@@ -95,66 +96,24 @@ void unbindTexture(void)
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-static unsigned int
-calculateGLBitmapMode(int n)
-{
-    switch (n)
-    {
-    case 1:
-        return GL_LUMINANCE;
-    case 2:
-        return GL_LUMINANCE_ALPHA;
-    case 3:
-        return GL_RGB;
-    case 4:
-        return GL_RGBA;
-    default:
-        return GL_RGB;
-    }
-}
-
 static int
 loadTextures(void)
 {
     int i;
-
-    unsigned char *data;
-    int width, height;
-    int channels;
+    int ok = 1;
 
     if (initTextureArray())
     {
-        /* Alle Texturen nacheinander laden. */
+        /* Alle Texturen mit Platzhalter anlegen, dekodiert werden sie im
+         * Hintergrund und in updateTextures hochgeladen. */
         for (i = 0; i < TEX_COUNT; i++)
         {
-            data = stbi_load(g_textures[i].filename, &width, &height, &channels, 0);
-
-            if (data != NULL)
-            {
-                glBindTexture(GL_TEXTURE_2D, g_textures[i].id);
-
-                gluBuild2DMipmaps(GL_TEXTURE_2D,
-                                  channels,
-                                  width,
-                                  height,
-                                  calculateGLBitmapMode(channels),
-                                  GL_UNSIGNED_BYTE, data);
-
-                glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-                glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-                glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-
-                stbi_image_free(data);
-            }
-            else
-            {
-                return 0;
-            }
+            ok = ok && requestTexture(g_textures[i].id, g_textures[i].filename);
         }
+        startTextureLoader(stbi_load, stbi_image_free);
 
         /* Alles in Ordnung? */
-        return (GLGETERROR == GL_NO_ERROR);
+        return ok && (GLGETERROR == GL_NO_ERROR);
     }
     else
     {
@@ -163,6 +122,16 @@ loadTextures(void)
     }
 }
 
+void updateTextures(void)
+{
+    uploadLoadedTextures();
+}
+
+void freeTextures(void)
+{
+    stopTextureLoader();
+}
+
 void toggleAutomaticTextureCoordinates(void)
 {
     static int automatic = GL_FALSE;
@@ -81,6 +81,95 @@ typedef struct
 } Cloud;
 
 
+/* Datentyp fuer die Hindernisse */
+typedef struct
+{
+    float x;
+    float y;
+    float radius;
+} Obstacle;
+
+/* Ausgangsdaten eines Levels, aus der Leveldatei gelesen */
+typedef struct
+{
+    CGPoint2f *controlPoints;
+    int controlPointCount;
+    Star *stars;
+    int starCount;
+    Cloud *clouds;
+    int cloudCount;
+    Obstacle *obstacles;
+    int obstacleCount;
+} Level;
+
+/* Arten von Objekten, mit denen der Flieger kollidieren kann */
+typedef enum
+{
+    collisionStar,
+    collisionCloud,
+    collisionObstacle
+} CollisionType;
+
+/* Kreisfoermiges Objekt im Kollisionsgitter */
+typedef struct
+{
+    float x;
+    float y;
+    float radius;
+    CollisionType type;
+    /* Index im Array des jeweiligen Typs */
+    int index;
+} CollisionObject;
+
+/* Gleichmaessiges Gitter ueber den Kollisionsobjekten eines Levels. Die
+ * Objekte jeder Zelle liegen hintereinander in objects, beginnend bei
+ * cellStart[Zelle] und endend vor cellStart[Zelle + 1]. */
+typedef struct
+{
+    float minX;
+    float minY;
+    float cellSize;
+    int columns;
+    int rows;
+    int *cellStart;
+    CollisionObject *objects;
+    int objectCount;
+} CollisionGrid;
+
+/* Punkt der konvexen Huelle in der Sortierung nach x (dann y) */
+typedef struct
+{
+    float x;
+    float y;
+    /* Index im Array der Punkte */
+    int index;
+} HullPoint;
+
+/* Konvexe Huelle einer Punktmenge. Die nach x sortierten Punkte bleiben
+ * erhalten, sodass nach dem Verschieben eines Punktes nicht neu sortiert
+ * werden muss. */
+typedef struct
+{
+    /* Nach x (dann y) sortierte Kopie der Punkte */
+    HullPoint *sorted;
+    /* Position jedes Punktes in sorted */
+    int *position;
+    /* Indizes der Punkte der Huelle gegen den Uhrzeigersinn */
+    int *indices;
+    int length;
+    int count;
+} ConvexHull;
+
+/* Stueckweise kubische Kurve ueber einem Kontrollpolygon. Teilstueck i wird
+ * aus den Kontrollpunkten i bis i + 3 und der Basismatrix berechnet. */
+typedef struct
+{
+    const CGPoint2f *points;
+    int pointCount;
+    /* Basismatrix 4x4 zeilenweise, Zeile j wird mit t^(3-j) gewichtet */
+    const float *basis;
+} Curve;
+
 /** Mausereignisse. */
 enum e_MouseEventType
 {
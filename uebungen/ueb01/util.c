@@ -0,0 +1,36 @@
+/**
+ * @file
+ * Nuetzliche Funktionen-Modul.
+ * Dieses Modul beinhaltet nuetzliche Funktionen.
+ *
+ *
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "util.h"
+
+/* ---- Funktionen ---- */
+
+/**
+ * Reserviert ein Array neu und bricht das Programm ab, wenn kein Speicher
+ * verfuegbar ist. Eine Groesse von 0 liefert trotzdem einen gueltigen Zeiger.
+ * @param array das bisherige Array (oder NULL)
+ * @param size die neue Groesse in Byte
+ * @return das neu reservierte Array
+ */
+void *reallocArray(void *array, size_t size)
+{
+    array = realloc(array, size > 0 ? size : 1);
+    if (array == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    return array;
+}
@@ -0,0 +1,19 @@
+#ifndef __UTIL_H__
+#define __UTIL_H__
+
+/**
+ * @file
+ * Nuetzliche Funktionen-Modul.
+ * Dieses Modul beinhaltet nuetzliche Funktionen.
+ *
+ *
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stddef.h>
+
+void *reallocArray(void *array, size_t size);
+
+#endif
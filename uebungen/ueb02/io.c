@@ -593,6 +593,9 @@ cbDisplay(void)
                                      cameraDirectionX, cameraDirectionY, cameraDirectionZ,
                                      0.0, 1.0, 0.0};
 
+    /* Fertig geladene Texturen hochladen */
+    updateTextures();
+
     /* Framewbuffer und z-Buffer zuruecksetzen */
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -766,6 +769,7 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
             case ESC:
                 freeArraysLogic();
                 freeArraysScene();
+                freeTextures();
                 exit(0);
                 break;
 
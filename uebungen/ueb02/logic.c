@@ -24,6 +24,7 @@
 #include "scene.h"
 #include "io.h"
 #include "util.h"
+#include "arcLength.h"
 
 /* ---- Globale Daten ---- */
 
@@ -59,7 +60,12 @@ CGVector3f g_bezierControlPoints[4] = {0};
 int g_currentSplineSubPartT = 0;
 int g_currentSplineSubPartS = 0;
 
-float g_cameraT = 0.0f;
+/* Anteil der zurueckgelegten Strecke des Kamerafluges [0..1] */
+float g_cameraProgress = 0.0f;
+
+/* Bogenlaenge der Bezierkurve des Kamerafluges, ungueltig nach Aenderung der Kontrollpunkte */
+ArcLengthTable g_cameraFlightTable;
+GLboolean g_cameraFlightTableValid = GL_FALSE;
 
 GLboolean g_cameraFlight = GL_FALSE;
 
@@ -189,12 +195,12 @@ static float calculateSplineInterpolationPlain(float *monomVectorS, float *monom
     float multipliedMonomSWithMG[16] = {0};
     float multipliedTransposedInterpolationWithMonomT[16] = {0};
     float geometryMatrix[16] = {0};
-    float *transposedInterpolation = transpose(g_splineInterpolation, 4, 4);
+    float transposedInterpolation[16];
+    transpose4x4(g_splineInterpolation, transposedInterpolation);
     setGeometryMatrix(dimension, geometryMatrix);
     multiply4x4With4x4Matrix(g_splineInterpolation, geometryMatrix, multipliedMWithG);
     multiply1x4With4x4Matrix(monomVectorS, multipliedMWithG, multipliedMonomSWithMG);
     multiply4x4With4x1Matrix(transposedInterpolation, monomVectorT, multipliedTransposedInterpolationWithMonomT);
-    free(transposedInterpolation);
     return multiply1x4With4x1Matrix(multipliedMonomSWithMG, multipliedTransposedInterpolationWithMonomT);
 }
 
@@ -515,29 +521,49 @@ GLboolean getCameraFlightStatus(void)
 }
 
 /**
- * Berechnet das T beim Kameraflug und resettet die Werte nach einem Durchlauf.
+ * Berechnet den Fortschritt beim Kameraflug und resettet die Werte nach einem Durchlauf.
+ * Der Fortschritt ist der Anteil der Strecke, sodass die Kamera mit gleichmaessiger
+ * Geschwindigkeit fliegt.
  * @param interval Verstrichene Zeit in millisekunden.
  */
 static void calcCameraFlightT(float interval)
 {
-    if ((g_cameraT + (CAMERA_MOVEMENT_STEP * interval)) <= 1.0f)
+    if ((g_cameraProgress + (CAMERA_MOVEMENT_STEP * interval)) <= 1.0f)
     {
-        g_cameraT += CAMERA_MOVEMENT_STEP * interval;
+        g_cameraProgress += CAMERA_MOVEMENT_STEP * interval;
     }
     else
     {
-        g_cameraT = 0.0f;
+        g_cameraProgress = 0.0f;
         g_cameraFlight = GL_FALSE;
     }
 }
 
 /**
- * Liefert das Zeitintervall des Kamerafluges.
+ * Berechnet einen Punkt der Bezierkurve fuer die Bogenlaengentabelle.
+ * @param T der Zeitpunkt [0..1]
+ * @param point der Punkt (out-param)
+ * @param data nicht verwendet
+ */
+static void evaluateBezierArcLength(float T, float *point, void *data)
+{
+    point[LX] = getBezier(T, LX);
+    point[LY] = getBezier(T, LY);
+    point[LZ] = getBezier(T, LZ);
+}
+
+/**
+ * Liefert das Zeitintervall des Kamerafluges zum aktuellen Fortschritt.
  * @return das Zeitintervall [0..1].
  */
 float getCameraT(void)
 {
-    return g_cameraT;
+    if (!g_cameraFlightTableValid)
+    {
+        initArcLengthTable(&g_cameraFlightTable, evaluateBezierArcLength, NULL, 3, 1);
+        g_cameraFlightTableValid = GL_TRUE;
+    }
+    return getArcLengthParameter(&g_cameraFlightTable, g_cameraProgress * getArcLength(&g_cameraFlightTable));
 }
 
 /**
@@ -581,6 +607,8 @@ void handleLogicCalculations(double interval)
 void freeArraysLogic(void)
 {
     free(g_controlPoints);
+    freeArcLengthTable(&g_cameraFlightTable);
+    g_cameraFlightTableValid = GL_FALSE;
 }
 
 /**
@@ -620,6 +648,7 @@ void decreaseVertices(void)
  */
 void setg_bezierControlPoint(int idx, float x, float y, float z)
 {
+    g_cameraFlightTableValid = GL_FALSE;
     g_bezierControlPoints[idx][LX] = x;
     g_bezierControlPoints[idx][LY] = y;
     g_bezierControlPoints[idx][LZ] = z;
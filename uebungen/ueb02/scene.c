@@ -235,7 +235,8 @@ static void calcVertexNormals(float S, float T, float *normal)
         vS[i] = calcGradient(S, T, i, GL_TRUE);
         vT[i] = calcGradient(S, T, i, GL_FALSE);
     }
-    calcCrossProduct(vS, vT, normal);
+    //Normale auf Laenge 0.1, damit sie in der Darstellung gut sichtbar ist
+    calcNormalizedCrossProduct(vS, vT, 0.1f, normal);
 }
 
 /**
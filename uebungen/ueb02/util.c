@@ -56,19 +56,6 @@ void setMaterialAndColor(float red, float green, float blue, float alpha, GLenum
     glMaterialfv(face, materialAttribute, material);
 }
 
-/**
- * Berechnet den Richtungsvektor zwischen zwei Punkten im 3-D Raum
- * @param startPtr der Startpunkt
- * @param endPtr der Endpunkt
- * @param resPtr der Ergebnissvektor
- */
-void calcVectorBetweenPoints(GLfloat *startPtr, GLfloat *endPtr, GLfloat *resPtr)
-{
-    resPtr[0] = endPtr[0] - startPtr[0];
-    resPtr[1] = endPtr[1] - startPtr[1];
-    resPtr[2] = endPtr[2] - startPtr[2];
-}
-
 /**
  * Hilfsfunktion zum ausgaben einer 4x4 Matrix
  * @param m Zeiger auf das erste Element dieser Matrix
@@ -82,28 +69,6 @@ void printMatrix(GLfloat *m)
     //printf("\n");
 }
 
-/**
- * Hilfsfunktion um von Grad zu Radian zu konvertieren
- * @param degree Grad
- * @return Radian
- */
-float degreeToRad(float degree)
-{
-    return degree * (M_PI / 180);
-}
-
-/**
- * Hilfsfunktion zum begrenzen eines Wertes innerhalb eines Wertebereichs
- * @param value des Wert des zu Begrenzen ist
- * @param lower die untere Grenze
- * @param upper die obere Grenze
- * @return der potenziell korrigierte Wert
- */
-float clip(float value, float lower, float upper)
-{
-    return fmin(upper, fmax(lower, value));
-}
-
 /**
  * Hilfsfunktion welche zwei Strings zusammenfuegt
  * @param *s1 Zeiger auf den ersten String
@@ -126,305 +91,3 @@ char *concat(char *s1, char *s2)
     }
 }
 
-/**
- * Bestimmt die Inverse einer 4x4 Matrix
- * Quelle :https://stackoverflow.com/questions/1148309/inverting-a-4x4-matrix
- * @param m die zu invertierende Matrix
- * @param invOut die invertierte Matrix
- * @return ob die determinante == 0 (nicht loesbar) oder nicht
- */
-GLboolean gluInvertMatrix(const GLfloat m[16], GLfloat invOut[16])
-{
-    GLfloat inv[16], det;
-    int i;
-
-    inv[0] = m[5] * m[10] * m[15] -
-             m[5] * m[11] * m[14] -
-             m[9] * m[6] * m[15] +
-             m[9] * m[7] * m[14] +
-             m[13] * m[6] * m[11] -
-             m[13] * m[7] * m[10];
-
-    inv[4] = -m[4] * m[10] * m[15] +
-             m[4] * m[11] * m[14] +
-             m[8] * m[6] * m[15] -
-             m[8] * m[7] * m[14] -
-             m[12] * m[6] * m[11] +
-             m[12] * m[7] * m[10];
-
-    inv[8] = m[4] * m[9] * m[15] -
-             m[4] * m[11] * m[13] -
-             m[8] * m[5] * m[15] +
-             m[8] * m[7] * m[13] +
-             m[12] * m[5] * m[11] -
-             m[12] * m[7] * m[9];
-
-    inv[12] = -m[4] * m[9] * m[14] +
-              m[4] * m[10] * m[13] +
-              m[8] * m[5] * m[14] -
-              m[8] * m[6] * m[13] -
-              m[12] * m[5] * m[10] +
-              m[12] * m[6] * m[9];
-
-    inv[1] = -m[1] * m[10] * m[15] +
-             m[1] * m[11] * m[14] +
-             m[9] * m[2] * m[15] -
-             m[9] * m[3] * m[14] -
-             m[13] * m[2] * m[11] +
-             m[13] * m[3] * m[10];
-
-    inv[5] = m[0] * m[10] * m[15] -
-             m[0] * m[11] * m[14] -
-             m[8] * m[2] * m[15] +
-             m[8] * m[3] * m[14] +
-             m[12] * m[2] * m[11] -
-             m[12] * m[3] * m[10];
-
-    inv[9] = -m[0] * m[9] * m[15] +
-             m[0] * m[11] * m[13] +
-             m[8] * m[1] * m[15] -
-             m[8] * m[3] * m[13] -
-             m[12] * m[1] * m[11] +
-             m[12] * m[3] * m[9];
-
-    inv[13] = m[0] * m[9] * m[14] -
-              m[0] * m[10] * m[13] -
-              m[8] * m[1] * m[14] +
-              m[8] * m[2] * m[13] +
-              m[12] * m[1] * m[10] -
-              m[12] * m[2] * m[9];
-
-    inv[2] = m[1] * m[6] * m[15] -
-             m[1] * m[7] * m[14] -
-             m[5] * m[2] * m[15] +
-             m[5] * m[3] * m[14] +
-             m[13] * m[2] * m[7] -
-             m[13] * m[3] * m[6];
-
-    inv[6] = -m[0] * m[6] * m[15] +
-             m[0] * m[7] * m[14] +
-             m[4] * m[2] * m[15] -
-             m[4] * m[3] * m[14] -
-             m[12] * m[2] * m[7] +
-             m[12] * m[3] * m[6];
-
-    inv[10] = m[0] * m[5] * m[15] -
-              m[0] * m[7] * m[13] -
-              m[4] * m[1] * m[15] +
-              m[4] * m[3] * m[13] +
-              m[12] * m[1] * m[7] -
-              m[12] * m[3] * m[5];
-
-    inv[14] = -m[0] * m[5] * m[14] +
-              m[0] * m[6] * m[13] +
-              m[4] * m[1] * m[14] -
-              m[4] * m[2] * m[13] -
-              m[12] * m[1] * m[6] +
-              m[12] * m[2] * m[5];
-
-    inv[3] = -m[1] * m[6] * m[11] +
-             m[1] * m[7] * m[10] +
-             m[5] * m[2] * m[11] -
-             m[5] * m[3] * m[10] -
-             m[9] * m[2] * m[7] +
-             m[9] * m[3] * m[6];
-
-    inv[7] = m[0] * m[6] * m[11] -
-             m[0] * m[7] * m[10] -
-             m[4] * m[2] * m[11] +
-             m[4] * m[3] * m[10] +
-             m[8] * m[2] * m[7] -
-             m[8] * m[3] * m[6];
-
-    inv[11] = -m[0] * m[5] * m[11] +
-              m[0] * m[7] * m[9] +
-              m[4] * m[1] * m[11] -
-              m[4] * m[3] * m[9] -
-              m[8] * m[1] * m[7] +
-              m[8] * m[3] * m[5];
-
-    inv[15] = m[0] * m[5] * m[10] -
-              m[0] * m[6] * m[9] -
-              m[4] * m[1] * m[10] +
-              m[4] * m[2] * m[9] +
-              m[8] * m[1] * m[6] -
-              m[8] * m[2] * m[5];
-
-    det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
-
-    if (det == 0)
-        return GL_FALSE;
-
-    det = 1.0 / det;
-
-    for (i = 0; i < 16; i++)
-        invOut[i] = inv[i] * det;
-
-    return GL_TRUE;
-}
-
-/**
- * https://stackoverflow.com/questions/31225431/transpose-a-matrix-via-pointer-in-c
- * Transponiert eine Matrix beliebiger Groesse und gibt diese zurueck
- * @param n sind Zeilen
- * @param m sind Spalten
- */
-float *transpose(float *matrix, int n, int m)
-{
-    int i = 0;
-    int j = 0;
-    float num;
-    float *transposed = malloc(sizeof(float) * n * m);
-    while (i < n)
-    {
-        j = 0;
-        while (j < m)
-        {
-            num = *(matrix + i * m + j);
-            *(transposed + i + n * j) = num; // I changed how you index the transpose
-            j++;
-        }
-        i++;
-    }
-
-    return transposed;
-}
-
-/**
- * Hilfsfunktion welche zwei 4x4 Matrixen welche als 16-Elementige Arrays representiert
- * werden miteinander multipliziert. mat1*mat2 = res
- * @param mat1 Zeiger auf die ertste Matrix
- * @param mat2 Zeiger auf die zweite Matrix
- * @param res Zeiger auf die Ergebnissmatrix
- */
-void multiply4x4With4x4Matrix(GLfloat *mat1, GLfloat *mat2, GLfloat *res)
-{
-    for (int k = 0; k <= 12; k += 4)
-    {
-        for (int i = 0; i < 4; i++)
-        {
-            for (int j = 0, mat2Count = 0; j < 4; j++, mat2Count += 4)
-            {
-                res[k + i] += mat1[k + j % 4] * mat2[mat2Count + i % 4];
-            }
-        }
-    }
-}
-
-/**
- * Multipliziert dem Monomvektor S [1X4] mit der uebergebenen Matrix [4X4]
- * @param monomVectorS der Monomvektor S
- * @param mat4x4 die zu multiplizierende [4X4] Matrix
- * @param result das Ergebniss der multiplikation
- */
-void multiply1x4With4x4Matrix(float *monomVectorS, float *mat4x4, float *result)
-{
-    int count = 0;
-    for (int i = 0; i < 4; i++)
-    {
-        //Zur sicherheit mit 0 ueberschreiben
-        result[i] = 0.0f;
-        for (int j = 0; j < 16; j = j + 4)
-        {
-            result[i] += monomVectorS[count % 4] * mat4x4[j + i];
-            count++;
-        }
-    }
-}
-
-/**
- * Multipliziert den Monomvektor T mit der Interpolationsmatrix.
- * @param interpolation die Interpolationsmatrix
- * @param monomVectorT der Monomvektor T
- * @param result das Ergebniss des Multiplikation
- */
-void multiply4x4With4x1Matrix(float *interpolation, float *monomVectorT, float *result)
-{
-    int count = 0;
-    for (int i = 0; i < 4; i++)
-    {
-        //Zur sicherheit mit 0 ueberschreiben
-        result[i] = 0.0f;
-        for (int j = 0; j < 4; j++)
-        {
-            result[i] += interpolation[count] * monomVectorT[count % 4];
-            count++;
-        }
-    }
-}
-
-/**
- * Multipiliert die uebergebenen Matrixen miteinander
- * @param m1x4 Zeiger auf die 1X4 Matrix
- * @param m4x1 Zeiger auf die 4X1 Matrix
- */
-float multiply1x4With4x1Matrix(float *m1x4, float *m4x1)
-{
-    float res = 0.0f;
-    for (int i = 0; i < 4; i++)
-    {
-        res += m1x4[i] * m4x1[i];
-    }
-    return res;
-}
-
-/**
- * Multipiliert die uebergebenen Matrixen miteinander
- * @param m1x4 Zeiger auf die 1X4 Matrix
- * @param dimension die x, y oder z dimension der 1x4 Matrix welche zu berechnen ist.
- * @param m4x1 Zeiger auf die 4X1 Matrix
- */
-float multiply1x4With4x1MatrixByDimension(CGVector3f *m1x4, int dimension, float *m4x1)
-{
-    float res = 0.0f;
-    for (int i = 0; i < 4; i++)
-    {
-        res += m1x4[i][dimension] * m4x1[i];
-    }
-    return res;
-}
-
-/**
- * Berechnet aus der Modelmatrix dessen Position in Weltkoordinaten
- * @param viewMatrixPtr ein Zeiger auf die Aktuelle Viewmatrix
- * @param objectMatrixPtr ein Zeiger auf die Modelviewmatrix des zu bestimmenden Objektes
- * @param worldCoordinatesMatrixPtr Zeiger auf den Vektor in den das Ergebniss geschrieben werden soll (x,y,z)
- */
-void calcWorldCoordinates(GLfloat *viewMatrixPtr, GLfloat *objectMatrixPtr, GLfloat *worldCoordinatesPtr)
-{
-    GLfloat viewMatrix[16] = {0};
-    GLfloat invertedViewMatrix[16] = {0};
-    GLfloat objectMatrix[16] = {0};
-    GLfloat worldCoordinatesMatrix[16] = {0};
-    /*Daten von Ptr. kopieren*/
-    memcpy(viewMatrix, viewMatrixPtr, sizeof(GLfloat) * 16);
-    memcpy(objectMatrix, objectMatrixPtr, sizeof(GLfloat) * 16);
-    /*Inverse Berechnen*/
-    if (gluInvertMatrix(viewMatrix, invertedViewMatrix))
-    {
-        multiply4x4With4x4Matrix(objectMatrix, invertedViewMatrix, worldCoordinatesMatrix);
-        memcpy(worldCoordinatesPtr, &worldCoordinatesMatrix[12], sizeof(GLfloat) * 3);
-    }
-    else
-    {
-        printf("FELHER BEI BERECHNUNG DER INVERSE!");
-    }
-}
-
-/**
- * Berechnet das Kreuzprodukt zwischen zwei 3D Vektoren und schreibt das normalisierte Ergebnis auf res.
- * @param a Zeiger auf den ersten Vektor
- * @param b Zeiger auf den zweiten Vektor
- * @param res Zeiger auf das Arrayelemet in das das Erg. geschieben wird
- */
-void calcCrossProduct(GLfloat *a, GLfloat *b, GLfloat *res)
-{
-    float length;
-    res[0] = a[1] * b[2] - a[2] * b[1];
-    res[1] = a[2] * b[0] - a[0] * b[2];
-    res[2] = a[0] * b[1] - a[1] * b[0];
-    length = sqrt(res[0] * res[0] + res[1] * res[1] + res[2] * res[2]);
-    res[0] *= 0.1f / length; //0.1, damit diese auf 0.1 normalisiert werden
-    res[1] *= 0.1f / length;
-    res[2] *= 0.1f / length;
-}
@@ -0,0 +1,446 @@
+/**
+ * @file
+ * Benchmark der Murmelsimulation.
+ * Fuehrt die Physik der Murmeln ohne Fenster und ohne OpenGL fuer eine feste
+ * simulierte Dauer aus und gibt die Laufzeit pro Simulationsschritt sowie eine
+ * Perzentil-Aufschluesselung fuer Kollision, Anziehung und Integration aus.
+ * Mit -H werden zusaetzlich die Hardwarezaehler (Takte, Instruktionen,
+ * Cachefehlzugriffe, falsch vorhergesagte Spruenge) je Schritt und
+ * Teilschritt ausgegeben, sofern das System sie bereitstellt.
+ * Mit -t wird stattdessen fuer jedes Integrationsverfahren die groesste
+ * stabile Schrittweite gesucht und die Genauigkeit gegen eine Referenzloesung
+ * mit sehr kleiner Schrittweite bestimmt.
+ *
+ * Aufruf: ueb03_bench [-n Murmeln] [-m Loecher] [-k Barrieren] [-d Sekunden] [-s Schrittweite] [-r Seed] [-i Integrator] [-t] [-H]
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "surface.h"
+#include "physics.h"
+
+/* ---- Konstanten ---- */
+
+#define BENCH_DEFAULT_DURATION 10.0
+#define BENCH_DEFAULT_SEED 42
+
+/** Anzahl der ausgewerteten Messreihen (Teilschritte + gesamter Schritt) */
+#define BENCH_SERIES_COUNT (PHYSICS_STAGE_COUNT + 1)
+
+/** Ab dieser Geschwindigkeit (Einheiten/s) gilt eine Simulation als instabil */
+#define STABILITY_MAX_SPEED 50.0f
+/** Groesste zulaessige Abweichung von der Referenzloesung (Einheiten) */
+#define STABILITY_MAX_ERROR (MARBLE_RADIUS * 2.0f)
+/** Schrittweite der Referenzloesung relativ zu UPDATE_CALL */
+#define STABILITY_REFERENCE_DIVISOR 10
+/** Untersuchte Schrittweiten der Stabilitaetssuche */
+static const double g_stabilitySteps[] = {0.0025, 0.005, 0.0075, 0.01, 0.015, 0.02, 0.03, 0.04, 0.05, 0.075, 0.1, 0.15, 0.2};
+#define STABILITY_STEP_COUNT (int)(sizeof(g_stabilitySteps) / sizeof(g_stabilitySteps[0]))
+
+/* ---- Funktionen ---- */
+
+/**
+ * Liefert den aktuellen Zeitstempel einer monotonen Uhr.
+ * @return der Zeitstempel in Nanosekunden
+ */
+static double getNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/**
+ * Vergleichsfunktion fuer qsort.
+ */
+static int compareDoubles(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+/**
+ * Liefert ein Perzentil einer aufsteigend sortierten Messreihe.
+ * @param sorted die sortierte Messreihe
+ * @param count Anzahl der Messwerte
+ * @param percentile das Perzentil [0-100]
+ * @return der Messwert an dem Perzentil
+ */
+static double getPercentile(double *sorted, int count, double percentile)
+{
+    int idx = (int)(percentile / 100.0 * (count - 1) + 0.5);
+    return sorted[idx];
+}
+
+/**
+ * Gibt Mittelwert und Perzentile einer Messreihe aus.
+ * @param name Name der Messreihe
+ * @param samples die Messwerte (werden sortiert)
+ * @param count Anzahl der Messwerte
+ */
+static void printSeries(const char *name, double *samples, int count)
+{
+    double sum = 0.0;
+    for (int i = 0; i < count; i++)
+    {
+        sum += samples[i];
+    }
+    qsort(samples, count, sizeof(double), compareDoubles);
+    printf("%-12s %12.0f %12.0f %12.0f %12.0f %12.0f\n", name, sum / count,
+           getPercentile(samples, count, 50.0),
+           getPercentile(samples, count, 90.0),
+           getPercentile(samples, count, 99.0),
+           samples[count - 1]);
+}
+
+/**
+ * Setzt Flaeche und Physik mit dem gegebenen Seed auf den Anfangszustand.
+ * @param marbleCount Anzahl der Murmeln
+ * @param holeCount Anzahl der Loecher
+ * @param barrierCount Anzahl der Barrieren
+ * @param seed Seed des Zufallsgenerators
+ */
+static void resetScene(int marbleCount, int holeCount, int barrierCount, unsigned seed)
+{
+    srand(seed);
+    initControlPointArray();
+    initPhysics(marbleCount, holeCount, barrierCount);
+}
+
+/**
+ * Schreibt die Positionen der Murmeln in Weltkoordinaten (x, z) in ein Array.
+ * Verschluckte Murmeln werden als NAN eingetragen.
+ * @param positions Array mit zwei Eintraegen je Murmel (out-param)
+ */
+static void getMarblePositions(float *positions)
+{
+    for (int i = 0; i < getMarbleCount(); i++)
+    {
+        float S = getMarbleS(i);
+        float T = getMarbleT(i);
+        positions[2 * i] = isMarbleVisible(i) ? interpolate(S, T, LX) : NAN;
+        positions[2 * i + 1] = isMarbleVisible(i) ? interpolate(S, T, LZ) : NAN;
+    }
+}
+
+/**
+ * Simuliert die Szene mit einem Integrationsverfahren.
+ * @param integrator das Integrationsverfahren
+ * @param step die Schrittweite
+ * @param duration die simulierte Dauer
+ * @param positions die Positionen der Murmeln am Ende (out-param)
+ * @param nanosPerStep die mittlere Laufzeit pro Schritt (out-param)
+ * @return ob die Simulation stabil geblieben ist
+ */
+static GLboolean simulate(Integrator integrator, double step, double duration, float *positions, double *nanosPerStep)
+{
+    GLboolean stable = GL_TRUE;
+    int stepCount = (int)(duration / step + 0.5);
+    int marbleCount = getMarbleCount();
+    float *previous = malloc(sizeof(float) * 2 * marbleCount);
+    if (previous == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+
+    setIntegrator(integrator);
+    getMarblePositions(positions);
+    double simulationNanos = 0.0;
+    int i = 0;
+    while (i < stepCount && stable)
+    {
+        memcpy(previous, positions, sizeof(float) * 2 * marbleCount);
+        double stepStart = getNanos();
+        handleMarbleMovement(step);
+        simulationNanos += getNanos() - stepStart;
+        i++;
+
+        getMarblePositions(positions);
+        for (int j = 0; j < marbleCount; j++)
+        {
+            if (isMarbleVisible(j))
+            {
+                float dx = positions[2 * j] - previous[2 * j];
+                float dz = positions[2 * j + 1] - previous[2 * j + 1];
+                float speed = sqrtf(dx * dx + dz * dz) / step;
+                //Vergleich so formuliert, dass auch NAN als instabil gilt
+                if (!(speed < STABILITY_MAX_SPEED))
+                {
+                    stable = GL_FALSE;
+                }
+            }
+        }
+    }
+    free(previous);
+    *nanosPerStep = simulationNanos / i;
+    return stable;
+}
+
+/**
+ * Berechnet die mittlere Abweichung der Murmelpositionen von der Referenz.
+ * Murmeln, die nur in einer der beiden Loesungen verschluckt wurden, zaehlen
+ * nicht mit.
+ * @param positions die Positionen der untersuchten Loesung
+ * @param reference die Positionen der Referenzloesung
+ * @param marbleCount Anzahl der Murmeln
+ * @return die Wurzel der mittleren quadratischen Abweichung
+ */
+static double calculatePositionError(float *positions, float *reference, int marbleCount)
+{
+    double sum = 0.0;
+    int count = 0;
+    for (int i = 0; i < marbleCount; i++)
+    {
+        if (!isnan(positions[2 * i]) && !isnan(reference[2 * i]))
+        {
+            double dx = positions[2 * i] - reference[2 * i];
+            double dz = positions[2 * i + 1] - reference[2 * i + 1];
+            sum += dx * dx + dz * dz;
+            count++;
+        }
+    }
+    return count > 0 ? sqrt(sum / count) : 0.0;
+}
+
+/**
+ * Sucht fuer jedes Integrationsverfahren die groesste stabile Schrittweite
+ * und gibt Genauigkeit und Kosten je Schrittweite aus.
+ * @param marbleCount Anzahl der Murmeln
+ * @param holeCount Anzahl der Loecher
+ * @param barrierCount Anzahl der Barrieren
+ * @param duration die simulierte Dauer
+ * @param seed Seed des Zufallsgenerators
+ */
+static void runStabilitySearch(int marbleCount, int holeCount, int barrierCount, double duration, unsigned seed)
+{
+    float *reference = malloc(sizeof(float) * 2 * marbleCount);
+    float *positions = malloc(sizeof(float) * 2 * marbleCount);
+    if (reference == NULL || positions == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+
+    double referenceStep = UPDATE_CALL / STABILITY_REFERENCE_DIVISOR;
+    double nanosPerStep;
+    resetScene(marbleCount, holeCount, barrierCount, seed);
+    simulate(integratorRungeKutta4, referenceStep, duration, reference, &nanosPerStep);
+
+    printf("Murmeln: %d, Loecher: %d, Barrieren: %d, Simulierte Dauer: %.3f s\n",
+           marbleCount, holeCount, barrierCount, duration);
+    printf("Referenz: %s mit Schrittweite %.5f s\n\n", getIntegratorName(integratorRungeKutta4), referenceStep);
+    printf("%-22s %12s %8s %12s %12s %14s\n", "Verfahren", "Schrittweite", "stabil", "Fehler", "ns/Schritt", "ns/sim. Sek.");
+
+    for (int integrator = 0; integrator < INTEGRATOR_COUNT; integrator++)
+    {
+        double largestStableStep = 0.0;
+        double largestStableCost = 0.0;
+        double largestAccurateStep = 0.0;
+        double largestAccurateCost = 0.0;
+        GLboolean stable = GL_TRUE;
+        GLboolean accurate = GL_TRUE;
+        //Die Suche endet bei der ersten instabilen Schrittweite
+        for (int k = 0; k < STABILITY_STEP_COUNT && stable; k++)
+        {
+            double step = g_stabilitySteps[k];
+            resetScene(marbleCount, holeCount, barrierCount, seed);
+            stable = simulate(integrator, step, duration, positions, &nanosPerStep);
+            if (stable)
+            {
+                double error = calculatePositionError(positions, reference, marbleCount);
+                printf("%-22s %12.4f %8s %12.6f %12.0f %14.0f\n", getIntegratorName(integrator), step, "ja",
+                       error, nanosPerStep, nanosPerStep / step);
+                largestStableStep = step;
+                largestStableCost = nanosPerStep / step;
+                accurate = accurate && error <= STABILITY_MAX_ERROR;
+                if (accurate)
+                {
+                    largestAccurateStep = step;
+                    largestAccurateCost = nanosPerStep / step;
+                }
+            }
+            else
+            {
+                printf("%-22s %12.4f %8s %12s %12.0f %14s\n", getIntegratorName(integrator), step, "nein", "-", nanosPerStep, "-");
+            }
+        }
+        printf("=> groesste stabile Schrittweite: %.4f s (%.0f ns je simulierter Sekunde)\n", largestStableStep, largestStableCost);
+        printf("=> groesste Schrittweite mit Fehler <= %.3f: %.4f s (%.0f ns je simulierter Sekunde)\n\n",
+               STABILITY_MAX_ERROR, largestAccurateStep, largestAccurateCost);
+    }
+
+    free(reference);
+    free(positions);
+}
+
+/**
+ * Hauptprogramm des Benchmarks.
+ * @param argc Anzahl der Kommandozeilenparameter
+ * @param argv Kommandozeilenparameter
+ * @return Rueckgabewert im Fehlerfall ungleich Null.
+ */
+int main(int argc, char **argv)
+{
+    int marbleCount = MARBLE_COUNT;
+    int holeCount = INIT_HOLE_AMOUNT;
+    int barrierCount = BARRIER_COUNT;
+    double duration = BENCH_DEFAULT_DURATION;
+    double step = UPDATE_CALL;
+    unsigned seed = BENCH_DEFAULT_SEED;
+    Integrator integrator = integratorSemiImplicitEuler;
+    GLboolean stabilitySearch = GL_FALSE;
+    GLboolean countHardware = GL_FALSE;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:m:k:d:s:r:i:tH")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            marbleCount = atoi(optarg);
+            break;
+        case 'm':
+            holeCount = atoi(optarg);
+            break;
+        case 'k':
+            barrierCount = atoi(optarg);
+            break;
+        case 'd':
+            duration = atof(optarg);
+            break;
+        case 's':
+            step = atof(optarg);
+            break;
+        case 'r':
+            seed = (unsigned)atoi(optarg);
+            break;
+        case 'i':
+            integrator = (Integrator)atoi(optarg);
+            break;
+        case 't':
+            stabilitySearch = GL_TRUE;
+            break;
+        case 'H':
+            countHardware = GL_TRUE;
+            break;
+        default:
+            fprintf(stderr, "Aufruf: %s [-n Murmeln] [-m Loecher] [-k Barrieren] [-d Sekunden] [-s Schrittweite] [-r Seed] [-i Integrator] [-t] [-H]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    int stepCount = (int)(duration / step + 0.5);
+    if (marbleCount < 1 || holeCount < 0 || barrierCount < 0 || stepCount < 1 ||
+        integrator < 0 || integrator >= INTEGRATOR_COUNT)
+    {
+        fprintf(stderr, "Ungueltige Parameter.\n");
+        return 1;
+    }
+
+    if (stabilitySearch)
+    {
+        runStabilitySearch(marbleCount, holeCount, barrierCount, duration, seed);
+        freeArraysPhysics();
+        freeArraysSurface();
+        return 0;
+    }
+
+    double *samples[BENCH_SERIES_COUNT];
+    for (int i = 0; i < BENCH_SERIES_COUNT; i++)
+    {
+        samples[i] = malloc(sizeof(double) * stepCount);
+        if (samples[i] == NULL)
+        {
+            printf("Kein virtueller RAM mehr verfügbar ...\n");
+            exit(1);
+        }
+    }
+
+    resetScene(marbleCount, holeCount, barrierCount, seed);
+    setIntegrator(integrator);
+
+    PerfCounters counters;
+    PerfCounterValues stepCounters, benchStartCounters, benchEndCounters;
+    resetPerfCounterValues(&stepCounters);
+    if (countHardware)
+    {
+        openPerfCounters(&counters, 0);
+        setPhysicsPerfCounters(&counters);
+        readPerfCounters(&counters, &benchStartCounters);
+    }
+
+    double benchStart = getNanos();
+    for (int i = 0; i < stepCount; i++)
+    {
+        resetPhysicsStageNanos();
+        double stepStart = getNanos();
+        handleMarbleMovement(step);
+        samples[PHYSICS_STAGE_COUNT][i] = getNanos() - stepStart;
+        for (int stage = 0; stage < PHYSICS_STAGE_COUNT; stage++)
+        {
+            samples[stage][i] = getPhysicsStageNanos(stage);
+        }
+    }
+    double benchNanos = getNanos() - benchStart;
+    if (countHardware)
+    {
+        readPerfCounters(&counters, &benchEndCounters);
+        addPerfCounterDelta(&stepCounters, &benchStartCounters, &benchEndCounters);
+    }
+
+    int visibleMarbles = 0;
+    int sleepingMarbles = 0;
+    for (int i = 0; i < getMarbleCount(); i++)
+    {
+        visibleMarbles += isMarbleVisible(i);
+        sleepingMarbles += isMarbleVisible(i) && isMarbleSleeping(i);
+    }
+
+    printf("Murmeln: %d (am Ende sichtbar: %d, davon schlafend: %d), Loecher: %d, Barrieren: %d\n",
+           marbleCount, visibleMarbles, sleepingMarbles, holeCount, barrierCount);
+    printf("Simulierte Dauer: %.3f s, Schrittweite: %.4f s, Schritte: %d, Integrator: %s\n",
+           duration, step, stepCount, getIntegratorName(integrator));
+    printf("Gesamt: %.3f ms, %.0f ns/Schritt\n\n", benchNanos / 1e6, benchNanos / stepCount);
+    printf("%-12s %12s %12s %12s %12s %12s\n", "ns/Schritt", "Mittel", "p50", "p90", "p99", "max");
+    printSeries("Kollision", samples[physicsStageCollision], stepCount);
+    printSeries("Anziehung", samples[physicsStageAttraction], stepCount);
+    printSeries("Integration", samples[physicsStageIntegration], stepCount);
+    printSeries("Schritt", samples[PHYSICS_STAGE_COUNT], stepCount);
+
+    if (countHardware)
+    {
+        //Der gesamte Schritt enthaelt auch das Auslesen der Zaehler je Teilschritt
+        static const char *stageNames[PHYSICS_STAGE_COUNT] = {"Kollision", "Anziehung", "Integration"};
+        printf("\n");
+        printPerfCounterHeader("Zaehler/Schritt");
+        for (int stage = 0; stage < PHYSICS_STAGE_COUNT; stage++)
+        {
+            PerfCounterValues values;
+            getPhysicsStageCounters(stage, &values);
+            printPerfCounterValues(stageNames[stage], &values, stepCount);
+        }
+        printPerfCounterValues("Schritt", &stepCounters, stepCount);
+        setPhysicsPerfCounters(NULL);
+        closePerfCounters(&counters);
+    }
+
+    for (int i = 0; i < BENCH_SERIES_COUNT; i++)
+    {
+        free(samples[i]);
+    }
+    freeArraysPhysics();
+    freeArraysSurface();
+
+    return 0;
+}
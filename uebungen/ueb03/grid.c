@@ -0,0 +1,145 @@
+/**
+ * @file
+ * Gitter-Modul.
+ * Das Modul kapselt ein gleichmaessiges Gitter ueber das Spielfeld, in das
+ * Hindernisse anhand ihres Wirkungsbereichs einsortiert werden. Damit muessen
+ * pro Murmel nur die Hindernisse in ihrer Umgebung geprueft werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "grid.h"
+
+/* ---- Funktionen ---- */
+
+/**
+ * Liefert die Zellkoordinate zu einer Weltkoordinate.
+ * Werte ausserhalb des Spielfeldes werden auf die Randzellen begrenzt.
+ * @param grid das Gitter
+ * @param value die x- oder z-Koordinate in Weltkoordinaten
+ * @return die Zellkoordinate [0, cellsPerRow - 1]
+ */
+int getSpatialGridCellCoord(SpatialGrid *grid, float value)
+{
+    int cell = (int)floorf((value - grid->origin) / grid->cellSize);
+    if (cell < 0)
+    {
+        cell = 0;
+    }
+    else if (cell >= grid->cellsPerRow)
+    {
+        cell = grid->cellsPerRow - 1;
+    }
+    return cell;
+}
+
+/**
+ * Liefert die Indizes der Hindernisse einer Zelle.
+ * @param grid das Gitter
+ * @param cellX Zellkoordinate in x-Richtung
+ * @param cellZ Zellkoordinate in z-Richtung
+ * @param items Zeiger auf den ersten Index der Zelle
+ * @return die Anzahl der Indizes
+ */
+int getSpatialGridCellItems(SpatialGrid *grid, int cellX, int cellZ, int **items)
+{
+    int cell = cellZ * grid->cellsPerRow + cellX;
+    *items = grid->cellItems + grid->cellStart[cell];
+    return grid->cellStart[cell + 1] - grid->cellStart[cell];
+}
+
+/**
+ * Baut das Gitter per Counting Sort neu auf. Jedes Hindernis wird in alle
+ * Zellen einsortiert, die sein Wirkungsbereich beruehrt.
+ * @param grid das aufzubauende Gitter
+ * @param obstacles die Hindernisse
+ * @param count Anzahl der Hindernisse
+ * @param fieldWidth Breite des (quadratischen) Spielfeldes in Weltkoordinaten
+ */
+void buildSpatialGrid(SpatialGrid *grid, Obstacle *obstacles, int count, float fieldWidth)
+{
+    grid->cellsPerRow = (int)ceilf(fieldWidth / SPATIAL_GRID_CELL_SIZE);
+    if (grid->cellsPerRow < 1)
+    {
+        grid->cellsPerRow = 1;
+    }
+    grid->cellSize = fieldWidth / grid->cellsPerRow;
+    grid->origin = -fieldWidth / 2.0f;
+    int cellCount = grid->cellsPerRow * grid->cellsPerRow;
+
+    grid->cellStart = realloc(grid->cellStart, sizeof(int) * (cellCount + 1));
+    int *cellCursor = malloc(sizeof(int) * cellCount);
+    if (grid->cellStart == NULL || cellCursor == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    memset(grid->cellStart, 0, sizeof(int) * (cellCount + 1));
+
+    //Erster Durchlauf: Hindernisse pro Zelle zaehlen
+    for (int i = 0; i < count; i++)
+    {
+        int minX = getSpatialGridCellCoord(grid, obstacles[i].boundsMin[0]);
+        int maxX = getSpatialGridCellCoord(grid, obstacles[i].boundsMax[0]);
+        int minZ = getSpatialGridCellCoord(grid, obstacles[i].boundsMin[1]);
+        int maxZ = getSpatialGridCellCoord(grid, obstacles[i].boundsMax[1]);
+        for (int z = minZ; z <= maxZ; z++)
+        {
+            for (int x = minX; x <= maxX; x++)
+            {
+                grid->cellStart[z * grid->cellsPerRow + x + 1]++;
+            }
+        }
+    }
+
+    //Praefixsumme liefert den Beginn jeder Zelle
+    for (int c = 0; c < cellCount; c++)
+    {
+        grid->cellStart[c + 1] += grid->cellStart[c];
+        cellCursor[c] = grid->cellStart[c];
+    }
+
+    grid->cellItems = realloc(grid->cellItems, sizeof(int) * (grid->cellStart[cellCount] + 1));
+    if (grid->cellItems == NULL)
+    {
+        free(cellCursor);
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+
+    //Zweiter Durchlauf: Indizes einsortieren
+    for (int i = 0; i < count; i++)
+    {
+        int minX = getSpatialGridCellCoord(grid, obstacles[i].boundsMin[0]);
+        int maxX = getSpatialGridCellCoord(grid, obstacles[i].boundsMax[0]);
+        int minZ = getSpatialGridCellCoord(grid, obstacles[i].boundsMin[1]);
+        int maxZ = getSpatialGridCellCoord(grid, obstacles[i].boundsMax[1]);
+        for (int z = minZ; z <= maxZ; z++)
+        {
+            for (int x = minX; x <= maxX; x++)
+            {
+                grid->cellItems[cellCursor[z * grid->cellsPerRow + x]++] = i;
+            }
+        }
+    }
+    free(cellCursor);
+}
+
+/**
+ * Gibt den Speicher des Gitters frei.
+ * @param grid das Gitter
+ */
+void freeSpatialGrid(SpatialGrid *grid)
+{
+    free(grid->cellStart);
+    free(grid->cellItems);
+    grid->cellStart = NULL;
+    grid->cellItems = NULL;
+}
@@ -0,0 +1,26 @@
+#ifndef __GRID_H__
+#define __GRID_H__
+/**
+ * @file
+ * Gitter-Modul.
+ * Das Modul kapselt ein gleichmaessiges Gitter ueber das Spielfeld, in das
+ * Hindernisse anhand ihres Wirkungsbereichs einsortiert werden. Damit muessen
+ * pro Murmel nur die Hindernisse in ihrer Umgebung geprueft werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/* Kantenlaenge einer Gitterzelle in Weltkoordinaten */
+#define SPATIAL_GRID_CELL_SIZE 0.25f
+
+void buildSpatialGrid(SpatialGrid *grid, Obstacle *obstacles, int count, float fieldWidth);
+
+void freeSpatialGrid(SpatialGrid *grid);
+
+int getSpatialGridCellCoord(SpatialGrid *grid, float value);
+
+int getSpatialGridCellItems(SpatialGrid *grid, int cellX, int cellZ, int **items);
+
+#endif
@@ -29,6 +29,7 @@
 #include "debugGL.h"
 #include "util.h"
 #include "texture.h"
+#include "profiler.h"
 
 /* Funktionen */
 
@@ -68,6 +69,8 @@ GLfloat g_fps = 0.0f;
 /* ---- Konstanten ---- */
 /** Anzahl der Aufrufe der Timer-Funktion pro Sekunde */
 #define TIMER_CALLS_PS 60
+/** Datei fuer den Chrome-Trace der Frame-Zeiten */
+#define PROFILE_TRACE_PATH "profile_trace.json"
 /* ---- Funktionen ---- */
 
 /**
@@ -553,7 +556,9 @@ cbTimer(int lastCallTime)
     handleRadius();
 
     /*Kuemmert sich um die Berechnungen in der Logik (zeitgesteuert)*/
+    double profileStart = beginProfileScope();
     handleLogicCalculations(interval);
+    endProfileScope("Logik", profileStart);
 
     /* Wieder als Timer-Funktion registrieren */
     glutTimerFunc(1000 / TIMER_CALLS_PS, cbTimer, thisCallTime);
@@ -593,6 +598,11 @@ cbDisplay(void)
                                      cameraDirectionX, cameraDirectionY, cameraDirectionZ,
                                      0.0, 1.0, 0.0};
 
+    double profileStart = beginProfileScope();
+
+    /* Fertig geladene Texturen hochladen */
+    updateTextures();
+
     /* Framewbuffer und z-Buffer zuruecksetzen */
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -619,11 +629,16 @@ cbDisplay(void)
         }
     }
 
+    endProfileScope("Zeichnen", profileStart);
+
     /* Objekt anzeigen */
+    profileStart = beginProfileScope();
     glutSwapBuffers();
+    endProfileScope("Buffertausch", profileStart);
 
     /* Framerate berechnen */
     g_fps = frameRate();
+    markProfileFrame();
 }
 
 /**
@@ -729,6 +744,17 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
             case GLUT_KEY_F9:
                 toggleGamePause();
                 break;
+                /* Frame-Zeiten anzeigen */
+            case GLUT_KEY_F11:
+                toggleProfileOverlay();
+                break;
+                /* Frame-Zeiten als Chrome-Trace speichern */
+            case GLUT_KEY_F12:
+                if (writeProfileTrace(PROFILE_TRACE_PATH))
+                {
+                    printf("Frame-Zeiten gespeichert: %s\n", PROFILE_TRACE_PATH);
+                }
+                break;
             }
         }
         /* normale Taste gedrueckt */
@@ -792,6 +818,8 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
             case ESC:
                 freeArraysLogic();
                 freeArraysScene();
+                freeProfiler();
+                freeTextures();
                 exit(0);
                 break;
 
@@ -809,6 +837,11 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
             case 'F':
                 pokeMarble();
                 break;
+                /* Integrationsverfahren wechseln */
+            case 'm':
+            case 'M':
+                nextIntegrator();
+                break;
 
             case 'B':
             case 'b':
@@ -1078,6 +1111,9 @@ int initAndStartIO(char *title, int width, int height)
     int argc = 1;
     char *argv = "cmd";
 
+    /* Hauptthread im Chrome-Trace benennen */
+    setProfileThreadName("Hauptthread");
+
     /* Glut initialisieren */
     glutInit(&argc, &argv);
 
@@ -1,3 +1,5 @@
+#ifndef __LOGIC_H__
+#define __LOGIC_H__
 /**
  * @file
  * Logik-Modul.
@@ -16,6 +18,8 @@
 
 /* ---- Eigene Header einbinden ---- */
 #include "types.h"
+#include "surface.h"
+#include "physics.h"
 
 /* ---- Konstanten ---- */
 
@@ -32,18 +36,6 @@
 #define TX (9)
 #define TY (10)
 
-/*Konstaten zur besseren lesbarkeit des Arrays in der Logik zur bessereren lesbarkeit*/
-#define LX (0)
-#define LY (1)
-#define LZ (2)
-
-#define LT (0)
-#define LS (1)
-
-#define SLOPE_FACTOR 0.05f
-
-#define UPDATE_CALL 0.005f
-
 /*Kamera*/
 #define RADIUS_SCROLL_STEPS 0.25f
 #define CAMERA_ROTATION_SPEED 1.5f
@@ -60,74 +52,28 @@
 
 #define HEIGHT_CHANGE 0.1f
 
-#define INITIAL_SURFACES_IN_MESH 10
-
-#define MAX_CONTROLPOINTS_IN_MESH 99
-#define MIN_CONTROLPOINTS_IN_MESH 4
-
 #define VERTICES_PER_SQUARE 6
 
-#define FIELD_WIDTH 4.0f
-#define FIELD_HEIGHT 4.0f
-
 #define LIGHT_ROTATION_STEP 50.0f
 
 #define SUN_HEIGHT 5.0f
 #define SUN_RADIUS 10.0f
 
-#define CONTROL_POINTS_PER_SPLINE_SUBPART 4
-
 #define INIT_INTERPOLATION_RESOLUTION 40
 #define MIN_INTERPOLATION_RESOLUTION 2
 #define MAX_INTERPOLATION_RESOLUTION 500
 
 #define BEZIER_CURVE_RESOLUTION 200
 
-#define DELTA 0.0001f
-
 #define UPPER_BOUND_GREY 0.7f
 #define UPPER_BOUND_GREEN 0.5f
 #define UPPER_BOUND_BLUE 0.3f
 
-#define DIMENSIONS 3
-
 #define CAMERA_MOVEMENT_STEP 0.25f
 #define CAMERA_DISTANCE_BEZIER 0.2f
 
-#define BARRIER_STEP 0.01f
-#define BARRIER_COUNT 6
-#define BARRIER_WIDTH 0.1f
-#define BARRIER_HEIGHT 0.2f
-#define ROTATED_BARRIER_COUNT 4
-
-#define TARGET_RADIUS 0.1f
-
-#define HOLE_RADIUS 0.1f
-#define INIT_HOLE_AMOUNT 4
-#define MAX_HOLES 10
-#define MIN_HOLES 1
-#define ATTRACTION_DISTANCE HOLE_RADIUS * 3.0f
-#define ATTRACTION_FACTOR 150
-
-#define MARBLE_RADIUS 0.025f
-
-#define GRAVITY -10.0f
-#define SPRING_CONSTANT 2500
-#define FRICTION 0.997f
-
-/* Murmelkonstanten */
-#define MARBLE_COUNT 10
-
-#define POKE_FACTOR 500
-
 void changeControlPointHeight(GLuint vertexIndex, GLboolean vertexHeightChange);
 
-float calcGradient(float S, float T, int dimension, GLboolean derivativeS);
-
-float interpolate(float S, float T, int dimension);
-
-void initControlPointArray(void);
-
 void handleLogicCalculations(double interval);
 
 void setLightingStatus(GLboolean status);
@@ -146,14 +92,6 @@ void freeArraysLogic(void);
 
 void initLogic(void);
 
-int getControlPointAmount(void);
-
-float getControlPointX(int idx);
-
-float getControlPointY(int idx);
-
-float getControlPointZ(int idx);
-
 float getBezierControlPointX(int idx);
 
 float getBezierControlPointY(int idx);
@@ -164,10 +102,6 @@ void increaseVertices(void);
 
 void decreaseVertices(void);
 
-void increaseHoles(void);
-
-void decreaseHoles(void);
-
 void setg_bezierControlPoint(int idx, float x, float y, float z);
 
 float getBezier(float T, int dimension);
@@ -180,40 +114,10 @@ GLboolean getCameraFlightStatus(void);
 
 float getCameraT(void);
 
-float getBarrierT(int i);
-
-float getBarrierS(int i);
-
-float getHoleAmount(void);
-
-float getHoleT(int i);
-
-float getHoleS(int i);
-
-int getSelectedBarrier(void);
-
-float getTargetT(void);
-
-void setSelectedBarrierIndex(int i);
-
-void moveBarrierRight(void);
-
-void moveBarrierLeft(void);
-
-void moveBarrierUp(void);
-
-void moveBarrierDown(void);
-
-float getMarbleS(int i);
-
-float getMarbleT(int i);
-
 void startMarbles(void);
 
 void resetGame(void);
 
-void pokeMarble(void);
-
-GLboolean isMarbleVisible(int i);
+GLboolean getGameWonStatus(void);
 
-GLboolean getGameWonStatus(void);
\ No newline at end of file
+#endif
@@ -0,0 +1,316 @@
+/**
+ * @file
+ * Microbenchmarks der Flaechen- und Mathematikfunktionen.
+ * Misst einzelne Funktionen der Splineflaeche (Interpolation, Ableitung,
+ * Normale) und der gemeinsamen Mathematik (Inverse, Kreuzprodukt) ohne
+ * Fenster und ohne OpenGL. Die Eingaben werden vorab zufaellig erzeugt und
+ * reihum verwendet, damit der Compiler die Aufrufe nicht zusammenfassen kann.
+ * Mit -j werden die Ergebnisse zusaetzlich als JSON geschrieben ("-" fuer die
+ * Standardausgabe statt der Tabelle), um sie ueber mehrere Commits zu
+ * vergleichen. Mit -H werden zusaetzlich die Hardwarezaehler je Aufruf
+ * gemessen (perfcounters.h).
+ *
+ * Aufruf: ueb03_microbench [-w Aufwaermen] [-n Wiederholungen] [-c Aufrufe] [-r Seed] [-j Datei] [-H]
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "surface.h"
+#include "util.h"
+#include "microbench.h"
+
+/* ---- Konstanten ---- */
+
+#define MICROBENCH_DEFAULT_CALLS 1024
+#define MICROBENCH_DEFAULT_SEED 42
+
+/** Anzahl der vorab erzeugten Eingaben (Zweierpotenz) */
+#define MICROBENCH_INPUTS 1024
+#define MICROBENCH_INPUT_MASK (MICROBENCH_INPUTS - 1)
+
+/* ---- Typedeklarationen ---- */
+
+/** Eingaben der Kernel */
+typedef struct
+{
+    float S[MICROBENCH_INPUTS];
+    float T[MICROBENCH_INPUTS];
+    CGVector3f vectors[MICROBENCH_INPUTS];
+    GLfloat matrices[MICROBENCH_INPUTS][16];
+    /* Ergebnisse, damit die Aufrufe nicht entfernt werden */
+    volatile float sink;
+} MicroBenchInputs;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Misst interpolate.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchInterpolate(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    float sum = 0.0f;
+    for (int i = 0; i < calls; i++)
+    {
+        int k = i & MICROBENCH_INPUT_MASK;
+        sum += interpolate(inputs->S[k], inputs->T[k], LY);
+    }
+    inputs->sink = sum;
+}
+
+/**
+ * Misst calcGradient (Ableitung nach S).
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchCalcGradient(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    float sum = 0.0f;
+    for (int i = 0; i < calls; i++)
+    {
+        int k = i & MICROBENCH_INPUT_MASK;
+        sum += calcGradient(inputs->S[k], inputs->T[k], LY, GL_TRUE);
+    }
+    inputs->sink = sum;
+}
+
+/**
+ * Misst calcVertexNormal.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchCalcVertexNormal(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    float sum = 0.0f;
+    for (int i = 0; i < calls; i++)
+    {
+        int k = i & MICROBENCH_INPUT_MASK;
+        CGVector3f normal;
+        calcVertexNormal(inputs->S[k], inputs->T[k], normal);
+        consumeMicroBenchResult(normal);
+        sum += normal[LY];
+    }
+    inputs->sink = sum;
+}
+
+/**
+ * Misst gluInvertMatrix.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchGluInvertMatrix(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    float sum = 0.0f;
+    for (int i = 0; i < calls; i++)
+    {
+        GLfloat inverse[16];
+        if (gluInvertMatrix(inputs->matrices[i & MICROBENCH_INPUT_MASK], inverse))
+        {
+            consumeMicroBenchResult(inverse);
+            sum += inverse[5];
+        }
+    }
+    inputs->sink = sum;
+}
+
+/**
+ * Misst multiply4x4With4x4Matrix.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchMultiply4x4With4x4Matrix(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    float sum = 0.0f;
+    for (int i = 0; i < calls; i++)
+    {
+        GLfloat product[16];
+        multiply4x4With4x4Matrix(inputs->matrices[i & MICROBENCH_INPUT_MASK],
+                                 inputs->matrices[(i + 1) & MICROBENCH_INPUT_MASK], product);
+        consumeMicroBenchResult(product);
+        sum += product[5];
+    }
+    inputs->sink = sum;
+}
+
+/**
+ * Misst calcCrossProduct.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchCalcCrossProduct(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    float sum = 0.0f;
+    for (int i = 0; i < calls; i++)
+    {
+        CGVector3f cross;
+        calcCrossProduct(inputs->vectors[i & MICROBENCH_INPUT_MASK],
+                         inputs->vectors[(i + 1) & MICROBENCH_INPUT_MASK], cross);
+        consumeMicroBenchResult(cross);
+        sum += cross[0];
+    }
+    inputs->sink = sum;
+}
+
+/**
+ * Misst calcNormalizedCrossProduct.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchCalcNormalizedCrossProduct(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    float sum = 0.0f;
+    for (int i = 0; i < calls; i++)
+    {
+        CGVector3f cross;
+        calcNormalizedCrossProduct(inputs->vectors[i & MICROBENCH_INPUT_MASK],
+                                   inputs->vectors[(i + 1) & MICROBENCH_INPUT_MASK], 1.0f, cross);
+        consumeMicroBenchResult(cross);
+        sum += cross[0];
+    }
+    inputs->sink = sum;
+}
+
+/**
+ * Liefert eine zufaellige Zahl zwischen lower und upper.
+ * @param lower die untere Grenze
+ * @param upper die obere Grenze
+ * @return die zufaellige Zahl
+ */
+static float getRandomInRange(float lower, float upper)
+{
+    return lower + (upper - lower) * (float)rand() / (float)RAND_MAX;
+}
+
+/**
+ * Erzeugt die Eingaben der Kernel.
+ * @param inputs die Eingaben (out-param)
+ */
+static void initInputs(MicroBenchInputs *inputs)
+{
+    for (int i = 0; i < MICROBENCH_INPUTS; i++)
+    {
+        inputs->S[i] = getRandomInRange(0.0f, 1.0f);
+        inputs->T[i] = getRandomInRange(0.0f, 1.0f);
+        setVector(getRandomInRange(-1.0f, 1.0f), getRandomInRange(-1.0f, 1.0f), getRandomInRange(-1.0f, 1.0f), inputs->vectors[i]);
+        //Diagonal dominant, damit die Matrizen invertierbar sind
+        for (int j = 0; j < 16; j++)
+        {
+            inputs->matrices[i][j] = getRandomInRange(-1.0f, 1.0f) + (j % 5 == 0 ? 4.0f : 0.0f);
+        }
+    }
+    inputs->sink = 0.0f;
+}
+
+/**
+ * Hauptprogramm der Microbenchmarks.
+ * @param argc Anzahl der Kommandozeilenparameter
+ * @param argv Kommandozeilenparameter
+ * @return Rueckgabewert im Fehlerfall ungleich Null.
+ */
+int main(int argc, char **argv)
+{
+    int warmup = MICROBENCH_DEFAULT_WARMUP;
+    int repetitions = MICROBENCH_DEFAULT_REPETITIONS;
+    int calls = MICROBENCH_DEFAULT_CALLS;
+    unsigned seed = MICROBENCH_DEFAULT_SEED;
+    const char *jsonPath = NULL;
+    int countHardware = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "w:n:c:r:j:H")) != -1)
+    {
+        switch (opt)
+        {
+        case 'w':
+            warmup = atoi(optarg);
+            break;
+        case 'n':
+            repetitions = atoi(optarg);
+            break;
+        case 'c':
+            calls = atoi(optarg);
+            break;
+        case 'r':
+            seed = (unsigned)atoi(optarg);
+            break;
+        case 'j':
+            jsonPath = optarg;
+            break;
+        case 'H':
+            countHardware = 1;
+            break;
+        default:
+            fprintf(stderr, "Aufruf: %s [-w Aufwaermen] [-n Wiederholungen] [-c Aufrufe] [-r Seed] [-j Datei] [-H]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (warmup < 0 || repetitions < 1 || calls < 1)
+    {
+        fprintf(stderr, "Ungueltige Parameter.\n");
+        return 1;
+    }
+
+    MicroBenchInputs *inputs = malloc(sizeof(MicroBenchInputs));
+    if (inputs == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    srand(seed);
+    initControlPointArray();
+    initInputs(inputs);
+    PerfCounters perfCounters;
+    PerfCounters *counters = NULL;
+    if (countHardware)
+    {
+        openPerfCounters(&perfCounters, 0);
+        counters = &perfCounters;
+    }
+
+    MicroBenchResult results[] = {
+        runMicroBench("interpolate", benchInterpolate, inputs, calls, warmup, repetitions, counters),
+        runMicroBench("calcGradient", benchCalcGradient, inputs, calls, warmup, repetitions, counters),
+        runMicroBench("calcVertexNormal", benchCalcVertexNormal, inputs, calls, warmup, repetitions, counters),
+        runMicroBench("gluInvertMatrix", benchGluInvertMatrix, inputs, calls, warmup, repetitions, counters),
+        runMicroBench("multiply4x4With4x4Matrix", benchMultiply4x4With4x4Matrix, inputs, calls, warmup, repetitions, counters),
+        runMicroBench("calcCrossProduct", benchCalcCrossProduct, inputs, calls, warmup, repetitions, counters),
+        runMicroBench("calcNormalizedCrossProduct", benchCalcNormalizedCrossProduct, inputs, calls, warmup, repetitions, counters),
+    };
+    int resultCount = (int)(sizeof(results) / sizeof(results[0]));
+
+    //Bei JSON auf der Standardausgabe entfaellt die Tabelle
+    if (jsonPath == NULL || strcmp(jsonPath, "-") != 0)
+    {
+        printf("Kontrollpunkte: %d, Aufwaermen: %d, Wiederholungen: %d\n\n", getControlPointAmount(), warmup, repetitions);
+        printMicroBenchHeader();
+        for (int i = 0; i < resultCount; i++)
+        {
+            printMicroBenchResult(&results[i]);
+        }
+        printMicroBenchCounters(results, resultCount);
+    }
+
+    int ok = jsonPath == NULL || writeMicroBenchJson(jsonPath, "ueb03", warmup, results, resultCount);
+    if (counters != NULL)
+    {
+        closePerfCounters(counters);
+    }
+    free(inputs);
+    freeArraysSurface();
+    return ok ? 0 : 1;
+}
@@ -42,6 +42,24 @@ GLfloat g_sunPosMatrix[16] = {0};
 
 /* ---- Funktionsprototypen innerhalb ---- */
 
+/**
+ * Utility Funktion zum setzen der Farbe,
+ * sowie die Materialeigenschaften des zu Zeichnenden Objektes
+ * @param red Der Intensitaetswert fuer den roten Kanal
+ * @param green Der Intensitaetswert fuer den gruenen Kanal
+ * @param blue Der Intensitaetswert fuer den blauen Kanal
+ * @param alpha Der Intensitaetswert fuer den alpha Kanal beim Material
+ * @param face die Seite welche beim Material gesetzt werden soll
+ * @param materialAttribute Materialeigenschaft der Flaeche die geaendert werden soll 
+ * 
+ */
+void setMaterialAndColor(float red, float green, float blue, float alpha, GLenum face, GLenum materialAttribute)
+{
+    glColor3f(red, green, blue);
+    CGColor4f material = {red, green, blue, alpha};
+    glMaterialfv(face, materialAttribute, material);
+}
+
 /**
  * Hilfsmethode welche eine Linie zwischen 2 Punkten zeichnet
  * @param x1 x Koordinate des ersten Punktes
@@ -0,0 +1,1591 @@
+/**
+ * @file
+ * Physik-Modul.
+ * Das Modul kapselt die Simulation der Murmeln auf der Splineflaeche inklusive
+ * der Kollisionen mit Waenden, Barrieren und anderen Murmeln sowie der Anziehung
+ * der schwarzen Loecher. Es kommt ohne OpenGL-Aufrufe aus und kann daher auch
+ * ohne Fenster (z.B. im Benchmark) verwendet werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <string.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "physics.h"
+#include "surface.h"
+#include "util.h"
+#include "grid.h"
+
+/* ---- Globale Daten ---- */
+
+/*Array fuer die Loecher*/
+CGVector2f *g_holes = NULL;
+/* Anzahl der Loecher */
+int g_holesAmount = INIT_HOLE_AMOUNT;
+
+/* Ausgewaehlte Barriere */
+int g_selectedBarrier = 0;
+
+/* Array fuer die Barrieren */
+CGVector2f *g_barriers = NULL;
+/* Anzahl der Barrieren */
+int g_barrierCount = 0;
+
+/* T Position des Ziels */
+float g_targetT = 0;
+
+/* Soll Murmel angestossen werdeen ? */
+GLboolean g_pokeMarble = GL_FALSE;
+
+/* Array fuer die Murmeln */
+Marble *g_marbles = NULL;
+/* Anzahl der Murmeln */
+int g_marbleCount = 0;
+
+/* Zwischengespeicherte Lage der Loecher und Barrieren in Weltkoordinaten */
+Obstacle *g_holeObstacles = NULL;
+Obstacle *g_barrierObstacles = NULL;
+/* Zwischengespeicherte Lage des Ziels in Weltkoordinaten */
+CGVector3f g_targetCenter = {0};
+
+/* Gitter ueber die Wirkungsbereiche der Loecher und Barrieren */
+SpatialGrid g_holeGrid = {0};
+SpatialGrid g_barrierGrid = {0};
+
+/* Muessen die zwischengespeicherten Hindernisse neu berechnet werden? */
+GLboolean g_obstaclesDirty = GL_TRUE;
+
+/* Zwischengespeicherte Lage jeder Murmel als Hindernis, nach jeder Bewegung
+ * aktualisiert */
+Obstacle *g_marbleObstacles = NULL;
+/* Ruhende Murmeln im Gitter: kompakte Kopie der Hindernisse und Murmelindizes */
+Obstacle *g_restingObstacles = NULL;
+int *g_restingIndices = NULL;
+SpatialGrid g_restingGrid = {0};
+/* Ob eine Murmel seit dem Aufbau des Gitters ruhend darin steht */
+GLboolean *g_marbleInRestingGrid = NULL;
+/* Bewegte Murmeln (nicht im Gitter), die jede Murmel prueft */
+int *g_movingMarbles = NULL;
+int g_movingMarbleCount = 0;
+/* Muss das Gitter bzw. die Lage aller Murmeln neu berechnet werden? */
+GLboolean g_restingGridDirty = GL_TRUE;
+GLboolean g_marbleObstaclesDirty = GL_TRUE;
+
+/* Eingestelltes Integrationsverfahren der Murmeln */
+Integrator g_integrator = integratorSemiImplicitEuler;
+
+#ifdef PHYSICS_PROFILING
+/* Aufsummierte Laufzeit der Teilschritte in Nanosekunden */
+double g_stageNanos[PHYSICS_STAGE_COUNT] = {0};
+/* Hardwarezaehler der Teilschritte, NULL fuer keine */
+const PerfCounters *g_perfCounters = NULL;
+/* Zaehlerstaende zu Beginn des laufenden Teilschrittes */
+PerfCounterValues g_stageStartCounters;
+/* Aufsummierte Zaehlerdifferenzen der Teilschritte */
+PerfCounterValues g_stageCounters[PHYSICS_STAGE_COUNT];
+#endif
+
+/* ---- Funktionen ---- */
+
+/**
+ * Liefert den aktuellen Zeitstempel fuer die Zeitmessung.
+ * Ohne PHYSICS_PROFILING wird nichts gemessen.
+ * @return der aktuelle Zeitstempel in Nanosekunden
+ */
+static double profileNanos(void)
+{
+#ifdef PHYSICS_PROFILING
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+#else
+    return 0.0;
+#endif
+}
+
+/**
+ * Startet die Zeitmessung eines Teilschrittes. Die Hardwarezaehler werden
+ * vor der Uhr gelesen, damit ihr Auslesen nicht in die Laufzeit eingeht.
+ * Ohne PHYSICS_PROFILING wird nichts gemessen.
+ * @return der aktuelle Zeitstempel in Nanosekunden
+ */
+static double profileBegin(void)
+{
+#ifdef PHYSICS_PROFILING
+    if (g_perfCounters != NULL)
+    {
+        readPerfCounters(g_perfCounters, &g_stageStartCounters);
+    }
+#endif
+    return profileNanos();
+}
+
+/**
+ * Beendet die Zeitmessung eines Teilschrittes und summiert die Laufzeit und
+ * die Hardwarezaehler auf.
+ * Ohne PHYSICS_PROFILING wird nichts gemessen.
+ * @param stage der gemessene Teilschritt
+ * @param start der Zeitstempel von profileBegin()
+ */
+static void profileEnd(PhysicsStage stage, double start)
+{
+#ifdef PHYSICS_PROFILING
+    g_stageNanos[stage] += profileNanos() - start;
+    if (g_perfCounters != NULL)
+    {
+        PerfCounterValues end;
+        readPerfCounters(g_perfCounters, &end);
+        addPerfCounterDelta(&g_stageCounters[stage], &g_stageStartCounters, &end);
+    }
+#endif
+}
+
+#ifdef PHYSICS_PROFILING
+/**
+ * Liefert die seit dem letzten Zuruecksetzen aufsummierte Laufzeit eines Teilschrittes.
+ * @param stage der Teilschritt
+ * @return die Laufzeit in Nanosekunden
+ */
+double getPhysicsStageNanos(PhysicsStage stage)
+{
+    return g_stageNanos[stage];
+}
+
+/**
+ * Setzt die aufsummierten Laufzeiten aller Teilschritte zurueck.
+ */
+void resetPhysicsStageNanos(void)
+{
+    for (int i = 0; i < PHYSICS_STAGE_COUNT; i++)
+    {
+        g_stageNanos[i] = 0.0;
+    }
+}
+
+/**
+ * Legt die Hardwarezaehler fest, die je Teilschritt gelesen werden, und setzt
+ * deren Summen zurueck.
+ * @param counters die geoeffneten Zaehler, NULL fuer keine
+ */
+void setPhysicsPerfCounters(const PerfCounters *counters)
+{
+    g_perfCounters = counters;
+    for (int i = 0; i < PHYSICS_STAGE_COUNT; i++)
+    {
+        resetPerfCounterValues(&g_stageCounters[i]);
+    }
+}
+
+/**
+ * Liefert die seit setPhysicsPerfCounters aufsummierten Hardwarezaehler eines
+ * Teilschrittes. Sie werden von resetPhysicsStageNanos nicht zurueckgesetzt.
+ * @param stage der Teilschritt
+ * @param values die Zaehlerdifferenzen, -1 fuer nicht verfuegbare (out-param)
+ */
+void getPhysicsStageCounters(PhysicsStage stage, PerfCounterValues *values)
+{
+    *values = g_stageCounters[stage];
+}
+#endif
+
+/**
+ * Liefert die Ausmasse einer Barriere in x- und z-Richtung.
+ * @param i index der Barriere
+ * @param width die Ausdehnung in x-Richtung
+ * @param height die Ausdehnung in z-Richtung
+ */
+static void getBarrierExtents(int i, float *width, float *height)
+{
+    //Ein Teil der Barrieren ist rotiert
+    if (isBarrierRotated(i))
+    {
+        *width = BARRIER_HEIGHT;
+        *height = BARRIER_WIDTH;
+    }
+    else
+    {
+        *width = BARRIER_WIDTH;
+        *height = BARRIER_HEIGHT;
+    }
+}
+
+/**
+ * Weckt eine schlafende Murmel auf.
+ * @param i Index der Murmel
+ */
+static void wakeMarble(int i)
+{
+    g_marbles[i].isSleeping = GL_FALSE;
+    g_marbles[i].restTime = 0.0f;
+    //Bewegt sich ab jetzt, gilt bis zum Neuaufbau als bewegte Murmel
+    if (g_marbleInRestingGrid[i] && g_marbles[i].isVisible)
+    {
+        g_marbleInRestingGrid[i] = GL_FALSE;
+        g_movingMarbles[g_movingMarbleCount++] = i;
+        g_restingGridDirty = GL_TRUE;
+    }
+}
+
+/**
+ * Markiert die zwischengespeicherten Hindernisse als veraltet und weckt alle
+ * Murmeln, da sich ihre Umgebung geaendert hat.
+ * Muss aufgerufen werden, wenn Loecher oder Barrieren verschoben, hinzugefuegt
+ * oder entfernt werden oder sich die Splineflaeche aendert.
+ */
+void invalidateObstacles(void)
+{
+    g_obstaclesDirty = GL_TRUE;
+    g_marbleObstaclesDirty = GL_TRUE;
+    g_restingGridDirty = GL_TRUE;
+    for (int i = 0; i < g_marbleCount; i++)
+    {
+        wakeMarble(i);
+    }
+}
+
+/**
+ * Berechnet die Lage eines Hindernisses in Weltkoordinaten.
+ * @param obstacle das zu berechnende Hindernis
+ * @param position die Position des Hindernisses auf der Flaeche (t, s)
+ * @param halfWidth halbe Ausdehnung in x-Richtung
+ * @param halfHeight halbe Ausdehnung in z-Richtung
+ * @param reach zusaetzliche Reichweite des Wirkungsbereichs
+ */
+static void calculateObstacle(Obstacle *obstacle, float *position, float halfWidth, float halfHeight, float reach)
+{
+    for (int d = 0; d < DIMENSIONS; d++)
+    {
+        obstacle->center[d] = interpolate(position[LS], position[LT], d);
+    }
+    obstacle->halfExtents[0] = halfWidth;
+    obstacle->halfExtents[1] = halfHeight;
+    obstacle->boundsMin[0] = obstacle->center[LX] - halfWidth - reach;
+    obstacle->boundsMin[1] = obstacle->center[LZ] - halfHeight - reach;
+    obstacle->boundsMax[0] = obstacle->center[LX] + halfWidth + reach;
+    obstacle->boundsMax[1] = obstacle->center[LZ] + halfHeight + reach;
+}
+
+/**
+ * Berechnet die Lage aller Hindernisse und des Ziels neu und sortiert die
+ * Hindernisse in die Gitter ein, sofern sie als veraltet markiert sind.
+ */
+static void updateObstacles(void)
+{
+    if (!g_obstaclesDirty)
+    {
+        return;
+    }
+    g_holeObstacles = realloc(g_holeObstacles, sizeof(Obstacle) * (g_holesAmount + 1));
+    g_barrierObstacles = realloc(g_barrierObstacles, sizeof(Obstacle) * (g_barrierCount + 1));
+    if (g_holeObstacles == NULL || g_barrierObstacles == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < g_holesAmount; i++)
+    {
+        calculateObstacle(&g_holeObstacles[i], g_holes[i], 0.0f, 0.0f, ATTRACTION_DISTANCE);
+    }
+    for (int i = 0; i < g_barrierCount; i++)
+    {
+        float barrierWidth;
+        float barrierHeight;
+        getBarrierExtents(i, &barrierWidth, &barrierHeight);
+        calculateObstacle(&g_barrierObstacles[i], g_barriers[i], barrierWidth / 2.0f, barrierHeight / 2.0f, BARRIER_CONTACT_DISTANCE);
+    }
+    for (int d = 0; d < DIMENSIONS; d++)
+    {
+        g_targetCenter[d] = interpolate(1.0f, g_targetT, d);
+    }
+
+    float fieldWidth = getSurfaceWidth();
+    buildSpatialGrid(&g_holeGrid, g_holeObstacles, g_holesAmount, fieldWidth);
+    buildSpatialGrid(&g_barrierGrid, g_barrierObstacles, g_barrierCount, fieldWidth);
+    g_obstaclesDirty = GL_FALSE;
+}
+
+/**
+ * Berechnet die Lage einer Murmel als Hindernis, dessen Wirkungsbereich alle
+ * Murmeln umfasst, die sie beruehren.
+ * @param i Index der Murmel
+ */
+static void calculateMarbleObstacle(int i)
+{
+    calculateObstacle(&g_marbleObstacles[i], g_marbles[i].center, 0.0f, 0.0f, MARBLE_RADIUS * 2 + DELTA);
+}
+
+/**
+ * Teilt die Murmeln in ruhende (schlafend oder verschluckt) und bewegte und
+ * sortiert die ruhenden in ein Gitter ein, sofern sich die Aufteilung seit
+ * dem letzten Aufbau geaendert hat. Die Lage aller Murmeln wird nur nach
+ * einer Aenderung der Flaeche neu interpoliert, sonst nach jeder Bewegung
+ * einzeln, damit die Kollisionen der wachen Murmeln nicht mit der Gesamtzahl
+ * der Murmeln wachsen.
+ */
+static void updateRestingMarbles(void)
+{
+    if (!g_restingGridDirty)
+    {
+        return;
+    }
+    int restingCount = 0;
+    g_movingMarbleCount = 0;
+    for (int i = 0; i < g_marbleCount; i++)
+    {
+        if (g_marbleObstaclesDirty)
+        {
+            calculateMarbleObstacle(i);
+        }
+        g_marbleInRestingGrid[i] = !g_marbles[i].isVisible || g_marbles[i].isSleeping;
+        if (g_marbleInRestingGrid[i])
+        {
+            g_restingObstacles[restingCount] = g_marbleObstacles[i];
+            g_restingIndices[restingCount++] = i;
+        }
+        else
+        {
+            g_movingMarbles[g_movingMarbleCount++] = i;
+        }
+    }
+    buildSpatialGrid(&g_restingGrid, g_restingObstacles, restingCount, getSurfaceWidth());
+    g_marbleObstaclesDirty = GL_FALSE;
+    g_restingGridDirty = GL_FALSE;
+}
+
+/**
+ * Erhoehet die Anzahl der schwarzen Loecher
+ */
+void increaseHoles(void)
+{
+    if (g_holesAmount + 1 <= MAX_HOLES)
+    {
+        g_holesAmount++;
+        CGVector2f *tempHoles = malloc(sizeof(CGVector2f) * g_holesAmount);
+        if (tempHoles != NULL)
+        {
+            for (int i = 0; i < g_holesAmount; i++)
+            {
+                if (i == g_holesAmount - 1)
+                {
+                    tempHoles[i][LT] = getRandomNumber();
+                    tempHoles[i][LS] = getRandomNumber();
+                }
+                else
+                {
+                    tempHoles[i][LT] = g_holes[i][LT];
+                    tempHoles[i][LS] = g_holes[i][LS];
+                }
+            }
+            free(g_holes);
+            g_holes = NULL;
+            g_holes = tempHoles;
+            invalidateObstacles();
+        }
+        else
+        {
+            free(g_holes);
+            printf("Kein virtueller RAM mehr verfügbar ...\n");
+            exit(1);
+        }
+    }
+}
+
+/**
+ * Verringert die Anzahl der schwarzen Loecher
+ */
+void decreaseHoles(void)
+{
+    if (g_holesAmount - 1 >= MIN_HOLES)
+    {
+        g_holesAmount--;
+        CGVector2f *tempHoles = malloc(sizeof(CGVector2f) * g_holesAmount);
+        if (tempHoles != NULL)
+        {
+            for (int i = 0; i < g_holesAmount; i++)
+            {
+                tempHoles[i][LT] = g_holes[i][LT];
+                tempHoles[i][LS] = g_holes[i][LS];
+            }
+            free(g_holes);
+            g_holes = NULL;
+            g_holes = tempHoles;
+            invalidateObstacles();
+        }
+        else
+        {
+            free(tempHoles);
+            printf("Kein virtueller RAM mehr verfügbar ...\n");
+            exit(1);
+        }
+    }
+}
+
+/**
+ * Initialisiert die Murmeln.
+ * Die Murmeln werden in Reihen zu je MARBLE_SLOTS_PER_ROW am Start aufgestellt.
+ */
+static void initMarbles(void)
+{
+    float fieldWidth = getSurfaceWidth();
+    float minMarbleSpacing = MARBLE_RADIUS / fieldWidth;
+    int slotsPerRow = g_marbleCount < MARBLE_SLOTS_PER_ROW ? g_marbleCount : MARBLE_SLOTS_PER_ROW;
+    for (int i = 0; i < g_marbleCount; i++)
+    {
+        int slot = i % slotsPerRow;
+        int row = i / slotsPerRow;
+        float currPossiblePositionT = slot + getRandomNumber();
+        g_marbles[i].center[LT] = clip((currPossiblePositionT / slotsPerRow), ((float)slot / slotsPerRow) + minMarbleSpacing, ((slot + 1.0f) / slotsPerRow) - minMarbleSpacing);
+        float S = (MARBLE_RADIUS + row * 3.0f * MARBLE_RADIUS) / fieldWidth;
+        g_marbles[i].center[LS] = clip(S, 0.0f, 1.0f);
+        g_marbles[i].velocity[LX] = 0.0f;
+        g_marbles[i].velocity[LY] = 0.0f;
+        g_marbles[i].velocity[LZ] = 0.0f;
+        g_marbles[i].mass = getRandomNumber() + 1.0f;
+        g_marbles[i].isVisible = GL_TRUE;
+        g_marbles[i].isSleeping = GL_FALSE;
+        g_marbles[i].restTime = 0.0f;
+    }
+}
+
+/**
+ * Initialisiert die schwarzen Loecher
+ */
+static void initHoles(void)
+{
+    g_holes = realloc(g_holes, sizeof(CGVector2f) * g_holesAmount);
+    if (g_holes != NULL || g_holesAmount == 0)
+    {
+        for (int i = 0; i < g_holesAmount; i++)
+        {
+            g_holes[i][LT] = getRandomNumber();
+            g_holes[i][LS] = getRandomNumber();
+        }
+    }
+    else
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+}
+
+/**
+ * Initialisiert die Barrieren
+ */
+static void initBarriers(void)
+{
+    for (int i = 0; i < g_barrierCount; i++)
+    {
+        g_barriers[i][LT] = getRandomNumber();
+        g_barriers[i][LS] = getRandomNumber();
+    }
+}
+
+/**
+ * Initialisiert das Ziel an einem Random t-Wert
+ */
+static void initTarget(void)
+{
+    g_targetT = getRandomNumber();
+}
+
+/**
+ * Initialisiert Murmeln, Loecher, Barrieren und Ziel auf der Splineflaeche.
+ * Die Splineflaeche muss vorher initialisiert sein, da die Startpositionen der
+ * Murmeln von deren Breite abhaengen.
+ * @param marbleCount Anzahl der Murmeln
+ * @param holeCount Anzahl der schwarzen Loecher
+ * @param barrierCount Anzahl der Barrieren
+ */
+void initPhysics(int marbleCount, int holeCount, int barrierCount)
+{
+    g_marbleCount = marbleCount;
+    g_holesAmount = holeCount;
+    g_barrierCount = barrierCount;
+    g_selectedBarrier = 0;
+    g_pokeMarble = GL_FALSE;
+
+    g_marbles = realloc(g_marbles, sizeof(Marble) * g_marbleCount);
+    g_barriers = realloc(g_barriers, sizeof(CGVector2f) * g_barrierCount);
+    //+ 1, damit auch ohne Murmeln gueltige Zeiger entstehen
+    g_marbleObstacles = realloc(g_marbleObstacles, sizeof(Obstacle) * (g_marbleCount + 1));
+    g_restingObstacles = realloc(g_restingObstacles, sizeof(Obstacle) * (g_marbleCount + 1));
+    g_restingIndices = realloc(g_restingIndices, sizeof(int) * (g_marbleCount + 1));
+    g_marbleInRestingGrid = realloc(g_marbleInRestingGrid, sizeof(GLboolean) * (g_marbleCount + 1));
+    g_movingMarbles = realloc(g_movingMarbles, sizeof(int) * (g_marbleCount + 1));
+    if ((g_marbles == NULL && g_marbleCount > 0) || (g_barriers == NULL && g_barrierCount > 0) ||
+        g_marbleObstacles == NULL || g_restingObstacles == NULL || g_restingIndices == NULL ||
+        g_marbleInRestingGrid == NULL || g_movingMarbles == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    memset(g_marbleInRestingGrid, 0, sizeof(GLboolean) * (g_marbleCount + 1));
+    g_movingMarbleCount = 0;
+
+    initBarriers();
+    initHoles();
+    initTarget();
+    initMarbles();
+    invalidateObstacles();
+}
+
+/**
+ * Gibt den Speicher der dynamisch allozierten Arrays der Physik frei
+ */
+void freeArraysPhysics(void)
+{
+    free(g_holes);
+    free(g_barriers);
+    free(g_marbles);
+    free(g_holeObstacles);
+    free(g_barrierObstacles);
+    free(g_marbleObstacles);
+    free(g_restingObstacles);
+    free(g_restingIndices);
+    free(g_marbleInRestingGrid);
+    free(g_movingMarbles);
+    g_marbleObstacles = NULL;
+    g_restingObstacles = NULL;
+    g_restingIndices = NULL;
+    g_marbleInRestingGrid = NULL;
+    g_movingMarbles = NULL;
+    g_movingMarbleCount = 0;
+    g_holes = NULL;
+    g_barriers = NULL;
+    g_marbles = NULL;
+    g_holeObstacles = NULL;
+    g_barrierObstacles = NULL;
+    freeSpatialGrid(&g_holeGrid);
+    freeSpatialGrid(&g_barrierGrid);
+    freeSpatialGrid(&g_restingGrid);
+    g_obstaclesDirty = GL_TRUE;
+    g_restingGridDirty = GL_TRUE;
+    g_marbleObstaclesDirty = GL_TRUE;
+}
+
+/**
+ * Berechnet per Slab-Test, wann ein Punkt auf dem Weg von start nach start + delta
+ * in ein achsparalleles Rechteck auf der x-z-Ebene eintritt.
+ * Liegt der Startpunkt bereits im Rechteck, wird keine Kollision gemeldet, da
+ * diese Eindringung von der Penalty-Methode behandelt wird.
+ * @param start der Startpunkt (x, z)
+ * @param delta der Verschiebungsvektor (x, z)
+ * @param boxMin die minimale Ecke des Rechtecks (x, z)
+ * @param boxMax die maximale Ecke des Rechtecks (x, z)
+ * @param normal die Normale der getroffenen Seite (x, y, z)
+ * @return der Anteil [0-1] der Verschiebung bis zum Eintritt, sonst -1
+ */
+static float sweepPointAgainstBox(float *start, float *delta, float *boxMin, float *boxMax, float *normal)
+{
+    float tEnter = -INFINITY;
+    float tExit = INFINITY;
+    int enterAxis = 0;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (fabsf(delta[axis]) < DELTA * DELTA)
+        {
+            //Parallel zur Seite und ausserhalb -> keine Kollision moeglich
+            if (start[axis] < boxMin[axis] || start[axis] > boxMax[axis])
+            {
+                return -1.0f;
+            }
+        }
+        else
+        {
+            float t1 = (boxMin[axis] - start[axis]) / delta[axis];
+            float t2 = (boxMax[axis] - start[axis]) / delta[axis];
+            float tNear = fminf(t1, t2);
+            float tFar = fmaxf(t1, t2);
+            if (tNear > tEnter)
+            {
+                tEnter = tNear;
+                enterAxis = axis;
+            }
+            tExit = fminf(tExit, tFar);
+        }
+    }
+    if (tEnter > tExit || tEnter < 0.0f || tEnter > 1.0f)
+    {
+        return -1.0f;
+    }
+    //Normale zeigt der Bewegung entgegen, Achse 0 = x, Achse 1 = z
+    setVector(0.0f, 0.0f, 0.0f, normal);
+    normal[enterAxis == 0 ? LX : LZ] = delta[enterAxis] > 0.0f ? -1.0f : 1.0f;
+    return tEnter;
+}
+
+/**
+ * Berechnet, wann ein Punkt auf dem Weg von start nach start + delta ein
+ * achsparalleles Rechteck auf der x-z-Ebene verlaesst (Waende des Spielfeldes).
+ * @param start der Startpunkt (x, z)
+ * @param delta der Verschiebungsvektor (x, z)
+ * @param boxMin die minimale Ecke des Rechtecks (x, z)
+ * @param boxMax die maximale Ecke des Rechtecks (x, z)
+ * @param normal die Normale der getroffenen Wand (x, y, z)
+ * @return der Anteil [0-1] der Verschiebung bis zum Austritt, sonst -1
+ */
+static float sweepPointOutOfBox(float *start, float *delta, float *boxMin, float *boxMax, float *normal)
+{
+    float tHit = -1.0f;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        float t = -1.0f;
+        float wallNormal = 0.0f;
+        if (delta[axis] > 0.0f && start[axis] <= boxMax[axis])
+        {
+            t = (boxMax[axis] - start[axis]) / delta[axis];
+            wallNormal = -1.0f;
+        }
+        else if (delta[axis] < 0.0f && start[axis] >= boxMin[axis])
+        {
+            t = (boxMin[axis] - start[axis]) / delta[axis];
+            wallNormal = 1.0f;
+        }
+        if (t >= 0.0f && t <= 1.0f && (tHit < 0.0f || t < tHit))
+        {
+            tHit = t;
+            setVector(0.0f, 0.0f, 0.0f, normal);
+            normal[axis == 0 ? LX : LZ] = wallNormal;
+        }
+    }
+    return tHit;
+}
+
+/**
+ * Sucht den fruehesten Treffer einer Murmel mit den Waenden oder Barrieren
+ * entlang ihrer Verschiebung in diesem Zeitschritt.
+ * @param start der Startpunkt der Murmel (x, z)
+ * @param delta der Verschiebungsvektor der Murmel (x, z)
+ * @param normal die Normale der getroffenen Flaeche (x, y, z)
+ * @return der Anteil [0-1] der Verschiebung bis zum Treffer, sonst -1
+ */
+static float findTimeOfImpact(float *start, float *delta, float *normal)
+{
+    CGVector3f hitNormal = {0};
+    //Waende: Mittelpunkt darf sich nur bis auf MARBLE_RADIUS naehern
+    float halfWidth = getSurfaceWidth() / 2.0f;
+    CGVector2f fieldMin = {-halfWidth + MARBLE_RADIUS, -halfWidth + MARBLE_RADIUS};
+    CGVector2f fieldMax = {halfWidth - MARBLE_RADIUS, halfWidth - MARBLE_RADIUS};
+    float toi = sweepPointOutOfBox(start, delta, fieldMin, fieldMax, hitNormal);
+    if (toi >= 0.0f)
+    {
+        memcpy(normal, hitNormal, sizeof(CGVector3f));
+    }
+
+    //Barrieren: Wirkungsbereich ist um den Kontaktabstand der Penalty-Methode vergroessert.
+    //Nur die Gitterzellen entlang des Weges muessen geprueft werden.
+    int minCellX = getSpatialGridCellCoord(&g_barrierGrid, fminf(start[0], start[0] + delta[0]));
+    int maxCellX = getSpatialGridCellCoord(&g_barrierGrid, fmaxf(start[0], start[0] + delta[0]));
+    int minCellZ = getSpatialGridCellCoord(&g_barrierGrid, fminf(start[1], start[1] + delta[1]));
+    int maxCellZ = getSpatialGridCellCoord(&g_barrierGrid, fmaxf(start[1], start[1] + delta[1]));
+    for (int cellZ = minCellZ; cellZ <= maxCellZ; cellZ++)
+    {
+        for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+        {
+            int *barrierIndices = NULL;
+            int barrierAmount = getSpatialGridCellItems(&g_barrierGrid, cellX, cellZ, &barrierIndices);
+            for (int k = 0; k < barrierAmount; k++)
+            {
+                Obstacle *barrier = &g_barrierObstacles[barrierIndices[k]];
+                float t = sweepPointAgainstBox(start, delta, barrier->boundsMin, barrier->boundsMax, hitNormal);
+                if (t >= 0.0f && (toi < 0.0f || t < toi))
+                {
+                    toi = t;
+                    memcpy(normal, hitNormal, sizeof(CGVector3f));
+                }
+            }
+        }
+    }
+    return toi;
+}
+
+/**
+ * Spiegelt einen Vektor an der Ebene mit der uebergebenen Normalen
+ * (Einfallswinkel = Ausfallswinkel), sofern er auf die Ebene zu zeigt.
+ * @param v der zu spiegelnde Vektor (x, y, z)
+ * @param normal die normierte Normale der Ebene
+ */
+static void reflectVector(float *v, float *normal)
+{
+    float vDotN = calcDotProduct(v, normal);
+    if (vDotN < 0.0f)
+    {
+        CGVector3f reflection = {0};
+        multiplyVectorWithScalar(normal, 2.0f * vDotN, reflection);
+        subtractVectos(v, reflection, v);
+    }
+}
+
+/**
+ * Verschiebt eine schnelle Murmel mit kontinuierlicher Kollisionserkennung.
+ * Trifft der Weg der Murmel eine Wand oder Barriere, wird sie bis zum
+ * Trefferzeitpunkt bewegt, ihre Geschwindigkeit gespiegelt und der Rest des
+ * Zeitschritts mit der neuen Richtung fortgesetzt.
+ * @param i Index der Murmel
+ * @param position die Position der Murmel (x, z), wird aktualisiert
+ * @param delta die Verschiebung der Murmel in diesem Zeitschritt (x, z)
+ */
+static void sweepMarble(int i, float *position, float *delta)
+{
+    CGVector2f remaining = {delta[0], delta[1]};
+    for (int iteration = 0; iteration < CCD_MAX_ITERATIONS; iteration++)
+    {
+        CGVector3f normal = {0};
+        float toi = findTimeOfImpact(position, remaining, normal);
+        if (toi < 0.0f)
+        {
+            position[0] += remaining[0];
+            position[1] += remaining[1];
+            return;
+        }
+        position[0] += remaining[0] * toi;
+        position[1] += remaining[1] * toi;
+
+        //Restliche Verschiebung und Geschwindigkeit spiegeln
+        CGVector3f rest = {remaining[0] * (1.0f - toi), 0.0f, remaining[1] * (1.0f - toi)};
+        reflectVector(rest, normal);
+        reflectVector(g_marbles[i].velocity, normal);
+        remaining[0] = rest[LX];
+        remaining[1] = rest[LZ];
+    }
+    //Zu viele Treffer in einem Schritt: Murmel bleibt am letzten Trefferpunkt
+}
+
+/**
+ * Legt eine Murmel schlafen, wenn Geschwindigkeit und resultierende
+ * Beschleunigung fuer SLEEP_TIME unter den Schwellwerten bleiben.
+ * Betrachtet werden nur die x- und z-Anteile, da die Position der Murmel nur
+ * in der Ebene fortgeschrieben wird und die Hoehe aus der Flaeche folgt.
+ * @param interval die verstrichen Zeit
+ * @param i Index der Kugel
+ * @param accelaration die resultierende Beschleunigung der Kugel
+ */
+static void updateMarbleSleep(double interval, int i, float *accelaration)
+{
+    float *velocity = g_marbles[i].velocity;
+    float planarSpeed = velocity[LX] * velocity[LX] + velocity[LZ] * velocity[LZ];
+    float planarAccelaration = accelaration[LX] * accelaration[LX] + accelaration[LZ] * accelaration[LZ];
+    if (planarSpeed < SLEEP_VELOCITY * SLEEP_VELOCITY &&
+        planarAccelaration < SLEEP_ACCELERATION * SLEEP_ACCELERATION)
+    {
+        g_marbles[i].restTime += interval;
+        if (g_marbles[i].restTime >= SLEEP_TIME)
+        {
+            g_marbles[i].isSleeping = GL_TRUE;
+            setVector(0.0f, 0.0f, 0.0f, velocity);
+        }
+    }
+    else
+    {
+        g_marbles[i].restTime = 0.0f;
+    }
+}
+
+/**
+ * Berechnet die Gegenbeschleunigung nach der Penalty-Methode
+ * @param penetrationDepth die Eindringungstiefe in das Objekt
+ * @param penaltyAccelaration die berechnete Gegenbeschleunigung
+ * @param normal die normale des Objekts mit dem Kollidiert wurde
+ * @param i index der Murmel
+ */
+static void calculatePenaltyAccelaration(float penetrationDepth, float *penaltyAccelaration, float *normal, int i)
+{
+    //Falls mehere kraefte innerhalb einer kollision auf die Murmeln wirken
+    CGVector3f tempPenaltyAcceleration = {0};
+    // f = k * d
+    float fPenalty = SPRING_CONSTANT * penetrationDepth;
+    CGVector3f fPenaltyVector = {0};
+    // fpenalty = f * n
+    multiplyVectorWithScalar(normal, fPenalty, fPenaltyVector);
+    // a = fpenalty / m
+    divideVectorWithScalar(fPenaltyVector, g_marbles[i].mass, tempPenaltyAcceleration);
+    addVectors(penaltyAccelaration, tempPenaltyAcceleration, penaltyAccelaration);
+}
+
+/**
+ * Kuemmert sich um die Kollisionen der Murmel mit den Waenden
+ * @param i der Index der Murmel
+ * @param worldX die X Koord. der Murmel in Weltkoord.
+ * @param worldZ die Z Koord. der Murmel in Weltkoord.
+ * @param penaltyAccelaration die berechnete Gegenbeschleunigung
+ */
+static void handleCollisionWithWall(int i, float worldX, float worldZ, float *penaltyAccelaration)
+{
+    float interpolatedMeshWidth = getSurfaceWidth() / 2.0f;
+
+    float distanceToLeftWall = (worldX - MARBLE_RADIUS) - (-interpolatedMeshWidth);
+    //Umgedreht da Distanz innerhalb des Spielfeldes immer positiv ist.
+    float distanceToRightWall = interpolatedMeshWidth - (worldX + MARBLE_RADIUS);
+    float distanceToUpperWall = (worldZ - MARBLE_RADIUS) - (-interpolatedMeshWidth);
+    //Umgedreht da Distanz innerhalb des Spielfeldes immer positiv ist.
+    float distanceToLowerWall = interpolatedMeshWidth - (worldZ + MARBLE_RADIUS);
+
+    CGVector3f normal = {0};
+    //Linke Wand beruehrt
+    if (distanceToLeftWall <= 0.0f - DELTA)
+    {
+        setVector(1.0f, 0.0f, 0.0f, normal);
+
+        calculatePenaltyAccelaration(-distanceToLeftWall, penaltyAccelaration, normal, i);
+    }
+    //Rechte Wand beruehrt
+    if (distanceToRightWall <= 0.0f - DELTA)
+    {
+        setVector(-1.0f, 0.0f, 0.0f, normal);
+        calculatePenaltyAccelaration(-distanceToRightWall, penaltyAccelaration, normal, i);
+    }
+    //Obere Wand beruehrt
+    if (distanceToUpperWall <= 0.0f - DELTA)
+    {
+        setVector(0.0f, 0.0f, 1.0f, normal);
+        calculatePenaltyAccelaration(-distanceToUpperWall, penaltyAccelaration, normal, i);
+    }
+    //Untere Wand beruehrt
+    if (distanceToLowerWall <= 0.0f + DELTA)
+    {
+        setVector(0.0f, 0.0f, -1.0f, normal);
+        calculatePenaltyAccelaration(-distanceToLowerWall, penaltyAccelaration, normal, i);
+    }
+}
+
+/**
+ * Prueft ob die Murmel eine Barriere getroffen hat.
+ * @param px x-Wert der Kollisions der Murmel
+ * @param py y-Wert der Kollisions der Murmel
+ * @param cx x-Position der Barriere
+ * @param cz z-Position der Barriere
+ * @param w Breite der Barriere
+ * @param h Hoehe der Barriere
+ * @return GL_TRUE wenn Kollision
+ */
+static GLboolean isPointInBox(float px, float py, float cx, float cz, float w, float h)
+{
+    return px >= cx - w / 2.0f && px <= cx + w / 2.0f && py >= cz - h / 2.0f && py <= cz + h / 2.0f;
+}
+
+/**
+ * Kuemmert sich die Kollision der Murmel mit den Barrieren
+ * @param i der Index der Murmel
+ * @param worldX die X Koord. der Murmel in Weltkoord.
+ * @param worldY die Y Koord. der Murmel in Weltkoord.
+ * @param worldZ die Z Koord. der Murmel in Weltkoord.
+ * @param penaltyAccelaration die berechnete Gegenbeschleunigung
+ */
+static void handleCollisionWithBarriers(int i, float worldX, float worldY, float worldZ, float *penaltyAccelaration)
+{
+    //Nur Barrieren, deren Wirkungsbereich die Zelle der Murmel beruehrt
+    int *barrierIndices = NULL;
+    int barrierAmount = getSpatialGridCellItems(&g_barrierGrid,
+                                                getSpatialGridCellCoord(&g_barrierGrid, worldX),
+                                                getSpatialGridCellCoord(&g_barrierGrid, worldZ),
+                                                &barrierIndices);
+    for (int k = 0; k < barrierAmount; k++)
+    {
+        Obstacle *barrier = &g_barrierObstacles[barrierIndices[k]];
+        float x = barrier->center[LX];
+        float z = barrier->center[LZ];
+        float barrierWidth = barrier->halfExtents[0] * 2.0f;
+        float barrierHeight = barrier->halfExtents[1] * 2.0f;
+        CGVector3f normal = {0};
+        float marbleLeft = worldX - MARBLE_RADIUS * 2;
+        float marbleRight = worldX + MARBLE_RADIUS * 2;
+        float marbleUp = worldZ - MARBLE_RADIUS * 2;
+        float marbleDown = worldZ + MARBLE_RADIUS * 2;
+
+        //Rechte Wand beruehrt
+        if (isPointInBox(marbleLeft, worldZ, x, z, barrierWidth, barrierHeight))
+        {
+            setVector(1.0f, 0.0f, 0.0f, normal);
+            float distanceToRightWall = marbleLeft - (x + barrierWidth / 2.0f);
+            calculatePenaltyAccelaration(-distanceToRightWall, penaltyAccelaration, normal, i);
+        }
+        //Linke Wand beruehrt
+        if (isPointInBox(marbleRight, worldZ, x, z, barrierWidth, barrierHeight))
+        {
+            setVector(-1.0f, 0.0f, 0.0f, normal);
+            float distanceToLeftWall = (x - barrierWidth / 2.0f) - marbleRight;
+            calculatePenaltyAccelaration(-distanceToLeftWall, penaltyAccelaration, normal, i);
+        }
+        //Untere Wand beruehrt
+        if (isPointInBox(worldX, marbleUp, x, z, barrierWidth, barrierHeight))
+        {
+            setVector(0.0f, 0.0f, 1.0f, normal);
+            float distanceToLowerWall = marbleUp - (z + barrierHeight / 2.0f);
+            calculatePenaltyAccelaration(-distanceToLowerWall, penaltyAccelaration, normal, i);
+        }
+        //Obere Wand beruehrt
+        if (isPointInBox(worldX, marbleDown, x, z, barrierWidth, barrierHeight))
+        {
+            setVector(0.0f, 0.0f, -1.0f, normal);
+            float distanceToUpperWall = (z - barrierHeight / 2.0f) - marbleDown;
+            calculatePenaltyAccelaration(-distanceToUpperWall, penaltyAccelaration, normal, i);
+        }
+    }
+}
+
+/**
+ * Behandelt die Kollision einer Murmel mit einer anderen Murmel.
+ * @param i der Index der Murmel
+ * @param j der Index der anderen Murmel
+ * @param world die Lage der Murmel in Weltkoord.
+ * @param other die Lage der anderen Murmel in Weltkoord.
+ * @param penaltyAccelaration die berechnete Gegenbeschleunigung
+ */
+static void handleCollisionWithMarble(int i, int j, const float *world, const float *other, float *penaltyAccelaration)
+{
+    CGVector3f distanceVector = {world[LX] - other[LX], world[LY] - other[LY], world[LZ] - other[LZ]};
+    float distanceBetweenMarbles = calcVectorLength(distanceVector);
+    //TODO: Klaeren ob in ordnung
+    if (distanceBetweenMarbles <= (MARBLE_RADIUS * 2) + DELTA)
+    {
+        //Angestossene Murmel aufwecken
+        if (g_marbles[j].isSleeping)
+        {
+            wakeMarble(j);
+        }
+        CGVector3f normal = {0};
+        divideVectorWithScalar(distanceVector, distanceBetweenMarbles, normal);
+        float penetrationDepth = ((MARBLE_RADIUS * 2) + DELTA) - distanceBetweenMarbles;
+        calculatePenaltyAccelaration(penetrationDepth, penaltyAccelaration, normal, i);
+    }
+}
+
+/**
+ * Kuemmert sich um die Kollisionen der Murmeln untereinder. Bewegte Murmeln
+ * werden alle geprueft, ruhende nur aus der Zelle der Murmel im Gitter, die
+ * Lage beider kommt aus dem Zwischenspeicher. Paare zweier ruhender Murmeln
+ * werden so nie betrachtet.
+ * @param i der Index der Murmel
+ * @param worldX die X Koord. der Murmel in Weltkoord.
+ * @param worldY die Y Koord. der Murmel in Weltkoord.
+ * @param worldZ die Z Koord. der Murmel in Weltkoord.
+ * @param penaltyAccelaration die berechnete Gegenbeschleunigung
+ */
+static void handleCollisionWithMarbles(int i, float worldX, float worldY, float worldZ, float *penaltyAccelaration)
+{
+    CGVector3f world = {worldX, worldY, worldZ};
+    for (int k = 0; k < g_movingMarbleCount; k++)
+    {
+        int j = g_movingMarbles[k];
+        if (j != i)
+        {
+            handleCollisionWithMarble(i, j, world, g_marbleObstacles[j].center, penaltyAccelaration);
+        }
+    }
+
+    int *restingIndices = NULL;
+    int restingAmount = getSpatialGridCellItems(&g_restingGrid,
+                                                getSpatialGridCellCoord(&g_restingGrid, worldX),
+                                                getSpatialGridCellCoord(&g_restingGrid, worldZ),
+                                                &restingIndices);
+    for (int k = 0; k < restingAmount; k++)
+    {
+        int j = g_restingIndices[restingIndices[k]];
+        //Seit dem Aufbau aufgeweckte Murmeln stehen bei den bewegten
+        if (j != i && g_marbleInRestingGrid[j])
+        {
+            handleCollisionWithMarble(i, j, world, g_restingObstacles[restingIndices[k]].center, penaltyAccelaration);
+        }
+    }
+}
+
+/**
+ * Prueft ob eine Murmel innerhab eine Sphaere liegt
+ * @param i der Index der Murmel
+ * @param center der Mittelpunkt der zu ueberpuefenden Sphaere in Weltkoord.
+ * @param raduis der Radius der zu ueberpuefenden Sphaere
+ * @return ob die Murmel innerhalb der Sphare liegt oder nicht
+ */
+static GLboolean checkMarbleInSphere(int i, float *center, float radius)
+{
+    GLboolean ret = GL_FALSE;
+    CGVector2f marblePosition = {g_marbles[i].center[LT], g_marbles[i].center[LS]};
+    float worldX = interpolate(marblePosition[LS], marblePosition[LT], LX);
+    float worldY = interpolate(marblePosition[LS], marblePosition[LT], LY);
+    float worldZ = interpolate(marblePosition[LS], marblePosition[LT], LZ);
+    CGVector3f distanceVector = {worldX - center[LX], worldY - center[LY], worldZ - center[LZ]};
+    float distanceToTarget = calcVectorLength(distanceVector);
+    if (distanceToTarget + MARBLE_RADIUS <= radius - DELTA)
+    {
+        ret = GL_TRUE;
+    }
+    return ret;
+}
+
+/**
+ * Kuemmert sich um die Anziehung bei den Schwarzen loechern
+ * @param i der Index der Kugel
+ * @param worldX die x Koord. der Murmel in Weltkoord.
+ * @param worldY die y Koord. der Murmel in Weltkoord.
+ * @param worldZ die z Koord. der Murmel in Weltkoord.
+ * @param penaltyAccelaration die berechnete Gegenbeschleunigung
+ */
+static void handleAttraction(int i, float worldX, float worldY, float worldZ, float *penaltyAccelaration)
+{
+    //Nur Loecher, deren Wirkungsbereich die Zelle der Murmel beruehrt
+    int *holeIndices = NULL;
+    int holeAmount = getSpatialGridCellItems(&g_holeGrid,
+                                             getSpatialGridCellCoord(&g_holeGrid, worldX),
+                                             getSpatialGridCellCoord(&g_holeGrid, worldZ),
+                                             &holeIndices);
+    for (int k = 0; k < holeAmount; k++)
+    {
+        Obstacle *hole = &g_holeObstacles[holeIndices[k]];
+        float centerHoleX = hole->center[LX];
+        float centerHoleY = hole->center[LY];
+        float centerHoleZ = hole->center[LZ];
+        CGVector3f distanceVector = {centerHoleX - worldX, centerHoleY - worldY, centerHoleZ - worldZ};
+        float distanceBetweenMarbleAndHole = calcVectorLength(distanceVector);
+        if (distanceBetweenMarbleAndHole <= ATTRACTION_DISTANCE - DELTA)
+        {
+            float attractionValue = ATTRACTION_DISTANCE - DELTA - distanceBetweenMarbleAndHole;
+            multiplyVectorWithScalar(distanceVector, attractionValue * ATTRACTION_FACTOR, distanceVector);
+            addVectors(penaltyAccelaration, distanceVector, penaltyAccelaration);
+        }
+        //Murmel wurde verschluckt
+        if (distanceBetweenMarbleAndHole + MARBLE_RADIUS <= HOLE_RADIUS - DELTA)
+        {
+            g_marbles[i].isVisible = GL_FALSE;
+        }
+    }
+}
+
+/**
+ * Berechnet die Beschleunigung einer Kugel an einer beliebigen Position.
+ * Diese setzt sich aus der Hangabtriebskraft, den Gegenbeschleunigungen der
+ * Kollisionen, der Anziehung der Loecher und einer aeusseren Beschleunigung
+ * (Anstupsen) zusammen.
+ * @param i der Index der Kugel
+ * @param position die Position der Kugel in Weltkoord. (x, z)
+ * @param externalAccelaration zusaetzliche aeussere Beschleunigung
+ * @param accelaration die berechnete Beschleunigung (out-param)
+ */
+static void calculateMarbleAccelaration(int i, float *position, float *externalAccelaration, float *accelaration)
+{
+    float S;
+    float T;
+    convertGlobalCoorinatesToInterpolationInterval(position[0], position[1], getSurfaceWidth(), &S, &T);
+    float worldX = position[0];
+    float worldY = interpolate(S, T, LY);
+    float worldZ = position[1];
+
+    CGVector3f normal = {0};
+    CGVector3f gravity = {0.0f, GRAVITY, 0.0f};
+    CGVector3f l = {0};
+    CGVector3f force = {0};
+    CGVector3f penaltyAccelaration = {0.0f, 0.0f, 0.0f};
+
+    //Normale der Flaeche holen
+    calcVertexNormal(S, T, normal);
+    // g * n
+    float gravityProjectedOnNegativNormal = calcDotProduct(gravity, normal);
+    // l = n * (g * n)
+    multiplyVectorWithScalar(normal, gravityProjectedOnNegativNormal, l);
+    // f = g - l
+    subtractVectos(gravity, l, force);
+    // a = f / m
+    divideVectorWithScalar(force, g_marbles[i].mass, accelaration);
+
+    double start = profileBegin();
+    handleCollisionWithWall(i, worldX, worldZ, penaltyAccelaration);
+    handleCollisionWithBarriers(i, worldX, worldY, worldZ, penaltyAccelaration);
+    handleCollisionWithMarbles(i, worldX, worldY, worldZ, penaltyAccelaration);
+    profileEnd(physicsStageCollision, start);
+
+    start = profileBegin();
+    handleAttraction(i, worldX, worldY, worldZ, penaltyAccelaration);
+    profileEnd(physicsStageAttraction, start);
+
+    //Beschleunigungen zusammenrechnen
+    addVectors(accelaration, penaltyAccelaration, accelaration);
+    addVectors(accelaration, externalAccelaration, accelaration);
+}
+
+/**
+ * Integriert eine Kugel mit dem semi-impliziten Euler-Verfahren.
+ * Eine Auswertung der Beschleunigung pro Schritt.
+ * @param interval die verstrichen Zeit
+ * @param i Index der Kugel
+ * @param position die Position der Kugel in Weltkoord. (x, z)
+ * @param velocity die Geschwindigkeit der Kugel, wird aktualisiert
+ * @param externalAccelaration zusaetzliche aeussere Beschleunigung
+ * @param displacement die Verschiebung der Kugel (x, z) (out-param)
+ * @param accelaration die Beschleunigung am Anfang des Schritts (out-param)
+ */
+static void integrateSemiImplicitEuler(double interval, int i, float *position, float *velocity,
+                                       float *externalAccelaration, float *displacement, float *accelaration)
+{
+    calculateMarbleAccelaration(i, position, externalAccelaration, accelaration);
+    // v = v + delta(t) * a
+    for (int d = 0; d < DIMENSIONS; d++)
+    {
+        velocity[d] += interval * accelaration[d];
+    }
+    // delta(s) = delta(t) * v
+    displacement[0] = interval * velocity[LX];
+    displacement[1] = interval * velocity[LZ];
+}
+
+/**
+ * Integriert eine Kugel mit dem Velocity-Verlet-Verfahren.
+ * Zwei Auswertungen der Beschleunigung pro Schritt.
+ * @param interval die verstrichen Zeit
+ * @param i Index der Kugel
+ * @param position die Position der Kugel in Weltkoord. (x, z)
+ * @param velocity die Geschwindigkeit der Kugel, wird aktualisiert
+ * @param externalAccelaration zusaetzliche aeussere Beschleunigung
+ * @param displacement die Verschiebung der Kugel (x, z) (out-param)
+ * @param accelaration die Beschleunigung am Anfang des Schritts (out-param)
+ */
+static void integrateVelocityVerlet(double interval, int i, float *position, float *velocity,
+                                    float *externalAccelaration, float *displacement, float *accelaration)
+{
+    CGVector3f newAccelaration = {0};
+    calculateMarbleAccelaration(i, position, externalAccelaration, accelaration);
+    // delta(s) = delta(t) * v + delta(t)^2 / 2 * a
+    displacement[0] = interval * velocity[LX] + 0.5f * interval * interval * accelaration[LX];
+    displacement[1] = interval * velocity[LZ] + 0.5f * interval * interval * accelaration[LZ];
+    CGVector2f newPosition = {position[0] + displacement[0], position[1] + displacement[1]};
+    calculateMarbleAccelaration(i, newPosition, externalAccelaration, newAccelaration);
+    // v = v + delta(t) / 2 * (a + a')
+    for (int d = 0; d < DIMENSIONS; d++)
+    {
+        velocity[d] += 0.5f * interval * (accelaration[d] + newAccelaration[d]);
+    }
+}
+
+/**
+ * Integriert eine Kugel mit dem klassischen Runge-Kutta-Verfahren 4. Ordnung.
+ * Vier Auswertungen der Beschleunigung pro Schritt.
+ * @param interval die verstrichen Zeit
+ * @param i Index der Kugel
+ * @param position die Position der Kugel in Weltkoord. (x, z)
+ * @param velocity die Geschwindigkeit der Kugel, wird aktualisiert
+ * @param externalAccelaration zusaetzliche aeussere Beschleunigung
+ * @param displacement die Verschiebung der Kugel (x, z) (out-param)
+ * @param accelaration die Beschleunigung am Anfang des Schritts (out-param)
+ */
+static void integrateRungeKutta4(double interval, int i, float *position, float *velocity,
+                                 float *externalAccelaration, float *displacement, float *accelaration)
+{
+    //Teilschritte relativ zum Anfang des Schritts und ihre Gewichte
+    const float stepFactors[RK4_STAGES] = {0.0f, 0.5f, 0.5f, 1.0f};
+    const float weights[RK4_STAGES] = {1.0f, 2.0f, 2.0f, 1.0f};
+    CGVector3f stageVelocity = {velocity[LX], velocity[LY], velocity[LZ]};
+    CGVector3f stageAccelaration = {0};
+    CGVector3f velocitySum = {0};
+    CGVector3f accelarationSum = {0};
+
+    for (int stage = 0; stage < RK4_STAGES; stage++)
+    {
+        //Zustand des Teilschritts aus der Steigung des vorherigen Teilschritts
+        float h = interval * stepFactors[stage];
+        CGVector2f stagePosition = {position[0] + h * stageVelocity[LX], position[1] + h * stageVelocity[LZ]};
+        CGVector3f previousAccelaration = {stageAccelaration[LX], stageAccelaration[LY], stageAccelaration[LZ]};
+        for (int d = 0; d < DIMENSIONS; d++)
+        {
+            stageVelocity[d] = velocity[d] + h * previousAccelaration[d];
+        }
+        calculateMarbleAccelaration(i, stagePosition, externalAccelaration, stageAccelaration);
+        if (stage == 0)
+        {
+            memcpy(accelaration, stageAccelaration, sizeof(CGVector3f));
+        }
+        for (int d = 0; d < DIMENSIONS; d++)
+        {
+            velocitySum[d] += weights[stage] * stageVelocity[d];
+            accelarationSum[d] += weights[stage] * stageAccelaration[d];
+        }
+    }
+    displacement[0] = interval / 6.0f * velocitySum[LX];
+    displacement[1] = interval / 6.0f * velocitySum[LZ];
+    for (int d = 0; d < DIMENSIONS; d++)
+    {
+        velocity[d] += interval / 6.0f * accelarationSum[d];
+    }
+}
+
+/**
+ * Verschiebt die Kugel mit dem eingestellten Integrationsverfahren.
+ * Die Reibung wird als Daempfung pro Zeit angewendet, sodass sie nicht von
+ * der Schrittweite abhaengt.
+ * @param interval die verstrichen Zeit
+ * @param i Index der Kugel
+ * @param externalAccelaration zusaetzliche aeussere Beschleunigung (Anstupsen)
+ */
+static void moveMarble(double interval, int i, float *externalAccelaration)
+{
+    //Position bestimmen
+    CGVector2f oldPosition = {g_marbles[i].center[LT], g_marbles[i].center[LS]};
+    CGVector2f newWorldPosition = {interpolate(oldPosition[LS], oldPosition[LT], LX),
+                                   interpolate(oldPosition[LS], oldPosition[LT], LZ)};
+    CGVector2f displacement = {0};
+    CGVector3f accelaration = {0};
+
+    switch (g_integrator)
+    {
+    case integratorSemiImplicitEuler:
+        integrateSemiImplicitEuler(interval, i, newWorldPosition, g_marbles[i].velocity, externalAccelaration, displacement, accelaration);
+        break;
+    case integratorVelocityVerlet:
+        integrateVelocityVerlet(interval, i, newWorldPosition, g_marbles[i].velocity, externalAccelaration, displacement, accelaration);
+        break;
+    case integratorRungeKutta4:
+        integrateRungeKutta4(interval, i, newWorldPosition, g_marbles[i].velocity, externalAccelaration, displacement, accelaration);
+        break;
+    default:
+        break;
+    }
+
+    double start = profileBegin();
+    // Reibung dazumultiplizieren
+    multiplyVectorWithScalar(g_marbles[i].velocity, powf(FRICTION, interval / UPDATE_CALL), g_marbles[i].velocity);
+    updateMarbleSleep(interval, i, accelaration);
+    //Schnelle Murmeln koennten durch Waende und Barrieren tunneln
+    if (displacement[0] * displacement[0] + displacement[1] * displacement[1] >= CCD_MIN_DISPLACEMENT * CCD_MIN_DISPLACEMENT)
+    {
+        sweepMarble(i, newWorldPosition, displacement);
+    }
+    else
+    {
+        newWorldPosition[0] += displacement[0];
+        newWorldPosition[1] += displacement[1];
+    }
+    //Werte in S und T umrechnen
+    float interpolatedWidth = getSurfaceWidth();
+    convertGlobalCoorinatesToInterpolationInterval(newWorldPosition[0], newWorldPosition[1], interpolatedWidth, &g_marbles[i].center[LS], &g_marbles[i].center[LT]);
+    profileEnd(physicsStageIntegration, start);
+}
+
+/**
+ * Kuemmert sich um das Anstupsen einer Kugel
+ * @param i der Index der anzustupsenden Kugel
+ * @param penaltyAccelaration der berechnete Vektor in den die Kugel weggestossen wird.
+ */
+static void handleMarblePoke(float *penaltyAccelaration)
+{
+    //Random Vektor
+    float pokeX = getRandomNumber() - 0.5f;
+    float pokeY = getRandomNumber() - 0.5f;
+    float pokeZ = getRandomNumber() - 0.5f;
+    CGVector3f pokeVector = {pokeX, pokeY, pokeZ};
+    //Normieren
+    float vectorLength = calcVectorLength(pokeVector);
+    divideVectorWithScalar(pokeVector, vectorLength, pokeVector);
+    //Anstupskraft hinzufuegen
+    multiplyVectorWithScalar(pokeVector, POKE_FACTOR, pokeVector);
+    //Addieren
+    addVectors(penaltyAccelaration, pokeVector, penaltyAccelaration);
+    //Damit nur die erste Kugel angestupst wird
+    g_pokeMarble = GL_FALSE;
+}
+
+/**
+ * Kuemmert sich um die Animation/Bewegung der Murmeln auf der Splineflaeche
+ * @param interval das verstrichene Intervall seid dem letzten Zeichen
+ */
+void handleMarbleMovement(double interval)
+{
+    updateObstacles();
+    updateRestingMarbles();
+    for (int i = 0; i < g_marbleCount; i++)
+    {
+        if (g_marbles[i].isVisible && !g_marbles[i].isSleeping)
+        {
+            CGVector3f pokeAccelaration = {0.0f, 0.0f, 0.0f};
+            if (g_pokeMarble)
+            {
+                handleMarblePoke(pokeAccelaration);
+            }
+            moveMarble(interval, i, pokeAccelaration);
+            calculateMarbleObstacle(i);
+            //Eingeschlafen oder verschluckt: ab dem naechsten Schritt im Gitter
+            if (g_marbles[i].isSleeping || !g_marbles[i].isVisible)
+            {
+                g_restingGridDirty = GL_TRUE;
+            }
+        }
+    }
+}
+
+/**
+ * Setzt den Anstubsstatus auf true
+ */
+void pokeMarble(void)
+{
+    g_pokeMarble = GL_TRUE;
+    //Die erste sichtbare Kugel wird angestupst und muss dafuer wach sein
+    int i = 0;
+    while (i < g_marbleCount && !g_marbles[i].isVisible)
+    {
+        i++;
+    }
+    if (i < g_marbleCount)
+    {
+        wakeMarble(i);
+    }
+}
+
+/**
+ * Setzt das Integrationsverfahren der Murmeln.
+ * @param integrator das neue Integrationsverfahren
+ */
+void setIntegrator(Integrator integrator)
+{
+    if (integrator >= 0 && integrator < INTEGRATOR_COUNT)
+    {
+        g_integrator = integrator;
+    }
+}
+
+/**
+ * Wechselt zyklisch zum naechsten Integrationsverfahren.
+ */
+void nextIntegrator(void)
+{
+    g_integrator = (g_integrator + 1) % INTEGRATOR_COUNT;
+}
+
+/**
+ * Liefert das eingestellte Integrationsverfahren der Murmeln.
+ * @return das Integrationsverfahren
+ */
+Integrator getIntegrator(void)
+{
+    return g_integrator;
+}
+
+/**
+ * Liefert den Namen eines Integrationsverfahrens.
+ * @param integrator das Integrationsverfahren
+ * @return der Name des Verfahrens
+ */
+const char *getIntegratorName(Integrator integrator)
+{
+    switch (integrator)
+    {
+    case integratorSemiImplicitEuler:
+        return "Semi-impliziter Euler";
+    case integratorVelocityVerlet:
+        return "Velocity Verlet";
+    case integratorRungeKutta4:
+        return "Runge-Kutta 4";
+    default:
+        return "";
+    }
+}
+
+/**
+ * Verschiebt die aktuelle Barriere einen Schritt nach oben.
+ */
+void moveBarrierUp(void)
+{
+    if (g_barriers[g_selectedBarrier][LS] - BARRIER_STEP >= 0.0f + DELTA)
+    {
+        g_barriers[g_selectedBarrier][LS] -= BARRIER_STEP;
+        invalidateObstacles();
+    }
+}
+
+/**
+ * Verschiebt die aktuelle Barriere einen Schritt nach unten.
+ */
+void moveBarrierDown(void)
+{
+    if (g_barriers[g_selectedBarrier][LS] + BARRIER_STEP <= 1.0f - DELTA)
+    {
+        g_barriers[g_selectedBarrier][LS] += BARRIER_STEP;
+        invalidateObstacles();
+    }
+}
+
+/**
+ * Verschiebt die aktuelle Barriere einen Schritt nach links.
+ */
+void moveBarrierLeft(void)
+{
+    if (g_barriers[g_selectedBarrier][LT] - BARRIER_STEP >= 0.0f + DELTA)
+    {
+        g_barriers[g_selectedBarrier][LT] -= BARRIER_STEP;
+        invalidateObstacles();
+    }
+}
+
+/**
+ * Verschiebt die aktuelle Barriere einen Schritt nach rechts.
+ */
+void moveBarrierRight(void)
+{
+    if (g_barriers[g_selectedBarrier][LT] + BARRIER_STEP <= 1.0f - DELTA)
+    {
+        g_barriers[g_selectedBarrier][LT] += BARRIER_STEP;
+        invalidateObstacles();
+    }
+}
+
+/**
+ * Liefert die Anzahl der Barrieren
+ * @return die Anzahl
+ */
+int getBarrierCount(void)
+{
+    return g_barrierCount;
+}
+
+/**
+ * Liefert, ob eine Barriere um 90 Grad rotiert ist.
+ * Von je BARRIER_COUNT Barrieren sind die ersten ROTATED_BARRIER_COUNT rotiert.
+ * @param i index der Barriere
+ * @return GL_TRUE, wenn die Barriere rotiert ist
+ */
+GLboolean isBarrierRotated(int i)
+{
+    return i % BARRIER_COUNT < ROTATED_BARRIER_COUNT;
+}
+
+/**
+ * Gibt die t-Position einer Barriere zurueck.
+ * @param i index der Barriere
+ * @return t-Position
+ */
+float getBarrierT(int i)
+{
+    return g_barriers[i][LT];
+}
+
+/**
+ * Gibt die s-Position einer Barriere zurueck.
+ * @param i index der Barriere
+ * @return s-Position
+ */
+float getBarrierS(int i)
+{
+    return g_barriers[i][LS];
+}
+
+/**
+ * Liefert den Index der aktuell ausgewaehlten Barriere
+ * @return der Index
+ */
+int getSelectedBarrier(void)
+{
+
+    return g_selectedBarrier;
+}
+
+/**
+ * Selektiert eine Barriere
+ * @param i selektierte Barriere.
+ */
+void setSelectedBarrierIndex(int i)
+{
+    if (i < g_barrierCount)
+    {
+        g_selectedBarrier = i;
+    }
+}
+
+/**
+ * Liefert die Anzahl der schwarzen Loecher
+ * @return die Anzahl
+ */
+float getHoleAmount(void)
+{
+    return g_holesAmount;
+}
+
+/**
+ * Liefert die t-Position eines schwarzen Loches
+ * @param i Index des Loches
+ * @return das T des Loches
+ */
+float getHoleT(int i)
+{
+    return g_holes[i][LT];
+}
+
+/**
+ * Liefert die s-Position eines schwarzen Loches
+ * @param i Index des Loches
+ * @return das S des Loches
+ */
+float getHoleS(int i)
+{
+    return g_holes[i][LS];
+}
+
+/**
+ * Liefert die T-Position des Ziels
+ * @return die T-Position
+ */
+float getTargetT(void)
+{
+    return g_targetT;
+}
+
+/**
+ * Liefert die Anzahl der Murmeln
+ * @return die Anzahl
+ */
+int getMarbleCount(void)
+{
+    return g_marbleCount;
+}
+
+/**
+ * Liefert die S-Position einer Kugel.
+ * @param i index der Kugel
+ * @return die S-Position
+ */
+float getMarbleS(int i)
+{
+    return g_marbles[i].center[LS];
+}
+
+/**
+ * Liefert die T-Position einer Kugel.
+ * @param i index der Kugel
+ * @return die T-Position
+ */
+float getMarbleT(int i)
+{
+    return g_marbles[i].center[LT];
+}
+
+/**
+ * Liefert den boolischen Wert ob die Murmel sichtbar ist
+ * @param i Index der Kugel
+ * @return Sichtbarkeit true wenn sichtabr
+ */
+GLboolean isMarbleVisible(int i)
+{
+    return g_marbles[i].isVisible;
+}
+
+/**
+ * Liefert, ob die Murmel schlaeft und daher nicht simuliert wird
+ * @param i Index der Kugel
+ * @return GL_TRUE, wenn die Murmel schlaeft
+ */
+GLboolean isMarbleSleeping(int i)
+{
+    return g_marbles[i].isSleeping;
+}
+
+/**
+ * Prueft, ob eine Murmel das Ziel erreicht hat.
+ * @param i Index der Kugel
+ * @return GL_TRUE, wenn die Murmel im Ziel liegt
+ */
+GLboolean isMarbleInTarget(int i)
+{
+    updateObstacles();
+    return checkMarbleInSphere(i, g_targetCenter, TARGET_RADIUS);
+}
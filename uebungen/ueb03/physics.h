@@ -0,0 +1,144 @@
+#ifndef __PHYSICS_H__
+#define __PHYSICS_H__
+/**
+ * @file
+ * Physik-Modul.
+ * Das Modul kapselt die Simulation der Murmeln auf der Splineflaeche inklusive
+ * der Kollisionen mit Waenden, Barrieren und anderen Murmeln sowie der Anziehung
+ * der schwarzen Loecher. Es kommt ohne OpenGL-Aufrufe aus und kann daher auch
+ * ohne Fenster (z.B. im Benchmark) verwendet werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+#ifdef PHYSICS_PROFILING
+#include "perfcounters.h"
+#endif
+
+/* ---- Konstanten ---- */
+
+#define UPDATE_CALL 0.005f
+
+#define BARRIER_STEP 0.01f
+#define BARRIER_COUNT 6
+#define BARRIER_WIDTH 0.1f
+#define BARRIER_HEIGHT 0.2f
+#define ROTATED_BARRIER_COUNT 4
+
+#define TARGET_RADIUS 0.1f
+
+#define HOLE_RADIUS 0.1f
+#define INIT_HOLE_AMOUNT 4
+#define MAX_HOLES 10
+#define MIN_HOLES 1
+#define ATTRACTION_DISTANCE HOLE_RADIUS * 3.0f
+#define ATTRACTION_FACTOR 150
+
+#define MARBLE_RADIUS 0.025f
+
+#define GRAVITY -10.0f
+#define SPRING_CONSTANT 2500
+#define FRICTION 0.997f
+
+/* Kontinuierliche Kollisionserkennung */
+#define BARRIER_CONTACT_DISTANCE (MARBLE_RADIUS * 2)
+#define CCD_MIN_DISPLACEMENT (MARBLE_RADIUS * 0.5f)
+#define CCD_MAX_ITERATIONS 4
+
+/* Anzahl der Teilschritte des Runge-Kutta-Verfahrens */
+#define RK4_STAGES 4
+
+/* Ruhende Murmeln schlafen legen */
+#define SLEEP_VELOCITY 0.01f
+#define SLEEP_ACCELERATION 0.05f
+#define SLEEP_TIME 0.5f
+
+/* Murmelkonstanten */
+#define MARBLE_COUNT 10
+#define MARBLE_SLOTS_PER_ROW 10
+
+#define POKE_FACTOR 500
+
+/** Teilschritte der Murmelsimulation, deren Laufzeit gemessen werden kann. */
+typedef enum
+{
+    physicsStageCollision,
+    physicsStageAttraction,
+    physicsStageIntegration,
+    PHYSICS_STAGE_COUNT
+} PhysicsStage;
+
+void initPhysics(int marbleCount, int holeCount, int barrierCount);
+
+void freeArraysPhysics(void);
+
+void invalidateObstacles(void);
+
+void handleMarbleMovement(double interval);
+
+void pokeMarble(void);
+
+void setIntegrator(Integrator integrator);
+
+void nextIntegrator(void);
+
+Integrator getIntegrator(void);
+
+const char *getIntegratorName(Integrator integrator);
+
+void increaseHoles(void);
+
+void decreaseHoles(void);
+
+void moveBarrierRight(void);
+
+void moveBarrierLeft(void);
+
+void moveBarrierUp(void);
+
+void moveBarrierDown(void);
+
+void setSelectedBarrierIndex(int i);
+
+int getSelectedBarrier(void);
+
+int getBarrierCount(void);
+
+GLboolean isBarrierRotated(int i);
+
+float getBarrierT(int i);
+
+float getBarrierS(int i);
+
+float getHoleAmount(void);
+
+float getHoleT(int i);
+
+float getHoleS(int i);
+
+float getTargetT(void);
+
+int getMarbleCount(void);
+
+float getMarbleS(int i);
+
+float getMarbleT(int i);
+
+GLboolean isMarbleVisible(int i);
+
+GLboolean isMarbleSleeping(int i);
+
+GLboolean isMarbleInTarget(int i);
+
+#ifdef PHYSICS_PROFILING
+double getPhysicsStageNanos(PhysicsStage stage);
+
+void resetPhysicsStageNanos(void);
+
+void setPhysicsPerfCounters(const PerfCounters *counters);
+
+void getPhysicsStageCounters(PhysicsStage stage, PerfCounterValues *values);
+#endif
+
+#endif
@@ -35,11 +35,13 @@
 #include "util.h"
 #include "texture.h"
 #include "float.h"
+#include "profiler.h"
 /* ---- Globale Variablen ---- */
 
 GLboolean g_normals = GL_FALSE;
 GLboolean g_controlPointsAreVisible = GL_FALSE;
 GLboolean g_interpolatedPointsAreVisible = GL_FALSE;
+GLboolean g_profileOverlay = GL_FALSE;
 
 /* Vertex Array */
 Vertex *g_vertices = NULL;
@@ -93,7 +95,7 @@ void initDisplayLists(void)
 */
 static void drawHelp()
 {
-    int size = 28;
+    int size = 32;
 
     float color[3] = {LIGHT_BLUE};
 
@@ -110,6 +112,7 @@ static void drawHelp()
                     "p, P - Anzahl der Kontrollpunkte erhoehen",
                     "o, O - Anzahl der Kontrollpunkte verringern",
                     "f, F - Stupst eine Murmel an",
+                    "m, M - Integrationsverfahren wechseln",
                     "c, C - Kameraflug entlang Bezier",
                     "v, V - Orientierungshilfe in 3D an/aus",
                     "x, X - Anzahl schwarzer Loecher erhoehen",
@@ -125,6 +128,8 @@ static void drawHelp()
                     "F7 - Lichtberechnung an/aus",
                     "F8 - Punktlichtquelle (Sonne) an/aus",
                     "F9 - Pausiert bzw. setzt Simulation fort",
+                    "F11 - Frame-Zeiten an/aus",
+                    "F12 - Frame-Zeiten als Chrome-Trace speichern",
                     "ESC/Q/q - Ende"};
 
     drawString(0.2f, 0.1f, color, help[0]);
@@ -175,9 +180,13 @@ static void drawInfoInWindowTitle(void)
     sprintf(fpsString, "%.2f ", fps);
     char *fpsStringOut = concat(" | FPS: ", fpsString);
 
+    //Integrationsverfahren
+    char *integratorString = concat(" | Integrator: ", (char *)getIntegratorName(getIntegrator()));
+
     char *intermediateTitle = concat(name, controlPointsFinalString);
     char *intermediateTitle2 = concat(intermediateTitle, resolutionFinalString);
-    char *title = concat(intermediateTitle2, fpsStringOut);
+    char *intermediateTitle3 = concat(intermediateTitle2, integratorString);
+    char *title = concat(intermediateTitle3, fpsStringOut);
 
     glutSetWindowTitle(title);
 
@@ -193,6 +202,10 @@ static void drawInfoInWindowTitle(void)
     intermediateTitle = NULL;
     free(intermediateTitle2);
     intermediateTitle2 = NULL;
+    free(intermediateTitle3);
+    intermediateTitle3 = NULL;
+    free(integratorString);
+    integratorString = NULL;
     free(title);
     title = NULL;
 }
@@ -231,25 +244,6 @@ static void handleLight()
     }
 }
 
-/**
- * Berechnet die Normalen der Ebene anhand der paritellen Ableitungen.
- * @param S intervall [0-1]
- * @param T intervall [0-1]
- * @param normal die berechnete Normale
- */
-void calcVertexNormal(float S, float T, float *normal)
-{
-    //Vektoren die durch den Punkt und entlang der s und t Achse Verlaufen
-    float vS[3] = {0};
-    float vT[3] = {0};
-    for (int i = 0; i < DIMENSIONS; i++)
-    {
-        vS[i] = calcGradient(S, T, i, GL_TRUE);
-        vT[i] = calcGradient(S, T, i, GL_FALSE);
-    }
-    calcCrossProduct(vS, vT, normal);
-}
-
 /**
  * Liefert die Anzahl der interpolierten Punkte
  * @return die Anzahl.
@@ -454,7 +448,7 @@ static void drawHoles(void)
 static void drawBarriers(void)
 {
     int selectedIdx = getSelectedBarrier();
-    for (int i = 0; i < BARRIER_COUNT; i++)
+    for (int i = 0; i < getBarrierCount(); i++)
     {
         float S = getBarrierS(i);
         float T = getBarrierT(i);
@@ -472,8 +466,8 @@ static void drawBarriers(void)
         glPushMatrix();
         {
             glTranslatef(x, y, z);
-            // vier Barrieren werden rotiert
-            if (i < ROTATED_BARRIER_COUNT)
+            // ein Teil der Barrieren wird rotiert
+            if (isBarrierRotated(i))
             {
                 glRotatef(90, 0.0f, 1.0f, 0.0f);
             }
@@ -500,7 +494,7 @@ static void drawTargetAtFinish(void)
  */
 static void drawMarbles(void)
 {
-    for (int i = 0; i < MARBLE_COUNT; i++)
+    for (int i = 0; i < getMarbleCount(); i++)
     {
         if (isMarbleVisible(i))
         {
@@ -603,6 +597,11 @@ void drawScene(void)
             calculateLineBetweenLowestAndHighest();
             drawInterpolatedBezierCurve();
         }
+
+        if (g_profileOverlay)
+        {
+            drawProfileOverlay(drawString);
+        }
     }
 }
 
@@ -630,6 +629,14 @@ void toggleInterpolatedPoints(void)
     g_interpolatedPointsAreVisible = !g_interpolatedPointsAreVisible;
 }
 
+/**
+ * Toggelt das Overlay mit den Frame-Zeiten.
+ */
+void toggleProfileOverlay(void)
+{
+    g_profileOverlay = !g_profileOverlay;
+}
+
 /**
  * (De-)aktiviert den Wireframe-Modus.
  */
@@ -690,6 +697,7 @@ void getColorThroughHeight(float height, float *color)
  */
 void calculateInterpolatedVertexArray(void)
 {
+    double profileStart = beginProfileScope();
     int interpolationResolution = getInterpolationResolution();
     float sampleStepWidth = 1.0f / (interpolationResolution - 1);
     // Benoetigte Groessen zum Speicher reservieren
@@ -759,6 +767,7 @@ void calculateInterpolatedVertexArray(void)
         printf("Kein virtueller RAM mehr verfügbar ...\n");
         exit(1);
     }
+    endProfileScope("Tesselierung", profileStart);
 }
 
 /**
@@ -48,6 +48,11 @@ void toggleControlPoints(void);
 
 void toggleInterpolatedPoints(void);
 
+/**
+ * Toggelt das Overlay mit den Frame-Zeiten.
+ */
+void toggleProfileOverlay(void);
+
 void calculateInterpolatedVertexArray(void);
 
 /**
@@ -59,6 +64,4 @@ void calculateLineBetweenLowestAndHighest(void);
 
 float getInterpolatedMeshWidth(void);
 
-void calcVertexNormal(float S, float T, float *normal);
-
 #endif
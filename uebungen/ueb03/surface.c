@@ -0,0 +1,432 @@
+/**
+ * @file
+ * Splineflaechen-Modul.
+ * Das Modul kapselt die Kontrollpunkte der Splineflaeche und deren Auswertung
+ * (Interpolation, Ableitungen, Normalen). Es kommt ohne OpenGL-Aufrufe aus und
+ * kann daher auch ohne Fenster (z.B. im Benchmark) verwendet werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "surface.h"
+#include "util.h"
+
+/* ---- Globale Daten ---- */
+
+/* Array fuer Kontrollpunkte */
+LogicVertex *g_controlPoints = NULL;
+
+/* Anzahl der Kontrollpunkte */
+GLint g_controlPointAmount = (INITIAL_SURFACES_IN_MESH + 1) * (INITIAL_SURFACES_IN_MESH + 1);
+
+/* Breite der interpolierten Flaeche in Weltkoordinaten */
+float g_surfaceWidth = 0.0f;
+
+/*Interpolationsmatrix fuer Spline*/
+float g_splineInterpolation[16] = {-(1.0f / 6.0f), (1.0f / 2.0f), -(1.0f / 2.0f), (1.0f / 6.0f),
+                                   (1.0f / 2.0f), -1.0f, (1.0f / 2.0f), 0,
+                                   -(1.0f / 2.0f), 0.0f, (1.0f / 2.0f), 0,
+                                   (1.0f / 6.0f), (2.0f / 3.0f), (1.0f / 6.0f), 0};
+
+/* Subpart in dem Interpoliert wird */
+int g_currentSplineSubPartT = 0;
+int g_currentSplineSubPartS = 0;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Berechnet den Monomvektor
+ * Entweder abgleitet oder nicht
+ * @param val der Wert fuer den der Monomvektor berechnet werden soll.
+ * @param res der berechnete Monomvektor
+ */
+void calculateMonomVector(float val, float *res, GLboolean derivate)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        float exp = 3.0f - i;
+        if (derivate)
+        {
+            if (i != 3)
+            {
+                res[i] = exp * powf(val, exp - 1.0f);
+            }
+            else
+            {
+                res[i] = 0.0f;
+            }
+        }
+        else
+        {
+            res[i] = powf(val, exp);
+        }
+    }
+}
+
+/**
+ * Setzt die Geometriewerte der umliegenden Punkte in die Geometriematrix.
+ * @param dimension in welcher Dimension interpoliert wird.
+ * @param geometryMatrix die Matrix die mit geometriewerten besetzt werden soll.
+ */
+static void setGeometryMatrix(int dimension, float *geometryMatrix)
+{
+    int cols = (int)sqrt(g_controlPointAmount);
+    int rows = (int)sqrt(g_controlPointAmount);
+    int geometryMatrixIndex = 0;
+    int controlPointIndex = 0;
+    for (int z = 0; z < rows; z++)
+    {
+        for (int x = 0; x < cols; x++)
+        {
+            //Pruefung ob im richtigen Unterbereich der Kontrollpunkte
+            if (x >= g_currentSplineSubPartT && x < g_currentSplineSubPartT + CONTROL_POINTS_PER_SPLINE_SUBPART &&
+                z >= g_currentSplineSubPartS && z < g_currentSplineSubPartS + CONTROL_POINTS_PER_SPLINE_SUBPART)
+            {
+                geometryMatrix[geometryMatrixIndex] = g_controlPoints[controlPointIndex][dimension];
+                //Falls ein Punkt der 4X4 Geometriematrix gefunden wurde
+                geometryMatrixIndex++;
+            }
+            //Weil alle Kontrollpunkte abgeleufen werden
+            controlPointIndex++;
+        }
+    }
+}
+
+/**
+ * Konvertiert groß T oder S zu klein t oder s. Setzt dabei den aktuellen Teilbereich des Splines.
+ * @param T Gross T oder S der zu konvertieren ist
+ * @param isT ob es sich um T oder S handelt
+ * @return klein t oder s
+ */
+static float convertTInTAndSubPart(float T, GLboolean isT)
+{
+    int controlPointPerRow = (int)sqrt(g_controlPointAmount);
+    int subParts = 0;
+    //Gesamte subParts am Anfang zaehlen -> Da quadratisch nur in eine Dimension
+    while (subParts < controlPointPerRow - 4)
+    {
+        subParts++;
+    }
+    subParts += 1;
+    float splineSubPartWidth = 1.0f / subParts;
+    int splineSubPartCounter = 0;
+    float t = 0.0f;
+
+    //Fuer t > 1.0f also Objekte die ausserhalb der Splineflaeche gezeichnet werden sollen
+    // muss die Schleife abbrechen sonst zaehlt der SubPartCounter zu hoch.
+    while (t + splineSubPartWidth < T - DELTA && t + splineSubPartWidth <= 1.0f - DELTA)
+    {
+        t += splineSubPartWidth;
+        splineSubPartCounter++;
+    }
+    if (isT)
+    {
+        g_currentSplineSubPartT = splineSubPartCounter;
+    }
+    else
+    {
+        g_currentSplineSubPartS = splineSubPartCounter;
+    }
+    return (T - t) / splineSubPartWidth;
+}
+
+/**
+ * Uebernimmt die Berechnung des interpolierten Wertes
+ * oder die Berechnung der Steigung des interpolierten Wertes
+ * @param monomVectorS der zur berechnung benoetigte Monomvektor s
+ * @param monomVectorT der zur berechnung benoetigte Monomvektor t
+ * @param dimension die zu berechnende Dimension (x=0, y=1, z=2)
+
+ */
+static float calculateSplineInterpolationPlain(float *monomVectorS, float *monomVectorT, int dimension)
+{
+    float multipliedMWithG[16] = {0};
+    float multipliedMonomSWithMG[16] = {0};
+    float multipliedTransposedInterpolationWithMonomT[16] = {0};
+    float geometryMatrix[16] = {0};
+    float transposedInterpolation[16];
+    transpose4x4(g_splineInterpolation, transposedInterpolation);
+    setGeometryMatrix(dimension, geometryMatrix);
+    multiply4x4With4x4Matrix(g_splineInterpolation, geometryMatrix, multipliedMWithG);
+    multiply1x4With4x4Matrix(monomVectorS, multipliedMWithG, multipliedMonomSWithMG);
+    multiply4x4With4x1Matrix(transposedInterpolation, monomVectorT, multipliedTransposedInterpolationWithMonomT);
+    return multiply1x4With4x1Matrix(multipliedMonomSWithMG, multipliedTransposedInterpolationWithMonomT);
+}
+
+/**
+ * Berechnet die Steigung fuer einen Punkt an der uebergebene Dimension
+ * @param S die Zeit in X Dimenstion [0-1]
+ * @param T die Zeit in Z Dimenstion [0-1]
+ * @param dimension die zu berechnende Dimension (x=0, y=1, z=2)
+ * @param isDerivativeS ob nach s oder t abgeleitet wird
+ * @return die Steigung des interpolierten Wertes
+ */
+float calcGradient(float S, float T, int dimension, GLboolean isDerivativeS)
+{
+    float t = convertTInTAndSubPart(T, GL_TRUE);
+    float s = convertTInTAndSubPart(S, GL_FALSE);
+    float monomVectorS[4] = {0};
+    float monomVectorT[4] = {0};
+    //Benoetigte Monomvektoren berechnen
+    if (isDerivativeS)
+    {
+        calculateMonomVector(s, monomVectorS, GL_TRUE);
+        calculateMonomVector(t, monomVectorT, GL_FALSE);
+    }
+    else
+    {
+        calculateMonomVector(t, monomVectorT, GL_TRUE);
+        calculateMonomVector(s, monomVectorS, GL_FALSE);
+    }
+    return calculateSplineInterpolationPlain(monomVectorS, monomVectorT, dimension);
+}
+
+/**
+ * Berechnet die Koordinaten fuer eine uebergebene Dimension
+ * @param S die Zeit in Z Dimenstion [0-1]
+ * @param T die Zeit in X Dimenstion [0-1]
+ * @param dimension die zu berechnende Dimension (x=0, y=1, z=2)
+ * @return der interpolierte Wert
+ */
+float interpolate(float S, float T, int dimension)
+{
+    float t = convertTInTAndSubPart(T, GL_TRUE);
+    float s = convertTInTAndSubPart(S, GL_FALSE);
+    float monomVectorS[4] = {0};
+    float monomVectorT[4] = {0};
+    calculateMonomVector(s, monomVectorS, GL_FALSE);
+    calculateMonomVector(t, monomVectorT, GL_FALSE);
+    return calculateSplineInterpolationPlain(monomVectorS, monomVectorT, dimension);
+}
+
+/**
+ * Berechnet die Normalen der Ebene anhand der paritellen Ableitungen.
+ * @param S intervall [0-1]
+ * @param T intervall [0-1]
+ * @param normal die berechnete Normale
+ */
+void calcVertexNormal(float S, float T, float *normal)
+{
+    //Vektoren die durch den Punkt und entlang der s und t Achse Verlaufen
+    float vS[3] = {0};
+    float vT[3] = {0};
+    for (int i = 0; i < DIMENSIONS; i++)
+    {
+        vS[i] = calcGradient(S, T, i, GL_TRUE);
+        vT[i] = calcGradient(S, T, i, GL_FALSE);
+    }
+    calcNormalizedCrossProduct(vS, vT, 1.0f, normal);
+}
+
+/**
+ * Berechnet die Breite der interpolierten Flaeche neu.
+ * Die X-Koordinaten der Kontrollpunkte aendern sich nur beim Initialisieren
+ * und beim Veraendern der Anzahl, daher wird die Breite zwischengespeichert.
+ */
+static void updateSurfaceWidth(void)
+{
+    g_surfaceWidth = interpolate(1.0f, 1.0f, LX) - interpolate(0.0f, 0.0f, LX);
+}
+
+/**
+ * Liefert die Breite der interpolierten Flaeche in Weltkoordinaten
+ * @return die Breite
+ */
+float getSurfaceWidth(void)
+{
+    return g_surfaceWidth;
+}
+
+/**
+ * Initialisiert das Vertex Arrays in der Logik.
+ */
+void initControlPointArray(void)
+{
+    g_controlPoints = realloc(g_controlPoints, sizeof(LogicVertex) * g_controlPointAmount);
+    if (g_controlPoints == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+
+    int cols = (int)sqrt(g_controlPointAmount);
+    int rows = (int)sqrt(g_controlPointAmount);
+    int vertexIndex = 0;
+    for (int z = 0; z < rows; z++)
+    {
+        for (int x = 0; x < cols; x++)
+        {
+            g_controlPoints[vertexIndex][LX] = (-(FIELD_WIDTH / 2) + (x * FIELD_WIDTH / (float)(cols - 1)));
+            g_controlPoints[vertexIndex][LY] = getRandomNumber() - (((float)z) * SLOPE_FACTOR);
+            g_controlPoints[vertexIndex][LZ] = (-(FIELD_HEIGHT / 2) + (z * FIELD_HEIGHT / (float)(rows - 1)));
+            vertexIndex++;
+        }
+    }
+    updateSurfaceWidth();
+}
+
+/**
+ * Gibt den Speicher der Kontrollpunkte frei.
+ */
+void freeArraysSurface(void)
+{
+    free(g_controlPoints);
+    g_controlPoints = NULL;
+}
+
+/**
+ * Aendert die Hoehe eines Kontrollpunktes.
+ * @param vertexIndex Index des zu veraendernden Kontrollpunktes
+ * @param heightChange die Hoehenaenderung (negativ = verringern)
+ */
+void moveControlPointHeight(GLuint vertexIndex, float heightChange)
+{
+    g_controlPoints[vertexIndex][LY] += heightChange;
+}
+
+/**
+ * Liefert die Anzahl der Kontrollpunkte
+ * @return die Anzahl
+ */
+int getControlPointAmount(void)
+{
+    return g_controlPointAmount;
+}
+
+/**
+ * Liefert die X Koord. des Kontrollpunktes
+ * @param idx der Index des Kontrollpunktes
+ * @return die X Koord.
+ */
+float getControlPointX(int idx)
+{
+    return g_controlPoints[idx][LX];
+}
+
+/**
+ * Liefert die Y Koord. des Kontrollpunktes
+ * @param idx der Index des Kontrollpunktes
+ * @return die Y Koord.
+ */
+float getControlPointY(int idx)
+{
+    return g_controlPoints[idx][LY];
+}
+
+/**
+ * Liefert die Z Koord. des Kontrollpunktes
+ * @param idx der Index des Kontrollpunktes
+ * @return die Z Koord.
+ */
+float getControlPointZ(int idx)
+{
+    return g_controlPoints[idx][LZ];
+}
+
+/**
+ * Kopiert die Inhalte aus dem Globalen Vertices Array in das Temporaere fuer das veraendern der groesse
+ * @param dest temporaeres Vertice Array
+ * @param vertIndex Index im temporaeren Vertice Array
+ * @param vertexIndexGlobal Index im globalen Vertice Array
+ */
+static void copyIntoTemp(LogicVertex *dest, int vertexIndex, int vertexIndexGlobal, int x, int z, int cols, int rows)
+{
+    dest[vertexIndex][LX] = (-(FIELD_WIDTH / 2) + (x * FIELD_WIDTH / (float)(cols - 1)));
+    dest[vertexIndex][LY] = g_controlPoints[vertexIndexGlobal][LY];
+    dest[vertexIndex][LZ] = (-(FIELD_HEIGHT / 2) + (z * FIELD_HEIGHT / (float)(rows - 1)));
+}
+
+/**
+ * Veraendert die Groesse des Vertex Arrays in der Logik.
+ * @param inc ob erhoeht oder verringert wird
+ */
+static void resizeLogicVertexArray(GLboolean inc)
+{
+    // Laufvariablen
+    int vertexIndex = 0;
+    int vertexIndexGlobal = 0;
+    int cols = (int)sqrt(g_controlPointAmount);
+    int rows = (int)sqrt(g_controlPointAmount);
+
+    LogicVertex *tempVerticeArray = malloc(sizeof(LogicVertex) * g_controlPointAmount);
+
+    if (tempVerticeArray != NULL)
+    {
+        //Alle Punke neu berechnen da diese verschoben
+        for (int z = 0; z < rows; z++)
+        {
+            for (int x = 0; x < cols; x++)
+            {
+                // Increase Vertices
+                if (inc)
+                {
+                    //Am Rand neuer Vertex init.
+                    if (z == rows - 1 || x == cols - 1)
+                    {
+                        tempVerticeArray[vertexIndex][LX] = (-(FIELD_WIDTH / 2) + (x * FIELD_WIDTH / (float)(cols - 1)));
+                        tempVerticeArray[vertexIndex][LY] = getRandomNumber() - (((float)z) * SLOPE_FACTOR);
+                        tempVerticeArray[vertexIndex][LZ] = (-(FIELD_HEIGHT / 2) + (z * FIELD_HEIGHT / (float)(rows - 1)));
+                    }
+                    //Vorher schon vorhanden
+                    else
+                    {
+                        copyIntoTemp(tempVerticeArray, vertexIndex, vertexIndexGlobal, x, z, cols, rows);
+                        //Nur erhoehen wenn aus globalen Array kopieren
+                        vertexIndexGlobal++;
+                    }
+                    //Jedes mal
+                    vertexIndex++;
+                }
+                // Decrease Vertices
+                else
+                {
+                    //temp ist nun kleiner als global
+                    copyIntoTemp(tempVerticeArray, vertexIndex, vertexIndexGlobal, x, z, cols, rows);
+                    vertexIndexGlobal++;
+                    vertexIndex++;
+                    //Wenn x am Rand
+                    if (x == cols - 1)
+                    {
+                        //Ueberspringen aka. loeschen
+                        vertexIndexGlobal++;
+                    }
+                }
+            }
+        }
+        free(g_controlPoints);
+        g_controlPoints = NULL;
+        g_controlPoints = tempVerticeArray;
+    }
+    else
+    {
+        free(tempVerticeArray);
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+}
+
+/**
+ * Erhoeht oder verringert die Anzahl der Kontrollpunkte pro Reihe um eins,
+ * sofern die Grenzen es zulassen.
+ * @param inc ob erhoeht oder verringert wird
+ * @return GL_TRUE, wenn sich die Anzahl geaendert hat
+ */
+GLboolean resizeControlPointMesh(GLboolean inc)
+{
+    int controlPointPerRow = (int)sqrt(g_controlPointAmount);
+    int newControlPointPerRow = inc ? controlPointPerRow + 1 : controlPointPerRow - 1;
+    if (newControlPointPerRow > MAX_CONTROLPOINTS_IN_MESH || newControlPointPerRow < MIN_CONTROLPOINTS_IN_MESH)
+    {
+        return GL_FALSE;
+    }
+    g_controlPointAmount = newControlPointPerRow * newControlPointPerRow;
+    resizeLogicVertexArray(inc);
+    updateSurfaceWidth();
+    return GL_TRUE;
+}
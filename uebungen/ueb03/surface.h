@@ -0,0 +1,65 @@
+#ifndef __SURFACE_H__
+#define __SURFACE_H__
+/**
+ * @file
+ * Splineflaechen-Modul.
+ * Das Modul kapselt die Kontrollpunkte der Splineflaeche und deren Auswertung
+ * (Interpolation, Ableitungen, Normalen). Es kommt ohne OpenGL-Aufrufe aus und
+ * kann daher auch ohne Fenster (z.B. im Benchmark) verwendet werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/*Konstaten zur besseren lesbarkeit des Arrays in der Logik zur bessereren lesbarkeit*/
+#define LX (0)
+#define LY (1)
+#define LZ (2)
+
+#define LT (0)
+#define LS (1)
+
+#define SLOPE_FACTOR 0.05f
+
+#define INITIAL_SURFACES_IN_MESH 10
+
+#define MAX_CONTROLPOINTS_IN_MESH 99
+#define MIN_CONTROLPOINTS_IN_MESH 4
+
+#define FIELD_WIDTH 4.0f
+#define FIELD_HEIGHT 4.0f
+
+#define CONTROL_POINTS_PER_SPLINE_SUBPART 4
+
+#define DELTA 0.0001f
+
+#define DIMENSIONS 3
+
+void initControlPointArray(void);
+
+void freeArraysSurface(void);
+
+GLboolean resizeControlPointMesh(GLboolean inc);
+
+void moveControlPointHeight(GLuint vertexIndex, float heightChange);
+
+int getControlPointAmount(void);
+
+float getControlPointX(int idx);
+
+float getControlPointY(int idx);
+
+float getControlPointZ(int idx);
+
+void calculateMonomVector(float val, float *res, GLboolean derivate);
+
+float calcGradient(float S, float T, int dimension, GLboolean derivativeS);
+
+float interpolate(float S, float T, int dimension);
+
+void calcVertexNormal(float S, float T, float *normal);
+
+float getSurfaceWidth(void);
+
+#endif
@@ -0,0 +1,226 @@
+/**
+ * @file
+ * Texturkonverter.
+ * Wandelt Bilddateien offline in blockkomprimierte DDS-Dateien (BC1 fuer
+ * Bilder ohne, BC3 fuer Bilder mit Alphakanal) mit vollstaendiger
+ * Mipmap-Kette um. Die DDS-Datei erhaelt den Namen der Bilddatei mit der
+ * Endung .dds und wird vom Textur-Lade-Modul anstelle der Bilddatei geladen.
+ * Je Datei werden die Groesse mit und ohne Kompression, die Dauer und der
+ * Fehler der obersten Stufe (RMSE und PSNR ueber alle Kanaele) ausgegeben.
+ *
+ * Aufruf: ueb03_texconv [-f bc1|bc3] Bilddatei...
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "textureCompression.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb/stb_image.h" // Bibliothek um Bilder zu laden
+
+/* ---- Konstanten ---- */
+
+/* Laenge der Pfade der DDS-Dateien */
+#define TEXCONV_PATH_LENGTH 256
+
+/* ---- Funktionen ---- */
+
+/**
+ * Liefert den aktuellen Zeitstempel einer monotonen Uhr.
+ * @return der Zeitstempel in Nanosekunden
+ */
+static double getNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/**
+ * Berechnet den mittleren quadratischen Fehler der komprimierten obersten
+ * Stufe gegenueber dem Original.
+ * @param format das Format
+ * @param pixels das Original
+ * @param blocks die komprimierte Stufe
+ * @param width Breite der Stufe
+ * @param height Hoehe der Stufe
+ * @param channels Anzahl der Farbkanaele des Originals
+ * @return die Wurzel des mittleren quadratischen Fehlers je Kanal
+ */
+static double getCompressionError(TextureFormat format, const unsigned char *pixels, const unsigned char *blocks,
+                                  int width, int height, int channels)
+{
+    //Grauwerte werden als RGBA dekodiert und am ersten Kanal verglichen
+    unsigned char *decoded = malloc((size_t)width * height * 4);
+    if (decoded == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    decompressTextureLevel(format, blocks, width, height, 4, decoded);
+    static const int sourceChannels[4][4] = {{0}, {0, 1}, {0, 1, 2}, {0, 1, 2, 3}};
+    static const int decodedChannels[4][4] = {{0}, {0, 3}, {0, 1, 2}, {0, 1, 2, 3}};
+    double sum = 0.0;
+    for (size_t i = 0; i < (size_t)width * height; i++)
+    {
+        for (int c = 0; c < channels; c++)
+        {
+            double difference = pixels[i * channels + sourceChannels[channels - 1][c]] -
+                                decoded[i * 4 + decodedChannels[channels - 1][c]];
+            sum += difference * difference;
+        }
+    }
+    free(decoded);
+    return sqrt(sum / ((double)width * height * channels));
+}
+
+/**
+ * Wandelt eine Bilddatei in eine DDS-Datei um und gibt das Ergebnis aus.
+ * @param filename Pfad der Bilddatei
+ * @param forcedFormat vorgegebenes Format oder TEXTURE_FORMAT_COUNT fuer
+ *   die Wahl anhand des Alphakanals
+ * @return ob die Datei umgewandelt werden konnte
+ */
+static int convertTexture(const char *filename, TextureFormat forcedFormat)
+{
+    char path[TEXCONV_PATH_LENGTH];
+    if (!getDdsPath(filename, path, sizeof(path)))
+    {
+        fprintf(stderr, "Pfad %s ist zu lang!\n", filename);
+        return 0;
+    }
+    int width, height, channels;
+    unsigned char *pixels = stbi_load(filename, &width, &height, &channels, 0);
+    if (pixels == NULL)
+    {
+        fprintf(stderr, "Datei %s konnte nicht geladen werden: %s\n", filename, stbi_failure_reason());
+        return 0;
+    }
+    TextureFormat format = forcedFormat;
+    if (format == TEXTURE_FORMAT_COUNT)
+    {
+        format = channels == 2 || channels == 4 ? textureFormatBC3 : textureFormatBC1;
+    }
+
+    //Alle Stufen hintereinander hinter den Kopf
+    DdsHeader header;
+    initDdsHeader(&header, format, width, height);
+    size_t size = sizeof(DdsHeader);
+    size_t uncompressedSize = 0;
+    int levelWidth = width;
+    int levelHeight = height;
+    for (uint32_t level = 0; level < header.mipMapCount; level++)
+    {
+        size += getCompressedLevelSize(format, levelWidth, levelHeight);
+        uncompressedSize += (size_t)levelWidth * levelHeight * channels;
+        levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+        levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+    }
+    unsigned char *data = malloc(size);
+    unsigned char *levels[2] = {malloc((size_t)width * height * channels), malloc((size_t)width * height * channels)};
+    if (data == NULL || levels[0] == NULL || levels[1] == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    memcpy(data, &header, sizeof(DdsHeader));
+    memcpy(levels[0], pixels, (size_t)width * height * channels);
+
+    double start = getNanos();
+    unsigned char *blocks = data + sizeof(DdsHeader);
+    levelWidth = width;
+    levelHeight = height;
+    for (uint32_t level = 0; level < header.mipMapCount; level++)
+    {
+        const unsigned char *current = levels[level % 2];
+        compressTextureLevel(format, current, levelWidth, levelHeight, channels, blocks);
+        blocks += getCompressedLevelSize(format, levelWidth, levelHeight);
+        if (level + 1 < header.mipMapCount)
+        {
+            downsampleTextureLevel(current, levelWidth, levelHeight, channels, levels[(level + 1) % 2]);
+        }
+        levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+        levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+    }
+    double millis = (getNanos() - start) / 1e6;
+    double rmse = getCompressionError(format, pixels, data + sizeof(DdsHeader), width, height, channels);
+
+    FILE *file = fopen(path, "wb");
+    int ok = file != NULL && fwrite(data, 1, size, file) == size;
+    ok = file != NULL && fclose(file) == 0 && ok;
+    if (ok)
+    {
+        printf("%-32s %-6s %5dx%-5d %12.1f %12.1f %6.1f:1 %10.1f %8.2f %8.2f\n", path, getTextureFormatName(format), width,
+               height, uncompressedSize / 1024.0, size / 1024.0, (double)uncompressedSize / size, millis, rmse,
+               rmse > 0.0 ? 20.0 * log10(255.0 / rmse) : INFINITY);
+    }
+    else
+    {
+        fprintf(stderr, "Datei %s konnte nicht geschrieben werden!\n", path);
+        remove(path);
+    }
+
+    free(levels[0]);
+    free(levels[1]);
+    free(data);
+    stbi_image_free(pixels);
+    return ok;
+}
+
+/**
+ * Hauptprogramm. Wandelt alle uebergebenen Bilddateien um.
+ * @param argc Anzahl der Kommandozeilenparameter
+ * @param argv Kommandozeilenparameter
+ * @return Rueckgabewert im Fehlerfall ungleich Null.
+ */
+int main(int argc, char **argv)
+{
+    TextureFormat format = TEXTURE_FORMAT_COUNT;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "f:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+            if (strcasecmp(optarg, "bc1") == 0)
+            {
+                format = textureFormatBC1;
+                break;
+            }
+            if (strcasecmp(optarg, "bc3") == 0)
+            {
+                format = textureFormatBC3;
+                break;
+            }
+            /* fall through */
+        default:
+            fprintf(stderr, "Aufruf: %s [-f bc1|bc3] Bilddatei...\n", argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc)
+    {
+        fprintf(stderr, "Aufruf: %s [-f bc1|bc3] Bilddatei...\n", argv[0]);
+        return 1;
+    }
+
+    printf("%-32s %-6s %11s %12s %12s %8s %10s %8s %8s\n", "DDS-Datei", "Format", "Groesse", "Unkompr.-KiB", "DDS-KiB",
+           "Verh.", "Dauer-ms", "RMSE", "PSNR-dB");
+    int failed = 0;
+    for (int i = optind; i < argc; i++)
+    {
+        failed += !convertTexture(argv[i], format);
+    }
+    return failed > 0;
+}
@@ -23,11 +23,23 @@ typedef enum
 } TexName;
 
 /**
- * Laed Texturen und initialisiert das Texturmapping.
+ * Laed Texturen und initialisiert das Texturmapping. Bis eine Textur im
+ * Hintergrund geladen ist, wird ein Platzhalter angezeigt.
  * @return 1, wenn Laden und Initialisieren erfolgreich war, sonst 0.
  */
 int initTextures(void);
 
+/**
+ * Laedt fertig geladene Texturen in OpenGL hoch. Muss in jedem Frame
+ * aufgerufen werden.
+ */
+void updateTextures(void);
+
+/**
+ * Beendet das Laden im Hintergrund und gibt nicht hochgeladene Texturen frei.
+ */
+void freeTextures(void);
+
 /**
  * Bindet die Textur texture, so dass sie fuer alle nachfolgende gezeichneten
  * Primitiven verwendet wird.
@@ -88,6 +88,15 @@ typedef enum
     radiusNone,
 } Radius;
 
+/* Integrationsverfahren fuer die Bewegung der Murmeln */
+typedef enum
+{
+    integratorSemiImplicitEuler,
+    integratorVelocityVerlet,
+    integratorRungeKutta4,
+    INTEGRATOR_COUNT
+} Integrator;
+
 /* Deklaration fuer eine Murmel, welche ueber die Flache rollen soll */
 typedef struct
 {
@@ -95,8 +104,35 @@ typedef struct
     CGVector3f velocity;
     float mass;
     GLboolean isVisible;
+    /* Schlafende Murmeln werden nicht simuliert, bis sie geweckt werden */
+    GLboolean isSleeping;
+    /* Zeit, die die Murmel bereits (nahezu) in Ruhe ist */
+    float restTime;
 } Marble;
 
+/* Zwischengespeicherte Lage eines Hindernisses (Loch, Barriere) in Weltkoordinaten */
+typedef struct
+{
+    CGVector3f center;
+    /* halbe Ausdehnung in x- und z-Richtung (nur Barrieren) */
+    CGVector2f halfExtents;
+    /* Wirkungsbereich auf der x-z-Ebene */
+    CGVector2f boundsMin;
+    CGVector2f boundsMax;
+} Obstacle;
+
+/* Gleichmaessiges Gitter ueber das Spielfeld, das je Zelle die Indizes der
+ * Hindernisse enthaelt, deren Wirkungsbereich die Zelle beruehrt */
+typedef struct
+{
+    float origin;
+    float cellSize;
+    int cellsPerRow;
+    /* Zelle c umfasst cellItems[cellStart[c]] bis cellItems[cellStart[c + 1] - 1] */
+    int *cellStart;
+    int *cellItems;
+} SpatialGrid;
+
 /** Datentyp fuer Mausereignisse. */
 typedef enum e_MouseEventType CGMouseEventType;
 
@@ -0,0 +1,490 @@
+/**
+ * @file
+ * Benchmark der Partikelsimulation.
+ * Fuehrt die Bewegung der Partikel ohne Fenster und ohne OpenGL fuer eine feste
+ * simulierte Dauer aus und gibt den Durchsatz in Schritten pro Sekunde sowie
+ * die Laufzeit je Partikel und Schritt aus. Die Baelle stehen dabei still.
+ * Mit -b werden in jedem Schritt zusaetzlich so viele Partikel entfernt und
+ * neu erzeugt, um die Kosten wechselnder Partikelzahlen zu messen. Mit -e
+ * stoesst ein Emitter im Ursprung zusaetzlich einen Partikelstrom mit der
+ * gegebenen Rate (Partikel/s) aus. Mit -f werden nach jedem Schritt die
+ * Vertex Arrays der Darstellung (Dreiecke und Schatten) befuellt und deren
+ * Laufzeit getrennt ausgegeben. Mit -j wird die Anzahl der Threads des
+ * Job-Moduls festgelegt (Standard: alle Prozessorkerne). Mit -w wird der
+ * Benchmark nacheinander mit 1, 2, 4, ... bis zur gegebenen Anzahl an Threads
+ * wiederholt und die Beschleunigung gegenueber einem Thread ausgegeben.
+ * Im Zielmodus 3 (Schwarm) werden zusaetzlich die Laufzeiten von Gitteraufbau
+ * und Kraftberechnung getrennt ausgegeben. Mit -p wird die Genauigkeit der
+ * Mathematik gewaehlt (0 exakt, 1 schnell). Mit -a wird der Lauf mit beiden
+ * Genauigkeiten wiederholt und neben Durchsatz und Beschleunigung der Fehler
+ * der Naeherungen sowie die Abweichung der Partikelpositionen ausgegeben.
+ * Die Laufzeit jeder Stufe der Partikelpipeline wird getrennt ausgegeben, mit
+ * -u laufen die Stufen einzeln statt je Block zusammengefasst.
+ * Mit -l startet der Lauf mit dem Zustand aus einem Snapshot (Partikel,
+ * Baelle, Zielmodus und Integrator aus der Datei), mit -o wird der Zustand
+ * am Ende gespeichert. Mit -S werden waehrend des Laufs im Abstand -P
+ * (simulierte Sekunden) Snapshots im Hintergrund geschrieben (das Muster
+ * enthaelt genau ein %d fuer die laufende Nummer, z.B. snap_%06d.bin) und die Kosten
+ * des Kopierens in der Simulation sowie ausgelassene Snapshots ausgegeben.
+ * Mit -H werden zusaetzlich die Hardwarezaehler (Takte, Instruktionen,
+ * Cachefehlzugriffe, falsch vorhergesagte Spruenge) je Partikel und Schritt
+ * ausgegeben, summiert ueber alle Threads und aufgeteilt in Vorbereitung,
+ * Stufen (nur mit -u) und Pipeline. Gilt nicht fuer -w und -a.
+ *
+ * Aufruf: ueb04_bench [-n Partikel] [-d Sekunden] [-s Schrittweite] [-i Integrator] [-t Zielmodus] [-b Wechsel] [-e Rate] [-f] [-r Seed] [-j Threads] [-w Threads] [-p Genauigkeit] [-a] [-u] [-l Datei] [-o Datei] [-S Muster] [-P Sekunden] [-H]
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "particles.h"
+#include "emitters.h"
+#include "particleBuffers.h"
+#include "jobs.h"
+#include "flocking.h"
+#include "particleMath.h"
+#include "util.h"
+#include "snapshot.h"
+
+/* ---- Konstanten ---- */
+
+#define BENCH_DEFAULT_PARTICLES 1000000
+#define BENCH_DEFAULT_DURATION 0.5
+#define BENCH_DEFAULT_STEP 0.005
+#define BENCH_DEFAULT_SEED 42
+#define BENCH_BALL_COUNT 2
+#define BENCH_EMITTER_LIFETIME 1.0f
+#define BENCH_EMITTER_CONE_ANGLE 20.0f
+/* Anzahl der Stuetzstellen beim Vergleich der Naeherungen */
+#define BENCH_MATH_SAMPLES 1000000
+/* Abstand der fortlaufend geschriebenen Snapshots in simulierten Sekunden */
+#define BENCH_DEFAULT_STREAM_PERIOD 0.05
+
+/* ---- Typen ---- */
+
+/* Parameter eines Benchmarklaufs */
+typedef struct
+{
+    int particleCount;
+    double duration;
+    double step;
+    unsigned seed;
+    Integrator integrator;
+    TargetMode targetMode;
+    MathPrecision precision;
+    GLboolean fused;
+    int churn;
+    float emitterRate;
+    GLboolean fillBuffers;
+    /* Snapshot, mit dem der Lauf beginnt bzw. in den am Ende gespeichert
+     * wird, und Muster fuer fortlaufende Snapshots (jeweils NULL -> keiner) */
+    const char *loadPath;
+    const char *savePath;
+    const char *streamPattern;
+    double streamPeriod;
+    /* Hardwarezaehler, NULL -> keine */
+    const PerfCounters *counters;
+} BenchConfig;
+
+/* Messergebnisse eines Benchmarklaufs in Nanosekunden */
+typedef struct
+{
+    int stepCount;
+    double totalNanos;
+    double churnNanos;
+    /* Anzahl der tatsaechlich entfernten und neu erzeugten Partikel */
+    long churnParticles;
+    double fillNanos;
+    /* Hardwarezaehler aller Schritte */
+    PerfCounterValues counters;
+} BenchResult;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Fuehrt einen Benchmarklauf mit frisch initialisierten Partikeln aus. Durch
+ * den festen Seed sind aufeinanderfolgende Laeufe vergleichbar.
+ * @param config die Parameter des Laufs
+ * @return die Messergebnisse
+ */
+static BenchResult runBench(const BenchConfig *config)
+{
+    BenchResult result = {0};
+    srand(config->seed);
+    CGVector3f balls[BENCH_BALL_COUNT] = {0};
+    for (int i = 0; i < BENCH_BALL_COUNT; i++)
+    {
+        balls[i][0] = getRandomNumber();
+        balls[i][1] = getRandomNumber();
+        balls[i][2] = getRandomNumber();
+    }
+    initParticles(config->loadPath != NULL ? MIN_PARTICLES : config->particleCount);
+    resetFlockingStats();
+    resetParticleStageStats();
+    setParticlePerfCounters(config->counters);
+    setParticlePipelineFused(config->fused);
+    setMathPrecision(config->precision);
+    setIntegrator(config->integrator);
+    setTargetMode(config->targetMode);
+    if (config->loadPath != NULL && loadSnapshot(config->loadPath, balls, BENCH_BALL_COUNT) < 0)
+    {
+        exit(1);
+    }
+    if (config->streamPattern != NULL && !startSnapshotStream(config->streamPattern, config->streamPeriod))
+    {
+        exit(1);
+    }
+    clearEmitters();
+    if (config->emitterRate > 0.0f)
+    {
+        CGVector3f origin = {0.0f, 0.0f, 0.0f};
+        CGVector3f up = {0.0f, 1.0f, 0.0f};
+        addEmitter(origin, up, BENCH_EMITTER_CONE_ANGLE, config->emitterRate, BENCH_EMITTER_LIFETIME);
+    }
+
+    result.stepCount = (int)(config->duration / config->step + 0.5);
+    result.stepCount = result.stepCount < 1 ? 1 : result.stepCount;
+    ParticleBufferOptions bufferOptions = {GL_TRUE, GL_TRUE, GL_FALSE, GL_FALSE, GL_FALSE, 0};
+    PerfCounterValues startCounters, endCounters;
+    resetPerfCounterValues(&result.counters);
+    readPerfCounters(config->counters, &startCounters);
+    double start = getTimeNanos();
+    for (int i = 0; i < result.stepCount; i++)
+    {
+        if (config->churn > 0)
+        {
+            double churnStart = getTimeNanos();
+            //Nur so viele neu erzeugen wie entfernt wurden, damit die Anzahl gleich bleibt
+            int removed = killRandomParticles(config->churn);
+            result.churnParticles += spawnParticles(removed, NULL);
+            result.churnNanos += getTimeNanos() - churnStart;
+        }
+        updateEmitters(config->step);
+        updateParticles(config->step, balls, BENCH_BALL_COUNT);
+        updateSnapshotStream(config->step, balls, BENCH_BALL_COUNT);
+        if (config->fillBuffers)
+        {
+            double fillStart = getTimeNanos();
+            fillParticleBuffers(&bufferOptions);
+            result.fillNanos += getTimeNanos() - fillStart;
+        }
+    }
+    result.totalNanos = getTimeNanos() - start;
+    readPerfCounters(config->counters, &endCounters);
+    addPerfCounterDelta(&result.counters, &startCounters, &endCounters);
+    setParticlePerfCounters(NULL);
+    stopSnapshotStream();
+    if (config->savePath != NULL && !saveSnapshot(config->savePath, balls, BENCH_BALL_COUNT))
+    {
+        exit(1);
+    }
+    return result;
+}
+
+/**
+ * Gibt die Messergebnisse eines Benchmarklaufs aus.
+ * @param config die Parameter des Laufs
+ * @param result die Messergebnisse
+ */
+static void printBench(const BenchConfig *config, const BenchResult *result)
+{
+    printf("Partikel: %d, Threads: %d, Integrator: %s, Zielmodus: %d, Mathematik: %s\n",
+           getParticleAmount(), getJobWorkerCount(), getIntegratorName(getIntegrator()), getTargetMode(),
+           getMathPrecisionName(getMathPrecision()));
+    printf("Simulierte Dauer: %.3f s, Schrittweite: %.4f s, Schritte: %d\n",
+           result->stepCount * config->step, config->step, result->stepCount);
+    printf("Gesamt: %.3f ms, %.2f Schritte/s, %.2f ns je Partikel und Schritt\n",
+           result->totalNanos / 1e6, result->stepCount / (result->totalNanos / 1e9),
+           result->totalNanos / result->stepCount / getParticleAmount());
+    printf("Stufen (%s):", config->fused ? "zusammengefasst" : "einzeln");
+    for (int stage = 0; stage < PARTICLE_STAGE_COUNT; stage++)
+    {
+        printf(" %s %.2f ns", getParticleStageName(stage),
+               getParticleStageNanos(stage) / getParticlePipelineSteps() / getParticleAmount());
+    }
+    printf(" je Partikel und Schritt\n");
+    if (config->churn > 0)
+    {
+        printf("Wechsel: %.1f Partikel je Schritt, %.0f ns je Schritt, %.2f ns je gewechseltem Partikel\n",
+               (double)result->churnParticles / result->stepCount, result->churnNanos / result->stepCount,
+               result->churnParticles > 0 ? result->churnNanos / result->churnParticles : 0.0);
+    }
+    if (config->fillBuffers)
+    {
+        printf("Vertex Arrays: %.0f ns je Schritt, %.2f ns je Partikel, %d Vertices\n",
+               result->fillNanos / result->stepCount, result->fillNanos / result->stepCount / getParticleAmount(),
+               getParticleBuffer(particleBufferBodies)->count + getParticleBuffer(particleBufferShadows)->count);
+    }
+    if (config->streamPattern != NULL)
+    {
+        SnapshotStreamStats stats = getSnapshotStreamStats();
+        printf("Snapshots: %d geschrieben, %d ausgelassen, Kopieren %.3f ms je Snapshot, Schreiben %.3f ms je Snapshot (%.1f MB/s)\n",
+               stats.written, stats.dropped, stats.copyNanos / 1e6 / (stats.written > 0 ? stats.written : 1),
+               stats.writeNanos / 1e6 / (stats.written > 0 ? stats.written : 1),
+               stats.writeNanos > 0.0 ? stats.bytes / (stats.writeNanos / 1e9) / 1e6 : 0.0);
+    }
+    if (getTargetMode() == targetModeFlocking)
+    {
+        FlockingStats stats = getFlockingStats();
+        printf("Schwarm: Gitter %.0f ns je Schritt (%.2f ns je Partikel, %d Zellen), Kraefte %.0f ns je Schritt (%.2f ns je Auswertung)\n",
+               stats.buildNanos / stats.steps, stats.buildNanos / stats.steps / getParticleAmount(), stats.cellCount,
+               stats.forceNanos / result->stepCount, stats.forceNanos / stats.evaluations);
+        printf("Schwarm: %.1f Kandidaten und %.1f Nachbarn je Auswertung\n",
+               (double)stats.candidates / stats.evaluations, (double)stats.neighbours / stats.evaluations);
+    }
+    if (config->counters != NULL)
+    {
+        PerfCounterValues prepare, stages[PARTICLE_STAGE_COUNT], pipeline;
+        getParticleStageCounters(&prepare, stages, &pipeline);
+        double perParticleStep = (double)result->stepCount * getParticleAmount();
+        printPerfCounterHeader("Zaehler je Partikel und Schritt");
+        printPerfCounterValues("Vorbereitung", &prepare, perParticleStep);
+        if (!config->fused)
+        {
+            for (int stage = 0; stage < PARTICLE_STAGE_COUNT; stage++)
+            {
+                printPerfCounterValues(getParticleStageName(stage), &stages[stage], perParticleStep);
+            }
+        }
+        printPerfCounterValues("Pipeline", &pipeline, perParticleStep);
+        printPerfCounterValues("Schritt", &result->counters, perParticleStep);
+    }
+    printf("Partikel 0: (%.4f, %.4f, %.4f)\n", getParticleX(0), getParticleY(0), getParticleZ(0));
+}
+
+/**
+ * Wiederholt den Benchmark mit 1, 2, 4, ... Threads bis maxWorkers und gibt
+ * Durchsatz und Beschleunigung gegenueber einem Thread als Tabelle aus.
+ * @param config die Parameter der Laeufe
+ * @param maxWorkers groesste Anzahl an Threads
+ */
+static void runScaling(const BenchConfig *config, int maxWorkers)
+{
+    double baseNanos = 0.0;
+    printf("Threads  Schritte/s  ns/Partikel  Vertex Arrays ns/Partikel  Beschleunigung  Effizienz\n");
+    for (int workers = 1; workers <= maxWorkers; workers = workers * 2 > maxWorkers && workers < maxWorkers ? maxWorkers : workers * 2)
+    {
+        initJobSystem(workers);
+        BenchResult result = runBench(config);
+        double nanos = result.totalNanos;
+        baseNanos = workers == 1 ? nanos : baseNanos;
+        printf("%7d  %10.2f  %11.2f  %25.2f  %14.2f  %9.2f\n",
+               getJobWorkerCount(), result.stepCount / (nanos / 1e9), nanos / result.stepCount / getParticleAmount(),
+               result.fillNanos / result.stepCount / getParticleAmount(), baseNanos / nanos, baseNanos / nanos / getJobWorkerCount());
+    }
+}
+
+/**
+ * Bestimmt den groessten relativen Fehler der schnellen Naeherungen
+ * gegenueber der libm auf logarithmisch bzw. gleichmaessig verteilten
+ * Stuetzstellen.
+ * @param inverseSqrtError groesster Fehler von 1 / sqrt(x) fuer x in [1e-6, 1e6] (out-param)
+ * @param expError groesster Fehler von e^x fuer x in [-20, 20] (out-param)
+ */
+static void measureMathErrors(double *inverseSqrtError, double *expError)
+{
+    *inverseSqrtError = 0.0;
+    *expError = 0.0;
+    for (int i = 0; i < BENCH_MATH_SAMPLES; i++)
+    {
+        float t = (float)i / (BENCH_MATH_SAMPLES - 1);
+        float x = powf(10.0f, -6.0f + 12.0f * t);
+        double exact = 1.0 / sqrt((double)x);
+        *inverseSqrtError = fmax(*inverseSqrtError, fabs(fastInverseSqrt(x) - exact) / exact);
+        x = -20.0f + 40.0f * t;
+        exact = exp((double)x);
+        *expError = fmax(*expError, fabs(fastExp(x) - exact) / exact);
+    }
+}
+
+/**
+ * Vergleicht die schnelle mit der exakten Mathematik: beide Laeufe starten
+ * mit demselben Seed, ausgegeben werden Durchsatz, Beschleunigung, Fehler
+ * der Naeherungen und die Abweichung der Positionen am Ende des Laufs.
+ * @param config die Parameter der Laeufe
+ */
+static void runAccuracy(const BenchConfig *config)
+{
+    BenchConfig exactConfig = *config;
+    BenchConfig fastConfig = *config;
+    exactConfig.precision = mathPrecisionExact;
+    fastConfig.precision = mathPrecisionFast;
+
+    BenchResult exact = runBench(&exactConfig);
+    printBench(&exactConfig, &exact);
+    const ParticleStore *particles = getParticleStore();
+    int count = particles->count;
+    float *reference[3];
+    for (int d = 0; d < 3; d++)
+    {
+        reference[d] = malloc(sizeof(float) * count);
+        if (reference[d] == NULL)
+        {
+            printf("Kein virtueller RAM mehr verfügbar ...\n");
+            exit(1);
+        }
+        memcpy(reference[d], particles->center[d], sizeof(float) * count);
+    }
+
+    BenchResult fast = runBench(&fastConfig);
+    printBench(&fastConfig, &fast);
+    particles = getParticleStore();
+    double maxDeviation = 0.0;
+    double squaredDeviation = 0.0;
+    int compared = count < particles->count ? count : particles->count;
+    for (int i = 0; i < compared; i++)
+    {
+        double dx = particles->center[0][i] - reference[0][i];
+        double dy = particles->center[1][i] - reference[1][i];
+        double dz = particles->center[2][i] - reference[2][i];
+        double deviation = dx * dx + dy * dy + dz * dz;
+        squaredDeviation += deviation;
+        maxDeviation = fmax(maxDeviation, sqrt(deviation));
+    }
+    for (int d = 0; d < 3; d++)
+    {
+        free(reference[d]);
+    }
+
+    double inverseSqrtError;
+    double expError;
+    measureMathErrors(&inverseSqrtError, &expError);
+    printf("Beschleunigung schnell/exakt: %.2f\n", exact.totalNanos / fast.totalNanos);
+    printf("Groesster relativer Fehler: 1/sqrt %.2e, exp %.2e\n", inverseSqrtError, expError);
+    printf("Abweichung der Positionen nach %d Schritten: RMS %.2e, Maximum %.2e\n",
+           fast.stepCount, sqrt(squaredDeviation / compared), maxDeviation);
+}
+
+/**
+ * Hauptprogramm des Benchmarks.
+ * @param argc Anzahl der Kommandozeilenparameter
+ * @param argv Kommandozeilenparameter
+ * @return Rueckgabewert im Fehlerfall ungleich Null.
+ */
+int main(int argc, char **argv)
+{
+    BenchConfig config = {BENCH_DEFAULT_PARTICLES, BENCH_DEFAULT_DURATION, BENCH_DEFAULT_STEP, BENCH_DEFAULT_SEED,
+                          integratorSemiImplicitEuler, targetModeBalls, getMathPrecision(), GL_TRUE, 0, 0.0f, GL_FALSE,
+                          NULL, NULL, NULL, BENCH_DEFAULT_STREAM_PERIOD, NULL};
+    int workers = 0;
+    int maxWorkers = 0;
+    GLboolean compareAccuracy = GL_FALSE;
+    GLboolean countHardware = GL_FALSE;
+    PerfCounters counters;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:d:s:i:t:b:e:fr:j:w:p:aul:o:S:P:H")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            config.particleCount = atoi(optarg);
+            break;
+        case 'd':
+            config.duration = atof(optarg);
+            break;
+        case 's':
+            config.step = atof(optarg);
+            break;
+        case 'i':
+            config.integrator = (Integrator)atoi(optarg);
+            break;
+        case 't':
+            config.targetMode = (TargetMode)atoi(optarg);
+            break;
+        case 'b':
+            config.churn = atoi(optarg);
+            break;
+        case 'e':
+            config.emitterRate = atof(optarg);
+            break;
+        case 'f':
+            config.fillBuffers = GL_TRUE;
+            break;
+        case 'r':
+            config.seed = (unsigned)atoi(optarg);
+            break;
+        case 'j':
+            workers = atoi(optarg);
+            break;
+        case 'w':
+            maxWorkers = atoi(optarg);
+            break;
+        case 'p':
+            config.precision = (MathPrecision)atoi(optarg);
+            break;
+        case 'a':
+            compareAccuracy = GL_TRUE;
+            break;
+        case 'u':
+            config.fused = GL_FALSE;
+            break;
+        case 'l':
+            config.loadPath = optarg;
+            break;
+        case 'o':
+            config.savePath = optarg;
+            break;
+        case 'S':
+            config.streamPattern = optarg;
+            break;
+        case 'P':
+            config.streamPeriod = atof(optarg);
+            break;
+        case 'H':
+            countHardware = GL_TRUE;
+            break;
+        default:
+            fprintf(stderr, "Aufruf: %s [-n Partikel] [-d Sekunden] [-s Schrittweite] [-i Integrator] [-t Zielmodus] [-b Wechsel] [-e Rate] [-f] [-r Seed] [-j Threads] [-w Threads] [-p Genauigkeit] [-a] [-u] [-l Datei] [-o Datei] [-S Muster] [-P Sekunden] [-H]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (config.particleCount < MIN_PARTICLES || config.particleCount > MAX_PARTICLES || config.duration <= 0.0 || config.step <= 0.0 ||
+        config.churn < 0 || config.emitterRate < 0.0f || config.integrator < 0 || config.integrator >= INTEGRATOR_COUNT ||
+        config.targetMode < targetModeBalls || config.targetMode >= TARGET_MODE_COUNT ||
+        config.precision < 0 || config.precision >= MATH_PRECISION_COUNT ||
+        config.streamPeriod <= 0.0 || workers < 0 || workers > MAX_JOB_WORKERS || maxWorkers < 0 || maxWorkers > MAX_JOB_WORKERS)
+    {
+        fprintf(stderr, "Ungueltige Parameter.\n");
+        return 1;
+    }
+
+    if (maxWorkers > 0)
+    {
+        runScaling(&config, maxWorkers);
+    }
+    else if (compareAccuracy)
+    {
+        initJobSystem(workers);
+        runAccuracy(&config);
+    }
+    else
+    {
+        //Die Zaehler vor den Arbeitsthreads oeffnen, damit diese mitgezaehlt werden
+        if (countHardware)
+        {
+            openPerfCounters(&counters, 1);
+            config.counters = &counters;
+        }
+        initJobSystem(workers);
+        BenchResult result = runBench(&config);
+        printBench(&config, &result);
+        if (countHardware)
+        {
+            closePerfCounters(&counters);
+        }
+    }
+
+    clearEmitters();
+    freeParticles();
+    freeParticleBuffers();
+    shutdownJobSystem();
+    return 0;
+}
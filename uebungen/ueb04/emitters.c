@@ -0,0 +1,134 @@
+/**
+ * @file
+ * Emitter-Modul.
+ * Das Modul verwaltet Emitter, die mit fester Rate neue Partikel mit
+ * begrenzter Lebensdauer in einem Kegel ausstossen. Die Partikel werden ueber
+ * die Schnittstelle des Partikel-Moduls erzeugt; sobald dessen Speicher die
+ * groesste Population erreicht hat, wird nichts mehr alloziert.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <math.h>
+#include <string.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "emitters.h"
+#include "particles.h"
+
+/* ---- Globale Daten ---- */
+
+/* Feste Menge an Emittern, belegte Eintraege sind aktiv */
+Emitter g_emitters[MAX_EMITTERS] = {0};
+
+/* ---- Funktionen ---- */
+
+/**
+ * Fuegt einen Emitter hinzu.
+ * @param position Position des Emitters
+ * @param direction Austrittsrichtung (muss nicht normiert sein)
+ * @param coneAngle halber Oeffnungswinkel des Austrittskegels in Grad
+ * @param rate erzeugte Partikel pro Sekunde
+ * @param lifetime Lebensdauer der Partikel in Sekunden
+ * @return Index des Emitters oder -1, wenn kein Platz mehr frei ist
+ */
+int addEmitter(const float *position, const float *direction, float coneAngle, float rate, float lifetime)
+{
+    for (int i = 0; i < MAX_EMITTERS; i++)
+    {
+        if (!g_emitters[i].isActive)
+        {
+            memset(&g_emitters[i], 0, sizeof(Emitter));
+            setEmitterPose(i, position, direction);
+            g_emitters[i].coneAngle = coneAngle;
+            g_emitters[i].rate = rate;
+            g_emitters[i].lifetime = lifetime;
+            g_emitters[i].isActive = GL_TRUE;
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Entfernt einen Emitter. Bereits erzeugte Partikel leben weiter.
+ * @param i Index des Emitters
+ */
+void removeEmitter(int i)
+{
+    if (i >= 0 && i < MAX_EMITTERS)
+    {
+        g_emitters[i].isActive = GL_FALSE;
+    }
+}
+
+/**
+ * Entfernt alle Emitter.
+ */
+void clearEmitters(void)
+{
+    for (int i = 0; i < MAX_EMITTERS; i++)
+    {
+        g_emitters[i].isActive = GL_FALSE;
+    }
+}
+
+/**
+ * Setzt Position und Austrittsrichtung eines Emitters, z.B. um ihn an einem
+ * bewegten Objekt mitzufuehren.
+ * @param i Index des Emitters
+ * @param position neue Position
+ * @param direction neue Austrittsrichtung
+ */
+void setEmitterPose(int i, const float *position, const float *direction)
+{
+    for (int d = 0; d < 3; d++)
+    {
+        g_emitters[i].position[d] = position[d];
+        g_emitters[i].direction[d] = direction[d];
+    }
+}
+
+/**
+ * Laesst alle aktiven Emitter fuer die verstrichene Zeit Partikel erzeugen.
+ * Bruchteile von Partikeln werden bis zum naechsten Aufruf aufgehoben,
+ * sodass die Rate auch bei kleinen Zeitschritten eingehalten wird.
+ * @param interval die verstrichene Zeit
+ */
+void updateEmitters(double interval)
+{
+    for (int i = 0; i < MAX_EMITTERS; i++)
+    {
+        Emitter *emitter = &g_emitters[i];
+        if (emitter->isActive)
+        {
+            emitter->pending += emitter->rate * interval;
+            int count = (int)floorf(emitter->pending);
+            if (count > 0)
+            {
+                ParticleSpawnDistribution distribution = {{emitter->position[0], emitter->position[1], emitter->position[2]},
+                                                          0.0f,
+                                                          {emitter->direction[0], emitter->direction[1], emitter->direction[2]},
+                                                          emitter->coneAngle,
+                                                          emitter->lifetime};
+                spawnParticles(count, &distribution);
+                emitter->pending -= count;
+            }
+        }
+    }
+}
+
+/**
+ * Liefert die Anzahl der aktiven Emitter.
+ * @return Anzahl der aktiven Emitter
+ */
+int getActiveEmitterCount(void)
+{
+    int count = 0;
+    for (int i = 0; i < MAX_EMITTERS; i++)
+    {
+        count += g_emitters[i].isActive ? 1 : 0;
+    }
+    return count;
+}
@@ -0,0 +1,37 @@
+#ifndef __EMITTERS_H__
+#define __EMITTERS_H__
+/**
+ * @file
+ * Emitter-Modul.
+ * Das Modul verwaltet Emitter, die mit fester Rate neue Partikel mit
+ * begrenzter Lebensdauer in einem Kegel ausstossen. Die Partikel werden ueber
+ * die Schnittstelle des Partikel-Moduls erzeugt; sobald dessen Speicher die
+ * groesste Population erreicht hat, wird nichts mehr alloziert.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/* ---- Konstanten ---- */
+
+#define MAX_EMITTERS 8
+
+/* Abgasstrahl des ausgewaehlten Partikels */
+#define EXHAUST_RATE 2000.0f
+#define EXHAUST_LIFETIME 1.5f
+#define EXHAUST_CONE_ANGLE 15.0f
+
+int addEmitter(const float *position, const float *direction, float coneAngle, float rate, float lifetime);
+
+void removeEmitter(int i);
+
+void clearEmitters(void);
+
+void setEmitterPose(int i, const float *position, const float *direction);
+
+void updateEmitters(double interval);
+
+int getActiveEmitterCount(void);
+
+#endif
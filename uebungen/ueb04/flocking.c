@@ -0,0 +1,340 @@
+/**
+ * @file
+ * Schwarm-Modul.
+ * Das Modul berechnet das Schwarmverhalten (Boids) der Partikel: Abstand
+ * halten (Separation), Ausrichtung an den Nachbarn (Alignment) und
+ * Zusammenhalt (Kohaesion). Die Nachbarn werden ueber ein gleichmaessiges
+ * Gitter gefunden, das einmal je Zeitschritt per Counting Sort aufgebaut wird.
+ * Das Gitter haelt eine nach Zellen sortierte Kopie der Positionen und
+ * Geschwindigkeiten zu Beginn des Zeitschritts, sodass die Kraefte parallel
+ * berechnet werden koennen, waehrend die Partikel bereits bewegt werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "flocking.h"
+#include "util.h"
+
+/* ---- Konstanten ---- */
+
+#define LX (0)
+#define LY (1)
+#define LZ (2)
+
+/* ---- Typen ---- */
+
+/* Gleichmaessiges Gitter ueber die Bounding Box des Schwarms */
+typedef struct
+{
+    /* Anzahl der Zellen je Achse und insgesamt */
+    int dims[3];
+    int cellCount;
+    /* Ecke der Bounding Box und Kehrwert der Kantenlaenge einer Zelle */
+    float origin[3];
+    float invCellSize;
+    /* Erster Eintrag je Zelle, cellStart[cellCount] ist die Anzahl der Partikel */
+    int *cellStart;
+    int cellCapacity;
+    /* Zelle je Partikel (in Partikelreihenfolge) */
+    int *cellOf;
+    /* Eintrag im Gitter je Partikel (in Partikelreihenfolge) */
+    int *slotOf;
+    /* Nach Zellen sortierte Positionen und Geschwindigkeiten */
+    float *position[3];
+    float *velocity[3];
+    int capacity;
+} FlockingGrid;
+
+/* ---- Globale Daten ---- */
+
+/* Das Gitter des aktuellen Zeitschritts */
+FlockingGrid g_grid;
+
+/* Zaehler fuer die Auswertung, die Kraefte werden von allen Threads summiert */
+int g_gridSteps = 0;
+double g_buildNanos = 0.0;
+atomic_llong g_forceNanos = 0;
+atomic_llong g_evaluations = 0;
+atomic_llong g_candidates = 0;
+atomic_llong g_neighbours = 0;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Vergroessert ein Array bei Bedarf, der Inhalt wird nicht uebernommen.
+ * @param array das bisherige Array (darf NULL sein)
+ * @param size neue Groesse in Byte
+ * @return das neue Array
+ */
+static void *reallocGrid(void *array, size_t size)
+{
+    free(array);
+    array = malloc(size);
+    if (array == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    return array;
+}
+
+/**
+ * Stellt sicher, dass das Gitter die gegebene Anzahl an Partikeln und Zellen
+ * aufnehmen kann. Die Kapazitaeten werden dabei mindestens verdoppelt.
+ * @param count Anzahl der Partikel
+ * @param cellCount Anzahl der Zellen
+ */
+static void reserveGrid(int count, int cellCount)
+{
+    if (count > g_grid.capacity)
+    {
+        int capacity = g_grid.capacity * 2 > count ? g_grid.capacity * 2 : count;
+        g_grid.cellOf = reallocGrid(g_grid.cellOf, sizeof(int) * capacity);
+        g_grid.slotOf = reallocGrid(g_grid.slotOf, sizeof(int) * capacity);
+        for (int d = 0; d < 3; d++)
+        {
+            g_grid.position[d] = reallocGrid(g_grid.position[d], sizeof(float) * capacity);
+            g_grid.velocity[d] = reallocGrid(g_grid.velocity[d], sizeof(float) * capacity);
+        }
+        g_grid.capacity = capacity;
+    }
+    if (cellCount + 1 > g_grid.cellCapacity)
+    {
+        int capacity = g_grid.cellCapacity * 2 > cellCount + 1 ? g_grid.cellCapacity * 2 : cellCount + 1;
+        g_grid.cellStart = reallocGrid(g_grid.cellStart, sizeof(int) * capacity);
+        g_grid.cellCapacity = capacity;
+    }
+}
+
+/**
+ * Bestimmt die Zelle einer Koordinate auf einer Achse. Punkte ausserhalb der
+ * Bounding Box (z.B. Zwischenpositionen der Integrationsverfahren) landen in
+ * der Randzelle.
+ * @param d die Achse
+ * @param value die Koordinate
+ * @return Index der Zelle auf der Achse
+ */
+static int cellCoordinate(int d, float value)
+{
+    int cell = (int)((value - g_grid.origin[d]) * g_grid.invCellSize);
+    cell = cell < 0 ? 0 : cell;
+    return cell >= g_grid.dims[d] ? g_grid.dims[d] - 1 : cell;
+}
+
+/**
+ * Baut das Gitter fuer den aktuellen Zeitschritt per Counting Sort auf:
+ * Partikel je Zelle zaehlen, Praefixsumme bilden, Partikel einsortieren.
+ * Die Zellen sind mindestens FLOCKING_RADIUS gross, sodass alle Nachbarn in
+ * den 27 umliegenden Zellen liegen.
+ * @param particles die Partikel
+ * @param swarm die Kenngroessen des Schwarms (Bounding Box)
+ */
+void buildFlockingGrid(const ParticleStore *particles, const SwarmAggregates *swarm)
+{
+    double start = getTimeNanos();
+    int count = particles->count;
+
+    float cellSize = FLOCKING_RADIUS;
+    for (int d = 0; d < 3; d++)
+    {
+        float extent = swarm->boundsMax[d] - swarm->boundsMin[d];
+        if (extent / cellSize > FLOCKING_MAX_CELLS_PER_AXIS)
+        {
+            cellSize = extent / FLOCKING_MAX_CELLS_PER_AXIS;
+        }
+    }
+    g_grid.cellCount = 1;
+    for (int d = 0; d < 3; d++)
+    {
+        g_grid.dims[d] = (int)((swarm->boundsMax[d] - swarm->boundsMin[d]) / cellSize) + 1;
+        g_grid.dims[d] = g_grid.dims[d] > FLOCKING_MAX_CELLS_PER_AXIS ? FLOCKING_MAX_CELLS_PER_AXIS : g_grid.dims[d];
+        g_grid.origin[d] = swarm->boundsMin[d];
+        g_grid.cellCount *= g_grid.dims[d];
+    }
+    g_grid.invCellSize = 1.0f / cellSize;
+    reserveGrid(count, g_grid.cellCount);
+
+    int *cellStart = g_grid.cellStart;
+    memset(cellStart, 0, sizeof(int) * (g_grid.cellCount + 1));
+    //Partikel je Zelle zaehlen (um eins verschoben fuer die Praefixsumme)
+    for (int i = 0; i < count; i++)
+    {
+        int cell = (cellCoordinate(LZ, particles->center[LZ][i]) * g_grid.dims[LY] +
+                    cellCoordinate(LY, particles->center[LY][i])) * g_grid.dims[LX] +
+                   cellCoordinate(LX, particles->center[LX][i]);
+        g_grid.cellOf[i] = cell;
+        cellStart[cell + 1]++;
+    }
+    for (int c = 0; c < g_grid.cellCount; c++)
+    {
+        cellStart[c + 1] += cellStart[c];
+    }
+    //Einsortieren, danach zeigt cellStart[c] auf den Anfang der Zelle c + 1
+    for (int i = 0; i < count; i++)
+    {
+        int slot = cellStart[g_grid.cellOf[i]]++;
+        g_grid.slotOf[i] = slot;
+        for (int d = 0; d < 3; d++)
+        {
+            g_grid.position[d][slot] = particles->center[d][i];
+            g_grid.velocity[d][slot] = particles->velocity[d][i];
+        }
+    }
+    memmove(cellStart + 1, cellStart, sizeof(int) * g_grid.cellCount);
+    cellStart[0] = 0;
+
+    g_gridSteps++;
+    g_buildNanos += getTimeNanos() - start;
+}
+
+/**
+ * Addiert die Beschleunigung durch das Schwarmverhalten auf die
+ * Beschleunigungen eines Blocks von Partikeln. Je Partikel werden hoechstens
+ * FLOCKING_MAX_NEIGHBOURS Nachbarn im FLOCKING_RADIUS beruecksichtigt:
+ * a += S * Summe((s - s_j) / ||s - s_j||^2) + A * (v_mittel - v) + K * (s_mittel - s)
+ * Die drei Zellen einer Zeile liegen im Gitter hintereinander und werden
+ * daher als ein zusammenhaengender Bereich durchlaufen. Das Partikel selbst
+ * wird ueber seinen Eintrag im Gitter uebersprungen, da es an den
+ * Zwischenpositionen der Integrationsverfahren nicht mehr bei Abstand 0 liegt.
+ * @param first Index des ersten Partikels im Block
+ * @param n Anzahl der Partikel im Block
+ * @param position die Positionen, an denen ausgewertet wird
+ * @param velocity die Geschwindigkeiten der Partikel
+ * @param acceleration die Beschleunigungen, werden erhoeht
+ */
+void accelerateFlocking(int first, int n, float **position, float **velocity, float **acceleration)
+{
+    double start = getTimeNanos();
+    const float radiusSquared = FLOCKING_RADIUS * FLOCKING_RADIUS;
+    const float *gx = g_grid.position[LX];
+    const float *gy = g_grid.position[LY];
+    const float *gz = g_grid.position[LZ];
+    const float *gvx = g_grid.velocity[LX];
+    const float *gvy = g_grid.velocity[LY];
+    const float *gvz = g_grid.velocity[LZ];
+    const int *slotOf = g_grid.slotOf + first;
+    long long candidates = 0;
+    long long neighbours = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        float px = position[LX][i];
+        float py = position[LY][i];
+        float pz = position[LZ][i];
+        int self = slotOf[i];
+        int cell[3] = {cellCoordinate(LX, px), cellCoordinate(LY, py), cellCoordinate(LZ, pz)};
+        int xFirst = cell[LX] > 0 ? cell[LX] - 1 : 0;
+        int xLast = cell[LX] + 1 < g_grid.dims[LX] ? cell[LX] + 1 : g_grid.dims[LX] - 1;
+        float separation[3] = {0.0f, 0.0f, 0.0f};
+        float alignment[3] = {0.0f, 0.0f, 0.0f};
+        float cohesion[3] = {0.0f, 0.0f, 0.0f};
+        int found = 0;
+
+        for (int z = cell[LZ] - 1; z <= cell[LZ] + 1 && found < FLOCKING_MAX_NEIGHBOURS; z++)
+        {
+            for (int y = cell[LY] - 1; y <= cell[LY] + 1 && found < FLOCKING_MAX_NEIGHBOURS; y++)
+            {
+                if (z < 0 || z >= g_grid.dims[LZ] || y < 0 || y >= g_grid.dims[LY])
+                {
+                    continue;
+                }
+                int row = (z * g_grid.dims[LY] + y) * g_grid.dims[LX];
+                int last = g_grid.cellStart[row + xLast + 1];
+                for (int j = g_grid.cellStart[row + xFirst]; j < last && found < FLOCKING_MAX_NEIGHBOURS; j++)
+                {
+                    float dx = px - gx[j];
+                    float dy = py - gy[j];
+                    float dz = pz - gz[j];
+                    float distanceSquared = dx * dx + dy * dy + dz * dz;
+                    candidates++;
+                    //Das Partikel selbst zaehlt nicht als Nachbar, deckungsgleiche
+                    //Partikel haben keine Richtung fuer die Trennung
+                    if (j != self && distanceSquared < radiusSquared && distanceSquared > 0.0f)
+                    {
+                        separation[LX] += dx / distanceSquared;
+                        separation[LY] += dy / distanceSquared;
+                        separation[LZ] += dz / distanceSquared;
+                        alignment[LX] += gvx[j];
+                        alignment[LY] += gvy[j];
+                        alignment[LZ] += gvz[j];
+                        cohesion[LX] += gx[j];
+                        cohesion[LY] += gy[j];
+                        cohesion[LZ] += gz[j];
+                        found++;
+                    }
+                }
+            }
+        }
+
+        if (found > 0)
+        {
+            float p[3] = {px, py, pz};
+            float inverseFound = 1.0f / found;
+            for (int d = 0; d < 3; d++)
+            {
+                acceleration[d][i] += FLOCKING_SEPARATION_WEIGHT * separation[d] +
+                                      FLOCKING_ALIGNMENT_WEIGHT * (alignment[d] * inverseFound - velocity[d][i]) +
+                                      FLOCKING_COHESION_WEIGHT * (cohesion[d] * inverseFound - p[d]);
+            }
+        }
+        neighbours += found;
+    }
+
+    atomic_fetch_add(&g_evaluations, n);
+    atomic_fetch_add(&g_candidates, candidates);
+    atomic_fetch_add(&g_neighbours, neighbours);
+    atomic_fetch_add(&g_forceNanos, (long long)(getTimeNanos() - start));
+}
+
+/**
+ * Gibt den Speicher des Gitters frei.
+ */
+void freeFlockingGrid(void)
+{
+    free(g_grid.cellStart);
+    free(g_grid.cellOf);
+    free(g_grid.slotOf);
+    for (int d = 0; d < 3; d++)
+    {
+        free(g_grid.position[d]);
+        free(g_grid.velocity[d]);
+    }
+    memset(&g_grid, 0, sizeof(g_grid));
+}
+
+/**
+ * Liefert die Laufzeiten und Zaehler seit dem letzten Zuruecksetzen.
+ * @return die Laufzeiten und Zaehler
+ */
+FlockingStats getFlockingStats(void)
+{
+    FlockingStats stats;
+    stats.steps = g_gridSteps;
+    stats.cellCount = g_grid.cellCount;
+    stats.buildNanos = g_buildNanos;
+    stats.forceNanos = (double)atomic_load(&g_forceNanos);
+    stats.evaluations = atomic_load(&g_evaluations);
+    stats.candidates = atomic_load(&g_candidates);
+    stats.neighbours = atomic_load(&g_neighbours);
+    return stats;
+}
+
+/**
+ * Setzt die Laufzeiten und Zaehler zurueck.
+ */
+void resetFlockingStats(void)
+{
+    g_gridSteps = 0;
+    g_buildNanos = 0.0;
+    atomic_store(&g_forceNanos, 0);
+    atomic_store(&g_evaluations, 0);
+    atomic_store(&g_candidates, 0);
+    atomic_store(&g_neighbours, 0);
+}
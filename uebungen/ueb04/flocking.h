@@ -0,0 +1,40 @@
+#ifndef __FLOCKING_H__
+#define __FLOCKING_H__
+/**
+ * @file
+ * Schwarm-Modul.
+ * Das Modul berechnet das Schwarmverhalten (Boids) der Partikel: Abstand
+ * halten (Separation), Ausrichtung an den Nachbarn (Alignment) und
+ * Zusammenhalt (Kohaesion). Die Nachbarn werden ueber ein gleichmaessiges
+ * Gitter gefunden, das einmal je Zeitschritt per Counting Sort aufgebaut wird.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/* ---- Konstanten ---- */
+
+/* Radius, in dem andere Partikel als Nachbarn zaehlen */
+#define FLOCKING_RADIUS 0.08f
+/* Hoechstzahl an Nachbarn, die je Partikel beruecksichtigt werden */
+#define FLOCKING_MAX_NEIGHBOURS 32
+/* Hoechstzahl an Zellen je Achse, bei groesserem Schwarm wachsen die Zellen */
+#define FLOCKING_MAX_CELLS_PER_AXIS 64
+
+/* Gewichte der drei Regeln */
+#define FLOCKING_SEPARATION_WEIGHT 0.05f
+#define FLOCKING_ALIGNMENT_WEIGHT 4.0f
+#define FLOCKING_COHESION_WEIGHT 40.0f
+
+void buildFlockingGrid(const ParticleStore *particles, const SwarmAggregates *swarm);
+
+void accelerateFlocking(int first, int n, float **position, float **velocity, float **acceleration);
+
+void freeFlockingGrid(void);
+
+FlockingStats getFlockingStats(void);
+
+void resetFlockingStats(void);
+
+#endif
@@ -29,6 +29,7 @@
 #include "debugGL.h"
 #include "util.h"
 #include "texture.h"
+#include "profiler.h"
 
 /* Funktionen */
 
@@ -77,6 +78,8 @@ GLfloat g_fps = 0.0f;
 /* ---- Konstanten ---- */
 /** Anzahl der Aufrufe der Timer-Funktion pro Sekunde */
 #define TIMER_CALLS_PS 60
+/** Datei fuer den Chrome-Trace der Frame-Zeiten */
+#define PROFILE_TRACE_PATH "profile_trace.json"
 /* ---- Funktionen ---- */
 
 /**
@@ -573,7 +576,9 @@ cbTimer(int lastCallTime)
     handleRadius();
 
     /*Kuemmert sich um die Berechnungen in der Logik (zeitgesteuert)*/
+    double profileStart = beginProfileScope();
     handleLogicCalculations(interval);
+    endProfileScope("Logik", profileStart);
 
     /* Wieder als Timer-Funktion registrieren */
     glutTimerFunc(1000 / TIMER_CALLS_PS, cbTimer, thisCallTime);
@@ -624,6 +629,11 @@ cbDisplay(void)
                                      //Up Vector als Up Vector
                                      particleUp[LX], particleUp[LY], particleUp[LZ]};
 
+    double profileStart = beginProfileScope();
+
+    /* Fertig geladene Texturen hochladen */
+    updateTextures();
+
     /* Framewbuffer und z-Buffer zuruecksetzen */
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -650,11 +660,16 @@ cbDisplay(void)
         }
     }
 
+    endProfileScope("Zeichnen", profileStart);
+
     /* Objekt anzeigen */
+    profileStart = beginProfileScope();
     glutSwapBuffers();
+    endProfileScope("Buffertausch", profileStart);
 
     /* Framerate berechnen */
     g_fps = frameRate();
+    markProfileFrame();
 }
 
 /**
@@ -699,6 +714,12 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
             case GLUT_KEY_DOWN:
                 decreaseParticles();
                 break;
+            case GLUT_KEY_PAGE_UP:
+                spawnParticleBurst();
+                break;
+            case GLUT_KEY_PAGE_DOWN:
+                killParticleBurst();
+                break;
                 /* (De-)Aktivieren des Wireframemode */
             case GLUT_KEY_F1:
                 toggleWireframeMode();
@@ -730,6 +751,17 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
                 //Neuzeichnen anstossen
                 glutPostRedisplay();
                 break;
+                /* Frame-Zeiten anzeigen */
+            case GLUT_KEY_F11:
+                toggleProfileOverlay();
+                break;
+                /* Frame-Zeiten als Chrome-Trace speichern */
+            case GLUT_KEY_F12:
+                if (writeProfileTrace(PROFILE_TRACE_PATH))
+                {
+                    printf("Frame-Zeiten gespeichert: %s\n", PROFILE_TRACE_PATH);
+                }
+                break;
             }
         }
         /* normale Taste gedrueckt */
@@ -779,6 +811,8 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
             case 'Q':
             case ESC:
                 freeArraysLogic();
+                freeProfiler();
+                freeTextures();
                 exit(0);
                 break;
                 /* Hilfe */
@@ -820,10 +854,38 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
             case 'M':
                 g_ballMovement = !g_ballMovement;
                 break;
+                /* Integrationsverfahren wechseln */
+            case 'i':
+            case 'I':
+                nextIntegrator();
+                break;
+                /* Genauigkeit der Mathematik wechseln */
+            case 'g':
+            case 'G':
+                nextMathPrecision();
+                break;
+                /* Zustand speichern, laden bzw. fortlaufend schreiben */
+            case 'o':
+            case 'O':
+                saveState();
+                break;
+            case 'l':
+            case 'L':
+                loadState();
+                break;
+            case 'k':
+            case 'K':
+                toggleSnapshotStream();
+                break;
             case 'n':
             case 'N':
                 increasePickedParticle();
                 break;
+                /* Abgasstrahl des ausgewaehlten Partikels */
+            case 'x':
+            case 'X':
+                toggleExhaust();
+                break;
                 /* Textur aendern */
             case 't':
             case 'T':
@@ -1007,6 +1069,9 @@ int initAndStartIO(char *title, int width, int height)
     int argc = 1;
     char *argv = "cmd";
 
+    /* Hauptthread im Chrome-Trace benennen */
+    setProfileThreadName("Hauptthread");
+
     /* Glut initialisieren */
     glutInit(&argc, &argv);
 
@@ -0,0 +1,301 @@
+/**
+ * @file
+ * Job-Modul.
+ * Das Modul stellt einen festen Pool von Arbeitsthreads bereit, auf den
+ * Schleifen blockweise verteilt werden koennen (parallelFor). Jeder Thread
+ * arbeitet zunaechst seinen eigenen Bereich von Bloecken ab und stiehlt
+ * danach die Haelfte der verbleibenden Bloecke anderer Threads, sodass
+ * ungleich teure Bloecke die Threads nicht gegenseitig warten lassen.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "jobs.h"
+#include "profiler.h"
+
+/* ---- Konstanten ---- */
+
+/* Groesse einer Cache-Zeile, damit sich die Bereiche der Threads nicht stoeren */
+#define CACHE_LINE_SIZE 64
+
+/* ---- Typen ---- */
+
+/* Noch nicht vergebene Bloecke eines Threads als [Beginn, Ende). Beide Werte
+ * liegen in einem Wort, damit Entnehmen und Stehlen je ein einziges
+ * compare-and-swap sind. */
+typedef struct
+{
+    _Atomic uint64_t blocks;
+    char padding[CACHE_LINE_SIZE - sizeof(uint64_t)];
+} JobRange;
+
+/* Die gerade bearbeitete parallele Schleife */
+typedef struct
+{
+    JobFunction function;
+    void *data;
+    int count;
+    int grain;
+} Job;
+
+/* ---- Globale Daten ---- */
+
+/* Bereiche der Threads, Index 0 ist der aufrufende Thread */
+static JobRange g_ranges[MAX_JOB_WORKERS];
+
+/* Arbeitsthreads (ohne den aufrufenden Thread) */
+static pthread_t g_threads[MAX_JOB_WORKERS];
+
+/* Anzahl der Threads inklusive des aufrufenden Threads */
+static int g_workerCount = 1;
+
+/* Die aktuelle Schleife, gelesen nach dem Aufwecken unter g_mutex */
+static Job g_job;
+
+/* Aufwecken der Arbeitsthreads fuer eine neue Schleife bzw. zum Beenden */
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_wakeCondition = PTHREAD_COND_INITIALIZER;
+static unsigned g_generation = 0;
+static int g_shutdown = 0;
+
+/* Anzahl der Arbeitsthreads, die mit der aktuellen Schleife noch nicht fertig sind */
+static atomic_int g_busyWorkers = 0;
+
+/* Gesetzt, waehrend ein Thread Bloecke bearbeitet (verschachtelte Schleifen laufen seriell) */
+static _Thread_local int t_insideJob = 0;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Packt einen Bereich von Bloecken in ein Wort.
+ * @param begin erster Block
+ * @param end Block hinter dem letzten Block
+ * @return der gepackte Bereich
+ */
+static uint64_t packBlocks(uint32_t begin, uint32_t end)
+{
+    return ((uint64_t)end << 32) | begin;
+}
+
+/**
+ * Entnimmt den vordersten Block aus dem eigenen Bereich.
+ * @param range der eigene Bereich
+ * @return der Block oder -1, wenn der Bereich leer ist
+ */
+static int popBlock(JobRange *range)
+{
+    uint64_t old = atomic_load(&range->blocks);
+    for (;;)
+    {
+        uint32_t begin = (uint32_t)old;
+        uint32_t end = (uint32_t)(old >> 32);
+        if (begin >= end)
+        {
+            return -1;
+        }
+        if (atomic_compare_exchange_weak(&range->blocks, &old, packBlocks(begin + 1, end)))
+        {
+            return (int)begin;
+        }
+    }
+}
+
+/**
+ * Stiehlt die hintere Haelfte der Bloecke eines anderen Threads. Der erste
+ * gestohlene Block wird zurueckgegeben, die restlichen landen im eigenen
+ * (zu diesem Zeitpunkt leeren) Bereich.
+ * @param id Index des stehlenden Threads
+ * @return der Block oder -1, wenn kein Thread mehr Bloecke hat
+ */
+static int stealBlock(int id)
+{
+    for (int offset = 1; offset < g_workerCount; offset++)
+    {
+        JobRange *victim = &g_ranges[(id + offset) % g_workerCount];
+        uint64_t old = atomic_load(&victim->blocks);
+        for (;;)
+        {
+            uint32_t begin = (uint32_t)old;
+            uint32_t end = (uint32_t)(old >> 32);
+            if (begin >= end)
+            {
+                break;
+            }
+            uint32_t newEnd = end - (end - begin + 1) / 2;
+            if (atomic_compare_exchange_weak(&victim->blocks, &old, packBlocks(begin, newEnd)))
+            {
+                atomic_store(&g_ranges[id].blocks, packBlocks(newEnd + 1, end));
+                return (int)newEnd;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * Bearbeitet Bloecke der aktuellen Schleife, bis keine mehr zu vergeben sind.
+ * @param id Index des Threads
+ */
+static void runBlocks(int id)
+{
+    int block = popBlock(&g_ranges[id]);
+    while (block >= 0 || (block = stealBlock(id)) >= 0)
+    {
+        int first = block * g_job.grain;
+        int last = first + g_job.grain < g_job.count ? first + g_job.grain : g_job.count;
+        g_job.function(first, last, g_job.data);
+        block = popBlock(&g_ranges[id]);
+    }
+}
+
+/**
+ * Hauptschleife eines Arbeitsthreads: warten, bis eine Schleife ansteht,
+ * dann Bloecke bearbeiten und die Fertigstellung melden.
+ * @param arg Index des Threads
+ * @return immer NULL
+ */
+static void *runWorker(void *arg)
+{
+    int id = (int)(intptr_t)arg;
+    unsigned seenGeneration = 0;
+    t_insideJob = 1;
+
+    char name[PROFILER_NAME_LENGTH];
+    snprintf(name, PROFILER_NAME_LENGTH, "Arbeitsthread %d", id);
+    setProfileThreadName(name);
+    for (;;)
+    {
+        pthread_mutex_lock(&g_mutex);
+        while (g_generation == seenGeneration && !g_shutdown)
+        {
+            pthread_cond_wait(&g_wakeCondition, &g_mutex);
+        }
+        if (g_shutdown)
+        {
+            pthread_mutex_unlock(&g_mutex);
+            break;
+        }
+        seenGeneration = g_generation;
+        pthread_mutex_unlock(&g_mutex);
+
+        runBlocks(id);
+        atomic_fetch_sub(&g_busyWorkers, 1);
+    }
+    return NULL;
+}
+
+/**
+ * Startet den Pool der Arbeitsthreads. Ein bereits laufender Pool wird
+ * vorher beendet.
+ * @param workerCount Anzahl der Threads inklusive des aufrufenden Threads,
+ * 0 fuer die Anzahl der verfuegbaren Prozessorkerne
+ */
+void initJobSystem(int workerCount)
+{
+    shutdownJobSystem();
+    if (workerCount <= 0)
+    {
+        workerCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    workerCount = workerCount < 1 ? 1 : workerCount;
+    workerCount = workerCount > MAX_JOB_WORKERS ? MAX_JOB_WORKERS : workerCount;
+
+    g_workerCount = 1;
+    for (int i = 1; i < workerCount; i++)
+    {
+        if (pthread_create(&g_threads[i], NULL, runWorker, (void *)(intptr_t)i) != 0)
+        {
+            printf("Arbeitsthread %d konnte nicht gestartet werden.\n", i);
+            break;
+        }
+        g_workerCount++;
+    }
+}
+
+/**
+ * Beendet alle Arbeitsthreads. Danach laufen alle Schleifen seriell.
+ */
+void shutdownJobSystem(void)
+{
+    pthread_mutex_lock(&g_mutex);
+    g_shutdown = 1;
+    pthread_cond_broadcast(&g_wakeCondition);
+    pthread_mutex_unlock(&g_mutex);
+    for (int i = 1; i < g_workerCount; i++)
+    {
+        pthread_join(g_threads[i], NULL);
+    }
+    g_workerCount = 1;
+    g_generation = 0;
+    g_shutdown = 0;
+}
+
+/**
+ * Liefert die Anzahl der Threads inklusive des aufrufenden Threads.
+ * @return Anzahl der Threads
+ */
+int getJobWorkerCount(void)
+{
+    return g_workerCount;
+}
+
+/**
+ * Fuehrt eine Schleife ueber [0, count) blockweise auf allen Threads aus und
+ * kehrt erst zurueck, wenn alle Bloecke bearbeitet sind. Die Funktion wird
+ * je Block mit hoechstens grain Indizes aufgerufen. Ohne Arbeitsthreads oder
+ * innerhalb einer parallelen Schleife laufen die Bloecke seriell.
+ * @param count Anzahl der Indizes
+ * @param grain Anzahl der Indizes je Block
+ * @param function die Arbeitsfunktion
+ * @param data beliebige Daten, die an die Arbeitsfunktion weitergereicht werden
+ */
+void parallelFor(int count, int grain, JobFunction function, void *data)
+{
+    grain = grain < 1 ? 1 : grain;
+    int blockCount = (count + grain - 1) / grain;
+    if (g_workerCount <= 1 || blockCount <= 1 || t_insideJob)
+    {
+        for (int first = 0; first < count; first += grain)
+        {
+            function(first, first + grain < count ? first + grain : count, data);
+        }
+        return;
+    }
+
+    //Bloecke zu Beginn gleichmaessig auf die Threads verteilen
+    for (int w = 0; w < g_workerCount; w++)
+    {
+        uint32_t begin = (uint32_t)((int64_t)blockCount * w / g_workerCount);
+        uint32_t end = (uint32_t)((int64_t)blockCount * (w + 1) / g_workerCount);
+        atomic_store(&g_ranges[w].blocks, packBlocks(begin, end));
+    }
+
+    pthread_mutex_lock(&g_mutex);
+    g_job.function = function;
+    g_job.data = data;
+    g_job.count = count;
+    g_job.grain = grain;
+    atomic_store(&g_busyWorkers, g_workerCount - 1);
+    g_generation++;
+    pthread_cond_broadcast(&g_wakeCondition);
+    pthread_mutex_unlock(&g_mutex);
+
+    t_insideJob = 1;
+    runBlocks(0);
+    t_insideJob = 0;
+
+    //Warten, bis alle Arbeitsthreads ihre (ggf. gestohlenen) Bloecke beendet haben
+    while (atomic_load(&g_busyWorkers) > 0)
+    {
+        sched_yield();
+    }
+}
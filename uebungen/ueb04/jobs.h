@@ -0,0 +1,36 @@
+#ifndef __JOBS_H__
+#define __JOBS_H__
+/**
+ * @file
+ * Job-Modul.
+ * Das Modul stellt einen festen Pool von Arbeitsthreads bereit, auf den
+ * Schleifen blockweise verteilt werden koennen (parallelFor). Jeder Thread
+ * arbeitet zunaechst seinen eigenen Bereich von Bloecken ab und stiehlt
+ * danach die Haelfte der verbleibenden Bloecke anderer Threads, sodass
+ * ungleich teure Bloecke die Threads nicht gegenseitig warten lassen.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- Konstanten ---- */
+
+/* Hoechstzahl an Threads inklusive des aufrufenden Threads */
+#define MAX_JOB_WORKERS 64
+
+/**
+ * Arbeitsfunktion fuer einen Block einer parallelen Schleife.
+ * @param first erster Index des Blocks
+ * @param last Index hinter dem letzten Index des Blocks
+ * @param data beliebige Daten des Aufrufers
+ */
+typedef void (*JobFunction)(int first, int last, void *data);
+
+void initJobSystem(int workerCount);
+
+void shutdownJobSystem(void);
+
+int getJobWorkerCount(void);
+
+void parallelFor(int count, int grain, JobFunction function, void *data);
+
+#endif
@@ -1,3 +1,5 @@
+#ifndef __LOGIC_H__
+#define __LOGIC_H__
 /**
  * @file
  * Logik-Modul.
@@ -16,6 +18,7 @@
 
 /* ---- Eigene Header einbinden ---- */
 #include "types.h"
+#include "particles.h"
 
 /* ---- Konstanten ---- */
 
@@ -56,16 +59,8 @@
 #define UPPER_BOUND_THETA 90
 #define LOWER_BOUND_THETA -90
 
-#define INITIAL_PARTICLES 20
-#define MAX_PARTICLES 1000
-#define MIN_PARTICLES 1
-#define GAUSS_CONST 50
-#define K_V 0.5f
-
 #define WING_WIDTH 4.0
 
-#define PICKED_PARTICLE_SPEED_FAKTOR 1.2f
-
 #define DELTA 0.0001f
 
 #define BALL_COUNT 2
@@ -95,31 +90,13 @@ void freeArraysLogic(void);
 
 void initLogic(void);
 
-int getParticleAmount(void);
-
-float getParticleX(int i);
-
-float getParticleY(int i);
-
-float getParticleZ(int i);
-
-float getParticleVelocityX(int i);
-
-float getParticleVelocityY(int i);
-
-float getParticleVelocityZ(int i);
+void toggleExhaust(void);
 
-float getParticleAccelarationX(int i);
+void saveState(void);
 
-float getParticleAccelarationY(int i);
+void loadState(void);
 
-float getParticleAccelarationZ(int i);
-
-float getParticleUpX(int i);
-
-float getParticleUpY(int i);
-
-float getParticleUpZ(int i);
+void toggleSnapshotStream(void);
 
 float getBallX(int i);
 
@@ -127,12 +104,4 @@ float getBallY(int i);
 
 float getBallZ(int i);
 
-void decreaseParticles(void);
-
-void increaseParticles(void);
-
-int getPickedParticle(void);
-
-void increasePickedParticle(void);
-
-void changeTargetMode(void);
+#endif
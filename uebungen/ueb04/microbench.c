@@ -0,0 +1,180 @@
+/**
+ * @file
+ * Microbenchmarks des Partikelschritts.
+ * Misst einen einzelnen Zeitschritt der Partikelsimulation (updateParticles)
+ * fuer mehrere Partikelanzahlen, jeweils mit den Baellen und dem Schwarm als
+ * Ziel, ohne Fenster und ohne OpenGL. Ein Aufruf entspricht einem Schritt,
+ * zusaetzlich wird die Laufzeit je Partikel ausgegeben. Mit -t wird die
+ * Anzahl der Threads des Job-Moduls festgelegt (Standard: alle
+ * Prozessorkerne). Mit -j werden die Ergebnisse zusaetzlich als JSON
+ * geschrieben ("-" fuer die Standardausgabe statt der Tabelle), um sie ueber
+ * mehrere Commits zu vergleichen. Mit -H werden zusaetzlich die
+ * Hardwarezaehler je Schritt gemessen, summiert ueber alle Threads.
+ *
+ * Aufruf: ueb04_microbench [-w Aufwaermen] [-n Wiederholungen] [-t Threads] [-r Seed] [-j Datei] [-H]
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "particles.h"
+#include "jobs.h"
+#include "util.h"
+#include "microbench.h"
+
+/* ---- Konstanten ---- */
+
+#define MICROBENCH_DEFAULT_SEED 42
+#define MICROBENCH_STEP 0.005
+#define MICROBENCH_BALL_COUNT 2
+/** Laenge der Namen der Messungen */
+#define MICROBENCH_NAME_LENGTH 48
+
+/** Untersuchte Partikelanzahlen */
+static const int g_particleCounts[] = {1024, 8192, 65536};
+#define MICROBENCH_PARTICLE_COUNT_AMOUNT (int)(sizeof(g_particleCounts) / sizeof(g_particleCounts[0]))
+
+/** Untersuchte Zielmodi */
+static const TargetMode g_targetModes[] = {targetModeBalls, targetModeFlocking};
+#define MICROBENCH_TARGET_MODE_AMOUNT (int)(sizeof(g_targetModes) / sizeof(g_targetModes[0]))
+
+#define MICROBENCH_RESULT_COUNT (MICROBENCH_PARTICLE_COUNT_AMOUNT * MICROBENCH_TARGET_MODE_AMOUNT)
+
+/* ---- Typedeklarationen ---- */
+
+/** Eingaben des Kernels */
+typedef struct
+{
+    CGVector3f balls[MICROBENCH_BALL_COUNT];
+} MicroBenchInputs;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Misst updateParticles, ein Aufruf ist ein Zeitschritt.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchUpdateParticles(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    for (int i = 0; i < calls; i++)
+    {
+        updateParticles(MICROBENCH_STEP, inputs->balls, MICROBENCH_BALL_COUNT);
+    }
+}
+
+/**
+ * Hauptprogramm der Microbenchmarks.
+ * @param argc Anzahl der Kommandozeilenparameter
+ * @param argv Kommandozeilenparameter
+ * @return Rueckgabewert im Fehlerfall ungleich Null.
+ */
+int main(int argc, char **argv)
+{
+    int warmup = MICROBENCH_DEFAULT_WARMUP;
+    int repetitions = MICROBENCH_DEFAULT_REPETITIONS;
+    int workers = 0;
+    unsigned seed = MICROBENCH_DEFAULT_SEED;
+    const char *jsonPath = NULL;
+    int countHardware = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "w:n:t:r:j:H")) != -1)
+    {
+        switch (opt)
+        {
+        case 'w':
+            warmup = atoi(optarg);
+            break;
+        case 'n':
+            repetitions = atoi(optarg);
+            break;
+        case 't':
+            workers = atoi(optarg);
+            break;
+        case 'r':
+            seed = (unsigned)atoi(optarg);
+            break;
+        case 'j':
+            jsonPath = optarg;
+            break;
+        case 'H':
+            countHardware = 1;
+            break;
+        default:
+            fprintf(stderr, "Aufruf: %s [-w Aufwaermen] [-n Wiederholungen] [-t Threads] [-r Seed] [-j Datei] [-H]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (warmup < 0 || repetitions < 1 || workers < 0 || workers > MAX_JOB_WORKERS)
+    {
+        fprintf(stderr, "Ungueltige Parameter.\n");
+        return 1;
+    }
+
+    //Die Zaehler vor den Arbeitsthreads oeffnen, damit diese mitgezaehlt werden
+    PerfCounters perfCounters;
+    PerfCounters *counters = NULL;
+    if (countHardware)
+    {
+        openPerfCounters(&perfCounters, 1);
+        counters = &perfCounters;
+    }
+    initJobSystem(workers);
+    MicroBenchInputs inputs;
+    char names[MICROBENCH_RESULT_COUNT][MICROBENCH_NAME_LENGTH];
+    MicroBenchResult results[MICROBENCH_RESULT_COUNT];
+    int resultCount = 0;
+    for (int m = 0; m < MICROBENCH_TARGET_MODE_AMOUNT; m++)
+    {
+        for (int c = 0; c < MICROBENCH_PARTICLE_COUNT_AMOUNT; c++)
+        {
+            //Jede Messung beginnt mit denselben Partikeln und Baellen
+            srand(seed);
+            for (int i = 0; i < MICROBENCH_BALL_COUNT; i++)
+            {
+                setVector(getRandomNumber(), getRandomNumber(), getRandomNumber(), inputs.balls[i]);
+            }
+            initParticles(g_particleCounts[c]);
+            setTargetMode(g_targetModes[m]);
+            snprintf(names[resultCount], MICROBENCH_NAME_LENGTH, "updateParticles/%s/%d",
+                     g_targetModes[m] == targetModeFlocking ? "flocking" : "balls", g_particleCounts[c]);
+            results[resultCount] = runMicroBench(names[resultCount], benchUpdateParticles, &inputs, 1, warmup, repetitions, counters);
+            resultCount++;
+        }
+    }
+
+    //Bei JSON auf der Standardausgabe entfaellt die Tabelle
+    if (jsonPath == NULL || strcmp(jsonPath, "-") != 0)
+    {
+        printf("Threads: %d, Schrittweite: %.4f s, Aufwaermen: %d, Wiederholungen: %d\n\n",
+               getJobWorkerCount(), MICROBENCH_STEP, warmup, repetitions);
+        printMicroBenchHeader();
+        for (int i = 0; i < resultCount; i++)
+        {
+            printMicroBenchResult(&results[i]);
+        }
+        printf("\n%-32s %12s\n", "Funktion", "ns/Partikel");
+        for (int i = 0; i < resultCount; i++)
+        {
+            printf("%-32s %12.2f\n", results[i].name, results[i].medianNanos / g_particleCounts[i % MICROBENCH_PARTICLE_COUNT_AMOUNT]);
+        }
+        printMicroBenchCounters(results, resultCount);
+    }
+
+    int ok = jsonPath == NULL || writeMicroBenchJson(jsonPath, "ueb04", warmup, results, resultCount);
+    freeParticles();
+    shutdownJobSystem();
+    if (counters != NULL)
+    {
+        closePerfCounters(counters);
+    }
+    return ok ? 0 : 1;
+}
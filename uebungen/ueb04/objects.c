@@ -40,6 +40,24 @@
 
 /* ---- Funktionsprototypen innerhalb ---- */
 
+/**
+ * Utility Funktion zum setzen der Farbe,
+ * sowie die Materialeigenschaften des zu Zeichnenden Objektes
+ * @param red Der Intensitaetswert fuer den roten Kanal
+ * @param green Der Intensitaetswert fuer den gruenen Kanal
+ * @param blue Der Intensitaetswert fuer den blauen Kanal
+ * @param alpha Der Intensitaetswert fuer den alpha Kanal beim Material
+ * @param face die Seite welche beim Material gesetzt werden soll
+ * @param materialAttribute Materialeigenschaft der Flaeche die geaendert werden soll 
+ * 
+ */
+void setMaterialAndColor(float red, float green, float blue, float alpha, GLenum face, GLenum materialAttribute)
+{
+    glColor3f(red, green, blue);
+    CGColor4f material = {red, green, blue, alpha};
+    glMaterialfv(face, materialAttribute, material);
+}
+
 /**
  * Hilfsmethode welche eine Linie zwischen 2 Punkten zeichnet
  * @param x1 x Koordinate des ersten Punktes
@@ -98,136 +116,6 @@ static void drawArrow(void)
     glEnd();
 }
 
-/**
- * Erstellt einen Flieger
- * @param position Position im Raum
- * @param velocity Geschwindigkeitsvektor fuer die Orientation
- * @param rightVector VxA fuer die Orientation
- * @param isTarget Wahrheitswert ob es sich um das ausgewaehlte Partikel handelt
- */
-void drawPlane(float *position, float *velocity, float *rightVector, GLboolean isTarget)
-{
-    CGVector3f front = {position[LX], position[LY], position[LZ]};
-    CGVector3f leftWing = {position[LX] - velocity[LX] - (rightVector[LX] / WING_WIDTH),
-                           position[LY] - velocity[LY] - (rightVector[LY] / WING_WIDTH),
-                           position[LZ] - velocity[LZ] - (rightVector[LZ] / WING_WIDTH)};
-    CGVector3f rightWing = {position[LX] - velocity[LX] + (rightVector[LX] / WING_WIDTH),
-                            position[LY] - velocity[LY] + (rightVector[LY] / WING_WIDTH),
-                            position[LZ] - velocity[LZ] + (rightVector[LZ] / WING_WIDTH)};
-    CGVector3f backMid = {position[LX] - velocity[LX],
-                          position[LY] - velocity[LY],
-                          position[LZ] - velocity[LZ]};
-
-    if (isTarget) //Ausgewahlter Flieger in einer anderen Farbe
-    {
-        glBegin(GL_TRIANGLES);
-        {
-            setMaterialAndColor(RED, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-            //Oben links
-            glVertex3f(front[LX], front[LY], front[LZ]);
-            glVertex3f(leftWing[LX], leftWing[LY], leftWing[LZ]);
-            glVertex3f(backMid[LX], backMid[LY], backMid[LZ]);
-            //Unten links
-            glVertex3f(front[LX], front[LY], front[LZ]);
-            glVertex3f(backMid[LX], backMid[LY], backMid[LZ]);
-            glVertex3f(leftWing[LX], leftWing[LY], leftWing[LZ]);
-
-            setMaterialAndColor(BLUE, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-            //Unten rechts
-            glVertex3f(front[LX], front[LY], front[LZ]);
-            glVertex3f(rightWing[LX], rightWing[LY], rightWing[LZ]);
-            glVertex3f(backMid[LX], backMid[LY], backMid[LZ]);
-            //Oben rechts
-            glVertex3f(front[LX], front[LY], front[LZ]);
-            glVertex3f(backMid[LX], backMid[LY], backMid[LZ]);
-            glVertex3f(rightWing[LX], rightWing[LY], rightWing[LZ]);
-        }
-        glEnd();
-    }
-    else //Normale Flieger in anderer Farbe
-    {
-        glBegin(GL_TRIANGLES);
-        {
-            setMaterialAndColor(GREEN, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-            //Oben links
-            glVertex3f(front[LX], front[LY], front[LZ]);
-            glVertex3f(leftWing[LX], leftWing[LY], leftWing[LZ]);
-            glVertex3f(backMid[LX], backMid[LY], backMid[LZ]);
-            //Unten links
-            glVertex3f(front[LX], front[LY], front[LZ]);
-            glVertex3f(backMid[LX], backMid[LY], backMid[LZ]);
-            glVertex3f(leftWing[LX], leftWing[LY], leftWing[LZ]);
-
-            setMaterialAndColor(YELLOW, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-            //Oben rechts
-            glVertex3f(front[LX], front[LY], front[LZ]);
-            glVertex3f(backMid[LX], backMid[LY], backMid[LZ]);
-            glVertex3f(rightWing[LX], rightWing[LY], rightWing[LZ]);
-            //Unten rechts
-            glVertex3f(front[LX], front[LY], front[LZ]);
-            glVertex3f(rightWing[LX], rightWing[LY], rightWing[LZ]);
-            glVertex3f(backMid[LX], backMid[LY], backMid[LZ]);
-        }
-        glEnd();
-    }
-}
-
-/**
- * Zeichnet das Partikel als Linie.
- * @param position Position des Partikels
- * @param velocity Geschwindigkeit des Partikels
- * @param isTarget Wahrheitswert ob es sich um das ausgewaehlte Partikel handelt
- */
-void drawPlaneAsLine(float *position, float *velocity, GLboolean isTarget)
-{
-    if (isTarget) //Andere Farbe fuer ausgewahlten
-    {
-        glBegin(GL_LINES);
-        setMaterialAndColor(RED, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-        glVertex3f(position[LX], position[LY], position[LZ]);
-        setMaterialAndColor(BLUE, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-        glVertex3f(position[LX] - velocity[LX], position[LY] - velocity[LY], position[LZ] - velocity[LZ]);
-        glEnd();
-    }
-    else
-    {
-        glBegin(GL_LINES);
-        setMaterialAndColor(GREEN, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-        glVertex3f(position[LX], position[LY], position[LZ]);
-        setMaterialAndColor(YELLOW, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-        glVertex3f(position[LX] - velocity[LX], position[LY] - velocity[LY], position[LZ] - velocity[LZ]);
-        glEnd();
-    }
-}
-
-/**
- * Erstellt einen Schatten
- * @param position Position im Raum
- * @param velocity Geschwindigkeitsvektor fuer die Orientation
- * @param rightVector VxA fuer die Orientation
- */
-void drawShadow(float *position, float *velocity, float *rightVector)
-{
-    CGVector3f front = {position[LX], position[LY], position[LZ]};
-    CGVector3f leftWing = {position[LX] - velocity[LX] - (rightVector[LX] / WING_WIDTH),
-                           position[LY] - velocity[LY] - (rightVector[LY] / WING_WIDTH),
-                           position[LZ] - velocity[LZ] - (rightVector[LZ] / WING_WIDTH)};
-    CGVector3f rightWing = {position[LX] - velocity[LX] + (rightVector[LX] / WING_WIDTH),
-                            position[LY] - velocity[LY] + (rightVector[LY] / WING_WIDTH),
-                            position[LZ] - velocity[LZ] + (rightVector[LZ] / WING_WIDTH)};
-    glBegin(GL_TRIANGLES);
-    {
-        //Oben
-        glVertex3f(front[LX], SHADOW_DISTANCE_TO_GROUND, front[LZ]);
-        glVertex3f(leftWing[LX], SHADOW_DISTANCE_TO_GROUND, leftWing[LZ]);
-        glVertex3f(rightWing[LX], SHADOW_DISTANCE_TO_GROUND, rightWing[LZ]);
-        //Unten
-        glVertex3f(front[LX], SHADOW_DISTANCE_TO_GROUND, front[LZ]);
-        glVertex3f(rightWing[LX], SHADOW_DISTANCE_TO_GROUND, rightWing[LZ]);
-        glVertex3f(leftWing[LX], SHADOW_DISTANCE_TO_GROUND, leftWing[LZ]);
-    }
-    glEnd();
-}
 /**
  * Zeichnet Koordinatenachsen (inklusive Beschriftung).
  */
@@ -10,6 +10,8 @@
  * @author Michael Smirnov & Len Harmsen
  */
 
+void setMaterialAndColor(float red, float green, float blue, float alpha, GLenum face, GLenum materialAttribute);
+
 void drawLineInBetween(float x1, float y1, float z1, float x2, float y2, float z2);
 
 void drawGrid();
@@ -20,10 +22,4 @@ void drawSphere();
 
 void drawWalls(GLboolean drawNormals);
 
-void drawPlane(float *position, float *velocity, float *rightVector, GLboolean isTarget);
-
-void drawShadow(float *position, float *velocity, float *rightVector);
-
-void drawPlaneAsLine(float *position, float *velocity, GLboolean isTarget);
-
 #endif
\ No newline at end of file
@@ -0,0 +1,295 @@
+/**
+ * @file
+ * Partikelpuffer-Modul.
+ * Das Modul befuellt einmal pro Frame die Vertex Arrays aller Partikel,
+ * Schatten und Hilfsvektoren, sodass diese mit wenigen Zeichenaufrufen
+ * dargestellt werden koennen. Es kommt ohne OpenGL-Aufrufe aus und kann daher
+ * auch im Benchmark verwendet werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "particleBuffers.h"
+#include "logic.h"
+#include "util.h"
+#include "jobs.h"
+
+/* ---- Typen ---- */
+
+/* Parameter des Befuellens fuer die Arbeitsthreads */
+typedef struct
+{
+    const ParticleBufferOptions *options;
+    const ParticleStore *particles;
+    int bodyVertices;
+    int shadowVertices;
+    int vectorVertices;
+} ParticleBufferJob;
+
+/* ---- Globale Daten ---- */
+
+/* Vertex Arrays fuer Partikel, Schatten und Hilfsvektoren */
+VertexBuffer g_particleBuffers[PARTICLE_BUFFER_COUNT] = {{0}};
+
+/* ---- Funktionen ---- */
+
+/**
+ * Stellt sicher, dass ein Vertex Array mindestens die gegebene Anzahl an
+ * Vertices aufnehmen kann. Die Kapazitaet wird dabei mindestens verdoppelt,
+ * sodass bei gleichbleibender Partikelzahl nicht neu alloziert wird.
+ * @param buffer das Vertex Array
+ * @param count die benoetigte Anzahl an Vertices
+ */
+static void reserveVertices(VertexBuffer *buffer, int count)
+{
+    if (count <= buffer->capacity)
+    {
+        return;
+    }
+    int capacity = buffer->capacity * 2 > count ? buffer->capacity * 2 : count;
+    Vertex *vertices = realloc(buffer->vertices, sizeof(Vertex) * capacity);
+    if (vertices == NULL)
+    {
+        free(buffer->vertices);
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    buffer->vertices = vertices;
+    buffer->capacity = capacity;
+}
+
+/**
+ * Setzt Position und Farbe eines Vertex. Die Normale zeigt nach oben, die
+ * Texturkoordinaten werden nicht genutzt.
+ * @param vertex der zu setzende Vertex (out-param)
+ * @param x, y, z die Position
+ * @param r, g, b die Farbe
+ */
+static void setVertex(Vertex vertex, float x, float y, float z, float r, float g, float b)
+{
+    vertex[CX] = x;
+    vertex[CY] = y;
+    vertex[CZ] = z;
+    vertex[CR] = r;
+    vertex[CG] = g;
+    vertex[CB] = b;
+    vertex[NX] = 0.0f;
+    vertex[NY] = 1.0f;
+    vertex[NZ] = 0.0f;
+    vertex[TX] = 0.0f;
+    vertex[TY] = 0.0f;
+}
+
+/**
+ * Skaliert einen Vektor auf die Laenge VECTOR_LENGTH_FACTOR.
+ * @param vector der Vektor, wird veraendert
+ */
+static void scaleToVectorLength(float *vector)
+{
+    //FLT_MIN verhindert die Division durch Null bei Nullvektoren
+    float factor = VECTOR_LENGTH_FACTOR / sqrtf(vector[LX] * vector[LX] + vector[LY] * vector[LY] +
+                                                vector[LZ] * vector[LZ] + FLT_MIN);
+    vector[LX] *= factor;
+    vector[LY] *= factor;
+    vector[LZ] *= factor;
+}
+
+/**
+ * Schreibt die Vertices eines Partikels als vier Dreiecke (beidseitig
+ * sichtbare Fluegel) bzw. als Linie entgegen der Flugrichtung.
+ * @param vertices die Vertices des Partikels (out-param)
+ * @param position Position des Partikels
+ * @param velocity skalierte Geschwindigkeit fuer die Ausrichtung
+ * @param right skalierter Vektor v x a fuer die Ausrichtung der Fluegel
+ * @param asTriangles Dreiecke (GL_TRUE) oder Linie (GL_FALSE)
+ * @param isPicked ob es sich um das ausgewaehlte Partikel handelt
+ */
+static void writeBody(Vertex *vertices, const float *position, const float *velocity, const float *right,
+                      GLboolean asTriangles, GLboolean isPicked)
+{
+    //Ausgewahlter Flieger in einer anderen Farbe
+    CGColor3f left = {GREEN};
+    CGColor3f other = {YELLOW};
+    if (isPicked)
+    {
+        setVector(RED, left);
+        setVector(BLUE, other);
+    }
+    CGVector3f backMid = {position[LX] - velocity[LX], position[LY] - velocity[LY], position[LZ] - velocity[LZ]};
+    if (!asTriangles)
+    {
+        setVertex(vertices[0], position[LX], position[LY], position[LZ], left[0], left[1], left[2]);
+        setVertex(vertices[1], backMid[LX], backMid[LY], backMid[LZ], other[0], other[1], other[2]);
+        return;
+    }
+    CGVector3f leftWing = {backMid[LX] - right[LX] / WING_WIDTH, backMid[LY] - right[LY] / WING_WIDTH, backMid[LZ] - right[LZ] / WING_WIDTH};
+    CGVector3f rightWing = {backMid[LX] + right[LX] / WING_WIDTH, backMid[LY] + right[LY] / WING_WIDTH, backMid[LZ] + right[LZ] / WING_WIDTH};
+    const float *corners[BODY_TRIANGLE_VERTICES] = {position, leftWing, backMid, position, backMid, leftWing,
+                                                    position, rightWing, backMid, position, backMid, rightWing};
+    for (int k = 0; k < BODY_TRIANGLE_VERTICES; k++)
+    {
+        const float *color = k < BODY_TRIANGLE_VERTICES / 2 ? left : other;
+        setVertex(vertices[k], corners[k][LX], corners[k][LY], corners[k][LZ], color[0], color[1], color[2]);
+    }
+}
+
+/**
+ * Schreibt die Vertices eines Schattens auf dem Boden.
+ * @param vertices die Vertices des Schattens (out-param)
+ * @param position Position des Partikels
+ * @param velocity skalierte Geschwindigkeit fuer die Ausrichtung
+ * @param right skalierter Vektor v x a fuer die Ausrichtung der Fluegel
+ * @param asTriangles Dreiecke (GL_TRUE) oder Linie (GL_FALSE)
+ */
+static void writeShadow(Vertex *vertices, const float *position, const float *velocity, const float *right, GLboolean asTriangles)
+{
+    if (!asTriangles)
+    {
+        setVertex(vertices[0], position[LX], SHADOW_DISTANCE_TO_GROUND, position[LZ], BLACK);
+        setVertex(vertices[1], position[LX] - velocity[LX], SHADOW_DISTANCE_TO_GROUND, position[LZ] - velocity[LZ], BLACK);
+        return;
+    }
+    float leftX = position[LX] - velocity[LX] - right[LX] / WING_WIDTH;
+    float leftZ = position[LZ] - velocity[LZ] - right[LZ] / WING_WIDTH;
+    float rightX = position[LX] - velocity[LX] + right[LX] / WING_WIDTH;
+    float rightZ = position[LZ] - velocity[LZ] + right[LZ] / WING_WIDTH;
+    //Oben
+    setVertex(vertices[0], position[LX], SHADOW_DISTANCE_TO_GROUND, position[LZ], BLACK);
+    setVertex(vertices[1], leftX, SHADOW_DISTANCE_TO_GROUND, leftZ, BLACK);
+    setVertex(vertices[2], rightX, SHADOW_DISTANCE_TO_GROUND, rightZ, BLACK);
+    //Unten
+    setVertex(vertices[3], position[LX], SHADOW_DISTANCE_TO_GROUND, position[LZ], BLACK);
+    setVertex(vertices[4], rightX, SHADOW_DISTANCE_TO_GROUND, rightZ, BLACK);
+    setVertex(vertices[5], leftX, SHADOW_DISTANCE_TO_GROUND, leftZ, BLACK);
+}
+
+/**
+ * Schreibt eine Linie vom Partikel entlang eines Hilfsvektors.
+ * @param vertices die beiden Vertices der Linie (out-param)
+ * @param position Position des Partikels
+ * @param vector der skalierte Hilfsvektor
+ * @param color die Farbe der Linie
+ */
+static void writeVector(Vertex *vertices, const float *position, const float *vector, const float *color)
+{
+    setVertex(vertices[0], position[LX], position[LY], position[LZ], color[0], color[1], color[2]);
+    setVertex(vertices[1], position[LX] + vector[LX], position[LY] + vector[LY], position[LZ] + vector[LZ],
+              color[0], color[1], color[2]);
+}
+
+/**
+ * Arbeitsfunktion fuer das Job-Modul: befuellt die Vertex Arrays der
+ * Partikel [first, last). Jedes Partikel schreibt an eine feste Stelle der
+ * Arrays, daher koennen die Bloecke unabhaengig voneinander laufen.
+ * @param first Index des ersten Partikels
+ * @param last Index hinter dem letzten Partikel
+ * @param data die Parameter des Befuellens (ParticleBufferJob)
+ */
+static void fillParticleBuffersJob(int first, int last, void *data)
+{
+    const ParticleBufferJob *job = data;
+    const ParticleBufferOptions *options = job->options;
+    const ParticleStore *particles = job->particles;
+    Vertex *bodies = g_particleBuffers[particleBufferBodies].vertices;
+    Vertex *shadows = g_particleBuffers[particleBufferShadows].vertices;
+    Vertex *vectors = g_particleBuffers[particleBufferVectors].vertices;
+    const CGColor3f accelerationColor = {RED};
+    const CGColor3f velocityColor = {BLUE};
+    const CGColor3f upColor = {WHITE};
+
+    for (int i = first; i < last; i++)
+    {
+        CGVector3f position = {particles->center[LX][i], particles->center[LY][i], particles->center[LZ][i]};
+        CGVector3f velocity = {particles->velocity[LX][i], particles->velocity[LY][i], particles->velocity[LZ][i]};
+        CGVector3f acceleration = {particles->accelaration[LX][i], particles->accelaration[LY][i], particles->accelaration[LZ][i]};
+        CGVector3f up = {particles->up[LX][i], particles->up[LY][i], particles->up[LZ][i]};
+        // v x a
+        CGVector3f right = {velocity[LY] * acceleration[LZ] - velocity[LZ] * acceleration[LY],
+                            velocity[LZ] * acceleration[LX] - velocity[LX] * acceleration[LZ],
+                            velocity[LX] * acceleration[LY] - velocity[LY] * acceleration[LX]};
+        //Vektoren zum Zeichnen normieren und verkleinern
+        scaleToVectorLength(velocity);
+        scaleToVectorLength(right);
+
+        writeBody(bodies + (size_t)i * job->bodyVertices, position, velocity, right,
+                  options->asTriangles, i == options->pickedParticle);
+        if (job->shadowVertices > 0)
+        {
+            writeShadow(shadows + (size_t)i * job->shadowVertices, position, velocity, right, options->asTriangles);
+        }
+        if (job->vectorVertices > 0)
+        {
+            Vertex *vertices = vectors + (size_t)i * job->vectorVertices;
+            if (options->withAcceleration)
+            {
+                scaleToVectorLength(acceleration);
+                writeVector(vertices, position, acceleration, accelerationColor);
+                vertices += 2;
+            }
+            if (options->withVelocity)
+            {
+                writeVector(vertices, position, velocity, velocityColor);
+                vertices += 2;
+            }
+            if (options->withUp)
+            {
+                scaleToVectorLength(up);
+                writeVector(vertices, position, up, upColor);
+            }
+        }
+    }
+}
+
+/**
+ * Befuellt die Vertex Arrays aller Partikel, Schatten und Hilfsvektoren
+ * parallel ueber das Job-Modul.
+ * @param options welche Arrays wie befuellt werden
+ */
+void fillParticleBuffers(const ParticleBufferOptions *options)
+{
+    ParticleBufferJob job = {options, getParticleStore(), 0, 0, 0};
+    int count = job.particles->count;
+    job.bodyVertices = options->asTriangles ? BODY_TRIANGLE_VERTICES : BODY_LINE_VERTICES;
+    job.shadowVertices = options->withShadows ? (options->asTriangles ? SHADOW_TRIANGLE_VERTICES : SHADOW_LINE_VERTICES) : 0;
+    job.vectorVertices = 2 * ((options->withAcceleration ? 1 : 0) + (options->withVelocity ? 1 : 0) + (options->withUp ? 1 : 0));
+
+    int vertexCounts[PARTICLE_BUFFER_COUNT] = {job.bodyVertices, job.shadowVertices, job.vectorVertices};
+    for (int b = 0; b < PARTICLE_BUFFER_COUNT; b++)
+    {
+        reserveVertices(&g_particleBuffers[b], count * vertexCounts[b]);
+        g_particleBuffers[b].count = count * vertexCounts[b];
+    }
+
+    parallelFor(count, PARTICLE_BUFFER_GRAIN, fillParticleBuffersJob, &job);
+}
+
+/**
+ * Liefert ein zuletzt befuelltes Vertex Array.
+ * @param type welches Array geliefert wird
+ * @return das Vertex Array
+ */
+const VertexBuffer *getParticleBuffer(ParticleBufferType type)
+{
+    return &g_particleBuffers[type];
+}
+
+/**
+ * Gibt den Speicher der Vertex Arrays frei.
+ */
+void freeParticleBuffers(void)
+{
+    for (int i = 0; i < PARTICLE_BUFFER_COUNT; i++)
+    {
+        free(g_particleBuffers[i].vertices);
+        g_particleBuffers[i].vertices = NULL;
+        g_particleBuffers[i].count = 0;
+        g_particleBuffers[i].capacity = 0;
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef __PARTICLE_BUFFERS_H__
+#define __PARTICLE_BUFFERS_H__
+/**
+ * @file
+ * Partikelpuffer-Modul.
+ * Das Modul befuellt einmal pro Frame die Vertex Arrays aller Partikel,
+ * Schatten und Hilfsvektoren, sodass diese mit wenigen Zeichenaufrufen
+ * dargestellt werden koennen. Es kommt ohne OpenGL-Aufrufe aus und kann daher
+ * auch im Benchmark verwendet werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/* ---- Konstanten ---- */
+
+/* Vertices je Partikel: vier Dreiecke bzw. eine Linie */
+#define BODY_TRIANGLE_VERTICES 12
+#define BODY_LINE_VERTICES 2
+/* Vertices je Schatten: zwei Dreiecke bzw. eine Linie */
+#define SHADOW_TRIANGLE_VERTICES 6
+#define SHADOW_LINE_VERTICES 2
+
+/* Anzahl der Partikel, die ein Arbeitsthread am Stueck befuellt */
+#define PARTICLE_BUFFER_GRAIN 1024
+
+void fillParticleBuffers(const ParticleBufferOptions *options);
+
+const VertexBuffer *getParticleBuffer(ParticleBufferType type);
+
+void freeParticleBuffers(void);
+
+#endif
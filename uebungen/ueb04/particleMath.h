@@ -0,0 +1,98 @@
+#ifndef __PARTICLE_MATH_H__
+#define __PARTICLE_MATH_H__
+/**
+ * @file
+ * Mathematik der Partikelkernel.
+ * Schnelle Naeherungen fuer die inverse Wurzel und die Exponentialfunktion
+ * sowie Funktionen, die abhaengig von der eingestellten Genauigkeit die
+ * Naeherung oder die exakte Funktion der libm liefern. Die Funktionen sind
+ * inline und verzweigungsfrei, damit die Schleifen der Kernel vektorisiert
+ * werden koennen.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "types.h"
+
+/* ---- Konstanten ---- */
+
+/* Startwert der inversen Wurzel (Lomont) */
+#define FAST_INVERSE_SQRT_MAGIC 0x5f375a86
+/* 1 / ln(2) */
+#define FAST_EXP_LOG2E 1.44269504f
+/* Bereich des Exponenten, in dem 2^n als float darstellbar ist */
+#define FAST_EXP_MIN_EXPONENT -126.0f
+#define FAST_EXP_MAX_EXPONENT 127.0f
+
+/* ---- Funktionen ---- */
+
+/**
+ * Naehert 1 / sqrt(x) ueber die Bitdarstellung und einen Newton-Schritt.
+ * Relativer Fehler hoechstens ca. 1.8e-3.
+ * @param x der Wert (> 0)
+ * @return Naeherung von 1 / sqrt(x)
+ */
+static inline float fastInverseSqrt(float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = FAST_INVERSE_SQRT_MAGIC - (bits >> 1);
+    float y;
+    memcpy(&y, &bits, sizeof(y));
+    return y * (1.5f - 0.5f * x * y * y);
+}
+
+/**
+ * Naehert e^x ueber 2^(x / ln 2) = 2^n * 2^f mit ganzzahligem n und
+ * |f| <= 0.5. 2^n wird direkt als Exponent gesetzt, 2^f per Taylorpolynom
+ * 5. Grades angenaehert. Relativer Fehler hoechstens ca. 5e-6.
+ * @param x der Exponent
+ * @return Naeherung von e^x
+ */
+static inline float fastExp(float x)
+{
+    float t = x * FAST_EXP_LOG2E;
+    t = t < FAST_EXP_MIN_EXPONENT ? FAST_EXP_MIN_EXPONENT : t;
+    t = t > FAST_EXP_MAX_EXPONENT ? FAST_EXP_MAX_EXPONENT : t;
+    //Auf die naechste ganze Zahl runden (ohne floorf, das nicht ueberall vektorisiert)
+    float shifted = t + 0.5f;
+    int n = (int)shifted;
+    n -= shifted < (float)n;
+    float f = (t - (float)n) * 0.69314718f;
+    // e^f mit |f| <= ln(2) / 2
+    float p = 1.0f + f * (1.0f + f * (0.5f + f * (1.0f / 6.0f + f * (1.0f / 24.0f + f * (1.0f / 120.0f)))));
+    uint32_t bits = (uint32_t)(n + 127) << 23;
+    float scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+/**
+ * Liefert 1 / sqrt(x) in der gegebenen Genauigkeit.
+ * @param x der Wert (> 0)
+ * @param precision die Genauigkeit
+ * @return 1 / sqrt(x)
+ */
+static inline float particleInverseSqrt(float x, MathPrecision precision)
+{
+    return precision == mathPrecisionFast ? fastInverseSqrt(x) : 1.0f / sqrtf(x);
+}
+
+/**
+ * Liefert e^x in der gegebenen Genauigkeit.
+ * @param x der Exponent
+ * @param precision die Genauigkeit
+ * @return e^x
+ */
+static inline float particleExp(float x, MathPrecision precision)
+{
+    return precision == mathPrecisionFast ? fastExp(x) : expf(x);
+}
+
+#endif
@@ -0,0 +1,1604 @@
+/**
+ * @file
+ * Partikel-Modul.
+ * Das Modul kapselt die Partikel des Schwarms und deren Bewegung. Die Partikel
+ * werden als Structure of Arrays in ausgerichteten Arrays gehalten und
+ * blockweise ueber das Job-Modul parallel aktualisiert. Ein Zeitschritt ist
+ * eine Pipeline aus Stufen (Kraefte, Integration, Orientierung), die einen
+ * Satz von Zustand und Stroemen lesen und den anderen schreiben. Es
+ * kommt ohne OpenGL-Aufrufe aus und kann daher auch ohne Fenster (z.B. im
+ * Benchmark) verwendet werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <stdatomic.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "particles.h"
+#include "util.h"
+#include "jobs.h"
+#include "flocking.h"
+#include "particleMath.h"
+#include "profiler.h"
+
+/* ---- Konstanten ---- */
+
+/*Konstaten zur besseren lesbarkeit des Arrays in der Logik zur bessereren lesbarkeit*/
+#define LX (0)
+#define LY (1)
+#define LZ (2)
+
+/* ---- Typen ---- */
+
+/* Parameter eines Zeitschritts fuer die Arbeitsthreads */
+typedef struct
+{
+    float interval;
+    CGVector3f *balls;
+    int ballCount;
+    /* gelesener Zustand, geschriebener Zustand und dessen Stroeme */
+    const ParticleState *read;
+    const ParticleState *write;
+    const ParticleStreams *streams;
+    /* auszufuehrende Stufen der Pipeline */
+    int firstStage;
+    int lastStage;
+} ParticleStepJob;
+
+/* ---- Globale Daten ---- */
+
+/* Die Partikel als Structure of Arrays */
+ParticleStore g_particles = {0};
+
+/* Kenngroessen des Schwarms zu Beginn des aktuellen Zeitschritts */
+SwarmAggregates g_swarm = {0};
+
+/*Das gerade ausgewahlte Partikel*/
+int g_pickedParticle = 0;
+
+/*Modus des Targets 0-> Baelle, 1-> Ein Partikel, 2->Zentrum aller Partikel, 3->Schwarm um die Baelle*/
+TargetMode g_targetMode = targetModeBalls;
+
+/* Eingestelltes Integrationsverfahren der Partikel */
+Integrator g_integrator = integratorSemiImplicitEuler;
+
+/* Genauigkeit der Mathematik in den Kerneln, mit -D PARTICLE_FAST_MATH
+ * standardmaessig die schnellen Naeherungen */
+#ifdef PARTICLE_FAST_MATH
+MathPrecision g_mathPrecision = mathPrecisionFast;
+#else
+MathPrecision g_mathPrecision = mathPrecisionExact;
+#endif
+
+/* Stufen der Pipeline je Block hintereinander (GL_TRUE) oder je Stufe ueber alle Partikel */
+GLboolean g_pipelineFused = GL_TRUE;
+
+/* Laufzeit je Stufe (summiert ueber alle Threads) und Anzahl der Zeitschritte */
+atomic_llong g_stageNanos[PARTICLE_STAGE_COUNT];
+int g_pipelineSteps = 0;
+
+/* Hardwarezaehler des Zeitschritts (nur im Benchmark, NULL -> keine) und die
+ * aufsummierten Zaehler der Vorbereitung, je Stufe (nur einzeln laufende
+ * Stufen) und der gesamten Pipeline */
+const PerfCounters *g_perfCounters = NULL;
+PerfCounterValues g_prepareCounters;
+PerfCounterValues g_stageCounters[PARTICLE_STAGE_COUNT];
+PerfCounterValues g_pipelineCounters;
+
+/* Zum Entfernen vorgemerkte Partikel (Indizes, ggf. mehrfach) */
+int *g_killList = NULL;
+int g_killCount = 0;
+int g_killCapacity = 0;
+
+/* Anzahl der Partikel mit begrenzter Lebensdauer */
+int g_mortalParticles = 0;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Vergroessert ein ausgerichtetes Array und uebernimmt dessen Inhalt.
+ * @param old das bisherige Array (darf NULL sein)
+ * @param count Anzahl der zu uebernehmenden Eintraege
+ * @param capacity neue Kapazitaet (Vielfaches von PARTICLE_CHUNK_SIZE)
+ * @return das neue Array
+ */
+static float *reallocAligned(float *old, int count, int capacity)
+{
+    float *array = aligned_alloc(PARTICLE_ALIGNMENT, sizeof(float) * capacity);
+    if (array == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    if (old != NULL)
+    {
+        memcpy(array, old, sizeof(float) * count);
+        free(old);
+    }
+    return array;
+}
+
+/**
+ * Macht einen Satz von Zustand und Stroemen zum vorderen Satz, auf den alle
+ * Zugriffe ausserhalb eines Zeitschritts gehen.
+ * @param front Index des neuen vorderen Satzes
+ */
+static void setFrontParticles(int front)
+{
+    g_particles.front = front;
+    for (int d = 0; d < 3; d++)
+    {
+        g_particles.center[d] = g_particles.states[front].center[d];
+        g_particles.velocity[d] = g_particles.states[front].velocity[d];
+        g_particles.accelaration[d] = g_particles.streams[front].accelaration[d];
+        g_particles.up[d] = g_particles.streams[front].up[d];
+    }
+}
+
+/**
+ * Stellt sicher, dass mindestens die gegebene Anzahl an Partikeln Platz hat.
+ * Die Kapazitaet wird dabei mindestens verdoppelt, sodass das Hinzufuegen
+ * einzelner Partikel amortisiert konstante Kosten hat.
+ * @param count die benoetigte Anzahl an Partikeln
+ */
+static void reserveParticles(int count)
+{
+    if (count <= g_particles.capacity)
+    {
+        return;
+    }
+    int capacity = g_particles.capacity * 2;
+    if (capacity < count)
+    {
+        capacity = count;
+    }
+    //Auf ganze Bloecke aufrunden, damit alle Arrays gleich ausgerichtet enden
+    capacity = (capacity + PARTICLE_CHUNK_SIZE - 1) / PARTICLE_CHUNK_SIZE * PARTICLE_CHUNK_SIZE;
+
+    //Nur der vordere Satz enthaelt gueltige Werte, der hintere wird im naechsten Schritt beschrieben
+    for (int set = 0; set < 2; set++)
+    {
+        int keep = set == g_particles.front ? g_particles.count : 0;
+        for (int d = 0; d < 3; d++)
+        {
+            g_particles.states[set].center[d] = reallocAligned(g_particles.states[set].center[d], keep, capacity);
+            g_particles.states[set].velocity[d] = reallocAligned(g_particles.states[set].velocity[d], keep, capacity);
+            g_particles.streams[set].accelaration[d] = reallocAligned(g_particles.streams[set].accelaration[d], keep, capacity);
+            g_particles.streams[set].up[d] = reallocAligned(g_particles.streams[set].up[d], keep, capacity);
+        }
+    }
+    setFrontParticles(g_particles.front);
+    g_particles.kWeak = reallocAligned(g_particles.kWeak, g_particles.count, capacity);
+    g_particles.age = reallocAligned(g_particles.age, g_particles.count, capacity);
+    g_particles.lifetime = reallocAligned(g_particles.lifetime, g_particles.count, capacity);
+    g_particles.capacity = capacity;
+}
+
+/**
+ * Vergroessert die Liste der zu entfernenden Partikel bei Bedarf.
+ * @param count die benoetigte Anzahl an Eintraegen
+ */
+static void reserveKillList(int count)
+{
+    if (count <= g_killCapacity)
+    {
+        return;
+    }
+    int capacity = g_killCapacity * 2 > count ? g_killCapacity * 2 : count;
+    int *killList = realloc(g_killList, sizeof(int) * capacity);
+    if (killList == NULL)
+    {
+        free(g_killList);
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    g_killList = killList;
+    g_killCapacity = capacity;
+}
+
+/**
+ * Liefert eine zufaellige Richtung innerhalb eines Kegels.
+ * Die Richtungen sind gleichmaessig auf der Kugelkappe verteilt.
+ * @param axis Achse des Kegels (normiert)
+ * @param coneAngle halber Oeffnungswinkel des Kegels in Grad
+ * @param direction die zufaellige Richtung (out-param)
+ */
+static void sampleCone(const float *axis, float coneAngle, float *direction)
+{
+    //Orthonormalbasis (tangent, bitangent, axis) aufbauen
+    CGVector3f helper = {1.0f, 0.0f, 0.0f};
+    if (fabsf(axis[LX]) > 0.9f)
+    {
+        setVector(0.0f, 1.0f, 0.0f, helper);
+    }
+    CGVector3f tangent = {0};
+    CGVector3f bitangent = {0};
+    calcNormalizedCrossProduct(axis, helper, 1.0f, tangent);
+    calcCrossProduct(axis, tangent, bitangent);
+
+    //cos(theta) gleichverteilt in [cos(coneAngle), 1]
+    float cosTheta = 1.0f - (getRandomNumber() + 1.0f) * 0.5f * (1.0f - cosf(degreeToRad(coneAngle)));
+    float sinTheta = sqrtf(1.0f - cosTheta * cosTheta);
+    float phi = (getRandomNumber() + 1.0f) * (float)M_PI;
+    for (int d = 0; d < 3; d++)
+    {
+        direction[d] = tangent[d] * sinTheta * cosf(phi) + bitangent[d] * sinTheta * sinf(phi) + axis[d] * cosTheta;
+    }
+}
+
+/**
+ * Initialisiert ein Partikel nach der uebergebenen Verteilung.
+ * @param i Index des Partikels
+ * @param distribution die Verteilung der Startwerte
+ * @param axis normierte Flugrichtung der Verteilung, NULL fuer zufaellige Richtungen
+ */
+static void initParticle(int i, const ParticleSpawnDistribution *distribution, const float *axis)
+{
+    CGVector3f velocity = {0};
+    if (axis == NULL)
+    {
+        setVector(getRandomNumber(), getRandomNumber(), getRandomNumber(), velocity);
+        normalizeVector(velocity);
+    }
+    else
+    {
+        sampleCone(axis, distribution->coneAngle, velocity);
+    }
+    for (int d = 0; d < 3; d++)
+    {
+        g_particles.center[d][i] = distribution->center[d] + distribution->extent * getRandomNumber();
+        g_particles.velocity[d][i] = velocity[d] * K_V;
+        g_particles.up[d][i] = 0.0f;
+        g_particles.accelaration[d][i] = 0.0f;
+    }
+    //Erstellt Wert zwischen 0.5f und 10.5f
+    g_particles.kWeak[i] = (float)((rand() % 100) / 10.0f) + 0.5f;
+    g_particles.age[i] = 0.0f;
+    g_particles.lifetime[i] = distribution->lifetime;
+}
+
+/**
+ * Erzeugt neue Partikel am Ende des Speichers. Der Speicher waechst dabei
+ * hoechstens einmal, sodass auch viele Partikel je Frame guenstig sind.
+ * @param count Anzahl der zu erzeugenden Partikel
+ * @param distribution Verteilung der Startwerte, NULL fuer zufaellige
+ * Positionen im Wuerfel mit zufaelliger Flugrichtung
+ * @return Anzahl der tatsaechlich erzeugten Partikel (begrenzt durch MAX_PARTICLES)
+ */
+int spawnParticles(int count, const ParticleSpawnDistribution *distribution)
+{
+    const ParticleSpawnDistribution defaultDistribution = {{0.0f, 0.0f, 0.0f}, 1.0f, {0.0f, 0.0f, 0.0f}, 0.0f, 0.0f};
+    if (distribution == NULL)
+    {
+        distribution = &defaultDistribution;
+    }
+    count = g_particles.count + count > MAX_PARTICLES ? MAX_PARTICLES - g_particles.count : count;
+    if (count <= 0)
+    {
+        return 0;
+    }
+    //Die Achse des Kegels nur einmal je Aufruf normieren
+    CGVector3f axis = {distribution->direction[LX], distribution->direction[LY], distribution->direction[LZ]};
+    GLboolean randomDirection = calcVectorLength(axis) == 0.0f;
+    if (!randomDirection)
+    {
+        normalizeVector(axis);
+    }
+    reserveParticles(g_particles.count + count);
+    for (int i = g_particles.count; i < g_particles.count + count; i++)
+    {
+        initParticle(i, distribution, randomDirection ? NULL : axis);
+    }
+    g_particles.count += count;
+    if (distribution->lifetime > 0.0f)
+    {
+        g_mortalParticles += count;
+    }
+    return count;
+}
+
+/**
+ * Merkt ein Partikel zum Entfernen vor. Entfernt wird es erst durch
+ * compactParticles, bis dahin bleiben alle Indizes gueltig.
+ * @param i Index des Partikels
+ */
+void killParticle(int i)
+{
+    if (i >= 0 && i < g_particles.count)
+    {
+        reserveKillList(g_killCount + 1);
+        g_killList[g_killCount++] = i;
+    }
+}
+
+/**
+ * Merkt alle Partikel zum Entfernen vor, fuer die das Praedikat zutrifft.
+ * @param predicate das Praedikat, erhaelt den Index des Partikels
+ * @param data beliebige Daten, die an das Praedikat weitergereicht werden
+ * @return Anzahl der vorgemerkten Partikel
+ */
+int killParticlesIf(ParticlePredicate predicate, void *data)
+{
+    int killed = 0;
+    for (int i = 0; i < g_particles.count; i++)
+    {
+        if (predicate(i, data))
+        {
+            killParticle(i);
+            killed++;
+        }
+    }
+    return killed;
+}
+
+/**
+ * Vergleichsfunktion fuer qsort, sortiert absteigend.
+ */
+static int compareIndicesDescending(const void *a, const void *b)
+{
+    int ia = *(const int *)a;
+    int ib = *(const int *)b;
+    return (ia < ib) - (ia > ib);
+}
+
+/**
+ * Kopiert alle Werte eines Partikels auf einen anderen Index.
+ * @param dest Zielindex
+ * @param src Quellindex
+ */
+static void copyParticle(int dest, int src)
+{
+    for (int d = 0; d < 3; d++)
+    {
+        g_particles.center[d][dest] = g_particles.center[d][src];
+        g_particles.velocity[d][dest] = g_particles.velocity[d][src];
+        g_particles.up[d][dest] = g_particles.up[d][src];
+        g_particles.accelaration[d][dest] = g_particles.accelaration[d][src];
+    }
+    g_particles.kWeak[dest] = g_particles.kWeak[src];
+    g_particles.age[dest] = g_particles.age[src];
+    g_particles.lifetime[dest] = g_particles.lifetime[src];
+}
+
+/**
+ * Entfernt alle vorgemerkten Partikel. Jedes Partikel wird durch das
+ * jeweils letzte ersetzt (swap-remove), die Kosten haengen also nur von der
+ * Anzahl der entfernten Partikel ab. Die Reihenfolge der Partikel bleibt
+ * dabei nicht erhalten. Mindestens MIN_PARTICLES Partikel bleiben bestehen.
+ * @return Anzahl der entfernten Partikel
+ */
+int compactParticles(void)
+{
+    int removed = 0;
+    //Absteigend, damit das nachrueckende letzte Partikel nie selbst vorgemerkt ist
+    qsort(g_killList, g_killCount, sizeof(int), compareIndicesDescending);
+    for (int k = 0; k < g_killCount && g_particles.count > MIN_PARTICLES; k++)
+    {
+        int i = g_killList[k];
+        if (k > 0 && i == g_killList[k - 1])
+        {
+            continue;
+        }
+        int last = g_particles.count - 1;
+        if (i == g_pickedParticle)
+        {
+            g_pickedParticle = 0;
+        }
+        else if (last == g_pickedParticle)
+        {
+            g_pickedParticle = i;
+        }
+        if (g_particles.lifetime[i] > 0.0f)
+        {
+            g_mortalParticles--;
+        }
+        copyParticle(i, last);
+        g_particles.count--;
+        removed++;
+    }
+    g_killCount = 0;
+    if (g_pickedParticle >= g_particles.count)
+    {
+        g_pickedParticle = 0;
+    }
+    return removed;
+}
+
+/**
+ * Entfernt zufaellig gewaehlte, paarweise verschiedene Partikel. Doppelt
+ * gezogene Indizes entfernt compactParticles nur einmal, deshalb wird so
+ * lange nachgezogen, bis count Partikel entfernt sind oder nur noch
+ * MIN_PARTICLES uebrig bleiben.
+ * @param count Anzahl der zu entfernenden Partikel
+ * @return Anzahl der entfernten Partikel
+ */
+int killRandomParticles(int count)
+{
+    int removed = 0;
+    while (removed < count && g_particles.count > MIN_PARTICLES)
+    {
+        for (int k = removed; k < count; k++)
+        {
+            killParticle(rand() % g_particles.count);
+        }
+        removed += compactParticles();
+    }
+    return removed;
+}
+
+/**
+ * Setzt die Anzahl der Partikel. Neue Partikel werden zufaellig
+ * initialisiert, ueberzaehlige am Ende entfernt.
+ * @param count die neue Anzahl an Partikeln
+ */
+void setParticleAmount(int count)
+{
+    count = count < MIN_PARTICLES ? MIN_PARTICLES : count;
+    count = count > MAX_PARTICLES ? MAX_PARTICLES : count;
+    if (count > g_particles.count)
+    {
+        spawnParticles(count - g_particles.count, NULL);
+    }
+    else
+    {
+        //Die letzten Partikel muessen nicht verschoben werden
+        for (int i = g_particles.count - 1; i >= count; i--)
+        {
+            killParticle(i);
+        }
+        compactParticles();
+    }
+}
+
+/**
+ * Initialisiert die Partikel.
+ * @param count Anzahl der Partikel
+ */
+void initParticles(int count)
+{
+    g_particles.count = 0;
+    g_killCount = 0;
+    g_mortalParticles = 0;
+    g_pickedParticle = 0;
+    setParticleAmount(count);
+}
+
+/**
+ * Liefert die Arrays des vorderen Satzes in der festen Reihenfolge
+ * Positionen, Geschwindigkeiten, Up-Vektoren, Beschleunigungen (je x, y, z),
+ * Beschleunigungsfaktoren, Alter und Lebensdauern, z.B. zum Speichern.
+ * @param arrays die PARTICLE_ARRAY_COUNT Arrays (out-param)
+ */
+void getParticleArrays(float **arrays)
+{
+    for (int d = 0; d < 3; d++)
+    {
+        arrays[d] = g_particles.center[d];
+        arrays[3 + d] = g_particles.velocity[d];
+        arrays[6 + d] = g_particles.up[d];
+        arrays[9 + d] = g_particles.accelaration[d];
+    }
+    arrays[12] = g_particles.kWeak;
+    arrays[13] = g_particles.age;
+    arrays[14] = g_particles.lifetime;
+}
+
+/**
+ * Ersetzt alle Partikel durch die uebergebenen Werte, z.B. beim Laden eines
+ * gespeicherten Zustands. Vorgemerkte Partikel werden verworfen.
+ * @param count Anzahl der Partikel
+ * @param arrays die PARTICLE_ARRAY_COUNT Arrays in der Reihenfolge von
+ * getParticleArrays
+ */
+void restoreParticles(int count, const float *const *arrays)
+{
+    count = count < MIN_PARTICLES ? MIN_PARTICLES : count;
+    count = count > MAX_PARTICLES ? MAX_PARTICLES : count;
+    g_killCount = 0;
+    reserveParticles(count);
+    g_particles.count = count;
+
+    float *targets[PARTICLE_ARRAY_COUNT];
+    getParticleArrays(targets);
+    for (int a = 0; a < PARTICLE_ARRAY_COUNT; a++)
+    {
+        memcpy(targets[a], arrays[a], sizeof(float) * count);
+    }
+    g_mortalParticles = 0;
+    for (int i = 0; i < count; i++)
+    {
+        g_mortalParticles += g_particles.lifetime[i] > 0.0f;
+    }
+    g_pickedParticle = g_pickedParticle < count ? g_pickedParticle : 0;
+}
+
+/**
+ * Gibt den Speicher der Partikel frei.
+ */
+void freeParticles(void)
+{
+    for (int set = 0; set < 2; set++)
+    {
+        for (int d = 0; d < 3; d++)
+        {
+            free(g_particles.states[set].center[d]);
+            free(g_particles.states[set].velocity[d]);
+            free(g_particles.streams[set].accelaration[d]);
+            free(g_particles.streams[set].up[d]);
+        }
+    }
+    free(g_particles.kWeak);
+    free(g_particles.age);
+    free(g_particles.lifetime);
+    memset(&g_particles, 0, sizeof(ParticleStore));
+    free(g_killList);
+    g_killList = NULL;
+    g_killCount = 0;
+    g_killCapacity = 0;
+    g_mortalParticles = 0;
+    freeFlockingGrid();
+}
+
+/**
+ * Erhoeht die Anzahl an Partikel.
+ */
+void increaseParticles(void)
+{
+    spawnParticles(1, NULL);
+}
+
+/**
+ * Verringert die Anzahl an Partikel.
+ */
+void decreaseParticles(void)
+{
+    setParticleAmount(g_particles.count - 1);
+}
+
+/**
+ * Erzeugt einen Schwall neuer Partikel rund um das ausgewaehlte Partikel,
+ * die in dessen Flugrichtung starten.
+ */
+void spawnParticleBurst(void)
+{
+    ParticleSpawnDistribution distribution = {{0}, PARTICLE_BURST_EXTENT, {0}, PARTICLE_BURST_CONE_ANGLE, 0.0f};
+    for (int d = 0; d < 3; d++)
+    {
+        distribution.center[d] = g_particles.center[d][g_pickedParticle];
+        distribution.direction[d] = g_particles.velocity[d][g_pickedParticle];
+    }
+    spawnParticles(PARTICLE_BURST_SIZE, &distribution);
+}
+
+/**
+ * Entfernt einen Schwall zufaellig gewaehlter Partikel.
+ */
+void killParticleBurst(void)
+{
+    killRandomParticles(PARTICLE_BURST_SIZE);
+}
+
+/**
+ * Berechnet die Kenngroessen des Schwarms in einem Durchlauf ueber alle
+ * Partikel. Die Werte gelten fuer den gesamten Zeitschritt und werden von
+ * allen Partikeln gemeinsam genutzt, statt sie je Partikel neu zu berechnen.
+ * @param swarm die berechneten Kenngroessen (out-param)
+ */
+static void calculateSwarmAggregates(SwarmAggregates *swarm)
+{
+    int count = g_particles.count;
+    for (int d = 0; d < 3; d++)
+    {
+        const float *center = g_particles.center[d];
+        const float *velocity = g_particles.velocity[d];
+        double positionSum = 0.0;
+        double velocitySum = 0.0;
+        float boundsMin = center[0];
+        float boundsMax = center[0];
+        for (int i = 0; i < count; i++)
+        {
+            positionSum += center[i];
+            velocitySum += velocity[i];
+            boundsMin = fminf(boundsMin, center[i]);
+            boundsMax = fmaxf(boundsMax, center[i]);
+        }
+        swarm->mean[d] = clip(positionSum / count, -1.0f, 1.0f);
+        swarm->meanVelocity[d] = velocitySum / count;
+        swarm->boundsMin[d] = boundsMin;
+        swarm->boundsMax[d] = boundsMax;
+        swarm->pickedCenter[d] = center[g_pickedParticle];
+    }
+}
+
+/**
+ * Berechnet die Beschleunigung von Partikeln hin zu einem gemeinsamen Ziel.
+ * a = (t - s) / ||t - s|| * K_WEAK
+ * @param n Anzahl der Partikel
+ * @param px, py, pz die Positionen der Partikel je Achse
+ * @param kWeak die Beschleunigungsfaktoren der Partikel
+ * @param target die Position des Ziels
+ * @param precision die Genauigkeit der Wurzel
+ * @param ax, ay, az die berechneten Beschleunigungen je Achse (out-param)
+ */
+static void accelerateTowardsTarget(int n, const float *restrict px, const float *restrict py, const float *restrict pz,
+                                    const float *restrict kWeak, const float *target, MathPrecision precision,
+                                    float *restrict ax, float *restrict ay, float *restrict az)
+{
+    const float targetX = target[LX];
+    const float targetY = target[LY];
+    const float targetZ = target[LZ];
+    for (int i = 0; i < n; i++)
+    {
+        float dx = targetX - px[i];
+        float dy = targetY - py[i];
+        float dz = targetZ - pz[i];
+        float factor = kWeak[i] * particleInverseSqrt(dx * dx + dy * dy + dz * dz, precision);
+        ax[i] = dx * factor;
+        ay[i] = dy * factor;
+        az[i] = dz * factor;
+    }
+}
+
+/**
+ * Addiert die gewichtete Beschleunigung von Partikeln hin zu einem Ball.
+ * @param n Anzahl der Partikel
+ * @param px, py, pz die Positionen der Partikel je Achse
+ * @param kWeak die Beschleunigungsfaktoren der Partikel
+ * @param ball die Position des Balls
+ * @param precision die Genauigkeit von Wurzel und Exponentialfunktion
+ * @param ax, ay, az die Beschleunigungen je Achse, werden erhoeht
+ */
+static inline void accelerateTowardsBall(int n, const float *restrict px, const float *restrict py, const float *restrict pz,
+                                         const float *restrict kWeak, const float *ball, MathPrecision precision,
+                                         float *restrict ax, float *restrict ay, float *restrict az)
+{
+    const float ballX = ball[LX];
+    const float ballY = ball[LY];
+    const float ballZ = ball[LZ];
+    for (int i = 0; i < n; i++)
+    {
+        float dx = ballX - px[i];
+        float dy = ballY - py[i];
+        float dz = ballZ - pz[i];
+        float lengthSquared = dx * dx + dy * dy + dz * dz;
+        float weighting = particleExp(lengthSquared * (-1.0f / GAUSS_CONST), precision);
+        float factor = weighting * kWeak[i] * particleInverseSqrt(lengthSquared, precision);
+        ax[i] += dx * factor;
+        ay[i] += dy * factor;
+        az[i] += dz * factor;
+    }
+}
+
+/**
+ * Berechnet die gewichtete Beschleunigung von Partikeln hin zu allen Baellen.
+ * a = Summe(e^(-||t - s||^2 / GAUSS_CONST) * (t - s) / ||t - s|| * K_WEAK)
+ * Gewichtung und Normierung arbeiten beide auf dem quadrierten Abstand, je
+ * Ball wird also nur eine inverse Wurzel und keine Division benoetigt.
+ * @param n Anzahl der Partikel
+ * @param px, py, pz die Positionen der Partikel je Achse
+ * @param kWeak die Beschleunigungsfaktoren der Partikel
+ * @param balls die Positionen der Baelle
+ * @param ballCount Anzahl der Baelle
+ * @param precision die Genauigkeit von Wurzel und Exponentialfunktion
+ * @param ax, ay, az die berechneten Beschleunigungen je Achse (out-param)
+ */
+static void accelerateTowardsBalls(int n, const float *restrict px, const float *restrict py, const float *restrict pz,
+                                   const float *restrict kWeak, CGVector3f *balls, int ballCount, MathPrecision precision,
+                                   float *restrict ax, float *restrict ay, float *restrict az)
+{
+    for (int i = 0; i < n; i++)
+    {
+        ax[i] = 0.0f;
+        ay[i] = 0.0f;
+        az[i] = 0.0f;
+    }
+    for (int b = 0; b < ballCount; b++)
+    {
+        //Je Genauigkeit eine eigene Schleife, damit die schnelle vektorisiert wird
+        if (precision == mathPrecisionFast)
+        {
+            accelerateTowardsBall(n, px, py, pz, kWeak, balls[b], mathPrecisionFast, ax, ay, az);
+        }
+        else
+        {
+            accelerateTowardsBall(n, px, py, pz, kWeak, balls[b], mathPrecisionExact, ax, ay, az);
+        }
+    }
+}
+
+/**
+ * Berechnet die Beschleunigung eines Blocks von Partikeln abhaengig vom
+ * eingestellten Zielmodus.
+ * @param first Index des ersten Partikels im Block
+ * @param n Anzahl der Partikel im Block
+ * @param position die Positionen, an denen ausgewertet wird
+ * @param balls die Positionen der Baelle
+ * @param ballCount Anzahl der Baelle
+ * @param acceleration die berechneten Beschleunigungen (out-param)
+ */
+static void calculateAccelerationChunk(int first, int n, float **position, CGVector3f *balls, int ballCount, float **acceleration)
+{
+    float *velocity[3] = {g_particles.velocity[LX] + first, g_particles.velocity[LY] + first, g_particles.velocity[LZ] + first};
+    const float *kWeak = g_particles.kWeak + first;
+    int picked = g_pickedParticle - first;
+    switch (g_targetMode)
+    {
+    case targetModeBalls:
+        accelerateTowardsBalls(n, position[LX], position[LY], position[LZ], kWeak, balls, ballCount, g_mathPrecision,
+                               acceleration[LX], acceleration[LY], acceleration[LZ]);
+        break;
+    case targetModeSelectedParticle:
+        //Die anderen bewegen sich auf das ausgewahlte zu
+        accelerateTowardsTarget(n, position[LX], position[LY], position[LZ], kWeak, g_swarm.pickedCenter, g_mathPrecision,
+                                acceleration[LX], acceleration[LY], acceleration[LZ]);
+        //Das ausgewahlte bewegt sich weiterhin zu den Baellen nur schneller
+        if (picked >= 0 && picked < n)
+        {
+            accelerateTowardsBalls(1, position[LX] + picked, position[LY] + picked, position[LZ] + picked, kWeak + picked,
+                                   balls, ballCount, g_mathPrecision, acceleration[LX] + picked, acceleration[LY] + picked, acceleration[LZ] + picked);
+        }
+        break;
+    case targetModeCenterOfParticles:
+        accelerateTowardsTarget(n, position[LX], position[LY], position[LZ], kWeak, g_swarm.mean, g_mathPrecision,
+                                acceleration[LX], acceleration[LY], acceleration[LZ]);
+        break;
+    case targetModeFlocking:
+        //Schwarmverhalten unter den Nachbarn, zusammengehalten von den Baellen
+        accelerateTowardsBalls(n, position[LX], position[LY], position[LZ], kWeak, balls, ballCount, g_mathPrecision,
+                               acceleration[LX], acceleration[LY], acceleration[LZ]);
+        accelerateFlocking(first, n, position, velocity, acceleration);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Setzt die Geschwindigkeiten eines Blocks auf ihren festen Betrag.
+ * Die Partikel steuern nur ihre Richtung, der Betrag ist K_V (bzw. schneller
+ * fuer das ausgewaehlte Partikel).
+ * @param first Index des ersten Partikels im Block
+ * @param n Anzahl der Partikel im Block
+ * @param vx, vy, vz die Geschwindigkeiten je Achse, werden normiert und skaliert
+ */
+static void applyParticleSpeedChunk(int first, int n, float *restrict vx, float *restrict vy, float *restrict vz)
+{
+    const MathPrecision precision = g_mathPrecision;
+    for (int i = 0; i < n; i++)
+    {
+        float factor = K_V * particleInverseSqrt(vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i], precision);
+        vx[i] *= factor;
+        vy[i] *= factor;
+        vz[i] *= factor;
+    }
+    //Wenn es sich um das Ausgewahlte handelt -> schneller
+    int picked = g_pickedParticle - first;
+    if (g_targetMode == targetModeSelectedParticle && picked >= 0 && picked < n)
+    {
+        vx[picked] *= PICKED_PARTICLE_SPEED_FAKTOR;
+        vy[picked] *= PICKED_PARTICLE_SPEED_FAKTOR;
+        vz[picked] *= PICKED_PARTICLE_SPEED_FAKTOR;
+    }
+}
+
+/**
+ * Berechnet die Up-Vektoren eines Blocks aus Geschwindigkeit und
+ * Beschleunigung: up = (v x a) x v, normiert.
+ * @param n Anzahl der Partikel im Block
+ * @param vx, vy, vz die Geschwindigkeiten je Achse
+ * @param ax, ay, az die Beschleunigungen je Achse
+ * @param precision die Genauigkeit der Wurzel
+ * @param ux, uy, uz die berechneten Up-Vektoren je Achse (out-param)
+ */
+static void calculateUpChunk(int n, const float *restrict vx, const float *restrict vy, const float *restrict vz,
+                             const float *restrict ax, const float *restrict ay, const float *restrict az,
+                             MathPrecision precision, float *restrict ux, float *restrict uy, float *restrict uz)
+{
+    for (int i = 0; i < n; i++)
+    {
+        // v x a
+        float cx = vy[i] * az[i] - vz[i] * ay[i];
+        float cy = vz[i] * ax[i] - vx[i] * az[i];
+        float cz = vx[i] * ay[i] - vy[i] * ax[i];
+        // (v x a) x v
+        float upX = cy * vz[i] - cz * vy[i];
+        float upY = cz * vx[i] - cx * vz[i];
+        float upZ = cx * vy[i] - cy * vx[i];
+        //FLT_MIN verhindert ohne Verzweigung die Division durch Null
+        float factor = particleInverseSqrt(upX * upX + upY * upY + upZ * upZ + FLT_MIN, precision);
+        ux[i] = upX * factor;
+        uy[i] = upY * factor;
+        uz[i] = upZ * factor;
+    }
+}
+
+/**
+ * Integriert einen Block mit dem semi-impliziten Euler-Verfahren.
+ * Eine Auswertung der Beschleunigung pro Schritt (aus der Kraftstufe).
+ * @param interval die verstrichen Zeit
+ * @param first Index des ersten Partikels im Block
+ * @param n Anzahl der Partikel im Block
+ * @param position die Positionen am Anfang des Schritts
+ * @param velocity die Geschwindigkeiten am Anfang des Schritts
+ * @param acceleration die Beschleunigungen am Anfang des Schritts
+ * @param nextPosition die Positionen am Ende des Schritts (out-param)
+ * @param nextVelocity die Geschwindigkeiten am Ende des Schritts (out-param)
+ * @param balls die Positionen der Baelle
+ * @param ballCount Anzahl der Baelle
+ */
+static void integrateSemiImplicitEulerChunk(float interval, int first, int n, float **position, float **velocity,
+                                            float **acceleration, float **nextPosition, float **nextVelocity,
+                                            CGVector3f *balls, int ballCount)
+{
+    // v' = v + delta(t) * a
+    for (int d = 0; d < 3; d++)
+    {
+        float *restrict nextV = nextVelocity[d];
+        const float *restrict v = velocity[d];
+        const float *restrict a = acceleration[d];
+        for (int i = 0; i < n; i++)
+        {
+            nextV[i] = v[i] + interval * a[i];
+        }
+    }
+    applyParticleSpeedChunk(first, n, nextVelocity[LX], nextVelocity[LY], nextVelocity[LZ]);
+    // s' = s + delta(t) * v'
+    for (int d = 0; d < 3; d++)
+    {
+        float *restrict nextS = nextPosition[d];
+        const float *restrict s = position[d];
+        const float *restrict nextV = nextVelocity[d];
+        for (int i = 0; i < n; i++)
+        {
+            nextS[i] = s[i] + interval * nextV[i];
+        }
+    }
+}
+
+/**
+ * Integriert einen Block mit dem Velocity-Verlet-Verfahren.
+ * Zwei Auswertungen der Beschleunigung pro Schritt, die erste aus der
+ * Kraftstufe.
+ * @param interval die verstrichen Zeit
+ * @param first Index des ersten Partikels im Block
+ * @param n Anzahl der Partikel im Block
+ * @param position die Positionen am Anfang des Schritts
+ * @param velocity die Geschwindigkeiten am Anfang des Schritts
+ * @param acceleration die Beschleunigungen am Anfang des Schritts
+ * @param nextPosition die Positionen am Ende des Schritts (out-param)
+ * @param nextVelocity die Geschwindigkeiten am Ende des Schritts (out-param)
+ * @param balls die Positionen der Baelle
+ * @param ballCount Anzahl der Baelle
+ */
+static void integrateVelocityVerletChunk(float interval, int first, int n, float **position, float **velocity,
+                                         float **acceleration, float **nextPosition, float **nextVelocity,
+                                         CGVector3f *balls, int ballCount)
+{
+    float newAccelerationData[3][PARTICLE_CHUNK_SIZE];
+    float *newAcceleration[3] = {newAccelerationData[LX], newAccelerationData[LY], newAccelerationData[LZ]};
+
+    // s' = s + delta(t) * v + delta(t)^2 / 2 * a
+    for (int d = 0; d < 3; d++)
+    {
+        float *restrict nextS = nextPosition[d];
+        const float *restrict s = position[d];
+        const float *restrict v = velocity[d];
+        const float *restrict a = acceleration[d];
+        for (int i = 0; i < n; i++)
+        {
+            nextS[i] = s[i] + interval * v[i] + 0.5f * interval * interval * a[i];
+        }
+    }
+    calculateAccelerationChunk(first, n, nextPosition, balls, ballCount, newAcceleration);
+    // v' = v + delta(t) / 2 * (a + a')
+    for (int d = 0; d < 3; d++)
+    {
+        float *restrict nextV = nextVelocity[d];
+        const float *restrict v = velocity[d];
+        const float *restrict a = acceleration[d];
+        const float *restrict newA = newAcceleration[d];
+        for (int i = 0; i < n; i++)
+        {
+            nextV[i] = v[i] + 0.5f * interval * (a[i] + newA[i]);
+        }
+    }
+    applyParticleSpeedChunk(first, n, nextVelocity[LX], nextVelocity[LY], nextVelocity[LZ]);
+}
+
+/**
+ * Integriert einen Block mit dem klassischen Runge-Kutta-Verfahren 4. Ordnung.
+ * Vier Auswertungen der Beschleunigung pro Schritt, die erste aus der
+ * Kraftstufe.
+ * @param interval die verstrichen Zeit
+ * @param first Index des ersten Partikels im Block
+ * @param n Anzahl der Partikel im Block
+ * @param position die Positionen am Anfang des Schritts
+ * @param velocity die Geschwindigkeiten am Anfang des Schritts
+ * @param acceleration die Beschleunigungen am Anfang des Schritts
+ * @param nextPosition die Positionen am Ende des Schritts (out-param)
+ * @param nextVelocity die Geschwindigkeiten am Ende des Schritts (out-param)
+ * @param balls die Positionen der Baelle
+ * @param ballCount Anzahl der Baelle
+ */
+static void integrateRungeKutta4Chunk(float interval, int first, int n, float **position, float **velocity,
+                                      float **acceleration, float **nextPosition, float **nextVelocity,
+                                      CGVector3f *balls, int ballCount)
+{
+    //Teilschritte relativ zum Anfang des Schritts und ihre Gewichte
+    const float stepFactors[RK4_STAGES] = {0.0f, 0.5f, 0.5f, 1.0f};
+    const float weights[RK4_STAGES] = {1.0f, 2.0f, 2.0f, 1.0f};
+    float stagePositionData[3][PARTICLE_CHUNK_SIZE];
+    float stageVelocityData[3][PARTICLE_CHUNK_SIZE];
+    float stageAccelerationData[3][PARTICLE_CHUNK_SIZE];
+    float velocitySum[3][PARTICLE_CHUNK_SIZE];
+    float accelerationSum[3][PARTICLE_CHUNK_SIZE];
+    float *stagePosition[3] = {stagePositionData[LX], stagePositionData[LY], stagePositionData[LZ]};
+    float *stageAcceleration[3] = {stageAccelerationData[LX], stageAccelerationData[LY], stageAccelerationData[LZ]};
+
+    //Der erste Teilschritt ist der Anfang des Schritts mit der Beschleunigung der Kraftstufe
+    for (int d = 0; d < 3; d++)
+    {
+        memcpy(stageVelocityData[d], velocity[d], sizeof(float) * n);
+        memcpy(stageAccelerationData[d], acceleration[d], sizeof(float) * n);
+        memset(velocitySum[d], 0, sizeof(float) * n);
+        memset(accelerationSum[d], 0, sizeof(float) * n);
+    }
+
+    for (int stage = 0; stage < RK4_STAGES; stage++)
+    {
+        if (stage > 0)
+        {
+            //Zustand des Teilschritts aus der Steigung des vorherigen Teilschritts
+            float h = interval * stepFactors[stage];
+            for (int d = 0; d < 3; d++)
+            {
+                const float *restrict s = position[d];
+                const float *restrict v = velocity[d];
+                float *restrict stageS = stagePositionData[d];
+                float *restrict stageV = stageVelocityData[d];
+                const float *restrict stageA = stageAccelerationData[d];
+                for (int i = 0; i < n; i++)
+                {
+                    stageS[i] = s[i] + h * stageV[i];
+                    stageV[i] = v[i] + h * stageA[i];
+                }
+            }
+            calculateAccelerationChunk(first, n, stagePosition, balls, ballCount, stageAcceleration);
+        }
+        for (int d = 0; d < 3; d++)
+        {
+            float *restrict sumV = velocitySum[d];
+            float *restrict sumA = accelerationSum[d];
+            const float *restrict stageV = stageVelocityData[d];
+            const float *restrict stageA = stageAccelerationData[d];
+            for (int i = 0; i < n; i++)
+            {
+                sumV[i] += weights[stage] * stageV[i];
+                sumA[i] += weights[stage] * stageA[i];
+            }
+        }
+    }
+    for (int d = 0; d < 3; d++)
+    {
+        float *restrict nextS = nextPosition[d];
+        float *restrict nextV = nextVelocity[d];
+        const float *restrict s = position[d];
+        const float *restrict v = velocity[d];
+        const float *restrict sumV = velocitySum[d];
+        const float *restrict sumA = accelerationSum[d];
+        for (int i = 0; i < n; i++)
+        {
+            nextS[i] = s[i] + interval / 6.0f * sumV[i];
+            nextV[i] = v[i] + interval / 6.0f * sumA[i];
+        }
+    }
+    applyParticleSpeedChunk(first, n, nextVelocity[LX], nextVelocity[LY], nextVelocity[LZ]);
+}
+
+/**
+ * Verschiebt die Arrays je Achse auf den Anfang eines Blocks.
+ * @param arrays die Arrays je Achse
+ * @param first Index des ersten Partikels im Block
+ * @param chunk die verschobenen Arrays (out-param)
+ */
+static void offsetArrays(float *const *arrays, int first, float **chunk)
+{
+    for (int d = 0; d < 3; d++)
+    {
+        chunk[d] = arrays[d] + first;
+    }
+}
+
+/**
+ * Kraftstufe: berechnet die Beschleunigungen aus dem gelesenen Zustand.
+ * @param step der Zeitschritt
+ * @param first Index des ersten Partikels im Block
+ * @param n Anzahl der Partikel im Block
+ */
+static void runForcesStage(const ParticleStepJob *step, int first, int n)
+{
+    float *position[3];
+    float *acceleration[3];
+    offsetArrays(step->read->center, first, position);
+    offsetArrays(step->streams->accelaration, first, acceleration);
+    calculateAccelerationChunk(first, n, position, step->balls, step->ballCount, acceleration);
+}
+
+/**
+ * Integrationsstufe: berechnet aus dem gelesenen Zustand und den
+ * Beschleunigungen den geschriebenen Zustand mit dem eingestellten
+ * Integrationsverfahren und schreibt das Alter fort.
+ * @param step der Zeitschritt
+ * @param first Index des ersten Partikels im Block
+ * @param n Anzahl der Partikel im Block
+ */
+static void runIntegrateStage(const ParticleStepJob *step, int first, int n)
+{
+    float *position[3];
+    float *velocity[3];
+    float *acceleration[3];
+    float *nextPosition[3];
+    float *nextVelocity[3];
+    offsetArrays(step->read->center, first, position);
+    offsetArrays(step->read->velocity, first, velocity);
+    offsetArrays(step->streams->accelaration, first, acceleration);
+    offsetArrays(step->write->center, first, nextPosition);
+    offsetArrays(step->write->velocity, first, nextVelocity);
+
+    switch (g_integrator)
+    {
+    case integratorSemiImplicitEuler:
+        integrateSemiImplicitEulerChunk(step->interval, first, n, position, velocity, acceleration, nextPosition, nextVelocity,
+                                        step->balls, step->ballCount);
+        break;
+    case integratorVelocityVerlet:
+        integrateVelocityVerletChunk(step->interval, first, n, position, velocity, acceleration, nextPosition, nextVelocity,
+                                     step->balls, step->ballCount);
+        break;
+    case integratorRungeKutta4:
+        integrateRungeKutta4Chunk(step->interval, first, n, position, velocity, acceleration, nextPosition, nextVelocity,
+                                  step->balls, step->ballCount);
+        break;
+    default:
+        break;
+    }
+    //Alter fortschreiben
+    float *restrict age = g_particles.age + first;
+    for (int i = 0; i < n; i++)
+    {
+        age[i] += step->interval;
+    }
+}
+
+/**
+ * Orientierungsstufe: berechnet die Up-Vektoren aus dem geschriebenen
+ * Zustand und den Beschleunigungen.
+ * @param step der Zeitschritt
+ * @param first Index des ersten Partikels im Block
+ * @param n Anzahl der Partikel im Block
+ */
+static void runOrientationStage(const ParticleStepJob *step, int first, int n)
+{
+    float *velocity[3];
+    float *acceleration[3];
+    float *up[3];
+    offsetArrays(step->write->velocity, first, velocity);
+    offsetArrays(step->streams->accelaration, first, acceleration);
+    offsetArrays(step->streams->up, first, up);
+    calculateUpChunk(n, velocity[LX], velocity[LY], velocity[LZ], acceleration[LX], acceleration[LY], acceleration[LZ],
+                     g_mathPrecision, up[LX], up[LY], up[LZ]);
+}
+
+/* Die Stufen der Pipeline in Ausfuehrungsreihenfolge */
+static void (*const g_stageFunctions[PARTICLE_STAGE_COUNT])(const ParticleStepJob *step, int first, int n) = {
+    runForcesStage, runIntegrateStage, runOrientationStage};
+
+/**
+ * Arbeitsfunktion fuer das Job-Modul: fuehrt die Stufen [firstStage,
+ * lastStage] fuer die Partikel [first, last) aus, hoechstens
+ * PARTICLE_CHUNK_SIZE viele. Die Laufzeit jeder Stufe wird ueber alle
+ * Threads summiert.
+ * @param first Index des ersten Partikels
+ * @param last Index hinter dem letzten Partikel
+ * @param data der Zeitschritt (ParticleStepJob)
+ */
+static void runStagesJob(int first, int last, void *data)
+{
+    const ParticleStepJob *step = data;
+    for (int stage = step->firstStage; stage <= step->lastStage; stage++)
+    {
+        double start = beginProfileScope();
+        g_stageFunctions[stage](step, first, last - first);
+        atomic_fetch_add(&g_stageNanos[stage], (long long)(getTimeNanos() - start));
+        endProfileScope(getParticleStageName(stage), start);
+    }
+}
+
+/**
+ * Summiert die Hardwarezaehler seit dem letzten Zaehlerstand auf und merkt
+ * sich den aktuellen Stand als Beginn des naechsten Abschnitts.
+ * @param sum die Summe des beendeten Abschnitts (in/out-param)
+ * @param last Zaehlerstand zu Beginn des Abschnitts (in/out-param)
+ */
+static void addParticleCounters(PerfCounterValues *sum, PerfCounterValues *last)
+{
+    PerfCounterValues now;
+    readPerfCounters(g_perfCounters, &now);
+    addPerfCounterDelta(sum, last, &now);
+    *last = now;
+}
+
+/**
+ * Bewegt alle Partikel um einen Zeitschritt.
+ * Zuerst werden vorgemerkte Partikel entfernt und die Kenngroessen des
+ * Schwarms bestimmt. Danach laufen die Stufen der Pipeline (Kraefte,
+ * Integration, Orientierung): sie lesen nur den vorderen Zustand und
+ * schreiben den hinteren Satz, der am Ende zum vorderen wird. Zusammengefasst
+ * laufen alle Stufen je Block hintereinander (guenstig fuer den Cache),
+ * sonst jede Stufe als eigene parallele Schleife ueber alle Partikel. Zum
+ * Schluss werden Partikel entfernt, deren Lebensdauer abgelaufen ist.
+ * Sind Hardwarezaehler gesetzt, werden sie zwischen den Abschnitten vom
+ * Hauptthread gelesen, nach parallelFor also ueber alle Threads summiert.
+ * @param interval die verstrichen Zeit
+ * @param balls die Positionen der Baelle
+ * @param ballCount Anzahl der Baelle
+ */
+void updateParticles(double interval, CGVector3f *balls, int ballCount)
+{
+    PerfCounterValues counters, pipelineStart;
+    if (g_perfCounters != NULL)
+    {
+        readPerfCounters(g_perfCounters, &counters);
+    }
+
+    //Noch vorgemerkte Partikel vor dem Schritt entfernen
+    compactParticles();
+
+    //Kenngroessen einmal je Schritt fuer alle Partikel berechnen
+    calculateSwarmAggregates(&g_swarm);
+    if (g_targetMode == targetModeFlocking)
+    {
+        buildFlockingGrid(&g_particles, &g_swarm);
+    }
+
+    int back = 1 - g_particles.front;
+    ParticleStepJob step = {(float)interval, balls, ballCount, &g_particles.states[g_particles.front],
+                            &g_particles.states[back], &g_particles.streams[back], 0, PARTICLE_STAGE_COUNT - 1};
+    if (g_perfCounters != NULL)
+    {
+        addParticleCounters(&g_prepareCounters, &counters);
+        pipelineStart = counters;
+    }
+    if (g_pipelineFused)
+    {
+        parallelFor(g_particles.count, PARTICLE_CHUNK_SIZE, runStagesJob, &step);
+    }
+    else
+    {
+        for (int stage = 0; stage < PARTICLE_STAGE_COUNT; stage++)
+        {
+            step.firstStage = stage;
+            step.lastStage = stage;
+            parallelFor(g_particles.count, PARTICLE_CHUNK_SIZE, runStagesJob, &step);
+            if (g_perfCounters != NULL)
+            {
+                addParticleCounters(&g_stageCounters[stage], &counters);
+            }
+        }
+    }
+    if (g_perfCounters != NULL)
+    {
+        addParticleCounters(&g_pipelineCounters, &pipelineStart);
+    }
+    setFrontParticles(back);
+    g_pipelineSteps++;
+
+    //Abgelaufene Partikel entfernen, nur noetig wenn es sterbliche gibt
+    if (g_mortalParticles > 0)
+    {
+        for (int i = 0; i < g_particles.count; i++)
+        {
+            if (g_particles.lifetime[i] > 0.0f && g_particles.age[i] >= g_particles.lifetime[i])
+            {
+                killParticle(i);
+            }
+        }
+        compactParticles();
+    }
+}
+
+/**
+ * Liefert die Anzahl an Partikeln.
+ * @return Partikelanzahl
+ */
+int getParticleAmount(void)
+{
+    return g_particles.count;
+}
+
+/**
+ * Liefert die Partikel fuer Module, die ueber alle Partikel laufen (z.B. das
+ * Befuellen der Vertex Arrays), ohne je Komponente einen Getter aufzurufen.
+ * @return die Partikel (nur lesend)
+ */
+const ParticleStore *getParticleStore(void)
+{
+    return &g_particles;
+}
+
+/**
+ * Liefert die x-Koordinate des Partikels i.
+ * @param i Index des Partikels
+ * @return x-Koordinate des Partikels
+ */
+float getParticleX(int i)
+{
+    return g_particles.center[LX][i];
+}
+
+/**
+ * Liefert die y-Koordinate des Partikels i.
+ * @param i Index des Partikels
+ * @return y-Koordinate des Partikels
+ */
+float getParticleY(int i)
+{
+    return g_particles.center[LY][i];
+}
+
+/**
+ * Liefert die z-Koordinate des Partikels i.
+ * @param i Index des Partikels
+ * @return z-Koordinate des Partikels
+ */
+float getParticleZ(int i)
+{
+    return g_particles.center[LZ][i];
+}
+
+/**
+ * Liefert die x-Koordinate der Geschwindigkeit.
+ * @param i Index des Partikels
+ * @return x-Koordinate der Geschwindigkeit
+ */
+float getParticleVelocityX(int i)
+{
+    return g_particles.velocity[LX][i];
+}
+
+/**
+ * Liefert die y-Koordinate der Geschwindigkeit.
+ * @param i Index des Partikels
+ * @return y-Koordinate der Geschwindigkeit
+ */
+float getParticleVelocityY(int i)
+{
+    return g_particles.velocity[LY][i];
+}
+
+/**
+ * Liefert die z-Koordinate der Geschwindigkeit.
+ * @param i Index des Partikels
+ * @return z-Koordinate der Geschwindigkeit
+ */
+float getParticleVelocityZ(int i)
+{
+    return g_particles.velocity[LZ][i];
+}
+
+/**
+ * Liefert die x-Koordinate der Beschleunigung.
+ * @param i Index des Partikels
+ * @return x-Koordinate der Beschleunigung
+ */
+float getParticleAccelarationX(int i)
+{
+    return g_particles.accelaration[LX][i];
+}
+
+/**
+ * Liefert die y-Koordinate der Beschleunigung.
+ * @param i Index des Partikels
+ * @return y-Koordinate der Beschleunigung
+ */
+float getParticleAccelarationY(int i)
+{
+    return g_particles.accelaration[LY][i];
+}
+
+/**
+ * Liefert die z-Koordinate der Beschleunigung.
+ * @param i Index des Partikels
+ * @return z-Koordinate der Beschleunigung
+ */
+float getParticleAccelarationZ(int i)
+{
+    return g_particles.accelaration[LZ][i];
+}
+
+/**
+ * Liefert die x-Koordinate des UP-Vektors.
+ * @param i Index des Partikels
+ * @return x-Koordinate des UP-Vektors
+ */
+float getParticleUpX(int i)
+{
+    return g_particles.up[LX][i];
+}
+
+/**
+ * Liefert die y-Koordinate des UP-Vektors.
+ * @param i Index des Partikels
+ * @return y-Koordinate des UP-Vektors
+ */
+float getParticleUpY(int i)
+{
+    return g_particles.up[LY][i];
+}
+
+/**
+ * Liefert die z-Koordinate des UP-Vektors.
+ * @param i Index des Partikels
+ * @return z-Koordinate des UP-Vektors
+ */
+float getParticleUpZ(int i)
+{
+    return g_particles.up[LZ][i];
+}
+
+/**
+ * Liefert das ausgewaehlte Partikel.
+ */
+int getPickedParticle(void)
+{
+    return g_pickedParticle;
+}
+
+/**
+ * Setzt das ausgewaehlte Partikel.
+ * @param i Index des Partikels
+ */
+void setPickedParticle(int i)
+{
+    g_pickedParticle = i >= 0 && i < g_particles.count ? i : 0;
+}
+
+/**
+ * Erhoeht den Index des gepickten Partikels.
+ */
+void increasePickedParticle(void)
+{
+    g_pickedParticle = (g_pickedParticle + 1) % g_particles.count;
+}
+
+/**
+ * Aendert das Zielobjekt zyklisch.
+ */
+void changeTargetMode(void)
+{
+    g_targetMode = (g_targetMode + 1) % TARGET_MODE_COUNT;
+}
+
+/**
+ * Liefert das Zielobjekt der Partikel.
+ * @return der Zielmodus
+ */
+TargetMode getTargetMode(void)
+{
+    return g_targetMode;
+}
+
+/**
+ * Setzt das Zielobjekt der Partikel.
+ * @param mode der neue Zielmodus
+ */
+void setTargetMode(TargetMode mode)
+{
+    g_targetMode = mode >= 0 && mode < TARGET_MODE_COUNT ? mode : targetModeBalls;
+}
+
+/**
+ * Setzt das Integrationsverfahren der Partikel.
+ * @param integrator das neue Integrationsverfahren
+ */
+void setIntegrator(Integrator integrator)
+{
+    if (integrator >= 0 && integrator < INTEGRATOR_COUNT)
+    {
+        g_integrator = integrator;
+    }
+}
+
+/**
+ * Wechselt zyklisch zum naechsten Integrationsverfahren.
+ */
+void nextIntegrator(void)
+{
+    g_integrator = (g_integrator + 1) % INTEGRATOR_COUNT;
+}
+
+/**
+ * Liefert das eingestellte Integrationsverfahren der Partikel.
+ * @return das Integrationsverfahren
+ */
+Integrator getIntegrator(void)
+{
+    return g_integrator;
+}
+
+/**
+ * Liefert den Namen eines Integrationsverfahrens.
+ * @param integrator das Integrationsverfahren
+ * @return der Name des Verfahrens
+ */
+const char *getIntegratorName(Integrator integrator)
+{
+    switch (integrator)
+    {
+    case integratorSemiImplicitEuler:
+        return "Semi-impliziter Euler";
+    case integratorVelocityVerlet:
+        return "Velocity Verlet";
+    case integratorRungeKutta4:
+        return "Runge-Kutta 4";
+    default:
+        return "";
+    }
+}
+
+/**
+ * Setzt die Genauigkeit der Mathematik in den Partikelkerneln.
+ * @param precision die neue Genauigkeit
+ */
+void setMathPrecision(MathPrecision precision)
+{
+    if (precision >= 0 && precision < MATH_PRECISION_COUNT)
+    {
+        g_mathPrecision = precision;
+    }
+}
+
+/**
+ * Wechselt zwischen exakter und schneller Mathematik.
+ */
+void nextMathPrecision(void)
+{
+    g_mathPrecision = (g_mathPrecision + 1) % MATH_PRECISION_COUNT;
+}
+
+/**
+ * Liefert die eingestellte Genauigkeit der Mathematik.
+ * @return die Genauigkeit
+ */
+MathPrecision getMathPrecision(void)
+{
+    return g_mathPrecision;
+}
+
+/**
+ * Liefert den Namen einer Genauigkeit.
+ * @param precision die Genauigkeit
+ * @return der Name der Genauigkeit
+ */
+const char *getMathPrecisionName(MathPrecision precision)
+{
+    switch (precision)
+    {
+    case mathPrecisionExact:
+        return "exakt";
+    case mathPrecisionFast:
+        return "schnell";
+    default:
+        return "";
+    }
+}
+
+/**
+ * Legt fest, ob die Stufen der Pipeline je Block hintereinander oder jede
+ * Stufe fuer sich ueber alle Partikel laufen.
+ * @param fused GL_TRUE fuer zusammengefasste Stufen
+ */
+void setParticlePipelineFused(GLboolean fused)
+{
+    g_pipelineFused = fused;
+}
+
+/**
+ * Liefert, ob die Stufen der Pipeline zusammengefasst laufen.
+ * @return GL_TRUE fuer zusammengefasste Stufen
+ */
+GLboolean isParticlePipelineFused(void)
+{
+    return g_pipelineFused;
+}
+
+/**
+ * Liefert die Laufzeit einer Stufe seit dem letzten Zuruecksetzen, summiert
+ * ueber alle Threads.
+ * @param stage die Stufe
+ * @return die Laufzeit in Nanosekunden
+ */
+double getParticleStageNanos(ParticleStage stage)
+{
+    return (double)atomic_load(&g_stageNanos[stage]);
+}
+
+/**
+ * Liefert die Anzahl der Zeitschritte seit dem letzten Zuruecksetzen.
+ * @return Anzahl der Zeitschritte
+ */
+int getParticlePipelineSteps(void)
+{
+    return g_pipelineSteps;
+}
+
+/**
+ * Setzt die Laufzeiten und Hardwarezaehler der Stufen zurueck.
+ */
+void resetParticleStageStats(void)
+{
+    for (int stage = 0; stage < PARTICLE_STAGE_COUNT; stage++)
+    {
+        atomic_store(&g_stageNanos[stage], 0);
+        resetPerfCounterValues(&g_stageCounters[stage]);
+    }
+    resetPerfCounterValues(&g_prepareCounters);
+    resetPerfCounterValues(&g_pipelineCounters);
+    g_pipelineSteps = 0;
+}
+
+/**
+ * Legt die Hardwarezaehler fest, die in jedem Zeitschritt gelesen werden.
+ * Muessen mit inheritThreads geoeffnet sein, damit die Arbeitsthreads
+ * mitgezaehlt werden.
+ * @param counters die geoeffneten Zaehler, NULL fuer keine
+ */
+void setParticlePerfCounters(const PerfCounters *counters)
+{
+    g_perfCounters = counters;
+}
+
+/**
+ * Liefert die Hardwarezaehler seit dem letzten Zuruecksetzen, summiert ueber
+ * alle Threads. Einzelne Stufen werden nur gemessen, wenn die Stufen nicht
+ * zusammengefasst laufen.
+ * @param prepare Zaehler der Vorbereitung (Entfernen, Kenngroessen, Gitter) (out-param)
+ * @param stages Zaehler je Stufe, PARTICLE_STAGE_COUNT Eintraege (out-param)
+ * @param pipeline Zaehler aller Stufen zusammen (out-param)
+ */
+void getParticleStageCounters(PerfCounterValues *prepare, PerfCounterValues *stages, PerfCounterValues *pipeline)
+{
+    *prepare = g_prepareCounters;
+    for (int stage = 0; stage < PARTICLE_STAGE_COUNT; stage++)
+    {
+        stages[stage] = g_stageCounters[stage];
+    }
+    *pipeline = g_pipelineCounters;
+}
+
+/**
+ * Liefert den Namen einer Stufe der Pipeline.
+ * @param stage die Stufe
+ * @return der Name der Stufe
+ */
+const char *getParticleStageName(ParticleStage stage)
+{
+    switch (stage)
+    {
+    case particleStageForces:
+        return "Kraefte";
+    case particleStageIntegrate:
+        return "Integration";
+    case particleStageOrientation:
+        return "Orientierung";
+    default:
+        return "";
+    }
+}
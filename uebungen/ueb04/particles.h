@@ -0,0 +1,150 @@
+#ifndef __PARTICLES_H__
+#define __PARTICLES_H__
+/**
+ * @file
+ * Partikel-Modul.
+ * Das Modul kapselt die Partikel des Schwarms und deren Bewegung. Die Partikel
+ * werden als Structure of Arrays in ausgerichteten Arrays gehalten und
+ * blockweise ueber das Job-Modul parallel aktualisiert. Ein Zeitschritt ist
+ * eine Pipeline aus Stufen (Kraefte, Integration, Orientierung), die einen
+ * Satz von Zustand und Stroemen lesen und den anderen schreiben. Es
+ * kommt ohne OpenGL-Aufrufe aus und kann daher auch ohne Fenster (z.B. im
+ * Benchmark) verwendet werden.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+#include "perfcounters.h"
+
+/* ---- Konstanten ---- */
+
+#define INITIAL_PARTICLES 20
+#define MAX_PARTICLES 4000000
+#define MIN_PARTICLES 1
+#define GAUSS_CONST 50
+#define K_V 0.5f
+
+#define PICKED_PARTICLE_SPEED_FAKTOR 1.2f
+
+/* Anzahl der Teilschritte des Runge-Kutta-Verfahrens */
+#define RK4_STAGES 4
+
+/* Partikelschwall per Tastendruck */
+#define PARTICLE_BURST_SIZE 1000
+#define PARTICLE_BURST_EXTENT 0.05f
+#define PARTICLE_BURST_CONE_ANGLE 30.0f
+
+/* Ausrichtung der Partikelarrays in Byte (passend fuer AVX) */
+#define PARTICLE_ALIGNMENT 32
+/* Anzahl der Partikel, die gemeinsam als ein Block bearbeitet werden */
+#define PARTICLE_CHUNK_SIZE 256
+/* Anzahl der Arrays je Partikel (siehe getParticleArrays) */
+#define PARTICLE_ARRAY_COUNT 15
+
+/** Praedikat zur Auswahl von Partikeln ueber deren Index */
+typedef GLboolean (*ParticlePredicate)(int i, void *data);
+
+void initParticles(int count);
+
+void freeParticles(void);
+
+void getParticleArrays(float **arrays);
+
+void restoreParticles(int count, const float *const *arrays);
+
+void setParticleAmount(int count);
+
+int spawnParticles(int count, const ParticleSpawnDistribution *distribution);
+
+void killParticle(int i);
+
+int killParticlesIf(ParticlePredicate predicate, void *data);
+
+int compactParticles(void);
+
+int killRandomParticles(int count);
+
+void increaseParticles(void);
+
+void decreaseParticles(void);
+
+void spawnParticleBurst(void);
+
+void killParticleBurst(void);
+
+void updateParticles(double interval, CGVector3f *balls, int ballCount);
+
+int getParticleAmount(void);
+
+const ParticleStore *getParticleStore(void);
+
+float getParticleX(int i);
+
+float getParticleY(int i);
+
+float getParticleZ(int i);
+
+float getParticleVelocityX(int i);
+
+float getParticleVelocityY(int i);
+
+float getParticleVelocityZ(int i);
+
+float getParticleAccelarationX(int i);
+
+float getParticleAccelarationY(int i);
+
+float getParticleAccelarationZ(int i);
+
+float getParticleUpX(int i);
+
+float getParticleUpY(int i);
+
+float getParticleUpZ(int i);
+
+int getPickedParticle(void);
+
+void setPickedParticle(int i);
+
+void increasePickedParticle(void);
+
+void changeTargetMode(void);
+
+void setTargetMode(TargetMode mode);
+
+TargetMode getTargetMode(void);
+
+void setIntegrator(Integrator integrator);
+
+void nextIntegrator(void);
+
+Integrator getIntegrator(void);
+
+const char *getIntegratorName(Integrator integrator);
+
+void setMathPrecision(MathPrecision precision);
+
+void nextMathPrecision(void);
+
+MathPrecision getMathPrecision(void);
+
+const char *getMathPrecisionName(MathPrecision precision);
+
+void setParticlePipelineFused(GLboolean fused);
+
+GLboolean isParticlePipelineFused(void);
+
+double getParticleStageNanos(ParticleStage stage);
+
+int getParticlePipelineSteps(void);
+
+void resetParticleStageStats(void);
+
+void setParticlePerfCounters(const PerfCounters *counters);
+
+void getParticleStageCounters(PerfCounterValues *prepare, PerfCounterValues *stages, PerfCounterValues *pipeline);
+
+const char *getParticleStageName(ParticleStage stage);
+
+#endif
@@ -34,10 +34,13 @@
 #include "objects.h"
 #include "util.h"
 #include "texture.h"
+#include "particleBuffers.h"
 #include "float.h"
+#include "profiler.h"
 /* ---- Globale Variablen ---- */
 
 GLboolean g_normals = GL_FALSE;
+GLboolean g_profileOverlay = GL_FALSE;
 
 GLuint g_ListIdSphere; //Sphere
 
@@ -50,7 +53,7 @@ GLuint g_ListIdSphere; //Sphere
 */
 static void drawHelp()
 {
-    int size = 24;
+    int size = 33;
 
     float color[3] = {LIGHT_BLUE};
 
@@ -58,16 +61,23 @@ static void drawHelp()
                     "w,a,s,d - Kamera bewegen",
                     "./, - Kamera rein/raus Zoomen",
                     "Pfeiltasten oben/unten - Partikel Anzahl erhoehen/verringern",
+                    "Bild auf/ab - Partikelschwall erzeugen/entfernen",
                     "H/h - Hilfe an/aus",
                     "E/e - Darstellung der Partikel aendern",
                     "M/m - Bewegung der Zielpunkte an/aus",
                     "N/n - Verfolger Partikel weiterschalten",
+                    "X/x - Abgasstrahl des Verfolger Partikels an/aus",
                     "R/r - Schattenwurf an/aus",
                     "c, C - Kamera wechseln",
                     "v, V - Orientierungshilfe in 3D an/aus",
                     "t, T - Textur der Flaeche wechseln",
                     "P/p - Pausiert bzw. setzt Simulation fort",
                     "Z/z - Wechsel den Verfolgungsmodus",
+                    "I/i - Integrationsverfahren wechseln",
+                    "G/g - Genauigkeit der Mathematik wechseln",
+                    "O/o - Zustand speichern",
+                    "L/l - Zustand laden",
+                    "K/k - Fortlaufende Snapshots an/aus",
                     "1 - Beschleunigungsvektor des Partikels an/aus",
                     "2 - Geschwindigkeitsvektor des Partikels an/aus",
                     "3 - Up-Vekor des Partikels an/aus",
@@ -77,6 +87,8 @@ static void drawHelp()
                     "F4 - Texturen an/aus",
                     "F5 - Lichtberechnung an/aus",
                     "F6 - Punktlichtquelle an/aus",
+                    "F11 - Frame-Zeiten an/aus",
+                    "F12 - Frame-Zeiten als Chrome-Trace speichern",
                     "ESC/Q/q - Ende"};
 
     drawString(0.2f, 0.10f, color, help[0]);
@@ -98,18 +110,26 @@ static void drawInfoInWindowTitle(void)
     //Vertices
     //Holt sich die Kontrollpunkte und wandelt sie in ein String um
     int particleAmount = getParticleAmount();
-    char particleAmountString[4];
+    char particleAmountString[16];
     sprintf(particleAmountString, "%d", particleAmount);
     char *particleAmountStringFinal = concat(" Anzahl Partikel: ", particleAmountString);
 
     //FPS
     float fps = getFps();
-    char fpsString[6];
+    char fpsString[16];
     sprintf(fpsString, "%.2f ", fps);
     char *fpsStringOut = concat(" | FPS: ", fpsString);
 
+    //Integrationsverfahren
+    char *integratorString = concat(" | Integrator: ", (char *)getIntegratorName(getIntegrator()));
+
+    //Genauigkeit der Mathematik
+    char *precisionString = concat(" | Mathematik: ", (char *)getMathPrecisionName(getMathPrecision()));
+
     char *title = concat(name, particleAmountStringFinal);
-    char *titleFinal = concat(title, fpsStringOut);
+    char *intermediateTitle = concat(title, integratorString);
+    char *precisionTitle = concat(intermediateTitle, precisionString);
+    char *titleFinal = concat(precisionTitle, fpsStringOut);
 
     glutSetWindowTitle(titleFinal);
 
@@ -120,6 +140,14 @@ static void drawInfoInWindowTitle(void)
     fpsStringOut = NULL;
     free(title);
     title = NULL;
+    free(intermediateTitle);
+    intermediateTitle = NULL;
+    free(integratorString);
+    integratorString = NULL;
+    free(precisionString);
+    precisionString = NULL;
+    free(precisionTitle);
+    precisionTitle = NULL;
     free(titleFinal);
     titleFinal = NULL;
 }
@@ -157,120 +185,38 @@ static void handleLight()
 }
 
 /**
- * Zeichnet alle Partikel.
+ * Zeichnet ein Vertex Array mit einem einzigen Zeichenaufruf.
+ * @param mode die Primitive (GL_TRIANGLES, GL_LINES)
+ * @param buffer das Vertex Array
  */
-static void drawParticles(void)
+static void drawVertexBuffer(GLenum mode, const VertexBuffer *buffer)
 {
-    int particleAmount = getParticleAmount();
-    for (int i = 0; i < particleAmount; i++)
+    if (buffer->count > 0)
     {
-        //Partikel Vektoren holen
-        CGVector3f position = {getParticleX(i), getParticleY(i), getParticleZ(i)};
-        CGVector3f velocity = {getParticleVelocityX(i), getParticleVelocityY(i), getParticleVelocityZ(i)};
-        CGVector3f acceleration = {getParticleAccelarationX(i), getParticleAccelarationY(i), getParticleAccelarationZ(i)};
-        CGVector3f upVector = {getParticleUpX(i), getParticleUpY(i), getParticleUpZ(i)};
-        CGVector3f velocityCrossAccelaration = {0};
-        calcCrossProduct(velocity, acceleration, velocityCrossAccelaration);
-        //Vektoren normalisieren
-        normalizeVector(velocity);
-        normalizeVector(acceleration);
-        normalizeVector(upVector);
-        normalizeVector(velocityCrossAccelaration);
-        //Vektoren zum Zeichnen noch verkleinern
-        multiplyVectorWithScalar(acceleration, VECTOR_LENGTH_FACTOR, acceleration);
-        multiplyVectorWithScalar(velocity, VECTOR_LENGTH_FACTOR, velocity);
-        multiplyVectorWithScalar(upVector, VECTOR_LENGTH_FACTOR, upVector);
-        multiplyVectorWithScalar(velocityCrossAccelaration, VECTOR_LENGTH_FACTOR, velocityCrossAccelaration);
-
-        //Beschleunigungvektor
-        if (getDrawParticleAccelerationStatus())
-        {
-            setMaterialAndColor(RED, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-            drawLineInBetween(position[LX], position[LY], position[LZ],
-                              position[LX] + acceleration[LX],
-                              position[LY] + acceleration[LY],
-                              position[LZ] + acceleration[LZ]);
-        }
-        //Geschwindigkeitsvektor
-        if (getDrawParticleVelocityStatus())
-        {
-            setMaterialAndColor(BLUE, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-            drawLineInBetween(position[LX], position[LY], position[LZ],
-                              position[LX] + velocity[LX],
-                              position[LY] + velocity[LY],
-                              position[LZ] + velocity[LZ]);
-        }
-        //Up-Vektor
-        if (getDrawParticleUpVectorStatus())
-        {
-            setMaterialAndColor(WHITE, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-            drawLineInBetween(position[LX], position[LY], position[LZ],
-                              position[LX] + upVector[LX],
-                              position[LY] + upVector[LY],
-                              position[LZ] + upVector[LZ]);
-        }
-
-        //Dreiecke zeichnen
-        if (getParticleLineStatus())
-        {
-            if (i == getPickedParticle())
-            {
-                drawPlane(position, velocity, velocityCrossAccelaration, GL_TRUE);
-            }
-            else
-            {
-                drawPlane(position, velocity, velocityCrossAccelaration, GL_FALSE);
-            }
-        }
-        else
-        //Linien zeichnen
-        {
-            if (i == getPickedParticle())
-            {
-                drawPlaneAsLine(position, velocity, GL_TRUE);
-            }
-            else
-            {
-                drawPlaneAsLine(position, velocity, GL_FALSE);
-            }
-        }
+        glVertexPointer(3, GL_FLOAT, sizeof(Vertex), &buffer->vertices[0][CX]);
+        glColorPointer(3, GL_FLOAT, sizeof(Vertex), &buffer->vertices[0][CR]);
+        glNormalPointer(GL_FLOAT, sizeof(Vertex), &buffer->vertices[0][NX]);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &buffer->vertices[0][TX]);
+        glDrawArrays(mode, 0, buffer->count);
     }
 }
 
 /**
- * Zeichnet alle Partikel.
+ * Zeichnet alle Partikel, ihre Hilfsvektoren und Schatten.
+ * Die Vertex Arrays werden einmal pro Frame befuellt und mit je einem
+ * Zeichenaufruf dargestellt.
  */
-static void drawShadows(void)
+static void drawParticles(void)
 {
-    int particleAmount = getParticleAmount();
-    for (int i = 0; i < particleAmount; i++)
-    {
-        //Partikel Vektoren holen
-        CGVector3f position = {getParticleX(i), getParticleY(i), getParticleZ(i)};
-        CGVector3f velocity = {getParticleVelocityX(i), getParticleVelocityY(i), getParticleVelocityZ(i)};
-        CGVector3f acceleration = {getParticleAccelarationX(i), getParticleAccelarationY(i), getParticleAccelarationZ(i)};
-        CGVector3f velocityCrossAccelaration = {0};
-        calcCrossProduct(velocity, acceleration, velocityCrossAccelaration);
-        //Vektoren normalisieren
-        normalizeVector(velocity);
-        normalizeVector(velocityCrossAccelaration);
-        //Vektoren zum Zeichnen noch verkleinern
-        multiplyVectorWithScalar(velocity, VECTOR_LENGTH_FACTOR, velocity);
-        multiplyVectorWithScalar(velocityCrossAccelaration, VECTOR_LENGTH_FACTOR, velocityCrossAccelaration);
-
-        setMaterialAndColor(BLACK, 0.0f, GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-        if (getParticleLineStatus())
-        {
-            drawShadow(position, velocity, velocityCrossAccelaration);
-        }
-        else
-        {
-            drawLineInBetween(position[LX], SHADOW_DISTANCE_TO_GROUND, position[LZ],
-                              position[LX] - velocity[LX],
-                              SHADOW_DISTANCE_TO_GROUND,
-                              position[LZ] - velocity[LZ]);
-        }
-    }
+    ParticleBufferOptions options = {getParticleLineStatus(), getDrawShadows(),
+                                     getDrawParticleAccelerationStatus(), getDrawParticleVelocityStatus(),
+                                     getDrawParticleUpVectorStatus(), getPickedParticle()};
+    GLenum mode = options.asTriangles ? GL_TRIANGLES : GL_LINES;
+    fillParticleBuffers(&options);
+
+    drawVertexBuffer(GL_LINES, getParticleBuffer(particleBufferVectors));
+    drawVertexBuffer(mode, getParticleBuffer(particleBufferBodies));
+    drawVertexBuffer(mode, getParticleBuffer(particleBufferShadows));
 }
 
 /**
@@ -309,10 +255,6 @@ static void drawGameField(void)
 {
     drawWalls(g_normals);
     drawParticles();
-    if (getDrawShadows())
-    {
-        drawShadows();
-    }
     drawBalls();
 }
 
@@ -337,6 +279,11 @@ void drawScene(void)
             drawAxes();
         }
         drawGameField();
+
+        if (g_profileOverlay)
+        {
+            drawProfileOverlay(drawString);
+        }
     }
 }
 
@@ -348,6 +295,14 @@ void toggleNormals(void)
     g_normals = !g_normals;
 }
 
+/**
+ * Toggelt das Overlay mit den Frame-Zeiten.
+ */
+void toggleProfileOverlay(void)
+{
+    g_profileOverlay = !g_profileOverlay;
+}
+
 /**
  * (De-)aktiviert den Wireframe-Modus.
  */
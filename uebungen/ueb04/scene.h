@@ -37,6 +37,11 @@ void toggleWireframeMode(void);
  */
 void toggleNormals(void);
 
+/**
+ * Toggelt das Overlay mit den Frame-Zeiten.
+ */
+void toggleProfileOverlay(void);
+
 /**
  * Toggelt die Kontrollpunkte.
  */
@@ -0,0 +1,490 @@
+/**
+ * @file
+ * Snapshot-Modul.
+ * Das Modul speichert den Zustand der Simulation (Partikel, Baelle,
+ * Zielmodus, Integrationsverfahren und ausgewaehltes Partikel) in einem
+ * kompakten Binaerformat und laedt ihn wieder.
+ *
+ * Aufbau der Datei: ein Kopf (SnapshotHeader), danach die
+ * PARTICLE_ARRAY_COUNT Arrays der Partikel (Reihenfolge wie
+ * getParticleArrays) im Abstand arrayStride, jeweils auf SNAPSHOT_ALIGNMENT
+ * ausgerichtet. Geschrieben wird mit einem einzigen writev direkt aus den
+ * Arrays der Partikel, geladen wird ueber mmap. Die Werte stehen in der
+ * Byte-Reihenfolge des schreibenden Rechners.
+ *
+ * Beim fortlaufenden Schreiben kopiert die Simulation den Zustand nur in
+ * ein Abbild der Datei, geschrieben wird es von einem Hintergrundthread.
+ * Ist dieser noch mit dem vorherigen Snapshot beschaeftigt, wird der
+ * aktuelle ausgelassen, statt die Simulation warten zu lassen.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "snapshot.h"
+#include "particles.h"
+#include "util.h"
+
+/* ---- Konstanten ---- */
+
+#define SNAPSHOT_MAGIC "UEB4SNAP"
+#define SNAPSHOT_VERSION 1
+/* Hoechstlaenge eines Dateinamens */
+#define SNAPSHOT_PATH_LENGTH 512
+
+/* ---- Typen ---- */
+
+/* Kopf einer Snapshot-Datei */
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    /* Byte-Abstand des ersten Arrays vom Dateianfang und der Arrays untereinander */
+    uint32_t dataOffset;
+    uint32_t arrayStride;
+    int32_t arrayCount;
+    int32_t count;
+    int32_t targetMode;
+    int32_t integrator;
+    int32_t pickedParticle;
+    int32_t ballCount;
+    float balls[SNAPSHOT_MAX_BALLS][3];
+} SnapshotHeader;
+
+/* ---- Globale Daten ---- */
+
+/* Nullbytes zum Auffuellen bis zur naechsten Ausrichtung */
+static const char g_padding[SNAPSHOT_ALIGNMENT] = {0};
+
+/* Hintergrundthread fuer das fortlaufende Schreiben */
+pthread_t g_streamThread;
+pthread_mutex_t g_streamMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t g_streamCondition = PTHREAD_COND_INITIALIZER;
+GLboolean g_streamRunning = GL_FALSE;
+GLboolean g_streamStop = GL_FALSE;
+
+/* Abbild der naechsten Datei, gesetzt solange der Thread es schreibt */
+char *g_streamImage = NULL;
+size_t g_streamImageCapacity = 0;
+size_t g_streamImageSize = 0;
+GLboolean g_streamBusy = GL_FALSE;
+
+/* Dateinamensmuster (mit %d fuer die laufende Nummer), Intervall und Zaehler */
+char g_streamPattern[SNAPSHOT_PATH_LENGTH];
+double g_streamPeriod = 0.0;
+double g_streamElapsed = 0.0;
+int g_streamSequence = 0;
+SnapshotStreamStats g_streamStats = {0};
+
+/* ---- Funktionen ---- */
+
+/**
+ * Rundet eine Byteanzahl auf die naechste Ausrichtung auf.
+ * @param size die Byteanzahl
+ * @return die aufgerundete Byteanzahl
+ */
+static size_t alignSnapshot(size_t size)
+{
+    return (size + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+}
+
+/**
+ * Befuellt den Kopf einer Snapshot-Datei mit dem aktuellen Zustand.
+ * @param header der Kopf (out-param)
+ * @param balls die Positionen der Baelle
+ * @param ballCount Anzahl der Baelle
+ */
+static void fillHeader(SnapshotHeader *header, CGVector3f *balls, int ballCount)
+{
+    memset(header, 0, sizeof(SnapshotHeader));
+    memcpy(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic));
+    header->version = SNAPSHOT_VERSION;
+    header->dataOffset = alignSnapshot(sizeof(SnapshotHeader));
+    header->arrayStride = alignSnapshot(sizeof(float) * getParticleAmount());
+    header->arrayCount = PARTICLE_ARRAY_COUNT;
+    header->count = getParticleAmount();
+    header->targetMode = getTargetMode();
+    header->integrator = getIntegrator();
+    header->pickedParticle = getPickedParticle();
+    header->ballCount = ballCount < SNAPSHOT_MAX_BALLS ? ballCount : SNAPSHOT_MAX_BALLS;
+    for (int b = 0; b < header->ballCount; b++)
+    {
+        memcpy(header->balls[b], balls[b], sizeof(CGVector3f));
+    }
+}
+
+/**
+ * Liefert die Groesse der Datei zu einem Kopf.
+ * @param header der Kopf
+ * @return die Dateigroesse in Byte
+ */
+static size_t getSnapshotSize(const SnapshotHeader *header)
+{
+    return header->dataOffset + (size_t)header->arrayCount * header->arrayStride;
+}
+
+/**
+ * Schreibt alle Puffer vollstaendig, auch wenn writev nur einen Teil
+ * uebernimmt.
+ * @param fd die Datei
+ * @param iov die Puffer, werden dabei veraendert
+ * @param iovCount Anzahl der Puffer
+ * @return GL_TRUE, wenn alles geschrieben wurde
+ */
+static GLboolean writeAll(int fd, struct iovec *iov, int iovCount)
+{
+    while (iovCount > 0)
+    {
+        ssize_t written = writev(fd, iov, iovCount);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return GL_FALSE;
+        }
+        //Vollstaendig geschriebene Puffer ueberspringen, den Rest des letzten kuerzen
+        while (iovCount > 0 && (size_t)written >= iov->iov_len)
+        {
+            written -= iov->iov_len;
+            iov++;
+            iovCount--;
+        }
+        if (iovCount > 0)
+        {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+    return GL_TRUE;
+}
+
+/**
+ * Schreibt Puffer in eine temporaere Datei und benennt diese danach um,
+ * sodass Leser nie eine halb geschriebene Datei sehen.
+ * @param path der Dateiname
+ * @param iov die Puffer
+ * @param iovCount Anzahl der Puffer
+ * @return GL_TRUE, wenn die Datei geschrieben wurde
+ */
+static GLboolean writeSnapshotFile(const char *path, struct iovec *iov, int iovCount)
+{
+    char tempPath[SNAPSHOT_PATH_LENGTH + 8];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+    int fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        printf("Snapshot %s konnte nicht angelegt werden.\n", tempPath);
+        return GL_FALSE;
+    }
+    GLboolean success = writeAll(fd, iov, iovCount);
+    success = close(fd) == 0 && success;
+    if (!success || rename(tempPath, path) != 0)
+    {
+        printf("Snapshot %s konnte nicht geschrieben werden.\n", path);
+        unlink(tempPath);
+        return GL_FALSE;
+    }
+    return GL_TRUE;
+}
+
+/**
+ * Speichert den aktuellen Zustand. Kopf und Arrays werden mit einem
+ * einzigen writev direkt aus dem Speicher der Partikel geschrieben.
+ * @param path der Dateiname
+ * @param balls die Positionen der Baelle
+ * @param ballCount Anzahl der Baelle
+ * @return GL_TRUE, wenn der Zustand gespeichert wurde
+ */
+GLboolean saveSnapshot(const char *path, CGVector3f *balls, int ballCount)
+{
+    SnapshotHeader header;
+    fillHeader(&header, balls, ballCount);
+    float *arrays[PARTICLE_ARRAY_COUNT];
+    getParticleArrays(arrays);
+
+    //Kopf, Auffuellen und je Array Daten und Auffuellen
+    struct iovec iov[2 + 2 * PARTICLE_ARRAY_COUNT];
+    int iovCount = 0;
+    size_t arrayBytes = sizeof(float) * header.count;
+    iov[iovCount++] = (struct iovec){&header, sizeof(SnapshotHeader)};
+    iov[iovCount++] = (struct iovec){(void *)g_padding, header.dataOffset - sizeof(SnapshotHeader)};
+    for (int a = 0; a < PARTICLE_ARRAY_COUNT; a++)
+    {
+        iov[iovCount++] = (struct iovec){arrays[a], arrayBytes};
+        iov[iovCount++] = (struct iovec){(void *)g_padding, header.arrayStride - arrayBytes};
+    }
+    return writeSnapshotFile(path, iov, iovCount);
+}
+
+/**
+ * Laedt einen gespeicherten Zustand. Die Datei wird per mmap eingeblendet,
+ * die Arrays werden direkt aus der Einblendung uebernommen.
+ * @param path der Dateiname
+ * @param balls die Positionen der Baelle (out-param)
+ * @param maxBalls Anzahl der Baelle, fuer die Platz ist
+ * @return Anzahl der geladenen Baelle oder -1 im Fehlerfall
+ */
+int loadSnapshot(const char *path, CGVector3f *balls, int maxBalls)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        printf("Snapshot %s konnte nicht geoeffnet werden.\n", path);
+        return -1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(SnapshotHeader))
+    {
+        printf("Snapshot %s ist unvollstaendig.\n", path);
+        close(fd);
+        return -1;
+    }
+    void *mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        printf("Snapshot %s konnte nicht eingeblendet werden.\n", path);
+        return -1;
+    }
+
+    const SnapshotHeader *header = mapping;
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 || header->version != SNAPSHOT_VERSION ||
+        header->arrayCount != PARTICLE_ARRAY_COUNT || header->count < MIN_PARTICLES || header->count > MAX_PARTICLES ||
+        header->arrayStride < sizeof(float) * header->count || header->ballCount < 0 ||
+        header->ballCount > SNAPSHOT_MAX_BALLS || getSnapshotSize(header) > (size_t)info.st_size)
+    {
+        printf("Snapshot %s hat ein ungueltiges Format.\n", path);
+        munmap(mapping, info.st_size);
+        return -1;
+    }
+
+    const float *arrays[PARTICLE_ARRAY_COUNT];
+    for (int a = 0; a < PARTICLE_ARRAY_COUNT; a++)
+    {
+        arrays[a] = (const float *)((const char *)mapping + header->dataOffset + (size_t)a * header->arrayStride);
+    }
+    restoreParticles(header->count, arrays);
+    setTargetMode(header->targetMode);
+    setIntegrator(header->integrator);
+    setPickedParticle(header->pickedParticle);
+    int ballCount = header->ballCount < maxBalls ? header->ballCount : maxBalls;
+    for (int b = 0; b < ballCount; b++)
+    {
+        memcpy(balls[b], header->balls[b], sizeof(CGVector3f));
+    }
+
+    munmap(mapping, info.st_size);
+    return ballCount;
+}
+
+/**
+ * Hauptschleife des Hintergrundthreads: wartet auf ein Abbild und schreibt
+ * es in die naechste Datei.
+ * @param arg nicht verwendet
+ * @return immer NULL
+ */
+static void *runSnapshotWriter(void *arg)
+{
+    pthread_mutex_lock(&g_streamMutex);
+    for (;;)
+    {
+        while (!g_streamBusy && !g_streamStop)
+        {
+            pthread_cond_wait(&g_streamCondition, &g_streamMutex);
+        }
+        if (!g_streamBusy)
+        {
+            break;
+        }
+        char path[SNAPSHOT_PATH_LENGTH];
+        snprintf(path, sizeof(path), g_streamPattern, g_streamSequence++);
+        pthread_mutex_unlock(&g_streamMutex);
+
+        double start = getTimeNanos();
+        struct iovec iov = {g_streamImage, g_streamImageSize};
+        GLboolean success = writeSnapshotFile(path, &iov, 1);
+        double nanos = getTimeNanos() - start;
+
+        pthread_mutex_lock(&g_streamMutex);
+        g_streamStats.writeNanos += nanos;
+        g_streamStats.written += success;
+        g_streamStats.bytes += success ? (long long)g_streamImageSize : 0;
+        g_streamBusy = GL_FALSE;
+        pthread_cond_broadcast(&g_streamCondition);
+    }
+    pthread_mutex_unlock(&g_streamMutex);
+    return NULL;
+}
+
+/**
+ * Prueft ein Dateinamensmuster, bevor es als Formatstring fuer snprintf
+ * dient: genau eine Umwandlung %d bzw. %i (optional mit Flags "0-+ #" und
+ * Breite, z.B. %06d) und kein weiteres %.
+ * @param pattern das Muster
+ * @return GL_TRUE, wenn das Muster gueltig ist und in SNAPSHOT_PATH_LENGTH passt
+ */
+static GLboolean isValidStreamPattern(const char *pattern)
+{
+    if (strlen(pattern) >= SNAPSHOT_PATH_LENGTH)
+    {
+        return GL_FALSE;
+    }
+    int conversions = 0;
+    for (const char *c = pattern; *c != '\0'; c++)
+    {
+        if (*c != '%')
+        {
+            continue;
+        }
+        c++;
+        c += strspn(c, "0-+ #");
+        c += strspn(c, "0123456789");
+        if ((*c != 'd' && *c != 'i') || ++conversions > 1)
+        {
+            return GL_FALSE;
+        }
+    }
+    return conversions == 1;
+}
+
+/**
+ * Startet das fortlaufende Schreiben von Snapshots. Ein bereits laufendes
+ * Schreiben wird vorher beendet.
+ * @param pathPattern Dateinamensmuster mit genau einem %d fuer die laufende
+ *        Nummer (z.B. snap_%06d.bin), sonst ohne %
+ * @param period Abstand der Snapshots in simulierter Zeit (Sekunden)
+ * @return GL_TRUE, wenn der Hintergrundthread gestartet wurde
+ */
+GLboolean startSnapshotStream(const char *pathPattern, double period)
+{
+    stopSnapshotStream();
+    if (!isValidStreamPattern(pathPattern))
+    {
+        printf("Ungueltiges Snapshot-Muster \"%s\": genau ein %%d erwartet.\n", pathPattern);
+        return GL_FALSE;
+    }
+    snprintf(g_streamPattern, sizeof(g_streamPattern), "%s", pathPattern);
+    g_streamPeriod = period;
+    g_streamElapsed = 0.0;
+    g_streamSequence = 0;
+    memset(&g_streamStats, 0, sizeof(g_streamStats));
+    g_streamStop = GL_FALSE;
+    g_streamBusy = GL_FALSE;
+    if (pthread_create(&g_streamThread, NULL, runSnapshotWriter, NULL) != 0)
+    {
+        printf("Snapshot-Thread konnte nicht gestartet werden.\n");
+        return GL_FALSE;
+    }
+    g_streamRunning = GL_TRUE;
+    return GL_TRUE;
+}
+
+/**
+ * Schreitet die Zeit des fortlaufenden Schreibens fort und uebergibt nach
+ * Ablauf des Intervalls ein Abbild des aktuellen Zustands an den
+ * Hintergrundthread. Die Simulation wartet dabei nur auf das Kopieren.
+ * @param interval die verstrichene simulierte Zeit
+ * @param balls die Positionen der Baelle
+ * @param ballCount Anzahl der Baelle
+ */
+void updateSnapshotStream(double interval, CGVector3f *balls, int ballCount)
+{
+    if (!g_streamRunning)
+    {
+        return;
+    }
+    g_streamElapsed += interval;
+    if (g_streamElapsed < g_streamPeriod)
+    {
+        return;
+    }
+    g_streamElapsed -= g_streamPeriod;
+
+    pthread_mutex_lock(&g_streamMutex);
+    GLboolean busy = g_streamBusy;
+    pthread_mutex_unlock(&g_streamMutex);
+    if (busy)
+    {
+        g_streamStats.dropped++;
+        return;
+    }
+
+    //Der Thread ist untaetig, das Abbild kann ohne Sperre befuellt werden
+    double start = getTimeNanos();
+    SnapshotHeader header;
+    fillHeader(&header, balls, ballCount);
+    size_t size = getSnapshotSize(&header);
+    if (size > g_streamImageCapacity)
+    {
+        free(g_streamImage);
+        g_streamImage = calloc(size, 1);
+        if (g_streamImage == NULL)
+        {
+            printf("Kein virtueller RAM mehr verfügbar ...\n");
+            exit(1);
+        }
+        g_streamImageCapacity = size;
+    }
+    memcpy(g_streamImage, &header, sizeof(SnapshotHeader));
+    float *arrays[PARTICLE_ARRAY_COUNT];
+    getParticleArrays(arrays);
+    for (int a = 0; a < PARTICLE_ARRAY_COUNT; a++)
+    {
+        memcpy(g_streamImage + header.dataOffset + (size_t)a * header.arrayStride, arrays[a], sizeof(float) * header.count);
+    }
+    g_streamImageSize = size;
+    g_streamStats.copyNanos += getTimeNanos() - start;
+
+    pthread_mutex_lock(&g_streamMutex);
+    g_streamBusy = GL_TRUE;
+    pthread_cond_broadcast(&g_streamCondition);
+    pthread_mutex_unlock(&g_streamMutex);
+}
+
+/**
+ * Beendet das fortlaufende Schreiben. Ein bereits uebergebenes Abbild wird
+ * noch geschrieben.
+ */
+void stopSnapshotStream(void)
+{
+    if (!g_streamRunning)
+    {
+        return;
+    }
+    pthread_mutex_lock(&g_streamMutex);
+    g_streamStop = GL_TRUE;
+    pthread_cond_broadcast(&g_streamCondition);
+    pthread_mutex_unlock(&g_streamMutex);
+    pthread_join(g_streamThread, NULL);
+    g_streamRunning = GL_FALSE;
+    free(g_streamImage);
+    g_streamImage = NULL;
+    g_streamImageCapacity = 0;
+}
+
+/**
+ * Liefert die Zaehler und Laufzeiten des fortlaufenden Schreibens.
+ * @return die Zaehler und Laufzeiten
+ */
+SnapshotStreamStats getSnapshotStreamStats(void)
+{
+    pthread_mutex_lock(&g_streamMutex);
+    SnapshotStreamStats stats = g_streamStats;
+    pthread_mutex_unlock(&g_streamMutex);
+    return stats;
+}
@@ -0,0 +1,40 @@
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+/**
+ * @file
+ * Snapshot-Modul.
+ * Das Modul speichert den Zustand der Simulation (Partikel, Baelle,
+ * Zielmodus, Integrationsverfahren und ausgewaehltes Partikel) in einem
+ * kompakten Binaerformat und laedt ihn wieder. Optional werden in einem
+ * festen Intervall Snapshots von einem Hintergrundthread geschrieben.
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+#include "types.h"
+
+/* ---- Konstanten ---- */
+
+/* Hoechstzahl an Baellen in einem Snapshot */
+#define SNAPSHOT_MAX_BALLS 8
+/* Ausrichtung der Arrays in der Datei in Byte */
+#define SNAPSHOT_ALIGNMENT 64
+/* Datei, in die per Tastendruck gespeichert bzw. aus der geladen wird */
+#define SNAPSHOT_FILE "ueb04.snap"
+/* Dateinamensmuster und Abstand in Sekunden beim fortlaufenden Schreiben */
+#define SNAPSHOT_STREAM_FILES "ueb04_%04d.snap"
+#define SNAPSHOT_STREAM_PERIOD 1.0
+
+GLboolean saveSnapshot(const char *path, CGVector3f *balls, int ballCount);
+
+int loadSnapshot(const char *path, CGVector3f *balls, int maxBalls);
+
+GLboolean startSnapshotStream(const char *pathPattern, double period);
+
+void updateSnapshotStream(double interval, CGVector3f *balls, int ballCount);
+
+void stopSnapshotStream(void);
+
+SnapshotStreamStats getSnapshotStreamStats(void);
+
+#endif
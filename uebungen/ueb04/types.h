@@ -93,18 +93,153 @@ typedef enum
 {
     targetModeBalls,
     targetModeSelectedParticle,
-    targetModeCenterOfParticles
+    targetModeCenterOfParticles,
+    targetModeFlocking,
+    TARGET_MODE_COUNT
 } TargetMode;
 
-/* Deklaration fuer ein Partikel */
+/* Integrationsverfahren fuer die Bewegung der Partikel */
+typedef enum
+{
+    integratorSemiImplicitEuler,
+    integratorVelocityVerlet,
+    integratorRungeKutta4,
+    INTEGRATOR_COUNT
+} Integrator;
+
+/* Genauigkeit der Mathematik in den Partikelkerneln */
+typedef enum
+{
+    mathPrecisionExact,
+    mathPrecisionFast,
+    MATH_PRECISION_COUNT
+} MathPrecision;
+
+/* Bewegungszustand der Partikel (Positionen und Geschwindigkeiten je Achse) */
+typedef struct
+{
+    float *center[3];
+    float *velocity[3];
+} ParticleState;
+
+/* Aus dem Zustand abgeleitete Groessen, je Stufe der Pipeline ein eigener
+ * Strom (Beschleunigungen und Up-Vektoren je Achse) */
+typedef struct
+{
+    float *accelaration[3];
+    float *up[3];
+} ParticleStreams;
+
+/* Partikel des Schwarms als Structure of Arrays. Jede Komponente liegt in
+ * einem eigenen, ausgerichteten Array, damit die Bewegung vektorisiert und
+ * blockweise berechnet werden kann. Zustand und Stroeme liegen doppelt vor:
+ * ein Zeitschritt liest den vorderen Satz und schreibt den hinteren, danach
+ * werden beide getauscht (Ping-Pong). */
+typedef struct
+{
+    /* Vorderer (zuletzt berechneter) Satz: Positionen, Geschwindigkeiten,
+     * Up-Vektoren und Beschleunigungen je Achse */
+    float *center[3];
+    float *velocity[3];
+    float *up[3];
+    float *accelaration[3];
+    /* Beide Saetze, front ist der Index des vorderen */
+    ParticleState states[2];
+    ParticleStreams streams[2];
+    int front;
+    /* Beschleunigungsfaktor je Partikel */
+    float *kWeak;
+    /* Alter und Lebensdauer (0 fuer unbegrenzt) in Sekunden */
+    float *age;
+    float *lifetime;
+    /* Anzahl der Partikel */
+    int count;
+    /* Anzahl der Partikel, fuer die Speicher reserviert ist */
+    int capacity;
+} ParticleStore;
+
+/* Stufen der Partikelpipeline eines Zeitschritts */
+typedef enum
+{
+    particleStageForces,
+    particleStageIntegrate,
+    particleStageOrientation,
+    PARTICLE_STAGE_COUNT
+} ParticleStage;
+
+/* Laufzeiten und Zaehler des Schwarmverhaltens seit dem letzten Zuruecksetzen */
 typedef struct
 {
+    /* Anzahl der Zeitschritte, in denen das Gitter aufgebaut wurde */
+    int steps;
+    /* Anzahl der Zellen des zuletzt aufgebauten Gitters */
+    int cellCount;
+    /* Laufzeit des Gitteraufbaus und der Kraftberechnung (summiert ueber alle Threads) in Nanosekunden */
+    double buildNanos;
+    double forceNanos;
+    /* Anzahl der Auswertungen je Partikel, der geprueften Kandidaten und der gefundenen Nachbarn */
+    long long evaluations;
+    long long candidates;
+    long long neighbours;
+} FlockingStats;
+
+/* Zaehler und Laufzeiten der im Hintergrund geschriebenen Snapshots */
+typedef struct
+{
+    /* geschriebene und (wegen eines noch laufenden Schreibvorgangs) ausgelassene Snapshots */
+    int written;
+    int dropped;
+    /* Laufzeit des Kopierens in der Simulation und des Schreibens im Hintergrund in Nanosekunden */
+    double copyNanos;
+    double writeNanos;
+    /* geschriebene Bytes */
+    long long bytes;
+} SnapshotStreamStats;
+
+/* Verteilung der Startwerte neu erzeugter Partikel */
+typedef struct
+{
+    /* Mittelpunkt und halbe Kantenlaenge des Wuerfels der Startpositionen */
     CGVector3f center;
-    CGVector3f velocity;
-    CGVector3f up;
-    CGVector3f accelaration;
-    float k_weak;
-} Particle;
+    float extent;
+    /* Flugrichtung (Nullvektor -> zufaellig) und halber Oeffnungswinkel
+     * des Kegels um diese Richtung in Grad */
+    CGVector3f direction;
+    float coneAngle;
+    /* Lebensdauer in Sekunden, 0 fuer unbegrenzt */
+    float lifetime;
+} ParticleSpawnDistribution;
+
+/* Emitter, der kontinuierlich neue Partikel erzeugt */
+typedef struct
+{
+    /* Position und Austrittsrichtung */
+    CGVector3f position;
+    CGVector3f direction;
+    /* halber Oeffnungswinkel des Austrittskegels in Grad */
+    float coneAngle;
+    /* erzeugte Partikel pro Sekunde */
+    float rate;
+    /* Lebensdauer der erzeugten Partikel in Sekunden */
+    float lifetime;
+    /* noch nicht erzeugter Bruchteil eines Partikels */
+    float pending;
+    GLboolean isActive;
+} Emitter;
+
+/* Kenngroessen des gesamten Schwarms, einmal je Zeitschritt berechnet */
+typedef struct
+{
+    /* Mittelpunkt der Partikel (auf den Wuerfel begrenzt) */
+    CGVector3f mean;
+    /* mittlere Geschwindigkeit der Partikel */
+    CGVector3f meanVelocity;
+    /* achsenparallele Huelle der Partikel */
+    CGVector3f boundsMin;
+    CGVector3f boundsMax;
+    /* Position des ausgewaehlten Partikels */
+    CGVector3f pickedCenter;
+} SwarmAggregates;
 
 /** Datentyp fuer Mausereignisse. */
 typedef enum e_MouseEventType CGMouseEventType;
@@ -112,4 +247,37 @@ typedef enum e_MouseEventType CGMouseEventType;
 typedef GLfloat Vertex[11];
 typedef GLfloat LogicVertex[3];
 
+/* Vertex Arrays der Partikeldarstellung */
+typedef enum
+{
+    particleBufferBodies,
+    particleBufferShadows,
+    particleBufferVectors,
+    PARTICLE_BUFFER_COUNT
+} ParticleBufferType;
+
+/* Einstellungen fuer das Befuellen der Partikel Vertex Arrays */
+typedef struct
+{
+    /* Dreiecke (GL_TRUE) oder Linien (GL_FALSE) fuer Partikel und Schatten */
+    GLboolean asTriangles;
+    GLboolean withShadows;
+    /* Hilfsvektoren fuer Beschleunigung, Geschwindigkeit und Up-Vektor */
+    GLboolean withAcceleration;
+    GLboolean withVelocity;
+    GLboolean withUp;
+    /* Index des ausgewaehlten Partikels, das andersfarbig dargestellt wird */
+    int pickedParticle;
+} ParticleBufferOptions;
+
+/* Dynamisch wachsendes Vertex Array, das pro Frame neu befuellt wird */
+typedef struct
+{
+    Vertex *vertices;
+    /* Anzahl der befuellten Vertices */
+    int count;
+    /* Anzahl der Vertices, fuer die Speicher reserviert ist */
+    int capacity;
+} VertexBuffer;
+
 #endif
\ No newline at end of file
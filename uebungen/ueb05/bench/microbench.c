@@ -0,0 +1,262 @@
+/**
+ * @file
+ * Microbenchmarks der Schnitttests des Raytracers.
+ * Misst die Schnitttests eines Strahls mit einer Kugel und mit den Dreiecken
+ * der Obj Objekte (Hase, Wuerfel) ohne Fenster. Die Strahlen starten auf
+ * einer Kugel um die Szene und zielen auf zufaellige Punkte im Bereich der
+ * Objekte, sodass Treffer und Fehlschuesse gemischt auftreten. Sie werden
+ * vorab erzeugt und reihum verwendet. Mit -j werden die Ergebnisse
+ * zusaetzlich als JSON geschrieben ("-" fuer die Standardausgabe statt der
+ * Tabelle), um sie ueber mehrere Commits zu vergleichen. Mit -H werden
+ * zusaetzlich die Hardwarezaehler je Schnitttest gemessen (perfcounters.h),
+ * etwa um die Cachefehlzugriffe beim Durchlaufen der Dreiecke zu sehen.
+ *
+ * Muss wie das Programm selbst aus dem Verzeichnis der Uebung gestartet
+ * werden, damit die Obj Dateien gefunden werden.
+ *
+ * Aufruf: ueb05_microbench [-w Aufwaermen] [-n Wiederholungen] [-c Aufrufe] [-r Seed] [-j Datei] [-H]
+ *
+ * @author Michael Smirnov & Len Harmsen
+ */
+
+/* ---- System Header einbinden ---- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ---- Eigene Header einbinden ---- */
+#include "scene.h"
+#include "util.h"
+#include "microbench.h"
+
+/* ---- Konstanten ---- */
+
+#define MICROBENCH_DEFAULT_CALLS 64
+#define MICROBENCH_DEFAULT_SEED 42
+
+/** Anzahl der vorab erzeugten Strahlen (Zweierpotenz) */
+#define MICROBENCH_RAYS 1024
+#define MICROBENCH_RAY_MASK (MICROBENCH_RAYS - 1)
+
+/** Abstand der Strahlurspruenge vom Mittelpunkt der Szene */
+#define MICROBENCH_RAY_DISTANCE 3.0f
+
+#define MICROBENCH_BUNNY_PATH "src/objects/bunny1355v2641f.obj"
+#define MICROBENCH_CUBE_PATH "src/objects/cube8v6f.obj"
+
+/* ---- Typedeklarationen ---- */
+
+/** Eingaben der Kernel */
+typedef struct
+{
+    Ray rays[MICROBENCH_RAYS];
+    Sphere sphere;
+    ObjObject bunny;
+    ObjObject cube;
+    /* Ergebnisse, damit die Aufrufe nicht entfernt werden */
+    volatile float sink;
+} MicroBenchInputs;
+
+/* ---- Funktionen ---- */
+
+/**
+ * Misst rayIntersectSphere.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchRayIntersectSphere(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    float sum = 0.0f;
+    for (int i = 0; i < calls; i++)
+    {
+        float t;
+        if (rayIntersectSphere(inputs->rays[i & MICROBENCH_RAY_MASK], &t, inputs->sphere))
+        {
+            sum += t;
+        }
+    }
+    inputs->sink = sum;
+}
+
+/**
+ * Misst rayIntersectObjObject fuer ein Objekt.
+ * @param inputs die Eingaben
+ * @param object das getestete Objekt
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchRayIntersectObject(MicroBenchInputs *inputs, ObjObject *object, int calls)
+{
+    float sum = 0.0f;
+    for (int i = 0; i < calls; i++)
+    {
+        float t;
+        CGVector3f normal;
+        if (rayIntersectObjObject(inputs->rays[i & MICROBENCH_RAY_MASK], &t, normal,
+                                  &object->faceCount, object->vertices, object->faces, GL_FALSE))
+        {
+            sum += t;
+        }
+    }
+    inputs->sink = sum;
+}
+
+/**
+ * Misst rayIntersectObjObject mit dem Hasen.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchRayIntersectBunny(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    benchRayIntersectObject(inputs, &inputs->bunny, calls);
+}
+
+/**
+ * Misst rayIntersectObjObject mit dem Wuerfel.
+ * @param context die Eingaben
+ * @param calls Anzahl der Aufrufe
+ */
+static void benchRayIntersectCube(void *context, int calls)
+{
+    MicroBenchInputs *inputs = context;
+    benchRayIntersectObject(inputs, &inputs->cube, calls);
+}
+
+/**
+ * Liefert eine zufaellige Zahl zwischen lower und upper.
+ * @param lower die untere Grenze
+ * @param upper die obere Grenze
+ * @return die zufaellige Zahl
+ */
+static float getRandomInRange(float lower, float upper)
+{
+    return lower + (upper - lower) * (float)rand() / (float)RAND_MAX;
+}
+
+/**
+ * Erzeugt die Strahlen der Kernel.
+ * @param inputs die Eingaben (out-param)
+ */
+static void initRays(MicroBenchInputs *inputs)
+{
+    for (int i = 0; i < MICROBENCH_RAYS; i++)
+    {
+        Ray *ray = &inputs->rays[i];
+        CGVector3f target;
+        setVector(getRandomInRange(-1.0f, 1.0f), getRandomInRange(-1.0f, 1.0f), getRandomInRange(-1.0f, 1.0f), ray->origin);
+        normalizeVector(ray->origin);
+        multiplyVectorWithScalar(ray->origin, MICROBENCH_RAY_DISTANCE, ray->origin);
+        setVector(getRandomInRange(-1.0f, 1.0f), getRandomInRange(-1.0f, 1.0f), getRandomInRange(-1.0f, 1.0f), target);
+        subtractVectos(target, ray->origin, ray->direction);
+        normalizeVector(ray->direction);
+    }
+}
+
+/**
+ * Hauptprogramm der Microbenchmarks.
+ * @param argc Anzahl der Kommandozeilenparameter
+ * @param argv Kommandozeilenparameter
+ * @return Rueckgabewert im Fehlerfall ungleich Null.
+ */
+int main(int argc, char **argv)
+{
+    int warmup = MICROBENCH_DEFAULT_WARMUP;
+    int repetitions = MICROBENCH_DEFAULT_REPETITIONS;
+    int calls = MICROBENCH_DEFAULT_CALLS;
+    unsigned seed = MICROBENCH_DEFAULT_SEED;
+    const char *jsonPath = NULL;
+    int countHardware = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "w:n:c:r:j:H")) != -1)
+    {
+        switch (opt)
+        {
+        case 'w':
+            warmup = atoi(optarg);
+            break;
+        case 'n':
+            repetitions = atoi(optarg);
+            break;
+        case 'c':
+            calls = atoi(optarg);
+            break;
+        case 'r':
+            seed = (unsigned)atoi(optarg);
+            break;
+        case 'j':
+            jsonPath = optarg;
+            break;
+        case 'H':
+            countHardware = 1;
+            break;
+        default:
+            fprintf(stderr, "Aufruf: %s [-w Aufwaermen] [-n Wiederholungen] [-c Aufrufe] [-r Seed] [-j Datei] [-H]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (warmup < 0 || repetitions < 1 || calls < 1)
+    {
+        fprintf(stderr, "Ungueltige Parameter.\n");
+        return 1;
+    }
+    if (access(MICROBENCH_BUNNY_PATH, R_OK) != 0 || access(MICROBENCH_CUBE_PATH, R_OK) != 0)
+    {
+        fprintf(stderr, "Obj Dateien nicht gefunden, bitte aus dem Verzeichnis der Uebung starten.\n");
+        return 1;
+    }
+
+    MicroBenchInputs *inputs = calloc(1, sizeof(MicroBenchInputs));
+    if (inputs == NULL)
+    {
+        printf("Kein virtueller RAM mehr verfügbar ...\n");
+        exit(1);
+    }
+    srand(seed);
+    initRays(inputs);
+    setVector(0.0f, 0.0f, 0.0f, inputs->sphere.center);
+    inputs->sphere.radius = 0.5f;
+    loadObjObject(MICROBENCH_BUNNY_PATH, &inputs->bunny);
+    loadObjObject(MICROBENCH_CUBE_PATH, &inputs->cube);
+    PerfCounters perfCounters;
+    PerfCounters *counters = NULL;
+    if (countHardware)
+    {
+        openPerfCounters(&perfCounters, 0);
+        counters = &perfCounters;
+    }
+
+    MicroBenchResult results[] = {
+        runMicroBench("rayIntersectSphere", benchRayIntersectSphere, inputs, calls, warmup, repetitions, counters),
+        runMicroBench("rayIntersectObjObject/cube", benchRayIntersectCube, inputs, calls, warmup, repetitions, counters),
+        runMicroBench("rayIntersectObjObject/bunny", benchRayIntersectBunny, inputs, calls, warmup, repetitions, counters),
+    };
+    int resultCount = (int)(sizeof(results) / sizeof(results[0]));
+
+    //Bei JSON auf der Standardausgabe entfaellt die Tabelle
+    if (jsonPath == NULL || strcmp(jsonPath, "-") != 0)
+    {
+        printf("Dreiecke: Hase %d, Wuerfel %d, Aufwaermen: %d, Wiederholungen: %d\n\n",
+               inputs->bunny.faceCount, inputs->cube.faceCount, warmup, repetitions);
+        printMicroBenchHeader();
+        for (int i = 0; i < resultCount; i++)
+        {
+            printMicroBenchResult(&results[i]);
+        }
+        printMicroBenchCounters(results, resultCount);
+    }
+
+    int ok = jsonPath == NULL || writeMicroBenchJson(jsonPath, "ueb05", warmup, results, resultCount);
+    if (counters != NULL)
+    {
+        closePerfCounters(counters);
+    }
+    free(inputs->bunny.vertices);
+    free(inputs->bunny.faces);
+    free(inputs->cube.vertices);
+    free(inputs->cube.faces);
+    free(inputs);
+    return ok ? 0 : 1;
+}
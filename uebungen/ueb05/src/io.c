@@ -27,6 +27,7 @@
 #include "logic.h"
 #include "scene.h"
 #include "util.h"
+#include "profiler.h"
 
 /* Funktionen */
 
@@ -56,6 +57,8 @@ GLfloat g_fps = 0.0f;
 /* ---- Konstanten ---- */
 /** Anzahl der Aufrufe der Timer-Funktion pro Sekunde */
 #define TIMER_CALLS_PS 60
+/** Datei fuer den Chrome-Trace der Frame-Zeiten */
+#define PROFILE_TRACE_PATH "profile_trace.json"
 /* ---- Funktionen ---- */
 
 /**
@@ -358,10 +361,12 @@ cbTimer(int lastCallTime)
     /* Seit dem Programmstart vergangene Zeit in Millisekunden */
     int thisCallTime = glutGet(GLUT_ELAPSED_TIME);
 
+    double profileStart = beginProfileScope();
     /*Kamerabewegung durch Tastendruecke*/
     moveCam();
     /*Kameraradius durch Tastendruecke*/
     handleRadius();
+    endProfileScope("Logik", profileStart);
 
     /* Wieder als Timer-Funktion registrieren */
     glutTimerFunc(1000 / TIMER_CALLS_PS, cbTimer, thisCallTime);
@@ -383,16 +388,22 @@ cbDisplay(void)
     int width = glutGet(GLUT_WINDOW_WIDTH);
     int height = glutGet(GLUT_WINDOW_HEIGHT);
 
+    double profileStart = beginProfileScope();
+
     /* Framewbuffer und z-Buffer zuruecksetzen */
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     drawScene(width, height);
+    endProfileScope("Zeichnen", profileStart);
 
     /* Objekt anzeigen */
+    profileStart = beginProfileScope();
     glutSwapBuffers();
+    endProfileScope("Buffertausch", profileStart);
 
     /* Framerate berechnen */
     g_fps = frameRate();
+    markProfileFrame();
 }
 
 /**
@@ -438,6 +449,17 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
                 break;
             case GLUT_KEY_F4:
                 break;
+                /* Frame-Zeiten anzeigen */
+            case GLUT_KEY_F11:
+                toggleProfileOverlay();
+                break;
+                /* Frame-Zeiten als Chrome-Trace speichern */
+            case GLUT_KEY_F12:
+                if (writeProfileTrace(PROFILE_TRACE_PATH))
+                {
+                    printf("Frame-Zeiten gespeichert: %s\n", PROFILE_TRACE_PATH);
+                }
+                break;
             }
         }
         /* normale Taste gedrueckt */
@@ -535,6 +557,7 @@ handleKeyboardEvent(int key, int status, GLboolean isSpecialKey, int x,
             case 'Q':
             case ESC:
                 freeFrameBuffer();
+                freeProfiler();
                 exit(0);
                 /* Hilfe */
             case 'h':
@@ -732,6 +755,9 @@ int initAndStartIO(char* title, int width, int height)
     int argc = 1;
     char* argv = "cmd";
 
+    /* Hauptthread im Chrome-Trace benennen */
+    setProfileThreadName("Hauptthread");
+
     /* Glut initialisieren */
     glutInit(&argc, &argv);
 
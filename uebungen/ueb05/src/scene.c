@@ -35,6 +35,8 @@
 #include "util.h"
 #include "float.h"
 #include "stdio.h"
+#include "stringOutput.h"
+#include "profiler.h"
 
 /* ---- Globale Variablen ---- */
 
@@ -43,6 +45,8 @@ GLint g_firstRenderAfterMoveCount = 0;
 
 GLboolean g_vignette = GL_FALSE;
 
+GLboolean g_profileOverlay = GL_FALSE;
+
 GLboolean g_light0Status = GL_TRUE;
 
 GLboolean g_light1Status = GL_TRUE;
@@ -88,7 +92,7 @@ CGVector3f g_backgroundColor = { BLACK };
 */
 static void drawHelp(void)
 {
-    int size = 15;
+    int size = 17;
 
     char* help[] = { "Hilfe:",
                     "w,a,s,d - Kamera bewegen",
@@ -104,6 +108,8 @@ static void drawHelp(void)
                     "N/n - Umschalten der Art der Bounding Box (kein, AABB, OBB) ",
                     "1 - Lichtquelle 1 an/aus",
                     "2 - Vignette Effekt an/aus",
+                    "F11 - Frame-Zeiten an/aus",
+                    "F12 - Frame-Zeiten als Chrome-Trace speichern",
                     "ESC/Q/q - Ende" };
 
     for (int i = 1; i < size; ++i)
@@ -142,7 +148,7 @@ static void drawInfoInWindowTitle(void)
  * @param filename der Pfad zur Datei
  * @param object Ziel in das das Obj Objekt geladen wird
  */
-static void loadObjObject(char* filename, ObjObject* object)
+void loadObjObject(char* filename, ObjObject* object)
 {
     FILE* file;
     file = fopen(filename, "r");
@@ -509,7 +515,7 @@ GLboolean rayIntersectSphere(Ray currRay, float* t, Sphere sphere)
  * @param isWall boolean, ob es sich um eine Wand handelt
  * @return true, wenn ein Objekt getroffen wurde
  */
-static GLboolean rayIntersectObjObject(Ray currRay, float* t, float* normal, int* faceCount, CGVector3f* vertices, CGVector3i* faces, GLboolean isWall)
+GLboolean rayIntersectObjObject(Ray currRay, float* t, float* normal, int* faceCount, CGVector3f* vertices, CGVector3i* faces, GLboolean isWall)
 {
     //Ob Schnittpunkt existiert
     GLboolean ret = GL_FALSE;
@@ -1018,6 +1024,7 @@ void drawScene(GLint width, GLint height)
     {
         if (!g_rendered || g_firstRenderAfterMoveCount == 0)
         {
+            double profileStart = beginProfileScope();
             //Framebuffer berechnen mittels Rays die in die Scene geschossen werden
             //Zeilenweise laufen
             for (int j = 0; j < height; j = isCameraMoving() ? j + SKIP_PIXEL_COUNT : j + 1)
@@ -1064,8 +1071,16 @@ void drawScene(GLint width, GLint height)
             {
                 g_firstRenderAfterMoveCount++;
             }
+            endProfileScope("Raytracing", profileStart);
         }
+        double profileStart = beginProfileScope();
         glDrawPixels(width, height, GL_RGB, GL_FLOAT, g_framebuffer);
+        endProfileScope("Pixeluebertragung", profileStart);
+
+        if (g_profileOverlay)
+        {
+            drawProfileOverlay(drawString);
+        }
     }
     else
     {
@@ -1074,6 +1089,14 @@ void drawScene(GLint width, GLint height)
     }
 }
 
+/**
+ * Toggelt das Overlay mit den Frame-Zeiten.
+ */
+void toggleProfileOverlay(void)
+{
+    g_profileOverlay = !g_profileOverlay;
+}
+
 /**
  * Reserviert den Speicher fuer den Framebuffer
  * @param width Breite des Bildschirmes
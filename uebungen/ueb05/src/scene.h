@@ -36,4 +36,24 @@ void toggleG_numLightsStartIndex(void);
 
 void toggleG_Vignette(void);
 
+/**
+ * Toggelt das Overlay mit den Frame-Zeiten.
+ */
+void toggleProfileOverlay(void);
+
+/**
+ * Liesst eine Obj Datei ein.
+ */
+void loadObjObject(char* filename, ObjObject* object);
+
+/**
+ * Schnitttest eines Strahls mit einer Kugel.
+ */
+GLboolean rayIntersectSphere(Ray currRay, float* t, Sphere sphere);
+
+/**
+ * Schnitttest eines Strahls mit allen Dreiecken eines Obj Objektes.
+ */
+GLboolean rayIntersectObjObject(Ray currRay, float* t, float* normal, int* faceCount, CGVector3f* vertices, CGVector3i* faces, GLboolean isWall);
+
 #endif
\ No newline at end of file